@@ -0,0 +1,651 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Huang Rui <vowstar@gmail.com>
+
+#include "cli/qsoccliworker.h"
+#include "common/qsocconsole.h"
+#include "common/qsocprofiler.h"
+#include "common/qsocprojectmanager.h"
+#include "common/qsocyamlfilecache.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcess>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QThread>
+
+#include <cstdio>
+#include <memory>
+
+/* Scaling benchmark for the qsoc generator.
+ *
+ * Builds a deterministic synthetic project per scale, then drives the same
+ * CLI paths a user would: module import, bus mapping, module list (cold and
+ * against resident managers, as `qsoc daemon` serves it), generate verilog
+ * and generate template (one template, then sixteen over the same data,
+ * one call each and as one batch, a SystemRDL map elaborated cold and
+ * loaded from the elaboration cache, then a large CSV table without and
+ * with the pretty JSON data sidecar). Each stage reports wall time,
+ * throughput and its own peak RSS; on Linux the high-water mark is reset
+ * before every stage, elsewhere it is the process peak so far. With
+ * --baseline, results are compared to a stored JSON file and the run fails
+ * when any stage exceeds its baseline by more than the tolerance. */
+namespace {
+
+struct BenchScale
+{
+    QString name;
+    int     instances;       /* Netlist instances */
+    int     netsPerInstance; /* Data ports per instance, each chained to the next one */
+    int     busLinks;        /* Master/slave pairs joined through bus links */
+    int     domains;         /* Clock and reset controller pairs */
+    int     librarySize;     /* Distinct modules imported into the library */
+};
+
+const QList<BenchScale> kScales = {
+    {"small", 64, 4, 16, 2, 8},
+    {"medium", 512, 8, 128, 8, 32},
+    {"large", 2048, 16, 512, 32, 128},
+};
+
+/* Templates rendered over one data set by the template batch stages */
+constexpr int kBatchTemplates = 16;
+
+/* CSV rows per netlist instance in the table data of the sidecar stages */
+constexpr int kTableRowsPerInstance = 50;
+
+const QStringList kBusSignals
+    = {"paddr", "psel", "penable", "pwrite", "pwdata", "prdata", "pready"};
+
+struct StageResult
+{
+    QString stage;
+    qint64  items  = 0;
+    qint64  wallUs = 0;
+    qint64  rssKb  = 0;
+    bool    ok     = true;
+};
+
+bool writeText(const QString &filePath, const QString &content)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        return false;
+    }
+    QTextStream stream(&file);
+    stream << content;
+    return true;
+}
+
+/* Deterministic project content; the same scale and seed give identical files */
+class SyntheticProject
+{
+public:
+    SyntheticProject(const BenchScale &scale, quint32 seed)
+        : m_scale(scale)
+        , m_random(seed)
+    {}
+
+    QString moduleName(int index) const { return QString("bench_cell_%1").arg(index); }
+
+    QString verilog(int index)
+    {
+        const int   width = 1 << m_random.bounded(6); /* 1..32 bits */
+        QString     text;
+        QTextStream out(&text);
+        out << "module " << moduleName(index) << " (\n";
+        out << "  input  wire clk,\n";
+        out << "  input  wire rst_n,\n";
+        for (int port = 0; port < m_scale.netsPerInstance; ++port) {
+            out << "  input  wire [" << width - 1 << ":0] in_" << port << ",\n";
+            out << "  output wire [" << width - 1 << ":0] out_" << port << ",\n";
+        }
+        out << "  output wire [31:0] m_paddr,\n"
+            << "  output wire        m_psel,\n"
+            << "  output wire        m_penable,\n"
+            << "  output wire        m_pwrite,\n"
+            << "  output wire [31:0] m_pwdata,\n"
+            << "  input  wire [31:0] m_prdata,\n"
+            << "  input  wire        m_pready,\n"
+            << "  input  wire [31:0] s_paddr,\n"
+            << "  input  wire        s_psel,\n"
+            << "  input  wire        s_penable,\n"
+            << "  input  wire        s_pwrite,\n"
+            << "  input  wire [31:0] s_pwdata,\n"
+            << "  output wire [31:0] s_prdata,\n"
+            << "  output wire        s_pready\n"
+            << ");\n";
+        for (int port = 0; port < m_scale.netsPerInstance; ++port) {
+            out << "  assign out_" << port << " = in_" << port << " ^ " << width << "'d"
+                << m_random.bounded(1 << qMin(width, 16)) << ";\n";
+        }
+        out << "  assign m_paddr   = 32'd" << index << ";\n"
+            << "  assign m_psel    = rst_n;\n"
+            << "  assign m_penable = clk;\n"
+            << "  assign m_pwrite  = 1'b0;\n"
+            << "  assign m_pwdata  = s_pwdata;\n"
+            << "  assign s_prdata  = m_prdata;\n"
+            << "  assign s_pready  = m_pready;\n"
+            << "endmodule\n";
+        return text;
+    }
+
+    static QString bus()
+    {
+        QString     text;
+        QTextStream out(&text);
+        out << "bench_apb:\n  port:\n";
+        for (const QString &signal : kBusSignals) {
+            const bool fromMaster = signal != "prdata" && signal != "pready";
+            out << "    " << signal << ":\n"
+                << "      master:\n        direction: " << (fromMaster ? "out" : "in") << "\n"
+                << "      slave:\n        direction: " << (fromMaster ? "in" : "out") << "\n";
+        }
+        return text;
+    }
+
+    QString netlist() const
+    {
+        const int   count = m_scale.instances;
+        QString     text;
+        QTextStream out(&text);
+        out << "---\nversion: \"1.0\"\nmodule: \"bench_top\"\n";
+
+        out << "port:\n";
+        for (int domain = 0; domain < m_scale.domains; ++domain) {
+            out << "  osc_" << domain << ":\n    direction: input\n    type: logic\n"
+                << "  por_n_" << domain << ":\n    direction: input\n    type: logic\n";
+        }
+
+        out << "instance:\n";
+        for (int index = 0; index < count; ++index) {
+            const int domain = index % m_scale.domains;
+            out << "  u_" << index << ":\n"
+                << "    module: " << moduleName(index % m_scale.librarySize) << "\n"
+                << "    port:\n"
+                << "      clk:\n        link: clk_dom_" << domain << "\n"
+                << "      rst_n:\n        link: rst_dom_" << domain << "_n\n";
+            const int pair = index / 2;
+            if (pair < m_scale.busLinks) {
+                out << "    bus:\n"
+                    << "      " << (index % 2 == 0 ? "m" : "s") << ":\n"
+                    << "        link: bench_bus_" << pair << "\n";
+            }
+        }
+
+        out << "net:\n";
+        for (int index = 0; index < count; ++index) {
+            for (int port = 0; port < m_scale.netsPerInstance; ++port) {
+                out << "  n_" << index << "_" << port << ":\n"
+                    << "    - instance: u_" << index << "\n      port: out_" << port << "\n"
+                    << "    - instance: u_" << (index + 1) % count << "\n      port: in_"
+                    << port << "\n";
+            }
+        }
+
+        out << "clock:\n";
+        for (int domain = 0; domain < m_scale.domains; ++domain) {
+            out << "  - name: bench_clk_ctrl_" << domain << "\n"
+                << "    input:\n      osc_" << domain << ":\n        freq: 100MHz\n"
+                << "    target:\n      clk_dom_" << domain << ":\n        freq: 100MHz\n"
+                << "        link:\n          osc_" << domain << ":\n";
+        }
+
+        out << "reset:\n";
+        for (int domain = 0; domain < m_scale.domains; ++domain) {
+            out << "  - name: bench_rst_ctrl_" << domain << "\n"
+                << "    clock: clk_dom_" << domain << "\n"
+                << "    source:\n      por_n_" << domain << ":\n        active: low\n"
+                << "    target:\n      rst_dom_" << domain << "_n:\n        active: low\n"
+                << "        link:\n          por_n_" << domain << ":\n";
+        }
+        return text;
+    }
+
+    QString templateData()
+    {
+        QString     text;
+        QTextStream out(&text);
+        out << "register:\n";
+        for (int index = 0; index < m_scale.instances; ++index) {
+            out << "  - name: reg_" << index << "\n"
+                << "    offset: " << index * 4 << "\n"
+                << "    reset: " << m_random.bounded(65536) << "\n";
+        }
+        return text;
+    }
+
+    /* Two registers per instance, so the large scale elaborates thousands */
+    QString registerMap()
+    {
+        QString     text;
+        QTextStream out(&text);
+        out << "addrmap bench_map {\n";
+        for (int index = 0; index < m_scale.instances * 2; ++index) {
+            out << "    reg {\n"
+                << "        field { sw = rw; hw = r; } value[15:0] = " << m_random.bounded(65536)
+                << ";\n"
+                << "    } reg_" << index << " @ 0x" << QString::number(index * 4, 16) << ";\n";
+        }
+        out << "};\n";
+        return text;
+    }
+
+    /* Fifty rows per instance, so the large scale holds about 100k rows */
+    QString tableData()
+    {
+        QString     text;
+        QTextStream out(&text);
+        out << "name,offset,reset,description\n";
+        for (int index = 0; index < m_scale.instances * kTableRowsPerInstance; ++index) {
+            out << "field_" << index << "," << index * 4 << "," << m_random.bounded(65536)
+                << ",Synthetic field " << index << "\n";
+        }
+        return text;
+    }
+
+    static QString tableTemplateText() { return "rows = {{ length(bench_table) }}\n"; }
+
+    static QString registerTemplateText()
+    {
+        return "{% for reg in bench_map.registers %}"
+               "#define {{ upper(reg.inst_name) }}_ADDR {{ reg.absolute_address }}\n"
+               "{% endfor %}";
+    }
+
+    static QString templateText()
+    {
+        return "// Register map\n"
+               "{% for reg in register %}"
+               "localparam {{ upper(reg.name) }}_OFFSET = {{ reg.offset }};\n"
+               "localparam {{ upper(reg.name) }}_RESET = {{ reg.reset }};\n"
+               "{% endfor %}";
+    }
+
+private:
+    BenchScale       m_scale;
+    QRandomGenerator m_random;
+};
+
+/* Run one qsoc CLI invocation in-process and return its exit code */
+int runCli(const QStringList &arguments)
+{
+    int           exitCode = -1;
+    QSocCliWorker worker;
+    QObject::connect(&worker, &QSocCliWorker::exit, [&exitCode](int code) { exitCode = code; });
+    worker.setup(QStringList{"qsoc"} + arguments, false);
+    worker.run();
+    return exitCode;
+}
+
+/* Restart the peak RSS count at the current RSS, so each stage reports its
+ * own high-water mark rather than the highest of every stage before it */
+void resetPeakRss()
+{
+#ifdef Q_OS_LINUX
+    QFile clearRefs("/proc/self/clear_refs");
+    if (clearRefs.open(QIODevice::WriteOnly)) {
+        clearRefs.write("5");
+    }
+#endif
+}
+
+/* Peak RSS since resetPeakRss(); the process-wide peak where it cannot be reset */
+qint64 stagePeakRssKb()
+{
+#ifdef Q_OS_LINUX
+    QFile status("/proc/self/status");
+    if (status.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        const QList<QByteArray> lines = status.readAll().split('\n');
+        for (const QByteArray &line : lines) {
+            if (line.startsWith("VmHWM:")) {
+                return line.mid(6).trimmed().split(' ').first().toLongLong();
+            }
+        }
+    }
+#endif
+    return QSocProfiler::peakRssKb();
+}
+
+StageResult timeStage(const QString &stage, qint64 items, const QList<QStringList> &invocations)
+{
+    StageResult   result{stage, items};
+    QElapsedTimer timer;
+    resetPeakRss();
+    timer.start();
+    for (const QStringList &arguments : invocations) {
+        if (runCli(arguments) != 0) {
+            result.ok = false;
+        }
+    }
+    result.wallUs = timer.nsecsElapsed() / 1000;
+    result.rssKb  = stagePeakRssKb();
+    return result;
+}
+
+/* Same invocations against one resident worker and parse cache, the way
+ * `qsoc daemon` serves repeated calls; the first call still parses */
+StageResult timeResidentStage(
+    const QString &stage, qint64 items, const QList<QStringList> &invocations)
+{
+    StageResult       result{stage, items};
+    QSocYamlFileCache cache;
+    QSocCliWorker     resident;
+    resident.setYamlCache(&cache);
+    QElapsedTimer timer;
+    resetPeakRss();
+    timer.start();
+    for (const QStringList &arguments : invocations) {
+        QSocCliWorker call(&resident);
+        if (call.execute(QStringList{"qsoc"} + arguments) != 0) {
+            result.ok = false;
+        }
+    }
+    result.wallUs = timer.nsecsElapsed() / 1000;
+    result.rssKb  = stagePeakRssKb();
+    return result;
+}
+
+/* One full pass over a fresh project; returns one result per stage */
+QList<StageResult> runScale(const BenchScale &scale, quint32 seed, const QString &rootPath)
+{
+    SyntheticProject   project(scale, seed);
+    QSocProjectManager projectManager;
+    const QString      projectName = "bench_" + scale.name;
+    const QString      projectPath = QDir(rootPath).filePath(projectName);
+    projectManager.setProjectName(projectName);
+    projectManager.setCurrentPath(projectPath);
+    projectManager.mkpath();
+    projectManager.save(projectName);
+    projectManager.load(projectName);
+
+    const QStringList common = {"-d", projectPath, "-p", projectName};
+    const QDir        sourceDir(projectPath);
+
+    QStringList sources;
+    for (int index = 0; index < scale.librarySize; ++index) {
+        const QString path = sourceDir.filePath(project.moduleName(index) + ".v");
+        writeText(path, project.verilog(index));
+        sources.append(path);
+    }
+    writeText(QDir(projectManager.getBusPath()).filePath("bench_apb.soc_bus"), project.bus());
+    const QString netlistPath  = sourceDir.filePath("bench_top.soc_net");
+    const QString dataPath     = sourceDir.filePath("bench_regs.yaml");
+    const QString templatePath = sourceDir.filePath("bench_regs.vh.j2");
+    writeText(netlistPath, project.netlist());
+    writeText(dataPath, project.templateData());
+    writeText(templatePath, SyntheticProject::templateText());
+    const QString rdlPath         = sourceDir.filePath("bench_map.rdl");
+    const QString rdlTemplatePath = sourceDir.filePath("bench_map.h.j2");
+    writeText(rdlPath, project.registerMap());
+    writeText(rdlTemplatePath, SyntheticProject::registerTemplateText());
+    const QString tablePath         = sourceDir.filePath("bench_table.csv");
+    const QString tableTemplatePath = sourceDir.filePath("bench_table.txt.j2");
+    writeText(tablePath, project.tableData());
+    writeText(tableTemplatePath, SyntheticProject::tableTemplateText());
+
+    QList<StageResult> results;
+    const QStringList importArguments = QStringList{"module", "import"} + common
+                                        + QStringList{"-l", "bench_lib", "-m", "bench_cell_.*"};
+    results.append(timeStage("module import", scale.librarySize, {importArguments + sources}));
+    /* Same library again, parsed on all cores; overwrites the serial result */
+    results.append(timeStage(
+        "module import -j",
+        scale.librarySize,
+        {importArguments + QStringList{"-j", "0"} + sources}));
+
+    QList<QStringList> busInvocations;
+    for (int index = 0; index < scale.librarySize; ++index) {
+        for (const QString &mode : {QString("master"), QString("slave")}) {
+            busInvocations.append(
+                QStringList{"module", "bus", "add"} + common
+                + QStringList{
+                    "-m", project.moduleName(index), "-b", "bench_apb", "-o", mode, mode.left(1)});
+        }
+    }
+    results.append(timeStage("bus mapping", busInvocations.size(), busInvocations));
+
+    const QList<QStringList> listInvocations(20, QStringList{"module", "list"} + common);
+    results.append(timeStage("module list", listInvocations.size(), listInvocations));
+    results.append(
+        timeResidentStage("module list resident", listInvocations.size(), listInvocations));
+
+    results.append(timeStage(
+        "generate verilog",
+        scale.instances,
+        {QStringList{"generate", "verilog", "--no-diagram"} + common + QStringList{netlistPath}}));
+
+    results.append(timeStage(
+        "generate template",
+        scale.instances,
+        {QStringList{"generate", "template"} + common
+         + QStringList{"--yaml", dataPath, templatePath}}));
+
+    /* Many templates over one data set: one call per template reloads the
+     * data every time, a batch call loads it once and renders in parallel */
+    QList<QStringList> templateInvocations;
+    QStringList        batchArguments = QStringList{"generate", "template"} + common
+                                         + QStringList{"--yaml", dataPath};
+    for (int index = 0; index < kBatchTemplates; ++index) {
+        const QString path = sourceDir.filePath(QString("bench_regs_%1.vh.j2").arg(index));
+        writeText(path, SyntheticProject::templateText());
+        templateInvocations.append(
+            QStringList{"generate", "template"} + common + QStringList{"--yaml", dataPath, path});
+        batchArguments.append(path);
+    }
+    results.append(timeStage(
+        "generate template x16", scale.instances * kBatchTemplates, templateInvocations));
+    results.append(timeStage(
+        "generate template batch x16", scale.instances * kBatchTemplates, {batchArguments}));
+
+    /* The first render elaborates the register map, the second one loads it
+     * from the elaboration cache */
+    const QList<QStringList> rdlInvocations
+        = {QStringList{"generate", "template"} + common
+           + QStringList{"--rdl", rdlPath, rdlTemplatePath}};
+    results.append(timeStage("generate template rdl", scale.instances * 2, rdlInvocations));
+    results.append(timeStage("generate template rdl hot", scale.instances * 2, rdlInvocations));
+
+    /* A large table under a tiny template, without and with the data sidecar */
+    const QStringList tableArguments = QStringList{"generate", "template"} + common
+                                       + QStringList{"--csv", tablePath, tableTemplatePath};
+    const qint64      tableRows      = qint64(scale.instances) * kTableRowsPerInstance;
+    results.append(timeStage("generate template csv", tableRows, {tableArguments}));
+    results.append(timeStage(
+        "generate template csv sidecar",
+        tableRows,
+        {tableArguments + QStringList{"--data-sidecar", "pretty"}}));
+
+    return results;
+}
+
+/* Route qsoc console output to the null device for the lifetime of the guard */
+class QuietConsole
+{
+public:
+    QuietConsole()
+        : m_sink(QProcess::nullDevice())
+    {
+        if (m_sink.open(QIODevice::WriteOnly)) {
+            QSocConsole::setLevel(QSocConsole::Level::Silent);
+            QSocConsole::setOutputDevice(&m_sink);
+            QSocConsole::setErrorDevice(&m_sink);
+        }
+    }
+    ~QuietConsole()
+    {
+        QSocConsole::setOutputDevice(nullptr);
+        QSocConsole::setErrorDevice(nullptr);
+    }
+    QuietConsole(const QuietConsole &)            = delete;
+    QuietConsole &operator=(const QuietConsole &) = delete;
+
+private:
+    QFile m_sink;
+};
+
+const StageResult *findStage(const QList<StageResult> &results, const QString &stage)
+{
+    for (const StageResult &result : results) {
+        if (result.stage == stage) {
+            return &result;
+        }
+    }
+    return nullptr;
+}
+
+QString caseKey(const BenchScale &scale, const StageResult &result)
+{
+    return scale.name + "/" + result.stage;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("qsoc_bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Scaling benchmark for qsoc project generation.");
+    parser.addHelpOption();
+    parser.addOptions({
+        {{"s", "scale"}, "Scale to run: small, medium, large or all.", "scale", "small"},
+        {{"r", "repeat"}, "Runs per scale; the fastest run is reported.", "count", "3"},
+        {"seed", "Seed for the synthetic project generator.", "seed", "1"},
+        {{"b", "baseline"}, "Fail when a stage regresses against this JSON file.", "file"},
+        {{"w", "write-baseline"}, "Store the results as a new baseline.", "file"},
+        {{"t", "tolerance"}, "Allowed slowdown or growth over baseline.", "ratio", "0.25"},
+        {"work-dir", "Keep generated projects in this directory.", "path"},
+        {{"v", "verbose"}, "Show qsoc output while running."},
+    });
+    parser.process(app);
+
+    QList<BenchScale> scales;
+    for (const BenchScale &scale : kScales) {
+        if (parser.value("scale") == "all" || parser.value("scale") == scale.name) {
+            scales.append(scale);
+        }
+    }
+    if (scales.isEmpty()) {
+        std::fprintf(stderr, "Unknown scale: %s\n", qPrintable(parser.value("scale")));
+        return 2;
+    }
+    const int     repeat    = qMax(1, parser.value("repeat").toInt());
+    const quint32 seed      = parser.value("seed").toUInt();
+    const double  tolerance = parser.value("tolerance").toDouble();
+
+    /* Keep the generator quiet unless asked; console output is not what we measure */
+    std::unique_ptr<QuietConsole> quiet;
+    if (!parser.isSet("verbose")) {
+        quiet = std::make_unique<QuietConsole>();
+    }
+
+    QTemporaryDir tempDir;
+    const QString rootPath = parser.isSet("work-dir") ? parser.value("work-dir") : tempDir.path();
+    QDir().mkpath(rootPath);
+
+    QTextStream report(stdout);
+    report << QString("case").leftJustified(28) << QString("items").rightJustified(8)
+           << QString("wall ms").rightJustified(12) << QString("items/s").rightJustified(12)
+           << QString("peak rss kb").rightJustified(14) << "\n";
+
+    bool        failed = false;
+    QJsonObject cases;
+    for (const BenchScale &scale : std::as_const(scales)) {
+        QList<StageResult> best;
+        for (int run = 0; run < repeat; ++run) {
+            const QString runPath = QDir(rootPath).filePath(QString("run_%1").arg(run));
+            QDir(runPath).removeRecursively();
+            /* An empty elaboration cache per run, so "generate template rdl"
+             * is cold in every run that best-of-N picks from */
+            qputenv("QSOC_RDL_CACHE", QDir(runPath).filePath("rdl-cache").toUtf8());
+            const QList<StageResult> results = runScale(scale, seed, runPath);
+            if (best.isEmpty()) {
+                best = results;
+                continue;
+            }
+            for (qsizetype index = 0; index < results.size(); ++index) {
+                /* Keep the peak RSS of the run whose wall time is reported */
+                if (results.at(index).wallUs < best.at(index).wallUs) {
+                    best[index].wallUs = results.at(index).wallUs;
+                    best[index].rssKb  = results.at(index).rssKb;
+                }
+                best[index].ok = best.at(index).ok && results.at(index).ok;
+            }
+        }
+
+        for (const StageResult &result : std::as_const(best)) {
+            const double seconds = static_cast<double>(result.wallUs) / 1e6;
+            const double rate    = seconds > 0 ? static_cast<double>(result.items) / seconds : 0;
+            report << caseKey(scale, result).leftJustified(28)
+                   << QString::number(result.items).rightJustified(8)
+                   << QString::number(static_cast<double>(result.wallUs) / 1000.0, 'f', 1)
+                          .rightJustified(12)
+                   << QString::number(rate, 'f', 1).rightJustified(12)
+                   << QString::number(result.rssKb).rightJustified(14)
+                   << (result.ok ? "" : "  FAILED") << "\n";
+            failed = failed || !result.ok;
+
+            QJsonObject entry;
+            entry["items"]       = result.items;
+            entry["wall_ms"]     = static_cast<double>(result.wallUs) / 1000.0;
+            entry["peak_rss_kb"] = result.rssKb;
+            cases[caseKey(scale, result)] = entry;
+        }
+        const StageResult *serialImport   = findStage(best, "module import");
+        const StageResult *parallelImport = findStage(best, "module import -j");
+        if (serialImport && parallelImport && parallelImport->wallUs > 0) {
+            const double speedup = static_cast<double>(serialImport->wallUs)
+                                   / static_cast<double>(parallelImport->wallUs);
+            report << scale.name << " parallel import speedup "
+                   << QString::number(speedup, 'f', 2) << "x on " << QThread::idealThreadCount()
+                   << " cores\n";
+        }
+        report.flush();
+    }
+
+    if (parser.isSet("write-baseline")) {
+        QFile file(parser.value("write-baseline"));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            std::fprintf(stderr, "Cannot write baseline: %s\n", qPrintable(file.fileName()));
+            return 2;
+        }
+        file.write(QJsonDocument(QJsonObject{{"cases", cases}}).toJson(QJsonDocument::Indented));
+    }
+
+    if (parser.isSet("baseline")) {
+        QFile file(parser.value("baseline"));
+        if (!file.open(QIODevice::ReadOnly)) {
+            std::fprintf(stderr, "Cannot read baseline: %s\n", qPrintable(file.fileName()));
+            return 2;
+        }
+        const QJsonObject baseline
+            = QJsonDocument::fromJson(file.readAll()).object().value("cases").toObject();
+        for (auto it = cases.constBegin(); it != cases.constEnd(); ++it) {
+            if (!baseline.contains(it.key())) {
+                continue;
+            }
+            const QJsonObject reference = baseline.value(it.key()).toObject();
+            const QJsonObject current   = it.value().toObject();
+            for (const char *metric : {"wall_ms", "peak_rss_kb"}) {
+                const double limit = reference.value(metric).toDouble() * (1.0 + tolerance);
+                const double value = current.value(metric).toDouble();
+                if (limit > 0 && value > limit) {
+                    report << "REGRESSION " << it.key() << " " << metric << ": " << value
+                           << " > " << limit << "\n";
+                    failed = true;
+                }
+            }
+        }
+    }
+
+    report.flush();
+    return failed ? 1 : 0;
+}
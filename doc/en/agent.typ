@@ -303,7 +303,7 @@ The following commands are available during an interactive session:
      comes up a two-column directory browser asks for the workspace; the
      choice is remembered in `<project>/.qsoc/remote.yml` and reused on
      later connects.],
-    [`/status`], [Show model, session, and endpoint info],
+    [`/status`], [Show model, session, TUI frame output, and web cache info],
     [`/help`], [Show help message],
     [`/agents`],
     [List sub-agent definitions by scope (builtin, user, project) and any
@@ -728,6 +728,15 @@ forming a sliding window. The foreground auto-background timeout in
 milliseconds (`agent.auto_background_ms`, env `QSOC_AUTO_BACKGROUND_MS`,
 default `120000`, `0` disables) is independently configurable.
 
+Each admitted child runs on its own thread with its own event loop and
+LLM connection, so streaming, context compaction and prompt building of
+several children proceed in parallel without stalling the parent. Tools
+marked thread-safe (such as `doc_query`) run on the calling child's
+thread, so several children can use them at once. Other tool calls are
+executed on the main thread, where their state lives; long-running tools
+move their work to a worker thread there, and a child waits for the
+calls of children that started after it to return first.
+
 When a detached child reaches a terminal state, the parent receives a
 `task-notification` carrying the status, a capped result body, and the
 transcript path; it is injected at the next turn boundary, never
@@ -985,6 +994,15 @@ Workspace tools operate on the remote host (SFTP + SSH exec):
 - `monitor`, `monitor_stop` (remote command, local notification stream)
 - `path_context` (remote root, cwd, writable dirs)
 
+`list_files` and `@file` completion list the remote tree with a single
+`find` on the host, not one SFTP round trip per directory. `list_files`
+takes `max_depth` (0 for unlimited) and a file-name `pattern`, so a search
+such as `*.sv` across the workspace is one command. Results are cached
+locally. Each call first asks the host for the newest directory mtime in
+the scanned range. When that is unchanged, the cached listing is reused
+and nothing else is transferred. This needs GNU `find`; on other hosts,
+`list_files` falls back to SFTP for a one-level listing.
+
 Control-plane tools stay on the local machine regardless of mode:
 
 - `query_docs`
@@ -1036,6 +1054,23 @@ a mid-LLM-turn child cannot block waiting on user input; the user must
 first run `/ssh <alias>` in the main session to seed an authenticated
 session that subsequent sub-agent spawns reuse from cache.
 
+=== Session Maintenance
+<agent-remote-session>
+
+One SSH session carries every remote tool: exec channels for `bash` and
+SFTP for file I/O, interleaved on the same connection. While the session is
+idle, a timer sends SSH keepalives every 15 to 20 seconds, with the period
+jittered per session. The same timer keeps two session channels open ahead
+of use, so an exec skips the channel-open round trip. ProxyJump hops only
+carry the tunnel and keep no channel pool. After three failed keepalives in
+a row the session is marked unhealthy. QSoC then stops probing and prints
+a notice naming the lost target. It does not reconnect on its own; run
+`/ssh` again to reconnect.
+
+`/ssh stats` lists the call count, average latency and worst latency of
+each operation kind (`exec`, `channel_open`, `sftp_read`, `sftp_write`,
+`sftp_list`, `sftp_stat`, ...) since the session connected.
+
 === Background Jobs
 <agent-remote-bg>
 
@@ -1046,6 +1081,20 @@ reads those state files over SSH exec to report status, tail output, or
 send `SIGTERM`/`SIGKILL`. Jobs survive SSH channel closes; QSoC does not
 auto-kill them when the agent exits.
 
+For a growing log, call `bash_manage` with `action=output` and an `offset`:
+the remote side returns only the bytes past that offset (at most
+`max_bytes`, default 64 KiB) together with `next_offset`, so each poll costs
+what is new rather than re-reading the file.
+
+Foreground `bash` streams the remote stdout and stderr as they arrive: the
+latest output line shows in the running tool block. The remote shell also
+tees both streams into `output.log` of a foreground job directory
+`.qsoc-agent/jobs/fg-<id>/`. The model receives the first 20000 and last
+30000 bytes of each stream; when anything in between is omitted, the
+result names the `job_id` whose full output `bash_manage` can page by
+offset. The host removes the directory at once when the output fits, and
+keeps only the 20 newest foreground spills.
+
 == SECURITY
 <agent-security>
 The agent uses a read-unrestricted, write-restricted permission model:
@@ -1114,6 +1163,10 @@ mcp:
         Authorization: "Bearer placeholder"
       request_timeout_ms: 60000
       connect_timeout_ms: 30000
+      result_cache:         # memoize pure lookups
+        ttl_seconds: 300
+        max_entries: 128
+        tools: [spec_search, register_lookup]
 
     - name: archived
       type: stdio
@@ -1155,6 +1208,18 @@ mcp:
        Default 30000.],
     [`request_timeout_ms`], [Per-request timeout in milliseconds.
        Default 60000; non-positive values disable request deadlines.],
+    [`max_concurrent_requests`], [Requests in flight to this server at
+       once. Further requests queue in order until a response frees a
+       slot. Default 0, no limit; set it for servers that cannot take
+       many parallel calls.],
+    [`result_cache`], [Opt-in memo of successful tool results, keyed by
+       tool name and arguments (member order ignored). `ttl_seconds`
+       (default 300) bounds each entry's age and `max_entries` (default
+       128) the count, least recently used first. `tools` lists the tools
+       to memoize; when omitted, only tools annotated with both
+       `readOnlyHint` and `idempotentHint` are used.
+       Cleared when the server restarts or sends
+       `notifications/tools/list_changed`.],
     [`enabled`], [Set to `false` to keep the entry in the config but skip
        it at startup.],
   )],
@@ -1194,7 +1259,8 @@ to the same public name are omitted.
     table.header([Command], [Description]),
     table.hline(),
     [`/mcp` or `/mcp list`], [List configured MCP servers with state and
-       tool count.],
+       tool count, plus result cache hits, misses and entries where
+       enabled.],
     [`/mcp reconnect <name>`], [Immediately rebuild the named server,
        including one previously marked failed.],
   )],
@@ -1219,6 +1285,11 @@ not confirm remote termination. Connection loss during a call reports the
 same uncertainty.
 Once ready, JSON-RPC batches claim all pending response IDs before delivering
 callbacks, so one callback cannot replace another batch result.
+Calls to one server are pipelined over its single connection: tool calls
+from concurrent agents do not wait for each other's replies, and each call
+completes when its own reply arrives. `max_concurrent_requests` caps the
+calls in flight when set. A queued call that times out or is aborted was
+never sent, so no cancellation is sent for it.
 
 If startup, initialization, or the connection fails, the manager schedules
 a rebuild on exponential backoff (1 s, 2 s, 4 s, capped at 30 s). A
@@ -38,6 +38,7 @@ commands and subcommands are available:
     [], [stub], [Generate Verilog and Liberty stub files for selected modules],
     [gui], [], [Start the software in GUI mode],
     [agent], [], [Start interactive AI agent for SoC design automation],
+    [daemon], [], [Serve commands from a resident process over a local socket],
   )],
   caption: [COMMAND LINE INTERFACE],
   kind: table,
@@ -118,6 +119,8 @@ The `module import` command imports Verilog modules into module libraries.
     [Define macro as KEY or KEY=VALUE. Can be used multiple times to define multiple macros],
     [`-U`, `--undefine <macro>`],
     [Undefine macro KEY at the start of all source files. Can be used multiple times],
+    [`-j`, `--jobs <count>`],
+    [Parse sources on this many threads, 0 for all cores. Default 1 parses one compilation unit],
     [files], [The verilog files to be processed],
   )],
   caption: [MODULE IMPORT OPTIONS],
@@ -154,6 +157,16 @@ qsoc module import -D NEW_FEATURE -U OLD_FEATURE module.v
 qsoc module import -p myproject -l stdlib -D DEBUG=1 -f filelist.txt
 ```
 
+*Parallel Parsing (`-j`, `--jobs`)*:
+- By default all files form one compilation unit, so a macro defined in one
+  file is visible to every later file
+- With `-j N` (or `-j 0` for all cores) each file is parsed as its own unit
+  on N threads
+- The list is parsed as a single unit as before when a file's macros are
+  used by later files, when a later file relies on an earlier `` `timescale ``
+  or `` `default_nettype ``, or when any file but the last has an `` `include ``
+- If the parallel parse fails, it is retried once as a single unit
+
 == BUS COMMAND OPTIONS
 <bus-options>
 The bus command provides functionality for managing bus interfaces.
@@ -198,6 +211,12 @@ The `generate verilog` command generates Verilog code from netlist files.
     [Merge multiple netlist files in order before processing],
     [`-f`, `--force`],
     [Force overwrite existing primitive cell files (clock_cell.v, reset_cell.v)],
+    [`--no-diagram`],
+    [Skip Typst diagrams for reset, clock and power controllers],
+    [`--profile`],
+    [Write a per-phase timing profile (Chrome trace and text summary)],
+    [`--watch`],
+    [Keep running and regenerate the outputs affected by each file change],
     [files], [The netlist files to be processed],
   )],
   caption: [VERILOG GENERATION OPTIONS],
@@ -261,6 +280,45 @@ instance:
         direction: input
 ```
 
+==== Generation Profile (`--profile`)
+<generation-profile>
+With `--profile`, each generation phase is timed: library and bus loading,
+netlist loading, bus link and uplink expansion, bus and link processing,
+comb and seq processing, each controller primitive and diagram, wire and
+instance emission, the unconnected port report and formatting. Every
+phase records wall time, CPU time, process peak RSS and, where it applies,
+an item count such as instances or nets.
+
+Two files are written to the output directory:
+
+- `qsoc_profile.json`: Chrome trace events, viewable in
+  `chrome://tracing` or Perfetto. Parallel controller rendering shows up
+  on separate threads.
+- `qsoc_profile.txt`: a summary with one row per phase, also printed to
+  the terminal.
+
+==== Watch Mode (`--watch`)
+<generation-watch>
+With `--watch`, `generate verilog`, `generate template` and `generate stub`
+build everything once and then keep running until interrupted. Module and
+bus libraries stay loaded between rebuilds. Changes are collected for
+200 ms, so one editor save counts once, and then only the affected outputs
+are written again:
+
+- A netlist change regenerates that netlist's Verilog, or the merged
+  output under `--merge`. Only the edited netlist is parsed again.
+- A `.soc_mod` change reloads that one library. It regenerates the
+  netlists that instantiate a module it defines, before or after the edit.
+- A `.soc_bus` change reloads the bus libraries and regenerates every
+  netlist.
+- A template change renders that template. A data file change renders
+  every template.
+- Library files added to or removed from the module and bus directories
+  count as changes too.
+
+A failed rebuild is reported and the watch continues. The
+`--profile` option is ignored in watch mode.
+
 === Template Generation Options
 <template-generation>
 The `generate template` command generates files from Jinja2 templates using CSV, YAML, JSON, SystemRDL (RDL), and RCSV (Register-CSV) data sources.
@@ -279,12 +337,32 @@ The `generate template` command generates files from Jinja2 templates using CSV,
     [`--rdl <file>`], [SystemRDL data file (can be used multiple times)],
     [`--rcsv <file>`],
     [RCSV (Register-CSV) data file (can be used multiple times)],
+    [`--data-sidecar <mode>`],
+    [Also write the template data next to each output: `off`, `pretty`,
+      `compact`, `cbor` or `msgpack` (default: `off`)],
+    [`--watch`],
+    [Keep running and render again the templates affected by each file change],
     [templates], [The Jinja2 template files to be processed],
   )],
   caption: [TEMPLATE GENERATION OPTIONS],
   kind: table,
 )
 
+Several templates given to one command form a batch. The data files are
+loaded and merged once, each template is parsed once, and the templates
+render in parallel. Files are written and results reported in command line
+order. A template that fails does not stop the others; the command still
+exits with an error.
+
+The merged template data is not written by default. With `--data-sidecar`,
+`pretty` and `compact` write it as indented or single-line JSON to
+`<basename>.json` beside each output, while `cbor` and `msgpack` write the
+binary encodings to `<basename>.cbor` and `<basename>.msgpack`. The file is
+streamed to disk on a background thread while the templates render, and the
+other outputs of a batch receive a copy of it. It is written to
+`<file>.part` and renamed into place once complete; if writing fails, a
+warning is printed, no partial file is left and no copies are made.
+
 === Template Generation Examples
 <template-generation-examples>
 The following examples demonstrate usage of different data sources with template generation:
@@ -334,6 +412,19 @@ RCSV files are processed through two-stage conversion:
 2. SystemRDL elaboration to simplified JSON using `elaborate_simplified()`
 This ensures RCSV files follow the same template access patterns as RDL files.
 
+==== Elaboration Cache
+Elaborating a large register map can dominate template generation, so the
+simplified JSON of every RDL and RCSV file is cached on disk in
+`~/.config/qsoc/cache/rdl`, one CBOR file per entry. The cache key covers
+the file content, the content of every file it includes, the directory
+includes resolve against, and the qsoc and SystemRDL library versions. For
+the bundled SystemRDL library the version is the checked out submodule commit.
+An unchanged register map is loaded from the cache instead of being elaborated
+again. Any edit selects a new entry, and the 256 most recently used entries
+are kept. A map with an angle-bracket include that resolves neither next to
+the including file nor next to the top-level file is always elaborated. Set `QSOC_RDL_CACHE=0` to disable the cache, or set it to a directory
+to use that directory instead.
+
 === Stub Generation Options
 <stub-generation>
 The `generate stub` command generates Verilog and Liberty stub files for selected modules.
@@ -350,6 +441,7 @@ The `generate stub` command generates Verilog and Liberty stub files for selecte
     [The library base name or regex pattern to filter libraries],
     [`-m`, `--module <regex>`],
     [The module name or regex pattern to filter modules],
+    [`--watch`], [Keep running and regenerate the stubs when a module library changes],
     [stubname],
     [The base name for the generated stub files (generates stubname.v and stubname.lib)],
   )],
@@ -357,4 +449,51 @@ The `generate stub` command generates Verilog and Liberty stub files for selecte
   kind: table,
 )
 
+== DAEMON COMMAND OPTIONS
+<daemon-options>
+Scripts that call `qsoc` many times in a row pay process start-up and a full
+parse of every `.soc_mod` and `.soc_bus` library on each call. `qsoc daemon`
+keeps the project, bus, module and generate managers resident, one set per
+working directory, together with the parsed library files. A client started
+with `QSOC_DAEMON=1` (or the socket name) in its environment forwards its
+arguments, working directory, environment and color choice to the daemon and
+prints the output and exit code it gets back. Without a reachable daemon the
+command simply runs locally.
+
+Every call starts from freshly reset managers, so results match a cold run. A
+library is parsed again as soon as its size or modification time changes.
+Each call runs under the environment of the client that sent it. The
+resident configuration and LLM settings are rebuilt when that environment
+differs from the previous call in the same directory, or when a `qsoc.yml`
+or `.qsoc.yml` file has changed. Calls are served one at a time. `agent`,
+`gui` and `--watch` always run locally. Both ends check that the peer runs
+as the same user, and a client that finds someone else's daemon on the socket
+runs the command locally.
+
+#figure(
+  align(center)[#table(
+    columns: (0.5fr, 1fr),
+    align: (auto, left),
+    table.header([Option], [Description]),
+    table.hline(),
+    [`--socket <name>`],
+    [The local socket name, default is `daemon` (`qsoc-daemon-<user>` on
+      Windows). On Unix a bare name is placed in
+      `$XDG_RUNTIME_DIR/qsoc`, or in `/tmp/qsoc-<uid>` when that is unset, and
+      the directory is kept at mode 0700],
+    [`--idle-timeout <minutes>`],
+    [Exit after this many minutes without a call, 0 never exits (default 30)],
+    [`--stop`], [Stop the daemon serving the socket],
+  )],
+  caption: [DAEMON OPTIONS],
+  kind: table,
+)
+
+```bash
+qsoc daemon &
+export QSOC_DAEMON=1
+qsoc module list -d ./soc    # served by the daemon
+qsoc daemon --stop
+```
+
 #pagebreak()
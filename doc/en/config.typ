@@ -303,6 +303,9 @@ These settings can also be overridden by command-line options (see @agent-comman
     [agent.max_iterations], [Maximum agent iterations (default: 100)],
     [agent.effort], [Reasoning effort: off, low, medium, high],
     [agent.stream], [Enable streaming output: true/false (default: true)],
+    [agent.synchronized_output],
+    [Wrap TUI frames in synchronized output (DEC mode 2026): auto, true or false
+      (default: auto, on for terminals known to support it)],
     [agent.prune_threshold],
     [Token ratio to trigger tool output pruning (default: 0.4)],
     [agent.compact_threshold],
@@ -387,6 +390,11 @@ configuration.
     [web.search_api_url],
     [SearXNG instance URL (e.g., `http://localhost:8080`). Required for `web_search`.],
     [web.search_api_key], [SearXNG API key (optional)],
+    [web.cache_max_mb],
+    [Size cap of the `web_fetch` response cache in MiB (default: 64, `0` disables). Responses
+      are cached under `~/.config/qsoc/cache/web` following `Cache-Control`, and stale entries
+      are revalidated with `ETag` / `Last-Modified`. `QSOC_WEB_CACHE` set to `0` disables the
+      cache; any other value names the cache directory.],
   )],
   caption: [WEB CONFIGURATION OPTIONS],
   kind: table,
@@ -399,6 +407,7 @@ Example:
 web:
   search_api_url: http://localhost:8080
   search_api_key: my-secret-key
+  cache_max_mb: 64
 ```
 
 == COMPLETE CONFIGURATION EXAMPLE
@@ -6,6 +6,8 @@
 #include "agent/mcp/qsocmcpjson_p.h"
 #include "agent/mcp/qsocmcptransport.h"
 
+#include <utility>
+
 #include <QTimer>
 
 namespace {
@@ -165,11 +167,13 @@ int QSocMcpClient::request(
             if (!abandonRequest(id)) {
                 return;
             }
+            /* Settle the unsent mark now; the failure handler may stop us */
+            const bool    written = !unsent_.remove(id);
             const QString timeoutMessage
                 = requestFailureMessage(method, QStringLiteral("Request timed out: %1").arg(method));
             const QPointer<QSocMcpClient> guard(this);
             emit                          requestFailed(id, kClientErrorTimeout, timeoutMessage);
-            if (guard.isNull() || !isCurrentLifecycle(generation, Lifecycle::Active)
+            if (!written || guard.isNull() || !isCurrentLifecycle(generation, Lifecycle::Active)
                 || state_ != State::Ready) {
                 return;
             }
@@ -178,6 +182,15 @@ int QSocMcpClient::request(
         timer->start(effective);
         pending.timer = timer;
     }
+    /* Wait behind earlier queued requests even when a slot just freed */
+    const int limit = config_.maxConcurrentRequests;
+    if (limit > 0 && (inFlightCount() >= limit || !queued_.isEmpty())) {
+        pending.deferred = std::move(msg);
+        pending.queued   = true;
+        pending_.insert(id, pending);
+        queued_.append(id);
+        return id;
+    }
     pending_.insert(id, pending);
 
     writeMessage(msg);
@@ -340,7 +353,9 @@ void QSocMcpClient::onMessageReceived(const nlohmann::json &message)
     QSet<int> eligiblePendingIds;
     eligiblePendingIds.reserve(pending_.size());
     for (auto it = pending_.cbegin(); it != pending_.cend(); ++it) {
-        eligiblePendingIds.insert(it.key());
+        if (!it->queued) {
+            eligiblePendingIds.insert(it.key());
+        }
     }
     const QPointer<QSocMcpClient> guard(this);
     QSet<const nlohmann::json *>  claimedResponses;
@@ -434,7 +449,8 @@ std::optional<nlohmann::json> QSocMcpClient::handleMessage(
 
         if (!responseAlreadyClaimed) {
             if ((eligiblePendingIds != nullptr && !eligiblePendingIds->contains(id))
-                || !pending_.contains(id) || !takePending(id).has_value()) {
+                || !pending_.contains(id) || pending_.value(id).queued
+                || !takePending(id).has_value()) {
                 return std::nullopt;
             }
         }
@@ -643,17 +659,28 @@ std::optional<QSocMcpClient::Pending> QSocMcpClient::takePending(int id)
         pending.timer->stop();
         pending.timer->deleteLater();
     }
+    if (pending.queued) {
+        queued_.removeOne(id);
+    } else {
+        scheduleDrain();
+    }
     return pending;
 }
 
 bool QSocMcpClient::abandonRequest(int id)
 {
-    if (!takePending(id).has_value()) {
+    const std::optional<Pending> pending = takePending(id);
+    if (!pending.has_value()) {
         return false;
     }
     if (id == initializeId_) {
         initializeId_ = -1;
     }
+    if (pending->queued) {
+        /* Never written: there is nothing for the server to cancel */
+        unsent_.insert(id);
+        return true;
+    }
     if (transport_ != nullptr) {
         transport_->abandonRequest(id);
     }
@@ -662,6 +689,9 @@ bool QSocMcpClient::abandonRequest(int id)
 
 void QSocMcpClient::notifyRequestCancelled(int id, const QString &reason)
 {
+    if (unsent_.remove(id)) {
+        return;
+    }
     nlohmann::json params;
     params["requestId"] = id;
     params["reason"]    = reason.toStdString();
@@ -672,6 +702,8 @@ bool QSocMcpClient::failAllPending(int code, const QString &message)
 {
     QHash<int, Pending> pending;
     pending.swap(pending_);
+    queued_.clear();
+    unsent_.clear();
     initializeId_ = -1;
 
     const auto ids = pending.keys();
@@ -746,3 +778,36 @@ int QSocMcpClient::effectiveTimeoutMs(int requested) const
     }
     return config_.requestTimeoutMs;
 }
+
+qsizetype QSocMcpClient::inFlightCount() const
+{
+    return pending_.size() - queued_.size();
+}
+
+void QSocMcpClient::scheduleDrain()
+{
+    if (queued_.isEmpty() || drainScheduled_) {
+        return;
+    }
+    /* Deferred so a freed slot is refilled after the current response or
+     * failure has been delivered, never from inside its handling. */
+    drainScheduled_ = true;
+    QMetaObject::invokeMethod(this, &QSocMcpClient::drainQueue, Qt::QueuedConnection);
+}
+
+void QSocMcpClient::drainQueue()
+{
+    drainScheduled_ = false;
+    const int limit = config_.maxConcurrentRequests;
+    while (!queued_.isEmpty() && lifecycle_ == Lifecycle::Active && state_ == State::Ready
+           && (limit <= 0 || inFlightCount() < limit)) {
+        const int id        = queued_.takeFirst();
+        auto      pendingIt = pending_.find(id);
+        if (pendingIt == pending_.end()) {
+            continue;
+        }
+        pendingIt->queued            = false;
+        const nlohmann::json message = std::exchange(pendingIt->deferred, nlohmann::json());
+        writeMessage(message);
+    }
+}
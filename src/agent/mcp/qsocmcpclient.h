@@ -73,7 +73,12 @@ public:
     /**
      * @brief Send a JSON-RPC request and return its id.
      * @details The response (or failure) is emitted via responseReceived or
-     *          requestFailed; the id is the correlation key.
+     *          requestFailed; the id is the correlation key. Requests are
+     *          pipelined: all are in flight at once unless the server sets
+     *          max_concurrent_requests, and the rest wait in FIFO order for
+     *          a slot.
+     *          A queued request counts against its timeout and can be
+     *          abandoned before it is ever written.
      * @param method JSON-RPC method, e.g. "tools/list".
      * @param params Request parameters; defaults to an empty object.
      * @param timeoutMs Per-request timeout. Negative means no timeout
@@ -124,6 +129,8 @@ private:
     {
         QString          method;
         QPointer<QTimer> timer;
+        nlohmann::json   deferred; /* message held back while the server is at its limit */
+        bool             queued = false;
     };
 
     void                          setState(State newState);
@@ -145,6 +152,9 @@ private:
     void                   stopTransportOrFinish(quint64 generation);
     void                   finishLifecycle(quint64 generation);
     int                    effectiveTimeoutMs(int requested) const;
+    qsizetype              inFlightCount() const;
+    void                   scheduleDrain();
+    void                   drainQueue();
 
     McpServerConfig     config_;
     QSocMcpTransport   *transport_    = nullptr;
@@ -153,6 +163,9 @@ private:
     int                 initializeId_ = -1;
     nlohmann::json      serverCapabilities_;
     QHash<int, Pending> pending_;
+    QList<int>          queued_;
+    QSet<int>           unsent_;
+    bool                drainScheduled_ = false;
     QPointer<QTimer>    initializedSendTimer_;
     Lifecycle           lifecycle_            = Lifecycle::Idle;
     quint64             lifecycleGeneration_  = 0;
@@ -140,6 +140,8 @@ bool descriptorFromJson(
                 = annotationBool(*annotations, "readOnlyHint", result.readOnly, sanitizedFields);
             result.destructive = annotationBool(
                 *annotations, "destructiveHint", result.destructive, sanitizedFields);
+            result.idempotent = annotationBool(
+                *annotations, "idempotentHint", result.idempotent, sanitizedFields);
         } else {
             ++*sanitizedFields;
         }
@@ -251,6 +253,10 @@ QSocMcpManager::QSocMcpManager(
         order_ << cfg.name;
         ServerState state;
         state.config = cfg;
+        if (cfg.resultCacheTtlMs > 0 && cfg.resultCacheMaxEntries > 0) {
+            state.resultCache = std::make_shared<QSocMcpResultCache>(
+                cfg.resultCacheTtlMs, cfg.resultCacheMaxEntries);
+        }
         servers_.insert(cfg.name, state);
         auto &stored = servers_[cfg.name];
         buildServer(stored.config, ++stored.replacementRevision);
@@ -381,6 +387,15 @@ bool QSocMcpManager::hasGivenUp(const QString &name) const
     return servers_.value(name).givenUp;
 }
 
+std::optional<QSocMcpResultCache::Stats> QSocMcpManager::resultCacheStats(const QString &name) const
+{
+    const auto server = servers_.constFind(name);
+    if (server == servers_.constEnd() || !server->resultCache) {
+        return std::nullopt;
+    }
+    return server->resultCache->stats();
+}
+
 bool QSocMcpManager::reconnectServer(const QString &name)
 {
     if (!servers_.contains(name)) {
@@ -496,6 +511,10 @@ void QSocMcpManager::onClientNotification(const QString &method, const nlohmann:
     if (client == nullptr) {
         return;
     }
+    const auto server = servers_.find(nameForClient(client));
+    if (server != servers_.end() && server->resultCache) {
+        server->resultCache->clear();
+    }
     requestToolsList(client);
 }
 
@@ -805,6 +824,11 @@ void QSocMcpManager::registerTools(QSocMcpClient *client, const QList<McpToolDes
     qsizetype registered = 0;
     for (const McpToolDescriptor &descriptor : descriptors) {
         auto *tool = new QSocMcpTool(client, descriptor, this);
+        if (state.resultCache
+            && state.config.cachesTool(
+                descriptor.toolName, descriptor.readOnly, descriptor.idempotent)) {
+            tool->setResultCache(state.resultCache);
+        }
         toolRegistry_->registerTool(tool);
         state.registeredTools.append(tool);
         ++registered;
@@ -827,6 +851,9 @@ void QSocMcpManager::unregisterToolsFor(const QString &name)
         }
     }
     state.registeredTools.clear();
+    if (state.resultCache) {
+        state.resultCache->clear();
+    }
 }
 
 QSocMcpClient *QSocMcpManager::senderClient()
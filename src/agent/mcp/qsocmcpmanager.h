@@ -4,9 +4,12 @@
 #ifndef QSOCMCPMANAGER_H
 #define QSOCMCPMANAGER_H
 
+#include "agent/mcp/qsocmcpresultcache.h"
 #include "agent/mcp/qsocmcptypes.h"
 
 #include <functional>
+#include <memory>
+#include <optional>
 
 #include <QHash>
 #include <QList>
@@ -34,6 +37,11 @@ class QTimer;
  *          exponential backoff schedule, capped at kMaxReconnectAttempts.
  *          tools/list_changed notifications refresh the registered tools,
  *          coalescing changes while a request is active.
+ *
+ *          Servers with a `result_cache` block get one result cache shared
+ *          by their memoizable tools. It is cleared whenever the server's
+ *          tools are unregistered (restart, reconnect, catalog refresh) and
+ *          as soon as tools/list_changed arrives.
  */
 class QSocMcpManager : public QObject
 {
@@ -84,6 +92,9 @@ public:
     int                  reconnectAttempts(const QString &name) const;
     bool                 hasGivenUp(const QString &name) const;
 
+    /** @brief Result cache counters, or nullopt when the server has none. */
+    std::optional<QSocMcpResultCache::Stats> resultCacheStats(const QString &name) const;
+
     /**
      * @brief Reset state and rebuild the named server immediately.
      * @details Used by `/mcp reconnect`. Clears the reconnect counter
@@ -111,18 +122,19 @@ private slots:
 private:
     struct ServerState
     {
-        McpServerConfig              config;
-        QSocMcpClient               *client                  = nullptr;
-        int                          pendingListId           = -1;
-        int                          reconnectAttempts       = 0;
-        bool                         givenUp                 = false;
-        bool                         hasToolCatalog          = false;
-        bool                         toolListDirty           = false;
-        bool                         toolCatalogWarningShown = false;
-        QPointer<QTimer>             reconnectTimer;
-        QPointer<QSocMcpClient>      reconnectClient;
-        quint64                      replacementRevision = 0;
-        QList<QPointer<QSocMcpTool>> registeredTools;
+        McpServerConfig                     config;
+        QSocMcpClient                      *client                  = nullptr;
+        int                                 pendingListId           = -1;
+        int                                 reconnectAttempts       = 0;
+        bool                                givenUp                 = false;
+        bool                                hasToolCatalog          = false;
+        bool                                toolListDirty           = false;
+        bool                                toolCatalogWarningShown = false;
+        QPointer<QTimer>                    reconnectTimer;
+        QPointer<QSocMcpClient>             reconnectClient;
+        quint64                             replacementRevision = 0;
+        QList<QPointer<QSocMcpTool>>        registeredTools;
+        std::shared_ptr<QSocMcpResultCache> resultCache;
     };
 
     void buildServer(const McpServerConfig &cfg, quint64 revision);
@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Huang Rui <vowstar@gmail.com>
+
+#include "agent/mcp/qsocmcpresultcache.h"
+
+#include <QDateTime>
+
+QSocMcpResultCache::QSocMcpResultCache(int ttlMs, int maxEntries)
+    : ttlMs(ttlMs)
+    , entries(qMax(1, maxEntries))
+{}
+
+std::optional<QString> QSocMcpResultCache::lookup(
+    const QString &toolName, const nlohmann::json &arguments)
+{
+    const QString key   = keyFor(toolName, arguments);
+    const Entry  *entry = entries.object(key);
+    if (entry == nullptr) {
+        misses++;
+        return std::nullopt;
+    }
+    if (entry->expiresMs <= QDateTime::currentMSecsSinceEpoch()) {
+        entries.remove(key);
+        misses++;
+        return std::nullopt;
+    }
+    hits++;
+    return entry->result;
+}
+
+void QSocMcpResultCache::store(
+    const QString &toolName, const nlohmann::json &arguments, const QString &result)
+{
+    auto *entry      = new Entry;
+    entry->result    = result;
+    entry->expiresMs = QDateTime::currentMSecsSinceEpoch() + ttlMs;
+    entries.insert(keyFor(toolName, arguments), entry, 1);
+}
+
+void QSocMcpResultCache::clear()
+{
+    entries.clear();
+}
+
+QSocMcpResultCache::Stats QSocMcpResultCache::stats() const
+{
+    return Stats{hits, misses, entries.size()};
+}
+
+QString QSocMcpResultCache::keyFor(const QString &toolName, const nlohmann::json &arguments)
+{
+    /* nlohmann::json keeps object members sorted, so dump() is canonical */
+    return toolName + QLatin1Char('\n') + QString::fromStdString(arguments.dump());
+}
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Huang Rui <vowstar@gmail.com>
+
+#ifndef QSOCMCPRESULTCACHE_H
+#define QSOCMCPRESULTCACHE_H
+
+#include <nlohmann/json.hpp>
+
+#include <optional>
+
+#include <QCache>
+#include <QString>
+
+/**
+ * @brief Memoized tools/call results for one MCP server.
+ * @details Opt-in through the server's `result_cache` config block and
+ *          meant for pure lookup tools. Entries are keyed by tool name
+ *          and the canonical JSON of the arguments (object keys sorted,
+ *          so argument order does not matter), expire after a fixed TTL,
+ *          and are bounded by count with least-recently-used eviction.
+ *          The manager clears the cache when the server restarts or
+ *          announces a tool list change. Used on the registry thread only.
+ */
+class QSocMcpResultCache
+{
+public:
+    struct Stats
+    {
+        qint64    hits    = 0;
+        qint64    misses  = 0;
+        qsizetype entries = 0;
+    };
+
+    QSocMcpResultCache(int ttlMs, int maxEntries);
+
+    /** @brief Cached result for a call, counting a hit or a miss. */
+    std::optional<QString> lookup(const QString &toolName, const nlohmann::json &arguments);
+
+    /** @brief Remember the result of a successful call. */
+    void store(const QString &toolName, const nlohmann::json &arguments, const QString &result);
+
+    /** @brief Drop every entry; counters are kept. */
+    void clear();
+
+    Stats stats() const;
+
+private:
+    struct Entry
+    {
+        QString result;
+        qint64  expiresMs = 0;
+    };
+
+    static QString keyFor(const QString &toolName, const nlohmann::json &arguments);
+
+    int                    ttlMs;
+    QCache<QString, Entry> entries;
+    qint64                 hits   = 0;
+    qint64                 misses = 0;
+};
+
+#endif // QSOCMCPRESULTCACHE_H
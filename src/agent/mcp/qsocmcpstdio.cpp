@@ -314,8 +314,8 @@ bool QSocMcpStdioTransport::drainBuffer(QProcess *process, quint64 generation, b
 bool QSocMcpStdioTransport::drainNewlineBuffer(QProcess *process, quint64 generation, bool atEnd)
 {
     while (true) {
-        auto result
-            = QSocMcpStdioInternal::takeLine(readBuffer_, scanOffset_, kMaximumMessageBytes, atEnd);
+        auto result = QSocMcpStdioInternal::takeLine(
+            readBuffer_, readOffset_, scanOffset_, kMaximumMessageBytes, atEnd);
         if (result.status == QSocMcpStdioInternal::LineStatus::NeedMore) {
             return true;
         }
@@ -513,5 +513,6 @@ bool QSocMcpStdioTransport::isCurrent(QProcess *process, quint64 generation) con
 void QSocMcpStdioTransport::clearInput()
 {
     readBuffer_.clear();
+    readOffset_ = 0;
     scanOffset_ = 0;
 }
@@ -52,6 +52,7 @@ private:
     McpServerConfig    config_;
     QPointer<QProcess> process_;
     QByteArray         readBuffer_;
+    qsizetype          readOffset_          = 0;
     qsizetype          scanOffset_          = 0;
     quint64            lifecycleGeneration_ = 0;
     bool               terminal_            = true;
@@ -18,11 +18,22 @@ struct LineResult
     QByteArray message;
 };
 
+/* Extract the next newline-terminated message from buffer[readOffset..].
+ * Consumed lines only advance readOffset; the buffer is compacted once per
+ * drain, when no complete line is left, so a burst of many small messages
+ * costs linear rather than quadratic time. scanOffset remembers how far a
+ * partial line has been searched. */
 inline LineResult takeLine(
-    QByteArray &buffer, qsizetype &scanOffset, qsizetype maximumBytes, bool atEnd)
+    QByteArray &buffer,
+    qsizetype  &readOffset,
+    qsizetype  &scanOffset,
+    qsizetype   maximumBytes,
+    bool        atEnd)
 {
-    const qsizetype lineEnd = buffer.indexOf('\n', scanOffset);
+    const qsizetype lineEnd = buffer.indexOf('\n', qMax(scanOffset, readOffset));
     if (lineEnd < 0) {
+        buffer.remove(0, readOffset);
+        readOffset                = 0;
         scanOffset                = buffer.size();
         const bool      pendingCr = buffer.endsWith('\r');
         const qsizetype size      = buffer.size() - (pendingCr ? 1 : 0);
@@ -35,15 +46,20 @@ inline LineResult takeLine(
         return {};
     }
 
-    const bool      hasCr = lineEnd > 0 && buffer.at(lineEnd - 1) == '\r';
-    const qsizetype size  = lineEnd - (hasCr ? 1 : 0);
+    const bool      hasCr = lineEnd > readOffset && buffer.at(lineEnd - 1) == '\r';
+    const qsizetype size  = lineEnd - readOffset - (hasCr ? 1 : 0);
     if (size > maximumBytes) {
         return {LineStatus::TooLarge, {}};
     }
 
-    LineResult result{LineStatus::Message, buffer.left(size)};
-    buffer.remove(0, lineEnd + 1);
-    scanOffset = 0;
+    LineResult result{LineStatus::Message, buffer.mid(readOffset, size)};
+    readOffset = lineEnd + 1;
+    scanOffset = readOffset;
+    if (readOffset == buffer.size()) {
+        buffer.clear();
+        readOffset = 0;
+        scanOffset = 0;
+    }
     return result;
 }
 
@@ -4,12 +4,13 @@
 #include "agent/mcp/qsocmcptool.h"
 
 #include "agent/mcp/qsocmcpclient.h"
+#include "agent/mcp/qsocmcpresultcache.h"
 
 #include <optional>
+#include <utility>
 
 #include <QEventLoop>
 #include <QObject>
-#include <QScopeGuard>
 #include <QStringList>
 
 namespace {
@@ -106,6 +107,17 @@ std::optional<QString> formatContentBlock(const nlohmann::json &item)
     return QStringLiteral("[mcp unsupported content omitted: unknown]");
 }
 
+/* Only plain successes are worth memoizing; tool errors may be transient */
+bool isSuccessfulResult(const nlohmann::json &result)
+{
+    if (!result.is_object()) {
+        return false;
+    }
+    const auto errorMember = result.find("isError");
+    return errorMember == result.end()
+           || (errorMember->is_boolean() && !errorMember->get<bool>());
+}
+
 QString formatToolResult(const nlohmann::json &result)
 {
     if (!result.is_object()) {
@@ -188,133 +200,178 @@ json QSocMcpTool::getParametersSchema() const
 
 QString QSocMcpTool::execute(const json &arguments)
 {
-    QPointer<QSocToolCallContext> callContext(currentCallContext());
+    /* Synchronous callers wait for their own call only; the result is
+     * posted, so it always arrives through the loop */
+    std::optional<QString> result;
+    QEventLoop             loop;
+    executeAsync(arguments, currentCallContext(), [&result, &loop](const QString &text) {
+        result = text;
+        loop.quit();
+    });
+    if (!result.has_value()) {
+        loop.exec();
+    }
+    return result.value_or(QStringLiteral("[mcp error] call ended without a response"));
+}
 
+void QSocMcpTool::executeAsync(
+    const json &arguments, QSocToolCallContext *call, const ResultCallback &done)
+{
     if (retired_) {
-        return QStringLiteral("[mcp error] tool is no longer available");
+        return done(QStringLiteral("[mcp error] tool is no longer available"));
     }
     if (client_.isNull()) {
-        return QStringLiteral("[mcp error] server has gone away");
+        return done(QStringLiteral("[mcp error] server has gone away"));
     }
     if (client_->state() != QSocMcpClient::State::Ready) {
-        return QStringLiteral("[mcp error] server not ready");
+        return done(QStringLiteral("[mcp error] server not ready"));
+    }
+
+    const std::shared_ptr<QSocMcpResultCache> cache = resultCache_;
+    if (cache) {
+        if (std::optional<QString> cached = cache->lookup(descriptor_.toolName, arguments)) {
+            return done(*cached);
+        }
     }
 
     json params;
     params["name"]      = descriptor_.toolName.toStdString();
     params["arguments"] = arguments;
 
-    CallState  callState;
-    QEventLoop loop;
-    callState.loop = &loop;
-    activeCalls_.insert(&callState);
-
-    QPointer<QSocMcpTool> self(this);
-    const auto            removeCall = qScopeGuard([self, &callState]() {
-        if (self.isNull()) {
-            return;
-        }
-        self->activeCalls_.remove(&callState);
-        if (self->retired_ && self->activeCalls_.isEmpty()) {
-            self->deleteLater();
-        }
-    });
+    const auto state = std::make_shared<CallState>();
+    state->scope     = new QObject;
+    state->arguments = arguments;
+    state->cache     = cache;
+    state->done      = done;
+    activeCalls_.insert(state.get(), state);
 
+    const QPointer<QSocMcpTool> self(this);
     QObject::connect(
-        client_.data(), &QSocMcpClient::responseReceived, &loop, [&](int id, const json &resultJson) {
-            if (id != callState.requestId || callState.outcome != CallOutcome::Pending) {
+        client_.data(),
+        &QSocMcpClient::responseReceived,
+        state->scope,
+        [self, state](int id, const json &resultJson) {
+            if (self.isNull() || id != state->requestId || state->outcome != CallOutcome::Pending) {
                 return;
             }
-            callState.result  = formatToolResult(resultJson);
-            callState.outcome = CallOutcome::Completed;
-            loop.quit();
+            state->result    = formatToolResult(resultJson);
+            state->cacheable = isSuccessfulResult(resultJson)
+                               && state->result != invalidToolResult();
+            state->outcome   = CallOutcome::Completed;
+            self->finishCall(state);
         });
 
     QObject::connect(
         client_.data(),
         &QSocMcpClient::requestFailed,
-        &loop,
-        [&](int id, int code, const QString &message) {
-            if (id != callState.requestId || callState.outcome != CallOutcome::Pending) {
+        state->scope,
+        [self, state](int id, int code, const QString &message) {
+            if (self.isNull() || id != state->requestId || state->outcome != CallOutcome::Pending) {
                 return;
             }
-            callState.result  = QStringLiteral("[mcp error %1] %2").arg(code).arg(message);
-            callState.outcome = CallOutcome::Completed;
-            loop.quit();
+            state->result  = QStringLiteral("[mcp error %1] %2").arg(code).arg(message);
+            state->outcome = CallOutcome::Completed;
+            self->finishCall(state);
         });
 
-    QObject::connect(client_.data(), &QObject::destroyed, &loop, [&]() {
-        if (callState.outcome != CallOutcome::Pending) {
+    QObject::connect(client_.data(), &QObject::destroyed, state->scope, [self, state]() {
+        if (self.isNull() || state->outcome != CallOutcome::Pending) {
             return;
         }
-        callState.result  = serverClosedToolResult();
-        callState.outcome = CallOutcome::ClientClosed;
-        loop.quit();
+        state->result  = serverClosedToolResult();
+        state->outcome = CallOutcome::ClientClosed;
+        self->finishCall(state);
     });
 
-    if (!callContext.isNull()) {
+    if (call != nullptr) {
         QObject::connect(
-            callContext.data(),
-            &QSocToolCallContext::cancellationRequested,
-            &loop,
-            [this, &callState]() { cancelCalls(QSet<CallState *>{&callState}); });
+            call, &QSocToolCallContext::cancellationRequested, state->scope, [self, state]() {
+                if (!self.isNull()) {
+                    self->cancelCalls({state});
+                }
+            });
     }
 
     const int returnedId
-        = client_->request(QStringLiteral("tools/call"), params, -1, &callState.requestId);
+        = client_->request(QStringLiteral("tools/call"), params, -1, &state->requestId);
     if (returnedId < 0) {
-        return QStringLiteral("[mcp error] could not send request");
-    }
-
-    if (!callContext.isNull() && callContext->isCancellationRequested()) {
-        cancelCalls(QSet<CallState *>{&callState});
-    }
-
-    if (callState.outcome == CallOutcome::Pending) {
-        loop.exec();
+        if (state->outcome == CallOutcome::Pending) {
+            state->result  = QStringLiteral("[mcp error] could not send request");
+            state->outcome = CallOutcome::Completed;
+            finishCall(state);
+        }
+        return;
     }
 
-    switch (callState.outcome) {
-    case CallOutcome::Completed:
-    case CallOutcome::ClientClosed:
-        return callState.result;
-    case CallOutcome::Aborted:
-        return QStringLiteral(
-            "[mcp aborted] local wait ended; remote completion is unknown, do not retry "
-            "automatically");
-    case CallOutcome::Pending:
-        return QStringLiteral("[mcp error] call ended without a response");
+    if (call != nullptr && call->isCancellationRequested()) {
+        cancelCalls({state});
     }
-
-    Q_UNREACHABLE_RETURN(QString());
 }
 
 void QSocMcpTool::abort()
 {
-    const QSet<CallState *> calls = activeCalls_;
-    cancelCalls(calls);
+    cancelCalls(activeCalls_.values());
 }
 
-void QSocMcpTool::cancelCalls(const QSet<CallState *> &calls)
+void QSocMcpTool::cancelCalls(const QList<CallStatePtr> &calls)
 {
-    QList<CallState *> cancelledCalls;
+    QList<CallStatePtr> cancelledCalls;
     cancelledCalls.reserve(calls.size());
-    for (CallState *call : calls) {
+    for (const CallStatePtr &call : calls) {
         if (call->outcome != CallOutcome::Pending || client_.isNull()
             || !client_->abandonRequest(call->requestId)) {
             continue;
         }
         call->outcome = CallOutcome::Aborted;
         cancelledCalls.append(call);
-        if (call->loop != nullptr) {
-            call->loop->quit();
-        }
     }
-    for (CallState *call : cancelledCalls) {
-        if (client_.isNull()) {
-            return;
+    for (const CallStatePtr &call : cancelledCalls) {
+        if (!client_.isNull()) {
+            client_->notifyRequestCancelled(call->requestId, QStringLiteral("user abort"));
         }
-        client_->notifyRequestCancelled(call->requestId, QStringLiteral("user abort"));
+    }
+    for (const CallStatePtr &call : cancelledCalls) {
+        finishCall(call);
+    }
+}
+
+void QSocMcpTool::finishCall(const CallStatePtr &call)
+{
+    if (call->scope == nullptr) {
+        return;
+    }
+    /* Late signals still reach the scope until it goes; they see a
+     * settled outcome and return */
+    std::exchange(call->scope, nullptr)->deleteLater();
+    activeCalls_.remove(call.get());
+
+    if (call->cache && call->outcome == CallOutcome::Completed && call->cacheable) {
+        call->cache->store(descriptor_.toolName, call->arguments, call->result);
+    }
+
+    QString result;
+    switch (call->outcome) {
+    case CallOutcome::Completed:
+    case CallOutcome::ClientClosed:
+        result = call->result;
+        break;
+    case CallOutcome::Aborted:
+        result = QStringLiteral(
+            "[mcp aborted] local wait ended; remote completion is unknown, do not retry "
+            "automatically");
+        break;
+    case CallOutcome::Pending:
+        result = QStringLiteral("[mcp error] call ended without a response");
+        break;
+    }
+
+    /* Delivered from the event loop, never from inside the client's signal
+     * or the canceller's stack. Posted ahead of a retired wrapper's
+     * deferred delete, so it always runs. */
+    const ResultCallback done = std::exchange(call->done, ResultCallback());
+    QMetaObject::invokeMethod(this, [done, result]() { done(result); }, Qt::QueuedConnection);
+    if (retired_ && activeCalls_.isEmpty()) {
+        deleteLater();
     }
 }
 
@@ -329,7 +386,7 @@ void QSocMcpTool::retire()
         deleteLater();
         return;
     }
-    /* The active call stacks reclaim this wrapper after the final call exits. */
+    /* The last active call to finish reclaims this wrapper. */
     setParent(nullptr);
 }
 
@@ -337,3 +394,8 @@ const McpToolDescriptor &QSocMcpTool::descriptor() const
 {
     return descriptor_;
 }
+
+void QSocMcpTool::setResultCache(std::shared_ptr<QSocMcpResultCache> cache)
+{
+    resultCache_ = std::move(cache);
+}
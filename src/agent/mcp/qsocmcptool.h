@@ -7,21 +7,26 @@
 #include "agent/mcp/qsocmcptypes.h"
 #include "agent/qsoctool.h"
 
+#include <memory>
+
+#include <QHash>
 #include <QPointer>
-#include <QSet>
 #include <QString>
 
-class QEventLoop;
 class QSocMcpClient;
 class QSocMcpManager;
+class QSocMcpResultCache;
 
 /**
  * @brief Adapter that exposes one MCP server tool as a QSocTool.
  * @details The adapter holds a weak reference to the owning client and
- *          forwards execute() to its JSON-RPC tools/call. The synchronous
- *          QSocTool::execute() contract is satisfied via a nested event
- *          loop that waits on the client's response signals; abort()
- *          breaks every active call out of its loop early.
+ *          forwards executeAsync() to its JSON-RPC tools/call. Each call
+ *          completes from the client's response signals, so concurrent
+ *          calls finish in the order their replies arrive; abort() ends
+ *          every active call early. The synchronous execute() waits for
+ *          its own call on a local event loop. When the manager attaches
+ *          a result cache, successful results are memoized and repeated
+ *          calls with equal arguments skip the round trip.
  */
 class QSocMcpTool : public QSocTool
 {
@@ -35,10 +40,17 @@ public:
     QString getDescription() const override;
     json    getParametersSchema() const override;
     QString execute(const json &arguments) override;
+    bool    isAsync() const override { return true; }
     void    abort() override;
 
+    void executeAsync(
+        const json &arguments, QSocToolCallContext *call, const ResultCallback &done) override;
+
     const McpToolDescriptor &descriptor() const;
 
+    /** @brief Memoize successful results in a cache shared per server. */
+    void setResultCache(std::shared_ptr<QSocMcpResultCache> cache);
+
 private:
     friend class QSocMcpManager;
 
@@ -51,21 +63,30 @@ private:
 
     struct CallState
     {
-        QEventLoop *loop      = nullptr;
-        CallOutcome outcome   = CallOutcome::Pending;
-        int         requestId = -1;
-        QString     result;
+        QObject                            *scope     = nullptr; /* receives the call's signals */
+        CallOutcome                         outcome   = CallOutcome::Pending;
+        int                                 requestId = -1;
+        bool                                cacheable = false;
+        QString                             result;
+        json                                arguments;
+        std::shared_ptr<QSocMcpResultCache> cache;
+        ResultCallback                      done;
     };
 
-    void cancelCalls(const QSet<CallState *> &calls);
+    using CallStatePtr = std::shared_ptr<CallState>;
+
+    void cancelCalls(const QList<CallStatePtr> &calls);
+    void finishCall(const CallStatePtr &call);
     void retire();
 
     QPointer<QSocMcpClient> client_;
     McpToolDescriptor       descriptor_;
     QString                 namespacedName_;
 
-    QSet<CallState *> activeCalls_;
-    bool              retired_ = false;
+    std::shared_ptr<QSocMcpResultCache> resultCache_;
+
+    QHash<CallState *, CallStatePtr> activeCalls_;
+    bool                             retired_ = false;
 };
 
 #endif // QSOCMCPTOOL_H
@@ -5,6 +5,8 @@
 
 #include "common/qsocconsole.h"
 
+#include <limits>
+
 namespace {
 
 /* yaml-cpp throws InvalidNode if Type-querying methods (IsScalar/IsMap/...)
@@ -126,6 +128,17 @@ bool McpServerConfig::isValid() const
     return false;
 }
 
+bool McpServerConfig::cachesTool(const QString &toolName, bool readOnly, bool idempotent) const
+{
+    if (resultCacheTtlMs <= 0 || resultCacheMaxEntries <= 0) {
+        return false;
+    }
+    if (resultCacheTools.isEmpty()) {
+        return readOnly && idempotent;
+    }
+    return resultCacheTools.contains(toolName);
+}
+
 QList<McpServerConfig> McpServerConfig::parseList(const YAML::Node &node)
 {
     QList<McpServerConfig> out;
@@ -150,7 +163,19 @@ QList<McpServerConfig> McpServerConfig::parseList(const YAML::Node &node)
         cfg.proxy            = yamlScalarToQString(entry["proxy"]);
         cfg.connectTimeoutMs = yamlIntOrDefault(entry["connect_timeout_ms"], cfg.connectTimeoutMs);
         cfg.requestTimeoutMs = yamlIntOrDefault(entry["request_timeout_ms"], cfg.requestTimeoutMs);
-        cfg.enabled          = yamlBoolOrDefault(entry["enabled"], true);
+        cfg.maxConcurrentRequests
+            = yamlIntOrDefault(entry["max_concurrent_requests"], cfg.maxConcurrentRequests);
+        cfg.enabled = yamlBoolOrDefault(entry["enabled"], true);
+
+        const YAML::Node cacheNode = entry["result_cache"];
+        if (cacheNode.IsDefined() && cacheNode.IsMap()) {
+            const int ttlSeconds = yamlIntOrDefault(cacheNode["ttl_seconds"], 300);
+            cfg.resultCacheTtlMs = qBound(0, ttlSeconds, std::numeric_limits<int>::max() / 1000)
+                                   * 1000;
+            cfg.resultCacheMaxEntries
+                = yamlIntOrDefault(cacheNode["max_entries"], cfg.resultCacheMaxEntries);
+            cfg.resultCacheTools = yamlSequenceToQStringList(cacheNode["tools"]);
+        }
 
         if (cfg.type.isEmpty()) {
             cfg.type = QSocMcp::kTransportStdio;
@@ -56,9 +56,24 @@ struct McpServerConfig
     QString                url;     /* http: endpoint URL */
     QMap<QString, QString> headers; /* http: extra request headers */
     QString                proxy;   /* http: "none" disables proxy; empty / "system" follows env */
-    int                    connectTimeoutMs = 30000;
-    int                    requestTimeoutMs = 60000;
-    bool                   enabled          = true;
+    int                    connectTimeoutMs      = 30000;
+    int                    requestTimeoutMs      = 60000;
+    int                    maxConcurrentRequests = 0; /* requests in flight; <= 0 is unlimited */
+    int                    resultCacheTtlMs      = 0; /* tools/call memo lifetime; 0 disables */
+    int                    resultCacheMaxEntries = 128;
+    QStringList            resultCacheTools; /* tools to memoize; empty: read-only idempotent */
+    bool                   enabled = true;
+
+    /**
+     * @brief Whether results of one tool on this server may be memoized.
+     * @details Without an explicit tool list only tools that declare both
+     *          readOnlyHint and idempotentHint qualify; a read-only tool may
+     *          still return different answers for the same arguments.
+     * @param toolName Original tool name on the server.
+     * @param readOnly The tool's readOnlyHint annotation.
+     * @param idempotent The tool's idempotentHint annotation.
+     */
+    bool cachesTool(const QString &toolName, bool readOnly, bool idempotent) const;
 
     /**
      * @brief Quick structural validation.
@@ -91,6 +106,7 @@ struct McpToolDescriptor
     nlohmann::json inputSchema; /* JSON Schema as returned by the server */
     bool           readOnly    = false;
     bool           destructive = true;
+    bool           idempotent  = false;
 };
 
 #endif // QSOCMCPTYPES_H
@@ -166,6 +166,11 @@ bool QSocAgent::isCurrentRun(const ActiveRunPtr &run) const
 
 void QSocAgent::finishToolBatch(const ActiveRunPtr &run)
 {
+    /* A result still on its way no longer resumes anything */
+    if (run && run->pendingToolCall.has_value()) {
+        QObject::disconnect(run->pendingToolCall->progressRelay);
+        run->pendingToolCall.reset();
+    }
     if (!run || !run->toolBatchStart.has_value()) {
         return;
     }
@@ -1423,8 +1428,11 @@ void QSocAgent::handleStreamComplete(const json &response)
             }
         }
 
-        /* Handle tool calls synchronously */
+        /* A tool still running resumes the run through resumeToolCalls() */
         if (!handleToolCalls(message["tool_calls"], run)) {
+            if (run->pendingToolCall.has_value()) {
+                return;
+            }
             if (!restartOrStop() && !owner.isNull()) {
                 owner->processStreamIteration();
             }
@@ -1729,7 +1737,35 @@ QSocAgent::IterationResult QSocAgent::processIteration(const ActiveRunPtr &run)
     return IterationResult::Complete;
 }
 
-bool QSocAgent::handleToolCalls(const json &toolCalls, const ActiveRunPtr &run)
+bool QSocAgent::stopToolBatch(const QPointer<QSocAgent> &owner, const ActiveRunPtr &run)
+{
+    if (!owner.isNull() && owner->isCurrentRun(run) && run->stop.load() == StopMode::None) {
+        return false;
+    }
+    if (!owner.isNull() && owner->isCurrentRun(run)) {
+        owner->finishToolBatch(run);
+    }
+    return true;
+}
+
+void QSocAgent::failToolBatch(const QPointer<QSocAgent> &owner, const ActiveRunPtr &run)
+{
+    if (owner.isNull() || !owner->isCurrentRun(run)) {
+        return;
+    }
+    owner->finishToolBatch(run);
+    if (!owner->isCurrentRun(run)) {
+        return;
+    }
+    if (run->mode == RunMode::Streaming) {
+        owner->finishStreamRun(run, RunOutcome::Error, QStringLiteral("Tool registry destroyed"));
+    } else {
+        owner->finishSynchronousRun(run, RunOutcome::Error);
+    }
+}
+
+bool QSocAgent::handleToolCalls(
+    const json &toolCalls, const ActiveRunPtr &run, json::size_type first)
 {
     const QPointer<QSocAgent> owner(this);
     const auto current     = [owner, run]() { return !owner.isNull() && owner->isCurrentRun(run); };
@@ -1738,24 +1774,8 @@ bool QSocAgent::handleToolCalls(const json &toolCalls, const ActiveRunPtr &run)
             owner->finishToolBatch(run);
         }
     };
-    const auto stopBatch = [current, finishBatch, run]() {
-        if (current() && run->stop.load() == StopMode::None) {
-            return false;
-        }
-        finishBatch();
-        return true;
-    };
-    const auto dependencyFailed = [owner, current, finishBatch, run]() {
-        finishBatch();
-        if (!current()) {
-            return;
-        }
-        if (run->mode == RunMode::Streaming) {
-            owner->finishStreamRun(run, RunOutcome::Error, QStringLiteral("Tool registry destroyed"));
-        } else {
-            owner->finishSynchronousRun(run, RunOutcome::Error);
-        }
-    };
+    const auto stopBatch        = [owner, run]() { return stopToolBatch(owner, run); };
+    const auto dependencyFailed = [owner, run]() { failToolBatch(owner, run); };
 
     if (stopBatch()) {
         return false;
@@ -1769,7 +1789,8 @@ bool QSocAgent::handleToolCalls(const json &toolCalls, const ActiveRunPtr &run)
         streamMonitor->notifyProgress();
     }
 
-    for (const auto &toolCall : toolCalls) {
+    for (json::size_type index = first; index < toolCalls.size(); ++index) {
+        const json &toolCall = toolCalls[index];
         if (stopBatch()) {
             return false;
         }
@@ -1922,66 +1943,152 @@ bool QSocAgent::handleToolCalls(const json &toolCalls, const ActiveRunPtr &run)
             return false;
         }
         run->executingToolCallId = toolCallId;
-        const QString rawResult  = run->tools->executeTool(functionName, arguments, this);
-        if (!current()) {
-            return false;
+        const auto progressRelay = connect(
+            run->tools.data(),
+            &QSocToolRegistry::toolProgress,
+            this,
+            [owner](QObject *caller, const QString &toolName, const QString &message) {
+                if (!owner.isNull() && caller == owner.data()) {
+                    emit owner->toolProgress(toolName, message);
+                }
+            });
+        if (run->mode != RunMode::Streaming) {
+            const QString rawResult = run->tools->executeTool(functionName, arguments, this);
+            QObject::disconnect(progressRelay);
+            if (!current()
+                || !owner->completeToolCall(run, toolCallId, functionName, arguments, rawResult)) {
+                return false;
+            }
+            continue;
         }
 
-        QList<AttachmentSpec> attachments;
-        const QString         result = extractImageAttachments(rawResult, &attachments);
-        const QString         historyResult
-            = run->stop.load() == StopMode::None
-                  ? result
-                  : QStringLiteral(
-                        "Tool reported: %1. A stop was requested while this tool was running. "
-                        "Completion is uncertain, and side effects may have occurred. "
-                        "Verify current state before retrying.")
-                        .arg(result);
-        owner->addToolMessage(
-            toolCallId,
-            historyResult,
-            run->stop.load() == StopMode::None ? QString() : QStringLiteral("uncertain"));
-        if (const auto attachmentMessage = buildToolAttachmentMessage(attachments)) {
-            run->toolBatchAttachments.push_back(*attachmentMessage);
-        }
-        run->executingToolCallId.reset();
-        if (stopBatch()) {
+        /* A streaming run does not wait on the call: a tool with its body on
+         * a worker answers later, and the batch resumes from that answer. */
+        const auto answer  = std::make_shared<std::optional<QString>>();
+        const auto waiting = std::make_shared<bool>(false);
+        run->tools->executeToolAsync(
+            functionName, arguments, this, [owner, run, answer, waiting](const QString &result) {
+                if (!*waiting) {
+                    *answer = result;
+                    return;
+                }
+                if (owner.isNull()) {
+                    return;
+                }
+                QMetaObject::invokeMethod(
+                    owner.data(),
+                    [owner, run, result]() {
+                        if (!owner.isNull()) {
+                            owner->resumeToolCalls(run, result);
+                        }
+                    },
+                    Qt::QueuedConnection);
+            });
+        if (!answer->has_value()) {
+            *waiting             = true;
+            run->pendingToolCall = PendingToolCall{
+                toolCalls, index, toolCallId, functionName, arguments, progressRelay};
             return false;
         }
-        if (run->tools.isNull()) {
-            dependencyFailed();
+        QObject::disconnect(progressRelay);
+        if (!current()
+            || !owner->completeToolCall(run, toolCallId, functionName, arguments, **answer)) {
             return false;
         }
+    }
+    finishBatch();
+    return current();
+}
 
-        if (agentConfig.verbose) {
-            const QString truncatedResult = result.length() > 200
-                                                ? result.left(200) + "... (truncated)"
-                                                : result;
-            emit          owner->verboseOutput(QString("     Result: %1").arg(truncatedResult));
-            if (stopBatch()) {
-                return false;
-            }
-        }
+bool QSocAgent::completeToolCall(
+    const ActiveRunPtr &run,
+    const QString      &toolCallId,
+    const QString      &functionName,
+    const json         &arguments,
+    const QString      &rawResult)
+{
+    const QPointer<QSocAgent> owner(this);
+    const auto stopBatch        = [owner, run]() { return stopToolBatch(owner, run); };
+    const auto dependencyFailed = [owner, run]() { failToolBatch(owner, run); };
+    if (!isCurrentRun(run)) {
+        return false;
+    }
+
+    QList<AttachmentSpec> attachments;
+    const QString         result = extractImageAttachments(rawResult, &attachments);
+    const QString         historyResult
+        = run->stop.load() == StopMode::None
+              ? result
+              : QStringLiteral(
+                    "Tool reported: %1. A stop was requested while this tool was running. "
+                    "Completion is uncertain, and side effects may have occurred. "
+                    "Verify current state before retrying.")
+                    .arg(result);
+    owner->addToolMessage(
+        toolCallId,
+        historyResult,
+        run->stop.load() == StopMode::None ? QString() : QStringLiteral("uncertain"));
+    if (const auto attachmentMessage = buildToolAttachmentMessage(attachments)) {
+        run->toolBatchAttachments.push_back(*attachmentMessage);
+    }
+    run->executingToolCallId.reset();
+    if (stopBatch()) {
+        return false;
+    }
+    if (run->tools.isNull()) {
+        dependencyFailed();
+        return false;
+    }
 
-        emit owner->toolResult(functionName, result);
+    if (agentConfig.verbose) {
+        const QString truncatedResult = result.length() > 200
+                                            ? result.left(200) + "... (truncated)"
+                                            : result;
+        emit          owner->verboseOutput(QString("     Result: %1").arg(truncatedResult));
         if (stopBatch()) {
             return false;
         }
+    }
 
-        if (hookManager != nullptr && hookManager->hasHooksFor(QSocHookEvent::PostToolUse)) {
-            json payload          = buildHookEnvelope();
-            payload["event"]      = "post_tool_use";
-            payload["tool_name"]  = functionName.toStdString();
-            payload["tool_input"] = arguments;
-            payload["response"]   = result.toStdString();
-            hookManager->fire(QSocHookEvent::PostToolUse, functionName, payload);
-            if (stopBatch()) {
-                return false;
-            }
+    emit owner->toolResult(functionName, result);
+    if (stopBatch()) {
+        return false;
+    }
+
+    if (hookManager != nullptr && hookManager->hasHooksFor(QSocHookEvent::PostToolUse)) {
+        json payload          = buildHookEnvelope();
+        payload["event"]      = "post_tool_use";
+        payload["tool_name"]  = functionName.toStdString();
+        payload["tool_input"] = arguments;
+        payload["response"]   = result.toStdString();
+        hookManager->fire(QSocHookEvent::PostToolUse, functionName, payload);
+        if (stopBatch()) {
+            return false;
         }
     }
-    finishBatch();
-    return current();
+    return true;
+}
+
+void QSocAgent::resumeToolCalls(const ActiveRunPtr &run, const QString &rawResult)
+{
+    if (!run->pendingToolCall.has_value()) {
+        return;
+    }
+    const PendingToolCall pending = std::move(*run->pendingToolCall);
+    run->pendingToolCall.reset();
+    QObject::disconnect(pending.progressRelay);
+
+    const QPointer<QSocAgent> owner(this);
+    if (completeToolCall(run, pending.id, pending.name, pending.arguments, rawResult)
+        && !owner.isNull()) {
+        owner->handleToolCalls(pending.toolCalls, run, pending.index + 1);
+    }
+    if (owner.isNull() || run->pendingToolCall.has_value()) {
+        return;
+    }
+    if (owner->checkpointRun(run) != CheckpointAction::Terminal) {
+        owner->processStreamIteration();
+    }
 }
 
 void QSocAgent::setMemoryManager(QSocMemoryManager *manager)
@@ -486,6 +486,13 @@ signals:
      */
     void toolResult(const QString &toolName, const QString &result);
 
+    /**
+     * @brief Signal emitted for each progress line of a running tool
+     * @param toolName Name of the tool
+     * @param message Progress text
+     */
+    void toolProgress(const QString &toolName, const QString &message);
+
     /**
      * @brief Signal emitted for verbose output
      * @param message The verbose message
@@ -587,6 +594,17 @@ private:
 
     enum class IterationResult : std::uint8_t { Continue, Complete, RestartPreparation, Stopped };
 
+    /* Tool call of a streaming run whose result is still outstanding. */
+    struct PendingToolCall
+    {
+        json                    toolCalls;
+        json::size_type         index = 0;
+        QString                 id;
+        QString                 name;
+        json                    arguments;
+        QMetaObject::Connection progressRelay;
+    };
+
     struct ActiveRun
     {
         quint64                        epoch = 0;
@@ -599,7 +617,8 @@ private:
         std::optional<json::size_type> toolBatchStart;
         std::optional<QString>         executingToolCallId;
         json                           toolBatchAttachments = json::array();
-        RunPhase                       phase                = RunPhase::Active;
+        std::optional<PendingToolCall> pendingToolCall;
+        RunPhase                       phase = RunPhase::Active;
     };
 
     using ActiveRunPtr = std::shared_ptr<ActiveRun>;
@@ -799,9 +818,35 @@ private:
 
     /**
      * @brief Handle tool calls from the LLM response
+     * @details Streaming runs hand each call to the registry asynchronously.
+     *          When a result is still outstanding the run records it in
+     *          pendingToolCall and returns false; resumeToolCalls() picks
+     *          the batch up again once the result arrives.
      * @param toolCalls JSON array of tool calls
+     * @param first Index of the first call to handle
      */
-    bool handleToolCalls(const json &toolCalls, const ActiveRunPtr &run);
+    bool handleToolCalls(
+        const json &toolCalls, const ActiveRunPtr &run, json::size_type first = 0);
+
+    /**
+     * @brief Record one tool result in the history and fire its hooks
+     * @return false when the batch stopped or the run ended
+     */
+    bool completeToolCall(
+        const ActiveRunPtr &run,
+        const QString      &toolCallId,
+        const QString      &functionName,
+        const json         &arguments,
+        const QString      &rawResult);
+
+    /**
+     * @brief Finish the pending tool call of a streaming run and go on
+     *        with the rest of its batch, then with the next iteration
+     */
+    void resumeToolCalls(const ActiveRunPtr &run, const QString &rawResult);
+
+    static bool stopToolBatch(const QPointer<QSocAgent> &owner, const ActiveRunPtr &run);
+    static void failToolBatch(const QPointer<QSocAgent> &owner, const ActiveRunPtr &run);
 
     /**
      * @brief Add a message to the conversation history
@@ -6,11 +6,13 @@
 #include <nlohmann/json.hpp>
 #include <QCryptographicHash>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QFileInfo>
 #include <QTextStream>
 
 #include <algorithm>
+#include <limits>
 
 using json = nlohmann::json;
 
@@ -21,6 +23,46 @@ QString isoNowUtc()
     return QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs);
 }
 
+/* Blob header: magic, kind, chain depth, then the base sha256 for deltas.
+ * Text files never start with NUL, so raw blobs from older builds are
+ * told apart by the missing magic. */
+const QByteArray kBlobMagic = QByteArrayLiteral("\0QSFH");
+constexpr char   kBlobFull  = 'Z';
+constexpr char   kBlobDelta = 'D';
+constexpr int    kHeaderLen = 7;
+constexpr int    kShaLen    = 64;
+
+/* A file whose mtime is this close to its capture may have been rewritten
+ * within the same timestamp granularity (seconds over SFTP). */
+constexpr qint64 kRacyWindowMs = 2000;
+
+/* Monotonic milliseconds, immune to wall-clock steps */
+qint64 monotonicMs()
+{
+    static const QElapsedTimer clock = []() {
+        QElapsedTimer timer;
+        timer.start();
+        return timer;
+    }();
+    return clock.elapsed();
+}
+
+/* Effective file->sha256 map after each snapshot, in snapshot order */
+QList<QMap<QString, QString>> foldStates(const QList<QSocFileHistory::Snapshot> &snapshots)
+{
+    QList<QMap<QString, QString>> states;
+    states.reserve(snapshots.size());
+    QMap<QString, QString> state;
+    for (const QSocFileHistory::Snapshot &snap : snapshots) {
+        for (auto it = snap.files.begin(); it != snap.files.end(); ++it) {
+            /* Later snapshots overwrite earlier ones for the same path. */
+            state.insert(it.key(), it.value());
+        }
+        states.append(state);
+    }
+    return states;
+}
+
 } // namespace
 
 QSocFileHistory::LiveFileAccessor QSocFileHistory::localAccessor()
@@ -57,12 +99,22 @@ QSocFileHistory::LiveFileAccessor QSocFileHistory::localAccessor()
         }
         return existing.remove();
     };
+    accessor.stat = [](const QString &path) -> std::optional<FileStat> {
+        const QFileInfo info(path);
+        if (!info.isFile()) {
+            return std::nullopt;
+        }
+        return FileStat{info.size(), info.lastModified().toMSecsSinceEpoch()};
+    };
+    accessor.localClock = true;
     return accessor;
 }
 
 void QSocFileHistory::setLiveAccessor(LiveFileAccessor accessor)
 {
     liveAccessor = std::move(accessor);
+    /* Stats from another backend say nothing about this one */
+    statCache.clear();
 }
 
 QSocFileHistory::QSocFileHistory(QString projectPath, QString sessionId)
@@ -117,37 +169,146 @@ void QSocFileHistory::ensureDirs() const
     QDir().mkpath(backups);
 }
 
-void QSocFileHistory::writeBackup(const QString &sha256, const QString &content) const
+void QSocFileHistory::writeBackup(
+    const QString &sha, const QString &content, const QString &base) const
 {
     ensureDirs();
-    const QString path = backupPathFor(sha256);
+    const QString path = backupPathFor(sha);
     if (QFile::exists(path)) {
         return; /* already deduped by hash */
     }
+    const QByteArray utf8 = content.toUtf8();
+    QByteArray       blob = kBlobMagic;
+    blob.append(kBlobFull);
+    blob.append('\0');
+    if (!utf8.isEmpty()) {
+        blob.append(qCompress(utf8));
+    }
+
+    /* Delta against the previous version when the chain is short enough:
+     * keep the shared prefix and suffix, store only the changed middle. */
+    const int depth = base.isEmpty() || base == sha ? -1 : blobDepth(base);
+    if (depth >= 0 && depth < MAX_DELTA_CHAIN) {
+        const QByteArray previous = readBlob(base, 0);
+        if (!previous.isNull()) {
+            const qsizetype limit  = qMin(previous.size(), utf8.size());
+            qsizetype       prefix = 0;
+            while (prefix < limit && previous.at(prefix) == utf8.at(prefix)) {
+                prefix++;
+            }
+            qsizetype suffix = 0;
+            while (suffix < limit - prefix
+                   && previous.at(previous.size() - 1 - suffix)
+                          == utf8.at(utf8.size() - 1 - suffix)) {
+                suffix++;
+            }
+            QByteArray payload = QByteArray::number(prefix) + ' ' + QByteArray::number(suffix)
+                                 + '\n';
+            payload.append(utf8.mid(prefix, utf8.size() - prefix - suffix));
+
+            QByteArray delta = kBlobMagic;
+            delta.append(kBlobDelta);
+            delta.append(static_cast<char>(depth + 1));
+            delta.append(base.toLatin1());
+            delta.append(qCompress(payload));
+            if (delta.size() < blob.size()) {
+                blob = delta;
+            }
+        }
+    }
+
     QFile file(path);
     if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
         return;
     }
-    const QByteArray utf8 = content.toUtf8();
-    file.write(utf8);
+    file.write(blob);
     file.close();
 }
 
-QString QSocFileHistory::readBackup(const QString &sha256) const
+int QSocFileHistory::blobDepth(const QString &sha256, QString *baseSha256) const
 {
-    const QString path = backupPathFor(sha256);
-    QFile         file(path);
+    QFile file(backupPathFor(sha256));
     if (!file.open(QIODevice::ReadOnly)) {
-        return QString();
+        return -1;
     }
-    const QByteArray utf8 = file.readAll();
+    const QByteArray header = file.read(kHeaderLen + kShaLen);
     file.close();
-    return QString::fromUtf8(utf8);
+    if (!header.startsWith(kBlobMagic) || header.size() < kHeaderLen
+        || header.at(kBlobMagic.size()) != kBlobDelta) {
+        return 0; /* standalone: compressed full blob or legacy raw text */
+    }
+    if (baseSha256 != nullptr) {
+        *baseSha256 = QString::fromLatin1(header.mid(kHeaderLen, kShaLen));
+    }
+    return static_cast<unsigned char>(header.at(kBlobMagic.size() + 1));
+}
+
+QByteArray QSocFileHistory::readBlob(const QString &sha256, int depth) const
+{
+    if (depth > MAX_DELTA_CHAIN) {
+        return QByteArray(); /* corrupt or cyclic chain */
+    }
+    QFile file(backupPathFor(sha256));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    const QByteArray data = file.readAll();
+    file.close();
+    if (!data.startsWith(kBlobMagic)) {
+        return data.isNull() ? QByteArray("", 0) : data; /* legacy raw blob */
+    }
+    if (data.size() < kHeaderLen) {
+        return QByteArray();
+    }
+    if (data.at(kBlobMagic.size()) == kBlobFull) {
+        if (data.size() == kHeaderLen) {
+            return QByteArray("", 0);
+        }
+        const QByteArray content = qUncompress(data.mid(kHeaderLen));
+        return content.isEmpty() ? QByteArray() : content;
+    }
+    if (data.at(kBlobMagic.size()) != kBlobDelta || data.size() < kHeaderLen + kShaLen) {
+        return QByteArray();
+    }
+
+    const QString    base     = QString::fromLatin1(data.mid(kHeaderLen, kShaLen));
+    const QByteArray previous = readBlob(base, depth + 1);
+    const QByteArray payload  = qUncompress(data.mid(kHeaderLen + kShaLen));
+    const qsizetype  newline  = payload.indexOf('\n');
+    if (previous.isNull() || newline < 0) {
+        return QByteArray();
+    }
+    const QList<QByteArray> lengths = payload.left(newline).split(' ');
+    bool                    prefixOk = false;
+    bool                    suffixOk = false;
+    const qsizetype         prefix   = lengths.value(0).toLongLong(&prefixOk);
+    const qsizetype         suffix   = lengths.value(1).toLongLong(&suffixOk);
+    if (!prefixOk || !suffixOk || prefix < 0 || suffix < 0 || prefix + suffix > previous.size()) {
+        return QByteArray();
+    }
+    QByteArray content = previous.left(prefix);
+    content.append(payload.mid(newline + 1));
+    content.append(previous.right(suffix));
+    return content.isNull() ? QByteArray("", 0) : content;
+}
+
+QString QSocFileHistory::readBackup(const QString &sha256) const
+{
+    const QByteArray utf8 = readBlob(sha256, 0);
+    if (utf8.isNull()) {
+        return QString();
+    }
+    const QString content = QString::fromUtf8(utf8);
+    /* Empty content stays distinguishable from a missing backup */
+    return content.isNull() ? QStringLiteral("") : content;
 }
 
 void QSocFileHistory::trackEdit(
     const QString &filePath, bool beforeExists, const QString &beforeContent)
 {
+    /* The caller is about to write the file; never trust its old stat */
+    statCache.remove(filePath);
+
     /* If this file has already been tracked earlier in the session, its
      * baseline (the turn-0 "before the first edit" state) was captured on
      * the first call — nothing to do now. Subsequent edits in the same
@@ -161,7 +322,7 @@ void QSocFileHistory::trackEdit(
     QString sha;
     if (beforeExists) {
         sha = sha256Hex(beforeContent);
-        writeBackup(sha, beforeContent);
+        writeBackup(sha, beforeContent, QString());
     }
 
     /* Merge the baseline into snapshot turn 0. If the file already has an
@@ -198,18 +359,48 @@ bool QSocFileHistory::makeSnapshot(int turn)
     Snapshot snap;
     snap.turn      = turn;
     snap.timestamp = QDateTime::currentDateTimeUtc();
+    /* Previous versions serve as delta bases for changed files */
+    const QMap<QString, QString> previous = effectiveStateAt(std::numeric_limits<int>::max());
     for (const QString &path : trackedFiles) {
+        /* Unchanged size and mtime since a settled capture: reuse the hash
+         * without reading (over SFTP in remote mode) or hashing. */
+        const std::optional<FileStat> stat = liveAccessor.stat ? liveAccessor.stat(path)
+                                                               : std::nullopt;
+        const qint64                  nowMs    = QDateTime::currentMSecsSinceEpoch();
+        const qint64                  nowTick  = monotonicMs();
+        const auto                    cached   = statCache.constFind(path);
+        const bool                    sameStat = stat.has_value() && cached != statCache.constEnd()
+                                              && cached->stat == *stat;
+        /* Any host's clock was past the mtime when the stat was first seen,
+         * so a read a full window later follows every same-stamp rewrite. */
+        const bool settled
+            = sameStat
+              && ((liveAccessor.localClock
+                   && cached->stat.mtimeMs + kRacyWindowMs < cached->capturedMs)
+                  || cached->firstSeenTick + kRacyWindowMs <= cached->capturedTick);
+        if (settled && QFile::exists(backupPathFor(cached->sha256))) {
+            snap.files.insert(path, cached->sha256);
+            continue;
+        }
+        const qint64 firstSeenTick = sameStat ? cached->firstSeenTick : nowTick;
+
         const std::optional<QString> content = liveAccessor.read ? liveAccessor.read(path)
                                                                  : std::nullopt;
         if (!content.has_value()) {
             /* Absent or unreadable at snapshot time: record as absent so
              * rewind won't try to restore a stale blob. */
+            statCache.remove(path);
             snap.files.insert(path, QString());
             continue;
         }
         const QString sha = sha256Hex(*content);
-        writeBackup(sha, *content);
+        writeBackup(sha, *content, previous.value(path));
         snap.files.insert(path, sha);
+        if (stat.has_value()) {
+            statCache.insert(path, StatRecord{*stat, sha, nowMs, firstSeenTick, nowTick});
+        } else {
+            statCache.remove(path);
+        }
     }
 
     /* Append in-memory, trim to MAX_SNAPSHOTS (baseline is sticky), then
@@ -237,22 +428,23 @@ bool QSocFileHistory::makeSnapshot(int turn)
 
 QMap<QString, QString> QSocFileHistory::effectiveStateAt(int turn) const
 {
-    QMap<QString, QString> state;
-    const auto             snapshots = loadSnapshots();
-    for (const Snapshot &snap : snapshots) {
-        if (snap.turn > turn) {
-            continue;
-        }
-        for (auto it = snap.files.begin(); it != snap.files.end(); ++it) {
-            /* Later snapshots overwrite earlier ones for the same path. */
-            state.insert(it.key(), it.value());
-        }
+    loadSnapshots();
+    /* Snapshots are turn-ascending; take the state after the last one
+     * at or before the requested turn. */
+    const auto byTurn = [](int value, const Snapshot &snap) { return value < snap.turn; };
+    const auto after  = std::upper_bound(
+        cachedSnapshots.cbegin(), cachedSnapshots.cend(), turn, byTurn);
+    const qsizetype index = (after - cachedSnapshots.cbegin()) - 1;
+    if (index < 0) {
+        return {};
     }
-    return state;
+    return cachedStates.at(index);
 }
 
 QStringList QSocFileHistory::applySnapshot(int turn)
 {
+    /* Restored files get fresh mtimes; re-read them on the next snapshot */
+    statCache.clear();
     QStringList touched;
     const auto  state = effectiveStateAt(turn);
     if (state.isEmpty()) {
@@ -292,6 +484,8 @@ void QSocFileHistory::truncateAfter(int cutoffTurn)
         }
     }
     if (kept.size() != snapshots.size()) {
+        /* Blobs the stat cache points at may be collected below */
+        statCache.clear();
         saveSnapshots(kept);
         gcOrphanedBackups();
     }
@@ -341,7 +535,8 @@ QList<QSocFileHistory::Snapshot> QSocFileHistory::loadSnapshots() const
     QFile           file(snapshotsPath());
     if (!file.exists() || !file.open(QIODevice::ReadOnly | QIODevice::Text)) {
         cachedSnapshots = result;
-        cacheValid      = true;
+        cachedStates.clear();
+        cacheValid = true;
         return result;
     }
     QTextStream stream(&file);
@@ -383,6 +578,7 @@ QList<QSocFileHistory::Snapshot> QSocFileHistory::loadSnapshots() const
         return lhs.turn < rhs.turn;
     });
     cachedSnapshots = result;
+    cachedStates    = foldStates(result);
     cacheValid      = true;
     return result;
 }
@@ -416,6 +612,7 @@ void QSocFileHistory::saveSnapshots(const QList<Snapshot> &snapshots) const
     }
     file.close();
     cachedSnapshots = snapshots;
+    cachedStates    = foldStates(snapshots);
     cacheValid      = true;
 }
 
@@ -437,8 +634,14 @@ void QSocFileHistory::gcOrphanedBackups() const
     QSet<QString> referenced;
     for (const Snapshot &snap : snapshots) {
         for (auto it = snap.files.begin(); it != snap.files.end(); ++it) {
-            if (!it.value().isEmpty()) {
-                referenced.insert(it.value());
+            /* Keep every base a surviving delta blob is built on */
+            QString sha = it.value();
+            for (int hop = 0; !sha.isEmpty() && !referenced.contains(sha) && hop <= MAX_DELTA_CHAIN;
+                 hop++) {
+                referenced.insert(sha);
+                QString base;
+                blobDepth(sha, &base);
+                sha = base;
             }
         }
     }
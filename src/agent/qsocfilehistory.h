@@ -28,6 +28,12 @@
  *     backups/<sha256>.bak   - content-addressed backup blobs (deduped)
  *     snapshots.jsonl        - one line per snapshot, append-only
  *
+ *   Backup blobs are zlib-compressed. When a tracked file changes between
+ *   turns, its new blob is stored as a delta against the previous version
+ *   (shared prefix and suffix plus the changed middle), with chains capped
+ *   at MAX_DELTA_CHAIN. Blobs written by older builds are raw UTF-8 and
+ *   still readable.
+ *
  *   Each snapshots.jsonl line is a JSON object of the form
  *
  *     {
@@ -53,6 +59,13 @@
  *   **Lazy tracking**: only files that the agent has actually written are
  *   ever backed up or snapshotted. Untouched project files are left alone
  *   by every rewind / apply operation.
+ *
+ *   **Stat gating**: when the live accessor can stat, a tracked file whose
+ *   size and mtime match the previous snapshot reuses the previous hash
+ *   without being read. Files whose mtime was too close to the previous
+ *   capture to rule out a same-timestamp rewrite are always re-read. A
+ *   remote mtime is not compared with the local clock: the file is re-read
+ *   until one capture happened a racy window after its stat first showed.
  */
 class QSocFileHistory
 {
@@ -70,13 +83,31 @@ public:
         QMap<QString, QString> files; /* path -> sha256 hex, or "" for absent */
     };
 
+    /**
+     * @brief Cheap change probe for a live file.
+     */
+    struct FileStat
+    {
+        qint64 size    = -1;
+        qint64 mtimeMs = 0; /* milliseconds since epoch */
+
+        bool operator==(const FileStat &other) const
+        {
+            return size == other.size && mtimeMs == other.mtimeMs;
+        }
+    };
+
     /**
      * @brief Live-file backend for snapshot capture and restore.
      * @details Backup blobs are always stored locally; only the live files
      *          being snapshotted / restored go through this accessor. The
      *          default is local disk; the CLI swaps in an SFTP-backed
      *          accessor while a remote session is active so rewind restores
-     *          the remote working tree, not a stale local path.
+     *          the remote working tree, not a stale local path. stat is
+     *          optional; without it every snapshot reads every file.
+     *          localClock says stat mtimes come from this host's clock; a
+     *          remote host's clock may be skewed, so its files are trusted
+     *          only after the same stat has held for the racy window.
      */
     struct LiveFileAccessor
     {
@@ -84,6 +115,8 @@ public:
         std::function<std::optional<QString>(const QString &path)>       read;
         std::function<bool(const QString &path, const QString &content)> write;
         std::function<bool(const QString &path)>                         remove;
+        std::function<std::optional<FileStat>(const QString &path)>      stat;
+        bool                                                             localClock = false;
     };
 
     /** @brief Local-disk accessor (the default backend). */
@@ -109,6 +142,11 @@ public:
      */
     static constexpr int MAX_SNAPSHOTS = 100;
 
+    /**
+     * @brief Longest chain of delta blobs before a full blob is written.
+     */
+    static constexpr int MAX_DELTA_CHAIN = 8;
+
     /**
      * @brief Record the pre-mutation state of a file before a tool edits it.
      * @details Called by edit_file / write_file immediately before their
@@ -128,9 +166,9 @@ public:
      * @brief Capture the post-turn state of every tracked file.
      * @details Called from runAgentLoop after a turn completes (runStream
      *          returns and persistSessionDelta has flushed). Reads the
-     *          current content of every tracked file, hashes it, saves a
-     *          backup blob if new, and appends one line to snapshots.jsonl
-     *          indexed by turn.
+     *          current content of every tracked file whose stat changed,
+     *          hashes it, saves a backup blob if new, and appends one line
+     *          to snapshots.jsonl indexed by turn.
      * @param turn Monotonic turn index (1 for the first user turn, 2 for the
      *             next, ...). Must strictly increase across calls.
      * @return true if the snapshot was written, false on I/O errors.
@@ -224,22 +262,43 @@ private:
      * file wasn't re-edited in that specific turn. */
     QSet<QString> trackedFiles;
     /* Snapshots loaded lazily on first access; mutations to disk keep this
-     * in sync so callers don't pay for repeated reads. */
-    mutable QList<Snapshot> cachedSnapshots;
-    mutable bool            cacheValid = false;
+     * in sync so callers don't pay for repeated reads. cachedStates[i] is
+     * the effective file->sha256 map after cachedSnapshots[i]. */
+    mutable QList<Snapshot>               cachedSnapshots;
+    mutable QList<QMap<QString, QString>> cachedStates;
+    mutable bool                          cacheValid = false;
+
+    /* Stat and hash of each tracked file at its last capture. capturedMs is
+     * wall-clock time; the ticks are monotonic, from when this stat was first
+     * seen and from when the content was read. */
+    struct StatRecord
+    {
+        FileStat stat;
+        QString  sha256;
+        qint64   capturedMs    = 0;
+        qint64   firstSeenTick = 0;
+        qint64   capturedTick  = 0;
+    };
+    QHash<QString, StatRecord> statCache;
+
+    /* base names the blob of the previous version to delta against, or is
+     * empty for a standalone blob. */
+    void writeBackup(const QString &sha, const QString &content, const QString &base) const;
 
     void            ensureDirs() const;
-    void            writeBackup(const QString &sha256, const QString &content) const;
     QString         readBackup(const QString &sha256) const;
+    QByteArray      readBlob(const QString &sha256, int depth) const;
+    int             blobDepth(const QString &sha256, QString *baseSha256 = nullptr) const;
     QList<Snapshot> loadSnapshots() const;
     void            saveSnapshots(const QList<Snapshot> &snapshots) const;
     void            appendSnapshot(const Snapshot &snapshot) const;
     void            evictOldest();
-    /* Walk every surviving snapshot, collect referenced sha256 set, and
-     * delete any .bak blob that is no longer referenced. */
+    /* Walk every surviving snapshot, collect referenced sha256 set plus the
+     * delta bases those blobs are built on, and delete any .bak blob that
+     * is no longer referenced. */
     void gcOrphanedBackups() const;
-    /* Build the effective file->sha256 map at the given turn by scanning
-     * all snapshots with turn <= N and keeping the latest record per path. */
+    /* Effective file->sha256 map at the given turn: the latest record per
+     * path over snapshots with turn <= N, served from cachedStates. */
     QMap<QString, QString> effectiveStateAt(int turn) const;
 };
 
@@ -8,6 +8,7 @@
 #include <QEventLoop>
 #include <QPointer>
 #include <QRegularExpression>
+#include <QThread>
 
 #include <optional>
 #include <utility>
@@ -102,6 +103,20 @@ bool QSocHookManager::matches(const QString &pattern, const QString &subject)
 QSocHookManager::Outcome QSocHookManager::fire(
     QSocHookEvent event, const QString &matchSubject, const nlohmann::json &payload)
 {
+    /* Runners are children of this manager, so they must start here */
+    if (QThread::currentThread() != thread()) {
+        Outcome out;
+        out.blocked     = true;
+        out.blockReason = QStringLiteral("hook manager destroyed during dispatch");
+        QMetaObject::invokeMethod(
+            this,
+            [this, &out, event, &matchSubject, &payload]() {
+                out = fire(event, matchSubject, payload);
+            },
+            Qt::BlockingQueuedConnection);
+        return out;
+    }
+
     Outcome out;
 
     const auto matchers = m_config.matchersFor(event);
@@ -53,6 +53,9 @@ public:
 
     /**
      * @brief Fire an event synchronously.
+     * @details A call from another thread (a threaded sub-agent sharing
+     *          the parent's hooks) runs on the manager's thread and blocks
+     *          the caller until the hooks settle.
      * @param event Lifecycle event being raised.
      * @param matchSubject String tested against each matcher pattern
      *                     (tool name for tool-related events; the event
@@ -8,11 +8,16 @@
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QSaveFile>
 #include <QSet>
 #include <QStandardPaths>
 #include <QTextStream>
+#include <QThread>
 #include <QUuid>
+#include <QWaitCondition>
 
 #include <algorithm>
 #include <cstdint>
@@ -53,7 +58,24 @@ QString recoveryClaimPath(const QString &runId)
     return QDir(directory).filePath(QString::fromLatin1(name) + QStringLiteral(".claim"));
 }
 
-bool appendJsonLine(const QString &filePath, const nlohmann::json &line)
+/* Group commit: how long the writer waits for more records, and how much
+ * may be queued before appends block. */
+constexpr int       WRITER_COMMIT_WINDOW_MS = 5;
+constexpr qsizetype WRITER_MAX_RECORDS      = 1024;
+constexpr qsizetype WRITER_MAX_BYTES        = 8 * 1024 * 1024;
+
+bool serializeJsonLine(const nlohmann::json &line, QByteArray *payload)
+{
+    try {
+        *payload = QByteArray::fromStdString(line.dump());
+    } catch (const nlohmann::json::exception &) {
+        return false;
+    }
+    payload->append('\n');
+    return true;
+}
+
+bool appendPayload(const QString &filePath, const QByteArray &payload)
 {
     QFileInfo fileInfo(filePath);
     QDir      parentDir = fileInfo.absoluteDir();
@@ -65,16 +87,15 @@ bool appendJsonLine(const QString &filePath, const nlohmann::json &line)
     if (!file.open(QIODevice::Append | QIODevice::Text)) {
         return false;
     }
-    QByteArray payload;
-    try {
-        payload = QByteArray::fromStdString(line.dump());
-    } catch (const nlohmann::json::exception &) {
-        return false;
-    }
-    payload.append('\n');
     return file.write(payload) == payload.size() && file.flush();
 }
 
+bool appendJsonLine(const QString &filePath, const nlohmann::json &line)
+{
+    QByteArray payload;
+    return serializeJsonLine(line, &payload) && appendPayload(filePath, payload);
+}
+
 QString runEventName(QSocSession::RunEvent event)
 {
     switch (event) {
@@ -172,14 +193,238 @@ void sanitizeLoadedMessage(nlohmann::json *message)
     }
 }
 
+/* Encode messages as snapshot parts against the history already on disk:
+ * runs of unchanged messages become [start, length] into previous, the
+ * rest are stored inline. Messages are matched by content hash, so a
+ * compaction that keeps the recent tail only writes its summary. */
+nlohmann::json snapshotParts(const nlohmann::json &messages, const nlohmann::json &previous)
+{
+    const auto contentKey = [](const nlohmann::json &message) {
+        return QCryptographicHash::hash(
+            QByteArray::fromStdString(message.dump()), QCryptographicHash::Sha1);
+    };
+
+    QList<QByteArray>      previousKeys;
+    QHash<QByteArray, int> firstIndex;
+    if (previous.is_array()) {
+        previousKeys.reserve(static_cast<qsizetype>(previous.size()));
+        for (const auto &message : previous) {
+            const QByteArray key = contentKey(message);
+            if (!firstIndex.contains(key)) {
+                firstIndex.insert(key, static_cast<int>(previousKeys.size()));
+            }
+            previousKeys.append(key);
+        }
+    }
+
+    nlohmann::json parts    = nlohmann::json::array();
+    int            runStart = -1;
+    int            runLen   = 0;
+    const auto     closeRun = [&]() {
+        if (runLen > 0) {
+            parts.push_back(nlohmann::json::array({runStart, runLen}));
+        }
+        runLen = 0;
+    };
+    for (const auto &message : messages) {
+        const QByteArray key  = contentKey(message);
+        const int        next = runStart + runLen;
+        if (runLen > 0 && next < previousKeys.size() && previousKeys.at(next) == key) {
+            ++runLen;
+            continue;
+        }
+        closeRun();
+        const auto found = firstIndex.constFind(key);
+        if (found != firstIndex.constEnd()) {
+            runStart = found.value();
+            runLen   = 1;
+        } else {
+            parts.push_back(message);
+        }
+    }
+    closeRun();
+    return parts;
+}
+
+/* Rebuild a snapshot from parts against the history loaded so far.
+ * False when a reference falls outside it or the count disagrees. */
+bool applySnapshotParts(
+    const nlohmann::json &parts, std::size_t count, nlohmann::json *messages)
+{
+    nlohmann::json rebuilt = nlohmann::json::array();
+    for (const auto &part : parts) {
+        if (part.is_object()) {
+            nlohmann::json message = part;
+            sanitizeLoadedMessage(&message);
+            rebuilt.push_back(std::move(message));
+            continue;
+        }
+        if (!part.is_array() || part.size() != 2 || !part[0].is_number_unsigned()
+            || !part[1].is_number_unsigned()) {
+            return false;
+        }
+        const auto start  = part[0].get<std::size_t>();
+        const auto length = part[1].get<std::size_t>();
+        if (length == 0 || start > messages->size() || length > messages->size() - start) {
+            return false;
+        }
+        for (std::size_t index = start; index < start + length; ++index) {
+            rebuilt.push_back((*messages)[index]);
+        }
+    }
+    if (rebuilt.size() != count) {
+        return false;
+    }
+    *messages = std::move(rebuilt);
+    return true;
+}
+
 } // namespace
 
+/* Background appender: one thread per session, FIFO, one write per batch */
+class QSocSession::Writer
+{
+public:
+    explicit Writer(QString filePath)
+        : filePath(std::move(filePath))
+    {
+        thread = QThread::create([this]() { run(); });
+        thread->setObjectName(QStringLiteral("qsoc-session-writer"));
+        thread->start();
+    }
+
+    ~Writer()
+    {
+        {
+            const QMutexLocker locker(&mutex);
+            stopping = true;
+            wake.wakeOne();
+        }
+        thread->wait();
+        delete thread;
+    }
+
+    Writer(const Writer &)            = delete;
+    Writer &operator=(const Writer &) = delete;
+
+    bool enqueue(QByteArray payload)
+    {
+        QMutexLocker locker(&mutex);
+        while (!failed
+               && (queue.size() >= WRITER_MAX_RECORDS || queuedBytes >= WRITER_MAX_BYTES)) {
+            space.wait(&mutex);
+        }
+        if (failed) {
+            return false;
+        }
+        queuedBytes += payload.size();
+        queue.append(std::move(payload));
+        ++enqueued;
+        /* Later records ride the open commit window without waking it */
+        if (queue.size() == 1) {
+            wake.wakeOne();
+        }
+        return true;
+    }
+
+    bool flush()
+    {
+        QMutexLocker  locker(&mutex);
+        const quint64 target = enqueued;
+        ++flushWaiters;
+        wake.wakeOne();
+        while (committed < target) {
+            drained.wait(&mutex);
+        }
+        --flushWaiters;
+        return !failed;
+    }
+
+private:
+    void run()
+    {
+        QMutexLocker locker(&mutex);
+        while (true) {
+            while (queue.isEmpty() && !stopping) {
+                wake.wait(&mutex);
+            }
+            if (queue.isEmpty()) {
+                return;
+            }
+            if (!stopping && flushWaiters == 0) {
+                wake.wait(&mutex, WRITER_COMMIT_WINDOW_MS);
+            }
+
+            QByteArray batch;
+            batch.reserve(queuedBytes);
+            for (const QByteArray &payload : std::as_const(queue)) {
+                batch.append(payload);
+            }
+            queue.clear();
+            queuedBytes         = 0;
+            const quint64 upTo  = enqueued;
+            const bool    wrote = !failed;
+            space.wakeAll();
+
+            locker.unlock();
+            const bool ok = wrote && appendPayload(filePath, batch);
+            locker.relock();
+
+            if (!ok) {
+                failed = true;
+                space.wakeAll();
+            }
+            committed = upTo;
+            drained.wakeAll();
+        }
+    }
+
+    const QString     filePath;
+    QThread          *thread = nullptr;
+    QMutex            mutex;
+    QWaitCondition    wake;    /* writer: work queued, flush requested or stop */
+    QWaitCondition    space;   /* appenders: queue below its bounds */
+    QWaitCondition    drained; /* flushers: a batch reached the file */
+    QList<QByteArray> queue;
+    qsizetype         queuedBytes  = 0;
+    quint64           enqueued     = 0;
+    quint64           committed    = 0;
+    int               flushWaiters = 0;
+    bool              failed       = false;
+    bool              stopping     = false;
+};
+
 QSocSession::QSocSession(QString sessionId, QString filePath)
     : sessionIdValue(std::move(sessionId))
     , filePathValue(std::move(filePath))
     , persisted(QFile::exists(filePathValue))
 {}
 
+QSocSession::~QSocSession() = default;
+
+void QSocSession::setBackgroundWrites(bool enabled)
+{
+    if (enabled && !writer) {
+        writer = std::make_unique<Writer>(filePathValue);
+    } else if (!enabled) {
+        writer.reset();
+    }
+}
+
+bool QSocSession::flush()
+{
+    return !writer || writer->flush();
+}
+
+bool QSocSession::writeLine(const nlohmann::json &line)
+{
+    if (!writer) {
+        return appendJsonLine(filePathValue, line);
+    }
+    QByteArray payload;
+    return serializeJsonLine(line, &payload) && writer->enqueue(std::move(payload));
+}
+
 bool QSocSession::flushPendingMeta()
 {
     if (persisted || pendingMeta.isEmpty()) {
@@ -191,7 +436,7 @@ bool QSocSession::flushPendingMeta()
         metaLine["ts"]    = isoNow().toStdString();
         metaLine["key"]   = kv.first.toStdString();
         metaLine["value"] = kv.second.toStdString();
-        if (!appendJsonLine(filePathValue, metaLine)) {
+        if (!writeLine(metaLine)) {
             return false;
         }
     }
@@ -215,7 +460,7 @@ bool QSocSession::appendMessage(const nlohmann::json &message)
     for (auto it = message.begin(); it != message.end(); ++it) {
         line[it.key()] = it.value();
     }
-    if (!appendJsonLine(filePathValue, line)) {
+    if (!writeLine(line)) {
         return false;
     }
     persisted = true;
@@ -233,7 +478,7 @@ bool QSocSession::appendMeta(const QString &key, const QString &value)
     line["ts"]    = isoNow().toStdString();
     line["key"]   = key.toStdString();
     line["value"] = value.toStdString();
-    return appendJsonLine(filePathValue, line);
+    return writeLine(line);
 }
 
 bool QSocSession::appendRun(const RunRecord &record)
@@ -283,23 +528,29 @@ bool QSocSession::appendRun(const RunRecord &record)
     if (!record.toolCallId.isEmpty()) {
         line["tool_call_id"] = record.toolCallId.toStdString();
     }
-    if (!appendJsonLine(filePathValue, line)) {
+    /* Recovery trusts run records as barriers: wait for the disk */
+    if (!writeLine(line) || !flush()) {
         return false;
     }
     persisted = true;
     return true;
 }
 
-bool QSocSession::appendSnapshot(const nlohmann::json &messages)
+bool QSocSession::appendSnapshot(const nlohmann::json &messages, const nlohmann::json &previous)
 {
     if (!messages.is_array() || !flushPendingMeta()) {
         return false;
     }
     nlohmann::json line;
-    line["type"]     = "snapshot";
-    line["ts"]       = isoNow().toStdString();
-    line["messages"] = messages;
-    if (!appendJsonLine(filePathValue, line)) {
+    line["type"]  = "snapshot";
+    line["ts"]    = isoNow().toStdString();
+    line["count"] = messages.size();
+    try {
+        line["parts"] = snapshotParts(messages, previous);
+    } catch (const nlohmann::json::exception &) {
+        return false;
+    }
+    if (!writeLine(line)) {
         return false;
     }
     persisted = true;
@@ -318,6 +569,9 @@ bool QSocSession::rewriteMessages(const nlohmann::json &messages)
         return true;
     }
 
+    /* Queued appends belong before the truncation, not after it */
+    flush();
+
     QFileInfo fileInfo(filePathValue);
     QDir      parentDir = fileInfo.absoluteDir();
     if (!parentDir.exists() && !parentDir.mkpath(QStringLiteral("."))) {
@@ -441,6 +695,15 @@ nlohmann::json QSocSession::loadMessages(const QString &filePath)
                 continue;
             }
             const std::string type = doc["type"].get<std::string>();
+            if (type == "snapshot" && doc.contains("parts")) {
+                if (!doc["parts"].is_array() || !doc.contains("count")
+                    || !doc["count"].is_number_unsigned()) {
+                    continue;
+                }
+                /* A bad reference drops the record like a torn line */
+                applySnapshotParts(doc["parts"], doc["count"].get<std::size_t>(), &messages);
+                continue;
+            }
             if (type == "snapshot") {
                 if (!doc.contains("messages") || !doc["messages"].is_array()) {
                     continue;
@@ -764,6 +1027,8 @@ QSocSession::Info QSocSession::readInfo(const QString &filePath)
                     && doc["content"].is_string()) {
                     info.firstPrompt = QString::fromStdString(doc["content"].get<std::string>());
                 }
+            } else if (type == "snapshot" && doc.contains("count") && doc["count"].is_number()) {
+                info.messageCount = doc["count"].get<int>();
             } else if (type == "snapshot" && doc.contains("messages") && doc["messages"].is_array()) {
                 info.messageCount = static_cast<int>(doc["messages"].size());
             }
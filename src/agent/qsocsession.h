@@ -13,6 +13,7 @@
 
 #include <nlohmann/json.hpp>
 
+#include <memory>
 #include <optional>
 
 /**
@@ -29,6 +30,11 @@
  *
  *          Sessions live inside the project directory so moving the project
  *          carries its history.
+ *
+ *          Writes are synchronous by default. setBackgroundWrites() hands
+ *          them to a writer thread that group-commits records queued within
+ *          a short window; run records and flush() wait for the disk, so the
+ *          lifecycle points crash recovery reads are never behind.
  */
 class QSocSession
 {
@@ -97,6 +103,12 @@ public:
      */
     QSocSession(QString sessionId, QString filePath);
 
+    /** @brief Write out every queued record before the session goes. */
+    ~QSocSession();
+
+    QSocSession(const QSocSession &)            = delete;
+    QSocSession &operator=(const QSocSession &) = delete;
+
     QString id() const { return sessionIdValue; }
     QString filePath() const { return filePathValue; }
 
@@ -126,11 +138,21 @@ public:
     bool appendRun(const RunRecord &record);
 
     /**
-     * @brief Append a complete conversation snapshot without rewriting the file.
+     * @brief Append a conversation snapshot without rewriting the file.
      * @details Loaders replace messages accumulated before this record, then
-     *          continue applying later message records.
+     *          continue applying later message records. Messages also found
+     *          in @p previous are stored as `[start, length]` index ranges
+     *          into it, so only new or changed messages are written:
+     *
+     *            {"type":"snapshot","count":3,"parts":[{...summary...},[40,2]]}
+     *
+     * @param messages Complete history after the change.
+     * @param previous History the file currently loads to; empty stores
+     *        every message inline.
      */
-    bool appendSnapshot(const nlohmann::json &messages);
+    bool appendSnapshot(
+        const nlohmann::json &messages,
+        const nlohmann::json &previous = nlohmann::json::array());
 
     /**
      * @brief Replace the entire JSONL with the given message list. Used by
@@ -139,6 +161,25 @@ public:
      */
     bool rewriteMessages(const nlohmann::json &messages);
 
+    /**
+     * @brief Queue appends on a background writer thread.
+     * @details Records queued within a few milliseconds share one write.
+     *          The queue is bounded, so a stalled disk slows appends down
+     *          instead of growing memory. Message, meta and snapshot appends
+     *          return once queued; appendRun() and rewriteMessages() still
+     *          return only after the file holds every earlier record. A
+     *          failed background write is reported by the next append or
+     *          flush(). Disabling drains the queue first.
+     */
+    void setBackgroundWrites(bool enabled);
+
+    /**
+     * @brief Wait until every queued record is in the file.
+     * @return false if any background write failed; always true when
+     *         writes are synchronous.
+     */
+    bool flush();
+
     /**
      * @brief Load a session JSONL into a flat OpenAI-style message array.
      * @return Empty array on failure or if the file does not exist.
@@ -218,12 +259,16 @@ public:
     static QString generateId();
 
 private:
+    class Writer;
+
     bool flushPendingMeta();
+    bool writeLine(const nlohmann::json &line);
 
     QString                        sessionIdValue;
     QString                        filePathValue;
     QList<QPair<QString, QString>> pendingMeta; /* Flushed on first message */
     bool                           persisted = false;
+    std::unique_ptr<Writer>        writer; /* Set by setBackgroundWrites() */
 };
 
 #endif // QSOCSESSION_H
@@ -4,14 +4,19 @@
 #include "agent/qsocsubagenttasksource.h"
 
 #include "agent/qsocagent.h"
+#include "agent/qsoctool.h"
+#include "common/qsocconsole.h"
 
+#include <QCoreApplication>
 #include <QDateTime>
+#include <QDeadlineTimer>
 #include <QDir>
 #include <QFile>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QScopeGuard>
 #include <QStandardPaths>
+#include <QThread>
 
 #include <utility>
 
@@ -19,6 +24,35 @@ QSocSubAgentTaskSource::QSocSubAgentTaskSource(QObject *parent)
     : QSocTaskSource(parent)
 {}
 
+QSocSubAgentTaskSource::~QSocSubAgentTaskSource()
+{
+    /* Detach the list first: handlers queued by the children may run
+     * while we wait below and must find no run to update. */
+    const QList<RunState> runs = std::exchange(runs_, {});
+    for (const RunState &run : runs) {
+        if (run.thread == nullptr) {
+            continue;
+        }
+        if (!run.agent.isNull()) {
+            abortAgent(run.agent);
+            run.agent->deleteLater();
+        }
+        run.thread->quit();
+        /* A child parked in a tool call needs this thread to finish it */
+        const QDeadlineTimer deadline(5000);
+        while (!run.thread->wait(10)) {
+            if (deadline.hasExpired()) {
+                QSocConsole::warn() << "Sub-agent" << run.id << "did not stop; leaving its thread";
+                break;
+            }
+            QCoreApplication::processEvents();
+        }
+        if (run.thread->isFinished()) {
+            delete run.thread;
+        }
+    }
+}
+
 QList<QSocTask::Row> QSocSubAgentTaskSource::listTasks() const
 {
     QList<QSocTask::Row> rows;
@@ -142,7 +176,7 @@ bool QSocSubAgentTaskSource::killTask(const QString &id)
     }
 
     /* The child's terminal callback owns the status change and slot. */
-    runningAgent->abortAndDiscardPendingRequests();
+    abortAgent(runningAgent);
     return true;
 }
 
@@ -245,17 +279,25 @@ void QSocSubAgentTaskSource::pumpQueue()
             return;
         }
 
-        bool stillRunning = false;
+        bool                stillRunning = false;
+        QPointer<QSocAgent> threadedAgent;
         for (RunState &run : owner->runs_) {
             if (run.id == runId) {
                 stillRunning = (run.status == QSocTask::Status::Running);
                 if (stillRunning) {
                     run.launcherStarted = true;
+                    if (threadedRuns_ && !run.agent.isNull() && run.thread == nullptr) {
+                        run.thread    = startRunThread(run);
+                        threadedAgent = run.agent;
+                    }
                 }
                 break;
             }
         }
-        if (stillRunning) {
+        if (stillRunning && !threadedAgent.isNull()) {
+            /* The child's own loop runs the launcher; admission goes on */
+            QMetaObject::invokeMethod(threadedAgent.data(), launcher, Qt::QueuedConnection);
+        } else if (stillRunning) {
             launcher();
             if (owner.isNull()) {
                 return;
@@ -382,7 +424,7 @@ void QSocSubAgentTaskSource::abortAll()
     }
     for (const QPointer<QSocAgent> &agent : std::as_const(runningAgents)) {
         if (!agent.isNull()) {
-            agent->abortAndDiscardPendingRequests();
+            abortAgent(agent);
         }
     }
 }
@@ -659,6 +701,11 @@ void QSocSubAgentTaskSource::evictStaleCompleted()
         if (run.agent != nullptr) {
             run.agent->deleteLater();
         }
+        if (run.thread != nullptr) {
+            /* Deferred deletes are flushed when the thread finishes */
+            connect(run.thread, &QThread::finished, run.thread, &QObject::deleteLater);
+            run.thread->quit();
+        }
         runs_.removeAt(i);
         changed = true;
     }
@@ -666,3 +713,29 @@ void QSocSubAgentTaskSource::evictStaleCompleted()
         emit tasksChanged();
     }
 }
+
+QThread *QSocSubAgentTaskSource::startRunThread(RunState &run)
+{
+    auto *thread = new QThread;
+    thread->setObjectName(QStringLiteral("qsoc-agent-") + run.id);
+    /* moveToThread() refuses objects that still have a parent */
+    run.agent->setParent(nullptr);
+    run.agent->moveToThread(thread);
+    thread->start();
+    return thread;
+}
+
+void QSocSubAgentTaskSource::abortAgent(QSocAgent *agent)
+{
+    if (agent->thread() == QThread::currentThread()) {
+        agent->abortAndDiscardPendingRequests();
+        return;
+    }
+    /* The child may be parked in a tool call forwarded to this thread or
+     * running on its own; cancel it here so its loop can pick up the abort. */
+    if (QSocToolRegistry *registry = agent->getToolRegistry()) {
+        registry->abortCalls(agent);
+    }
+    QMetaObject::invokeMethod(
+        agent, [agent]() { agent->abortAndDiscardPendingRequests(); }, Qt::QueuedConnection);
+}
@@ -12,6 +12,7 @@
 #include <QString>
 
 class QSocAgent;
+class QThread;
 
 /**
  * @brief Task source backing in-process sub-agent runs.
@@ -21,7 +22,10 @@ class QSocAgent;
  *          markCompleted() or markFailed(). The overlay listing
  *          updates automatically through tasksChanged().
  *          The source owns each registered child agent and disposes
- *          of it during eviction.
+ *          of it during eviction. With threaded runs enabled, each
+ *          admitted child moves to its own QThread and event loop, so
+ *          one busy child no longer stalls its parent or siblings;
+ *          progress still reaches the source through queued signals.
  */
 class QSocSubAgentTaskSource : public QSocTaskSource
 {
@@ -29,7 +33,7 @@ class QSocSubAgentTaskSource : public QSocTaskSource
 
 public:
     explicit QSocSubAgentTaskSource(QObject *parent = nullptr);
-    ~QSocSubAgentTaskSource() override = default;
+    ~QSocSubAgentTaskSource() override;
 
     QString              sourceTag() const override { return QStringLiteral("agent"); }
     QList<QSocTask::Row> listTasks() const override;
@@ -67,6 +71,19 @@ public:
     /** @brief Current concurrency cap. */
     int maxConcurrent() const { return maxConcurrent_; }
 
+    /**
+     * @brief Run each admitted child on a dedicated thread.
+     * @details The child is unparented and moved to a fresh QThread when
+     *          its slot opens; the launcher is then invoked on that
+     *          thread. Abort requests are posted to the child's loop, and
+     *          tool calls it is parked in are cancelled from here first.
+     *          Only affects runs admitted after the call.
+     */
+    void setThreadedRuns(bool threaded) { threadedRuns_ = threaded; }
+
+    /** @brief Whether admitted children run on their own threads. */
+    bool threadedRuns() const { return threadedRuns_; }
+
     /**
      * @brief Append text to the run's transcript buffer (kept ~64 KiB
      *        rolling); also bumps lastActivityMs.
@@ -219,6 +236,7 @@ private:
         QString               label;
         QString               subagentType;
         QPointer<QSocAgent>   agent;
+        QThread              *thread         = nullptr; /* owned; set for threaded runs */
         QSocTask::Status      status         = QSocTask::Status::Pending;
         qint64                queuedAtMs     = 0;
         qint64                startedAtMs    = 0;
@@ -242,6 +260,12 @@ private:
      * registered, so the panel doesn't grow without bound. */
     void evictStaleCompleted();
 
+    /* Move a run's agent onto a new thread and start its event loop. */
+    static QThread *startRunThread(RunState &run);
+
+    /* Abort a child, posting to its own thread when it has one. */
+    static void abortAgent(QSocAgent *agent);
+
     /** Resolve the on-disk directory transcripts are written to. */
     QString transcriptDir() const;
 
@@ -257,6 +281,7 @@ private:
     int                  nextSerial_      = 1;
     int                  maxConcurrent_   = 0;                 /* sliding-window cap; 0=unbounded */
     bool                 pumping_         = false;             /* pumpQueue re-entry guard */
+    bool                 threadedRuns_    = false;             /* one QThread per admitted run */
     qint64               completionTtlMs_ = qint64{60} * 1000; /* 60 s lingering window */
     int                  transcriptCap_   = 64 * 1024;
     QString              transcriptDir_; /* empty = compute from QStandardPaths */
@@ -3,9 +3,54 @@
 
 #include "agent/qsoctool.h"
 
+#include "common/qsocconsole.h"
+
+#include <memory>
 #include <utility>
 
+#include <QMutexLocker>
 #include <QScopeGuard>
+#include <QThread>
+#include <QThreadPool>
+
+namespace {
+
+/* Calls in flight on this thread, innermost last. Nested event loops and
+ * thread-safe tools can put several calls of one tool on different stacks. */
+struct ToolCallFrame
+{
+    const QSocTool      *tool;
+    QSocToolCallContext *context;
+};
+
+thread_local QList<ToolCallFrame> toolCallFrames;
+
+/* Set while executeBlocking() runs, so worker bodies run inline */
+thread_local int inlineWorkerDepth = 0;
+
+/* Bodies of every tool share one pool, bounded to the core count. It is
+ * kept apart from the global pool, which the bodies use for their own
+ * parallel parsing and rendering. */
+QThreadPool &toolWorkerPool()
+{
+    static QThreadPool pool;
+    return pool;
+}
+
+/* One body queued on the pool, with what it hands back to the caller */
+struct WorkerCall
+{
+    explicit WorkerCall(QSocToolCallContext *context)
+        : worker(context)
+    {}
+
+    QSocToolWorker                                 worker;
+    std::function<QString(const QSocToolWorker &)> body;
+    QSocConsole::Capture                           log;
+    QString                                        result;
+};
+
+} // namespace
 
 /* QSocToolCallContext Implementation */
 
@@ -20,18 +65,46 @@ QSocToolCallContext::QSocToolCallContext(QObject *owner, QObject *fallbackScope)
 
 bool QSocToolCallContext::isCancellationRequested() const
 {
-    return cancellationRequested_;
+    return cancellationRequested_.load(std::memory_order_relaxed);
 }
 
 void QSocToolCallContext::requestCancellation()
 {
-    if (cancellationRequested_) {
+    if (cancellationRequested_.exchange(true, std::memory_order_relaxed)) {
         return;
     }
-    cancellationRequested_ = true;
     emit cancellationRequested();
 }
 
+void QSocToolCallContext::reportProgress(const QString &message)
+{
+    emit progressReported(message);
+}
+
+/* QSocToolWorker Implementation */
+
+QSocToolWorker::QSocToolWorker(QSocToolCallContext *context)
+    : context_(context)
+{}
+
+bool QSocToolWorker::isCancelled() const
+{
+    return cancelled_.load(std::memory_order_relaxed);
+}
+
+void QSocToolWorker::progress(const QString &message) const
+{
+    /* Context outlives the worker: the call ends only after the body returned */
+    if (context_ != nullptr) {
+        context_->reportProgress(message);
+    }
+}
+
+void QSocToolWorker::cancel()
+{
+    cancelled_.store(true, std::memory_order_relaxed);
+}
+
 /* QSocTool Implementation */
 
 QSocTool::QSocTool(QObject *parent)
@@ -44,7 +117,85 @@ void QSocTool::abort() {}
 
 QSocToolCallContext *QSocTool::currentCallContext() const
 {
-    return callContexts_.isEmpty() ? nullptr : callContexts_.constLast().data();
+    for (auto it = toolCallFrames.crbegin(); it != toolCallFrames.crend(); ++it) {
+        if (it->tool == this) {
+            return it->context;
+        }
+    }
+    return nullptr;
+}
+
+void QSocTool::executeAsync(
+    const json &arguments, QSocToolCallContext *call, const ResultCallback &done)
+{
+    Q_UNUSED(call);
+    done(execute(arguments));
+}
+
+QString QSocTool::executeBlocking(const json &arguments)
+{
+    QString result = QStringLiteral("Error: Tool finished without a result");
+    ++inlineWorkerDepth;
+    const auto restore = qScopeGuard([]() { --inlineWorkerDepth; });
+    executeAsync(arguments, currentCallContext(), [&result](const QString &text) {
+        result = text;
+    });
+    return result;
+}
+
+void QSocTool::runOnWorker(WorkerBody body, QSocToolCallContext *call, ResultCallback done)
+{
+    if (call != nullptr && call->isCancellationRequested()) {
+        done(QStringLiteral("Error: Operation cancelled"));
+        return;
+    }
+
+    if (inlineWorkerDepth > 0) {
+        QSocToolWorker          worker(call);
+        QMetaObject::Connection cancelHook;
+        if (call != nullptr) {
+            cancelHook = connect(
+                call,
+                &QSocToolCallContext::cancellationRequested,
+                call,
+                [&worker]() { worker.cancel(); },
+                Qt::DirectConnection);
+        }
+        const QString result = body(worker);
+        disconnect(cancelHook);
+        done(result);
+        return;
+    }
+
+    /* The receiver stays on this thread until the result is delivered and
+     * scopes the cancel hook; cancellation may come from any thread. */
+    auto state  = std::make_shared<WorkerCall>(call);
+    state->body = std::move(body);
+    auto *receiver = new QObject;
+    if (call != nullptr) {
+        connect(
+            call,
+            &QSocToolCallContext::cancellationRequested,
+            receiver,
+            [state]() { state->worker.cancel(); },
+            Qt::DirectConnection);
+    }
+    toolWorkerPool().start([state, receiver, done = std::move(done)]() mutable {
+        {
+            const QSocConsole::CaptureScope scope(state->log);
+            state->result = state->body(state->worker);
+        }
+        /* The last reference moves into the delivery, so the body and what
+         * it captured are destroyed on the calling thread */
+        QMetaObject::invokeMethod(
+            receiver,
+            [state = std::move(state), receiver, done = std::move(done)]() {
+                receiver->deleteLater();
+                state->log.replay();
+                done(state->result);
+            },
+            Qt::QueuedConnection);
+    });
 }
 
 json QSocTool::getDefinition() const
@@ -89,12 +240,16 @@ void QSocToolRegistry::registerTool(QSocTool *tool)
     if (registry->tools_.value(name).data() == candidate.data()) {
         return;
     }
-    registry->tools_[name] = candidate;
+    {
+        const QMutexLocker locker(&registry->toolsMutex_);
+        registry->tools_[name] = candidate;
+    }
     connect(candidate, &QObject::destroyed, registry, [registry, candidate, name]() {
         if (registry.isNull()) {
             return;
         }
-        auto it = registry->tools_.find(name);
+        const QMutexLocker locker(&registry->toolsMutex_);
+        auto               it = registry->tools_.find(name);
         /* The current guard may already be null when destroyed is delivered. */
         if (it != registry->tools_.end()
             && (it.value().isNull()
@@ -110,7 +265,8 @@ bool QSocToolRegistry::unregisterTool(QSocTool *tool)
         return false;
     }
 
-    bool removed = false;
+    const QMutexLocker locker(&toolsMutex_);
+    bool               removed = false;
     for (auto it = tools_.begin(); it != tools_.end();) {
         if (it.value().data() == tool) {
             it      = tools_.erase(it);
@@ -124,6 +280,7 @@ bool QSocToolRegistry::unregisterTool(QSocTool *tool)
 
 QSocTool *QSocToolRegistry::getTool(const QString &name) const
 {
+    const QMutexLocker locker(&toolsMutex_);
     return tools_.value(name).data();
 }
 
@@ -134,6 +291,16 @@ bool QSocToolRegistry::hasTool(const QString &name) const
 
 json QSocToolRegistry::getToolDefinitions() const
 {
+    /* Tools build their schema from live state owned by this thread */
+    if (QThread::currentThread() != thread()) {
+        json definitions = json::array();
+        QMetaObject::invokeMethod(
+            const_cast<QSocToolRegistry *>(this),
+            [this, &definitions]() { definitions = getToolDefinitions(); },
+            Qt::BlockingQueuedConnection);
+        return definitions;
+    }
+
     json       definitions = json::array();
     const auto tools       = tools_.values();
     for (const auto &tool : tools) {
@@ -147,28 +314,121 @@ json QSocToolRegistry::getToolDefinitions() const
 QString QSocToolRegistry::executeTool(const QString &name, const json &arguments, QObject *owner)
 {
     QPointer<QSocTool> tool = getTool(name);
+
+    /* Calls from a sub-agent thread run here, where the tools live, unless
+     * the tool is thread-safe. The caller blocks and forwarded calls nest on
+     * this thread's loop; executeToolAsync() avoids both for async tools. */
+    if (QThread::currentThread() != thread() && (tool.isNull() || !tool->isThreadSafe())) {
+        QString result = QString("Error: Tool '%1' registry is gone").arg(name);
+        QMetaObject::invokeMethod(
+            this,
+            [this, &result, &name, &arguments, owner]() {
+                result = executeTool(name, arguments, owner);
+            },
+            Qt::BlockingQueuedConnection);
+        return result;
+    }
+
     if (tool.isNull()) {
         return QString("Error: Tool '%1' not found").arg(name);
     }
 
     ActiveCall call(tool, owner, this);
-    activeCalls_.insert(&call);
-    tool->callContexts_.append(&call.context);
+    {
+        const QMutexLocker locker(&callsMutex_);
+        activeCalls_.insert(&call);
+    }
+    toolCallFrames.append({tool.data(), &call.context});
+    const QPointer<QObject> progressOwner(owner);
+    connect(
+        &call.context,
+        &QSocToolCallContext::progressReported,
+        this,
+        [this, progressOwner, name](const QString &message) {
+            emit toolProgress(progressOwner.data(), name, message);
+        });
     QPointer<QSocToolRegistry> registry(this);
-    const auto                 removeCall = qScopeGuard([registry, tool, &call]() {
-        if (!tool.isNull()) {
-            tool->callContexts_.removeOne(&call.context);
+    const auto                 removeCall = qScopeGuard([registry, &call]() {
+        for (qsizetype index = toolCallFrames.size() - 1; index >= 0; --index) {
+            if (toolCallFrames.at(index).context == &call.context) {
+                toolCallFrames.removeAt(index);
+                break;
+            }
         }
         if (!registry.isNull()) {
+            const QMutexLocker locker(&registry->callsMutex_);
             registry->activeCalls_.remove(&call);
         }
     });
     return tool->execute(arguments);
 }
 
+void QSocToolRegistry::executeToolAsync(
+    const QString                  &name,
+    const json                     &arguments,
+    QObject                        *owner,
+    const QSocTool::ResultCallback &done)
+{
+    QPointer<QSocTool> tool = getTool(name);
+    if (tool.isNull() || !tool->isAsync()) {
+        done(executeTool(name, arguments, owner));
+        return;
+    }
+
+    /* Async tools start here, where they live; the result is posted back
+     * to the owner's thread. Without an owner there is nowhere to post to,
+     * so the call blocks like executeTool(). */
+    if (QThread::currentThread() != thread() && !tool->isThreadSafe()) {
+        if (owner == nullptr) {
+            done(executeTool(name, arguments, owner));
+            return;
+        }
+        const QPointer<QObject> receiver(owner);
+        QMetaObject::invokeMethod(
+            this,
+            [this, name, arguments, receiver, done]() {
+                executeToolAsync(
+                    name, arguments, receiver.data(), [receiver, done](const QString &result) {
+                        if (!receiver.isNull()) {
+                            QMetaObject::invokeMethod(
+                                receiver.data(),
+                                [done, result]() { done(result); },
+                                Qt::QueuedConnection);
+                        }
+                    });
+            },
+            Qt::QueuedConnection);
+        return;
+    }
+
+    auto *call = new ActiveCall(tool, owner, this);
+    {
+        const QMutexLocker locker(&callsMutex_);
+        activeCalls_.insert(call);
+    }
+    const QPointer<QObject> progressOwner(owner);
+    connect(
+        &call->context,
+        &QSocToolCallContext::progressReported,
+        this,
+        [this, progressOwner, name](const QString &message) {
+            emit toolProgress(progressOwner.data(), name, message);
+        });
+    const QPointer<QSocToolRegistry> registry(this);
+    tool->executeAsync(arguments, &call->context, [registry, call, done](const QString &result) {
+        if (!registry.isNull()) {
+            const QMutexLocker locker(&registry->callsMutex_);
+            registry->activeCalls_.remove(call);
+        }
+        delete call;
+        done(result);
+    });
+}
+
 int QSocToolRegistry::count() const
 {
-    int total = 0;
+    const QMutexLocker locker(&toolsMutex_);
+    int                total = 0;
     for (const auto &tool : tools_) {
         if (!tool.isNull()) {
             ++total;
@@ -179,7 +439,8 @@ int QSocToolRegistry::count() const
 
 QStringList QSocToolRegistry::toolNames() const
 {
-    QStringList names;
+    const QMutexLocker locker(&toolsMutex_);
+    QStringList        names;
     for (auto it = tools_.constBegin(); it != tools_.constEnd(); ++it) {
         if (!it.value().isNull()) {
             names.append(it.key());
@@ -190,13 +451,8 @@ QStringList QSocToolRegistry::toolNames() const
 
 void QSocToolRegistry::abortAll()
 {
-    QList<QPointer<QSocTool>>            tools = tools_.values();
-    QList<QPointer<QSocToolCallContext>> contexts;
-    for (ActiveCall *call : std::as_const(activeCalls_)) {
-        tools.append(call->tool);
-        contexts.append(&call->context);
-    }
-
+    QList<QPointer<QSocTool>>                  tools    = tools_.values();
+    const QList<QPointer<QSocToolCallContext>> contexts = cancelActiveCalls(nullptr, &tools);
     for (const auto &context : contexts) {
         if (!context.isNull()) {
             context->requestCancellation();
@@ -219,16 +475,40 @@ void QSocToolRegistry::abortCalls(QObject *owner)
     if (owner == nullptr) {
         return;
     }
-
-    QList<QPointer<QSocToolCallContext>> contexts;
-    for (ActiveCall *call : std::as_const(activeCalls_)) {
-        if (call->context.owner_.data() == owner) {
-            contexts.append(&call->context);
-        }
+    if (QThread::currentThread() != thread()) {
+        QMetaObject::invokeMethod(
+            this, [this, owner]() { abortCalls(owner); }, Qt::QueuedConnection);
+        return;
     }
+
+    const QList<QPointer<QSocToolCallContext>> contexts = cancelActiveCalls(owner, nullptr);
     for (const auto &context : contexts) {
         if (!context.isNull()) {
             context->requestCancellation();
         }
     }
 }
+
+QList<QPointer<QSocToolCallContext>> QSocToolRegistry::cancelActiveCalls(
+    QObject *owner, QList<QPointer<QSocTool>> *tools)
+{
+    /* Calls running on another thread may end at any time, so cancel them
+     * under the lock; their listeners live on that thread and get a queued
+     * signal. Local calls are returned and cancelled by the caller. */
+    QList<QPointer<QSocToolCallContext>> local;
+    const QMutexLocker                   locker(&callsMutex_);
+    for (ActiveCall *call : std::as_const(activeCalls_)) {
+        if (owner != nullptr && call->context.owner_.data() != owner) {
+            continue;
+        }
+        if (tools != nullptr) {
+            tools->append(call->tool);
+        }
+        if (call->context.thread() == QThread::currentThread()) {
+            local.append(&call->context);
+        } else {
+            call->context.requestCancellation();
+        }
+    }
+    return local;
+}
@@ -6,11 +6,15 @@
 
 #include <nlohmann/json.hpp>
 #include <QMap>
+#include <QMutex>
 #include <QObject>
 #include <QPointer>
 #include <QSet>
 #include <QString>
 
+#include <atomic>
+#include <functional>
+
 using json = nlohmann::json;
 
 /**
@@ -26,9 +30,12 @@ public:
     bool isCancellationRequested() const;
     /** @brief Scope shared by tool calls from the same execution owner. */
     QObject *executionScope() const { return scope_.data(); }
+    /** @brief Report one progress line for this call; safe from any thread. */
+    void reportProgress(const QString &message);
 
 signals:
     void cancellationRequested();
+    void progressReported(const QString &message);
 
 private:
     QSocToolCallContext(QObject *owner, QObject *fallbackScope);
@@ -36,11 +43,33 @@ private:
 
     QPointer<QObject> owner_;
     QPointer<QObject> scope_;
-    bool              cancellationRequested_ = false;
+    std::atomic<bool> cancellationRequested_{false};
 
     friend class QSocToolRegistry;
 };
 
+/**
+ * @brief Handle given to a tool body running on a worker thread
+ * @details The body polls isCancelled() between steps and reports progress
+ *          lines, which reach the calling tool block while it runs.
+ */
+class QSocToolWorker
+{
+public:
+    explicit QSocToolWorker(QSocToolCallContext *context);
+
+    bool isCancelled() const;
+    void progress(const QString &message) const;
+
+private:
+    void cancel();
+
+    QSocToolCallContext *context_ = nullptr;
+    std::atomic<bool>    cancelled_{false};
+
+    friend class QSocTool;
+};
+
 /**
  * @brief Base class for all agent tools
  * @details Abstract base class that defines the interface for tools
@@ -57,6 +86,9 @@ public:
      */
     explicit QSocTool(QObject *parent = nullptr);
 
+    /** @brief Receives the result of one executeAsync() call. */
+    using ResultCallback = std::function<void(const QString &result)>;
+
     /**
      * @brief Virtual destructor
      */
@@ -87,6 +119,28 @@ public:
      */
     virtual QString execute(const json &arguments) = 0;
 
+    /**
+     * @brief Whether the tool delivers its result through executeAsync()
+     * @details An async tool returns from executeAsync() at once and calls
+     *          back from its thread's event loop once the work is done, so
+     *          a streaming agent waits for it without a nested event loop.
+     * @return true if executeAsync() does not block
+     */
+    virtual bool isAsync() const { return false; }
+
+    /**
+     * @brief Start the tool and deliver its result to a callback
+     * @details The default runs execute() and calls @p done before it
+     *          returns. Async tools call @p done exactly once on the
+     *          tool's thread, usually later from its event loop; @p call
+     *          stays valid until then.
+     * @param arguments JSON object containing the tool arguments
+     * @param call Cancellation state of this invocation, or nullptr
+     * @param done Receives the result
+     */
+    virtual void executeAsync(
+        const json &arguments, QSocToolCallContext *call, const ResultCallback &done);
+
     /**
      * @brief Abort the current tool execution
      * @details Default implementation is a no-op. Override in tools that run
@@ -105,6 +159,18 @@ public:
      */
     virtual bool isReadOnly() const { return false; }
 
+    /**
+     * @brief Whether execute() may run on the calling agent's thread
+     * @details Off by default: calls from a sub-agent thread are forwarded
+     *          to the thread the tool lives on and run there one at a time.
+     *          A tool that opts in runs on each caller's thread, so several
+     *          sub-agents can be inside it at once. execute() and abort()
+     *          must then only touch per-call state or data guarded by a
+     *          lock, and the tool must outlive the agents that call it.
+     * @return true if execute() is safe to run concurrently from any thread
+     */
+    virtual bool isThreadSafe() const { return false; }
+
     /**
      * @brief Get the tool definition in OpenAI function format
      * @return JSON object in OpenAI tool format
@@ -120,16 +186,43 @@ protected:
      */
     QSocToolCallContext *currentCallContext() const;
 
-private:
-    QList<QPointer<QSocToolCallContext>> callContexts_;
+    /** @brief Blocking work handed to runOnWorker(). */
+    using WorkerBody = std::function<QString(const QSocToolWorker &)>;
 
-    friend class QSocToolRegistry;
+    /**
+     * @brief Run a blocking body on the shared tool worker pool
+     * @details Returns at once. The pool is bounded to the core count and
+     *          starts bodies in the order they were queued; @p done gets
+     *          the result on this thread's event loop after the body's
+     *          console output is replayed. Cancelling @p call only raises
+     *          the worker flag; the body decides where it is safe to stop.
+     *          Under executeBlocking() the body runs on the calling thread
+     *          instead and @p done is called before this returns.
+     * @param body Work to run; must not touch objects shared with the
+     *        calling thread. It is destroyed on the calling thread.
+     * @param call Cancellation state of this invocation, or nullptr
+     * @param done Receives the result of the body
+     */
+    void runOnWorker(WorkerBody body, QSocToolCallContext *call, ResultCallback done);
+
+    /**
+     * @brief Run executeAsync() to completion on the calling thread
+     * @details execute() of a tool built on runOnWorker() uses this, so
+     *          synchronous callers get the result without any event loop.
+     * @param arguments JSON object containing the tool arguments
+     * @return Result passed to the executeAsync() callback
+     */
+    QString executeBlocking(const json &arguments);
 };
 
 /**
  * @brief Registry for managing available tools
  * @details Observes a non-owning collection of tools and provides methods
- *          to register, retrieve, and execute live tools by name.
+ *          to register, retrieve, and execute live tools by name. Agents
+ *          on other threads may call in: tool lookups and active calls are
+ *          guarded, thread-safe tools run on the caller's thread, while
+ *          other executeTool() calls, getToolDefinitions() and abortCalls()
+ *          are forwarded to the registry's own thread.
  */
 class QSocToolRegistry : public QObject
 {
@@ -188,6 +281,25 @@ public:
      */
     QString executeTool(const QString &name, const json &arguments, QObject *owner = nullptr);
 
+    /**
+     * @brief Execute a tool by name and deliver the result to a callback
+     * @details A tool that is not async runs as in executeTool() and
+     *          @p done is called before this returns. An async tool is
+     *          started on the registry's thread and @p done is called later
+     *          on the caller's thread, from its event loop; a call from
+     *          another thread is forwarded without blocking when @p owner
+     *          is given.
+     * @param name The name of the tool to execute
+     * @param arguments JSON object containing tool arguments
+     * @param owner Execution owner, as for executeTool()
+     * @param done Receives the result
+     */
+    void executeToolAsync(
+        const QString                  &name,
+        const json                     &arguments,
+        QObject                        *owner,
+        const QSocTool::ResultCallback &done);
+
     /**
      * @brief Get the number of registered tools
      * @return Number of tools in the registry
@@ -212,6 +324,15 @@ public:
      */
     void abortCalls(QObject *owner);
 
+signals:
+    /**
+     * @brief Progress line reported by a running tool call
+     * @param owner Owner passed to executeTool()
+     * @param toolName Name of the running tool
+     * @param message Progress text
+     */
+    void toolProgress(QObject *owner, const QString &toolName, const QString &message);
+
 private:
     struct ActiveCall
     {
@@ -224,8 +345,13 @@ private:
         QSocToolCallContext context;
     };
 
+    QList<QPointer<QSocToolCallContext>> cancelActiveCalls(
+        QObject *owner, QList<QPointer<QSocTool>> *tools);
+
     QMap<QString, QPointer<QSocTool>> tools_;
+    mutable QMutex                    toolsMutex_; /* guards tools_ for foreign readers */
     QSet<ActiveCall *>                activeCalls_;
+    QMutex                            callsMutex_; /* guards activeCalls_ */
 };
 
 #endif // QSOCTOOL_H
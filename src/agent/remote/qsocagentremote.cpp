@@ -211,6 +211,9 @@ bool connectAgentSshSession(
                 }
                 return nullptr;
             }
+            /* Hops only carry the tunnel; exec channels are opened on the
+             * target, so a warm pool here would just pin remote resources. */
+            hopSession->setChannelPoolSize(0);
             localJumps.append(hopSession);
             currentParent = hopSession;
         }
@@ -309,7 +312,8 @@ QSocToolRegistry *buildAgentRemoteRegistry(
 {
     auto *registry = new QSocToolRegistry(parent);
     registry->registerTool(new QSocToolRemoteFileRead(parent, state->sftp, pathCtx));
-    registry->registerTool(new QSocToolRemoteFileList(parent, state->sftp, pathCtx));
+    registry->registerTool(
+        new QSocToolRemoteFileList(parent, state->sftp, pathCtx, state->session));
     registry->registerTool(new QSocToolRemoteFileWrite(parent, state->sftp, pathCtx));
     registry->registerTool(new QSocToolRemoteFileEdit(parent, state->sftp, pathCtx));
     registry->registerTool(new QSocToolRemoteShellBash(parent, state->session, pathCtx));
@@ -0,0 +1,179 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Huang Rui <vowstar@gmail.com>
+
+#include "agent/remote/qsocremotelister.h"
+
+#include "agent/remote/qsocsshexec.h"
+#include "agent/remote/qsocsshsession.h"
+
+namespace {
+
+/* Exit codes of the host script for failures before any listing. */
+constexpr int kExitNoRoot   = 3;
+constexpr int kExitNoPrintf = 4;
+
+QString shellQuote(const QString &value)
+{
+    QString out = QStringLiteral("'");
+    for (const QChar chr : value) {
+        if (chr == QLatin1Char('\'')) {
+            out += QStringLiteral("'\\''");
+        } else {
+            out += chr;
+        }
+    }
+    out += QLatin1Char('\'');
+    return out;
+}
+
+} // namespace
+
+QSocRemoteLister::QSocRemoteLister(QSocSshSession *session)
+    : m_session(session)
+    , m_cache(32)
+{}
+
+void QSocRemoteLister::clearCache()
+{
+    m_cache.clear();
+}
+
+QString QSocRemoteLister::cacheKey(const Query &query)
+{
+    return QStringList{
+        query.root,
+        QString::number(query.maxDepth),
+        QString::number(query.limit),
+        query.namePattern,
+        query.pruneNames.join(QLatin1Char('/')),
+        query.filesOnly ? QStringLiteral("f") : QStringLiteral("a")}
+        .join(QLatin1Char('\n'));
+}
+
+QString QSocRemoteLister::buildCommand(const Query &query, const QString &knownStamp)
+{
+    QString prune;
+    for (const QString &name : query.pruneNames) {
+        prune += (prune.isEmpty() ? QString() : QStringLiteral(" -o ")) + QStringLiteral("-name ")
+                 + shellQuote(name);
+    }
+    if (!prune.isEmpty()) {
+        prune = QStringLiteral("\\( ") + prune + QStringLiteral(" \\) -prune -o ");
+    }
+
+    /* Directories at the deepest listed level only change entries below
+     * it, so the stamp scan stops one level short. */
+    const QString stampDepth = query.maxDepth > 0
+                                   ? QStringLiteral("-maxdepth %1 ").arg(query.maxDepth - 1)
+                                   : QString();
+    const QString listDepth  = query.maxDepth > 0
+                                   ? QStringLiteral("-maxdepth %1 ").arg(query.maxDepth)
+                                   : QString();
+    QString       filter;
+    if (query.filesOnly) {
+        filter += QStringLiteral("-type f ");
+    }
+    if (!query.namePattern.isEmpty()) {
+        filter += QStringLiteral("-name ") + shellQuote(query.namePattern) + QLatin1Char(' ');
+    }
+
+    return QStringLiteral(
+               "cd %1 2>/dev/null || exit %2; "
+               "s=$(find . %3%4-type d -printf '%T@\\n' 2>/dev/null | sort -n | tail -n 1); "
+               "[ -n \"$s\" ] || exit %5; "
+               "printf 'S%s\\0' \"$s\"; "
+               "[ \"$s\" = %6 ] && { printf 'U\\0'; exit 0; }; "
+               "find . -mindepth 1 %7%4%8-printf '%y\\t%s\\t%T@\\t%P\\0' 2>/dev/null "
+               "| head -z -n %9")
+        .arg(
+            shellQuote(query.root),
+            QString::number(kExitNoRoot),
+            stampDepth,
+            prune,
+            QString::number(kExitNoPrintf),
+            shellQuote(knownStamp),
+            listDepth,
+            filter,
+            QString::number(query.limit + 1));
+}
+
+QSocRemoteLister::Listing QSocRemoteLister::parse(const QByteArray &bytes, int limit)
+{
+    Listing                 listing;
+    const QList<QByteArray> records = bytes.split('\0');
+    for (const QByteArray &record : records) {
+        if (record.isEmpty()) {
+            continue;
+        }
+        if (record.size() < 2 || record.at(1) != '\t') {
+            if (record.startsWith('S')) {
+                listing.stamp = QString::fromLatin1(record.mid(1));
+            } else if (record == "U") {
+                listing.unchanged = true;
+            }
+            continue;
+        }
+        if (listing.entries.size() >= limit) {
+            listing.truncated = true;
+            break;
+        }
+        /* The path is last so tabs inside a file name survive. */
+        const qsizetype sizeEnd  = record.indexOf('\t', 2);
+        const qsizetype mtimeEnd = sizeEnd < 0 ? -1 : record.indexOf('\t', sizeEnd + 1);
+        if (mtimeEnd < 0) {
+            continue;
+        }
+        Entry entry;
+        entry.isDirectory = record.at(0) == 'd';
+        entry.isSymlink   = record.at(0) == 'l';
+        entry.size        = record.mid(2, sizeEnd - 2).toLongLong();
+        entry.mtime       = static_cast<qint64>(
+            record.mid(sizeEnd + 1, mtimeEnd - sizeEnd - 1).toDouble());
+        entry.path = QString::fromUtf8(record.mid(mtimeEnd + 1));
+        listing.entries.append(entry);
+    }
+    return listing;
+}
+
+bool QSocRemoteLister::list(const Query &query, Listing *out, QString *errorMessage)
+{
+    auto fail = [errorMessage](const QString &message) {
+        if (errorMessage != nullptr) {
+            *errorMessage = message;
+        }
+        return false;
+    };
+    if (m_session == nullptr || !m_session->isConnected()) {
+        return fail(QStringLiteral("SSH session is not connected"));
+    }
+
+    const QString  key    = cacheKey(query);
+    const Listing *cached = m_cache.object(key);
+
+    QSocSshExec exec(*m_session);
+    const auto  result = exec.run(
+        buildCommand(query, cached != nullptr ? cached->stamp : QString()), 30000);
+    if (!result.errorText.isEmpty()) {
+        return fail(result.errorText);
+    }
+    if (result.timedOut) {
+        return fail(QStringLiteral("Remote listing timed out"));
+    }
+    if (result.exitCode == kExitNoRoot) {
+        return fail(QStringLiteral("No such remote directory: %1").arg(query.root));
+    }
+    if (result.exitCode == kExitNoPrintf) {
+        return fail(QStringLiteral("Remote find does not support -printf"));
+    }
+
+    Listing listing = parse(result.stdoutBytes, query.limit);
+    if (listing.unchanged && cached != nullptr) {
+        m_hits++;
+        *out           = *cached;
+        out->unchanged = true;
+        return true;
+    }
+    *out = listing;
+    m_cache.insert(key, new Listing(listing), 1);
+    return true;
+}
@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Huang Rui <vowstar@gmail.com>
+
+#ifndef QSOCREMOTELISTER_H
+#define QSOCREMOTELISTER_H
+
+#include <QByteArray>
+#include <QCache>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+class QSocSshSession;
+
+/**
+ * @brief Bounded remote directory listing and name search over one exec.
+ * @details Runs a single GNU `find` on the host instead of walking the tree
+ *          with one SFTP readdir per directory. Records come back as compact
+ *          NUL-terminated `type TAB size TAB mtime TAB path` lines, capped at
+ *          the query limit on the host side. Every run first computes the
+ *          newest directory mtime under the scanned depth; a listing cached
+ *          locally is reused when that stamp is unchanged, so a repeat query
+ *          transfers a few bytes. File edits that leave directories alone do
+ *          not bump the stamp; sizes and mtimes of cached entries can lag
+ *          until something is added, removed or renamed.
+ */
+class QSocRemoteLister
+{
+public:
+    /** @brief One listed path, relative to the query root. */
+    struct Entry
+    {
+        QString path;
+        qint64  size        = 0;
+        qint64  mtime       = 0;
+        bool    isDirectory = false;
+        bool    isSymlink   = false;
+    };
+
+    /** @brief What to list. */
+    struct Query
+    {
+        QString     root;
+        int         maxDepth = 1;   /* 0 means unlimited */
+        int         limit    = 200; /* entries returned; the host stops after limit + 1 */
+        QString     namePattern;    /* shell glob on the basename; empty matches all */
+        QStringList pruneNames;     /* directory basenames skipped with their subtree */
+        bool        filesOnly = false;
+    };
+
+    /** @brief Result of a listing. */
+    struct Listing
+    {
+        QList<Entry> entries;
+        QString      stamp; /* newest directory mtime under the scanned depth */
+        bool         truncated = false;
+        bool         unchanged = false; /* host reported the cached stamp still holds */
+    };
+
+    explicit QSocRemoteLister(QSocSshSession *session);
+
+    /**
+     * @brief List or search under query.root.
+     * @return False when the session is down, the root is missing, or the
+     *         host `find` lacks `-printf` (non-GNU); @p errorMessage says which.
+     */
+    bool list(const Query &query, Listing *out, QString *errorMessage = nullptr);
+
+    /** @brief Forget every cached listing. */
+    void clearCache();
+
+    qint64 cacheHits() const { return m_hits; }
+
+    /** @brief Host script for @p query; @p knownStamp short-circuits the listing. */
+    static QString buildCommand(const Query &query, const QString &knownStamp);
+
+    /** @brief Decode the host output of buildCommand(). */
+    static Listing parse(const QByteArray &bytes, int limit);
+
+private:
+    static QString cacheKey(const Query &query);
+
+    QSocSshSession          *m_session = nullptr;
+    QCache<QString, Listing> m_cache;
+    qint64                   m_hits = 0;
+};
+
+#endif // QSOCREMOTELISTER_H
@@ -109,6 +109,8 @@ QByteArray QSocSftpClient::readFile(const QString &path, qint64 maxBytes, QStrin
     if (!open(errorMessage)) {
         return {};
     }
+    const QSocSshSession::Operation operation(m_session, "sftp_read");
+
     const QByteArray pathBytes = path.toUtf8();
 
     LIBSSH2_SFTP_HANDLE *handle = nullptr;
@@ -160,6 +162,7 @@ bool QSocSftpClient::writeFile(const QString &path, const QByteArray &content, Q
     if (!open(errorMessage)) {
         return false;
     }
+    const QSocSshSession::Operation operation(m_session, "sftp_write");
 
     const QFileInfo finalInfo(path);
     if (!mkdirP(finalInfo.absolutePath(), errorMessage)) {
@@ -260,6 +263,8 @@ bool QSocSftpClient::mkdirP(const QString &path, QString *errorMessage)
     if (!open(errorMessage)) {
         return false;
     }
+    const QSocSshSession::Operation operation(m_session, "sftp_mkdir");
+
     if (path.isEmpty() || path == QStringLiteral("/")) {
         return true;
     }
@@ -298,6 +303,8 @@ bool QSocSftpClient::rename(const QString &oldPath, const QString &newPath, QStr
     if (!open(errorMessage)) {
         return false;
     }
+    const QSocSshSession::Operation operation(m_session, "sftp_rename");
+
     const QByteArray from = oldPath.toUtf8();
     const QByteArray to   = newPath.toUtf8();
     int              rc   = 0;
@@ -320,6 +327,8 @@ bool QSocSftpClient::removeFile(const QString &path, QString *errorMessage)
     if (!open(errorMessage)) {
         return false;
     }
+    const QSocSshSession::Operation operation(m_session, "sftp_remove");
+
     /* An already-absent file is success: rewind-to-absent is idempotent. */
     if (!exists(path)) {
         return true;
@@ -346,6 +355,8 @@ QList<QSocSftpClient::Entry> QSocSftpClient::listDir(
     if (!open(errorMessage)) {
         return entries;
     }
+    const QSocSshSession::Operation operation(m_session, "sftp_list");
+
     const QByteArray     pathBytes = path.toUtf8();
     LIBSSH2_SFTP_HANDLE *handle    = nullptr;
     while ((handle = libssh2_sftp_opendir(m_sftp, pathBytes.constData())) == nullptr) {
@@ -373,6 +384,9 @@ QList<QSocSftpClient::Entry> QSocSftpClient::listDir(
             if ((attrs.flags & LIBSSH2_SFTP_ATTR_SIZE) != 0) {
                 entry.size = static_cast<qint64>(attrs.filesize);
             }
+            if ((attrs.flags & LIBSSH2_SFTP_ATTR_ACMODTIME) != 0) {
+                entry.mtime = static_cast<qint64>(attrs.mtime);
+            }
             if ((attrs.flags & LIBSSH2_SFTP_ATTR_PERMISSIONS) != 0) {
                 entry.isDirectory = (attrs.permissions & LIBSSH2_SFTP_S_IFDIR) != 0;
                 entry.isSymlink   = (attrs.permissions & LIBSSH2_SFTP_S_IFLNK) != 0;
@@ -404,6 +418,8 @@ bool QSocSftpClient::exists(const QString &path, QString *errorMessage)
     if (!open(errorMessage)) {
         return false;
     }
+    const QSocSshSession::Operation operation(m_session, "sftp_stat");
+
     const QByteArray        pathBytes = path.toUtf8();
     LIBSSH2_SFTP_ATTRIBUTES attrs;
     int                     rc = 0;
@@ -415,3 +431,39 @@ bool QSocSftpClient::exists(const QString &path, QString *errorMessage)
     }
     return rc == 0;
 }
+
+bool QSocSftpClient::stat(const QString &path, Entry *entry, QString *errorMessage)
+{
+    if (!open(errorMessage)) {
+        return false;
+    }
+    const QSocSshSession::Operation operation(m_session, "sftp_stat");
+
+    const QByteArray        pathBytes = path.toUtf8();
+    LIBSSH2_SFTP_ATTRIBUTES attrs;
+    int                     rc = 0;
+    while ((rc = libssh2_sftp_stat(m_sftp, pathBytes.constData(), &attrs)) == LIBSSH2_ERROR_EAGAIN) {
+        if (!waitReady()) {
+            setError(QStringLiteral("Timed out statting %1").arg(path), errorMessage);
+            return false;
+        }
+    }
+    if (rc != 0) {
+        setError(QStringLiteral("SFTP stat failed: %1").arg(path), errorMessage);
+        return false;
+    }
+    if (entry != nullptr) {
+        *entry      = Entry{};
+        entry->name = path.section(QLatin1Char('/'), -1);
+        if ((attrs.flags & LIBSSH2_SFTP_ATTR_SIZE) != 0) {
+            entry->size = static_cast<qint64>(attrs.filesize);
+        }
+        if ((attrs.flags & LIBSSH2_SFTP_ATTR_ACMODTIME) != 0) {
+            entry->mtime = static_cast<qint64>(attrs.mtime);
+        }
+        if ((attrs.flags & LIBSSH2_SFTP_ATTR_PERMISSIONS) != 0) {
+            entry->isDirectory = LIBSSH2_SFTP_S_ISDIR(attrs.permissions);
+        }
+    }
+    return true;
+}
@@ -23,11 +23,12 @@ class QSocSshSession;
 class QSocSftpClient
 {
 public:
-    /** @brief Directory entry returned by `listDir`. */
+    /** @brief Directory entry returned by `listDir` and `stat`. */
     struct Entry
     {
         QString name;
         qint64  size        = 0;
+        qint64  mtime       = 0; /* seconds since epoch, 0 if not reported */
         bool    isDirectory = false;
         bool    isSymlink   = false;
     };
@@ -70,6 +71,9 @@ public:
     /** @brief Check whether a remote path exists (file or directory). */
     bool exists(const QString &path, QString *errorMessage = nullptr);
 
+    /** @brief Fetch size, mtime and type of a remote path without reading it. */
+    bool stat(const QString &path, Entry *entry, QString *errorMessage = nullptr);
+
     /** @brief Most recent error, user-safe for logs. */
     QString lastError() const { return m_lastError; }
 
@@ -21,7 +21,7 @@ bool QSocSshExec::waitReady()
     return QSocSshSession::waitSocket(m_session.socketFd(), m_session.rawSession(), 200) >= 0;
 }
 
-QSocSshExec::Result QSocSshExec::run(const QString &command, int timeoutMs)
+QSocSshExec::Result QSocSshExec::run(const QString &command, int timeoutMs, const Stream *stream)
 {
     Result result;
     m_abort.store(false, std::memory_order_relaxed);
@@ -33,17 +33,11 @@ QSocSshExec::Result QSocSshExec::run(const QString &command, int timeoutMs)
         return result;
     }
 
-    LIBSSH2_CHANNEL *channel = nullptr;
-    while ((channel = libssh2_channel_open_session(session)) == nullptr) {
-        const int err = libssh2_session_last_errno(session);
-        if (err != LIBSSH2_ERROR_EAGAIN) {
-            result.errorText = QStringLiteral("Failed to open exec channel");
-            return result;
-        }
-        if (!waitReady()) {
-            result.errorText = QStringLiteral("Timed out waiting to open channel");
-            return result;
-        }
+    const QSocSshSession::Operation operation(m_session, "exec");
+
+    LIBSSH2_CHANNEL *channel = m_session.takeChannel(&result.errorText);
+    if (channel == nullptr) {
+        return result;
     }
 
     const QByteArray cmdBytes = command.toUtf8();
@@ -77,13 +71,21 @@ QSocSshExec::Result QSocSshExec::run(const QString &command, int timeoutMs)
 
         const ssize_t nout = libssh2_channel_read(channel, buffer, sizeof(buffer));
         if (nout > 0) {
-            result.stdoutBytes.append(buffer, static_cast<int>(nout));
+            if (stream != nullptr && stream->onChunk) {
+                stream->onChunk(QByteArray(buffer, static_cast<qsizetype>(nout)), false);
+            } else {
+                result.stdoutBytes.append(buffer, static_cast<int>(nout));
+            }
             continue;
         }
 
         const ssize_t nerr = libssh2_channel_read_stderr(channel, buffer, sizeof(buffer));
         if (nerr > 0) {
-            result.stderrBytes.append(buffer, static_cast<int>(nerr));
+            if (stream != nullptr && stream->onChunk) {
+                stream->onChunk(QByteArray(buffer, static_cast<qsizetype>(nerr)), true);
+            } else {
+                result.stderrBytes.append(buffer, static_cast<int>(nerr));
+            }
             continue;
         }
 
@@ -91,11 +93,17 @@ QSocSshExec::Result QSocSshExec::run(const QString &command, int timeoutMs)
             if (libssh2_channel_eof(channel) != 0) {
                 break;
             }
+            if (stream != nullptr && stream->onIdle) {
+                stream->onIdle();
+            }
             waitReady();
             continue;
         }
 
         if (nout == LIBSSH2_ERROR_EAGAIN || nerr == LIBSSH2_ERROR_EAGAIN) {
+            if (stream != nullptr && stream->onIdle) {
+                stream->onIdle();
+            }
             waitReady();
             continue;
         }
@@ -10,13 +10,15 @@
 #include <QString>
 
 #include <atomic>
+#include <functional>
 
 class QSocSshSession;
 
 /**
  * @brief Runs a single shell command over an existing SSH session.
  * @details Opens a fresh channel per invocation, streams stdout and stderr
- *          into buffers, and waits for the remote process to exit or the
+ *          into buffers (or into a caller-supplied Stream as chunks
+ *          arrive), and waits for the remote process to exit or the
  *          per-call timeout to fire. `requestAbort()` is the recommended
  *          way to cancel a long-running command from another thread.
  */
@@ -34,6 +36,19 @@ public:
         QString    errorText;
     };
 
+    /**
+     * @brief Incremental delivery for `run()`.
+     * @details With a stream, output goes to onChunk as it is read and the
+     *          Result byte buffers stay empty. onIdle runs on the calling
+     *          thread whenever the channel has nothing to read, before the
+     *          socket wait; it may pump events or call requestAbort().
+     */
+    struct Stream
+    {
+        std::function<void(const QByteArray &chunk, bool isStderr)> onChunk;
+        std::function<void()>                                       onIdle;
+    };
+
     explicit QSocSshExec(QSocSshSession &session);
 
     /**
@@ -41,8 +56,9 @@ public:
      * @param command Shell command string passed straight to the remote
      *                shell. The caller owns any required escaping.
      * @param timeoutMs Per-call timeout. <=0 disables the timeout.
+     * @param stream Optional incremental sink; see Stream.
      */
-    Result run(const QString &command, int timeoutMs = 30000);
+    Result run(const QString &command, int timeoutMs = 30000, const Stream *stream = nullptr);
 
     /** @brief Flag a running `run()` call to stop reading and close channel. */
     void requestAbort();
@@ -11,6 +11,8 @@
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QRandomGenerator>
+#include <QTimer>
 
 #ifdef Q_OS_WIN
 #include <winsock2.h>
@@ -121,10 +123,35 @@ QString libssh2ErrorString(LIBSSH2_SESSION *session)
 
 } // namespace
 
+QSocSshSession::Operation::Operation(QSocSshSession &session, const char *name)
+    : m_session(session)
+    , m_name(name)
+{
+    /* A tunneled session's bytes ride on its ProxyJump parents, so they
+     * are busy too. */
+    for (QSocSshSession *hop = &m_session; hop != nullptr; hop = hop->m_parent) {
+        hop->m_busy++;
+    }
+    m_timer.start();
+}
+
+QSocSshSession::Operation::~Operation()
+{
+    for (QSocSshSession *hop = &m_session; hop != nullptr; hop = hop->m_parent) {
+        hop->m_busy--;
+    }
+    m_session.recordLatency(m_name, m_timer.elapsed());
+}
+
 QSocSshSession::QSocSshSession(QObject *parent)
     : QObject(parent)
+    , m_maintenance(new QTimer(this))
 {
     QSocLibSsh2Init::ensure();
+    /* Jitter the period so a jump chain and cached sub-agent sessions do
+     * not all wake (and probe the network) in lockstep. */
+    m_maintenance->setInterval(15000 + static_cast<int>(QRandomGenerator::global()->bounded(5000)));
+    connect(m_maintenance, &QTimer::timeout, this, &QSocSshSession::maintenanceTick);
 }
 
 QSocSshSession::~QSocSshSession()
@@ -169,8 +196,113 @@ void QSocSshSession::setError(const QString &msg)
     m_lastError = msg;
 }
 
+void QSocSshSession::recordLatency(const char *name, qint64 elapsedMs)
+{
+    OpStats &stats = m_latency[QString::fromLatin1(name)];
+    stats.count++;
+    stats.totalMs += elapsedMs;
+    stats.maxMs = qMax(stats.maxMs, elapsedMs);
+}
+
+void QSocSshSession::setChannelPoolSize(int size)
+{
+    m_poolSize = qMax(0, size);
+    while (m_warmChannels.size() > m_poolSize) {
+        libssh2_channel_free(m_warmChannels.takeLast());
+    }
+}
+
+LIBSSH2_CHANNEL *QSocSshSession::takeChannel(QString *errorMessage)
+{
+    if (m_session == nullptr) {
+        if (errorMessage != nullptr) {
+            *errorMessage = QStringLiteral("SSH session is not connected");
+        }
+        return nullptr;
+    }
+    if (!m_warmChannels.isEmpty()) {
+        return m_warmChannels.takeFirst();
+    }
+    const Operation  operation(*this, "channel_open");
+    LIBSSH2_CHANNEL *channel = nullptr;
+    while ((channel = libssh2_channel_open_session(m_session)) == nullptr) {
+        if (libssh2_session_last_errno(m_session) != LIBSSH2_ERROR_EAGAIN) {
+            if (errorMessage != nullptr) {
+                *errorMessage = QStringLiteral("Failed to open exec channel");
+            }
+            return nullptr;
+        }
+        if (waitSocket(m_socket, m_session, 200) < 0) {
+            if (errorMessage != nullptr) {
+                *errorMessage = QStringLiteral("Timed out waiting to open channel");
+            }
+            return nullptr;
+        }
+    }
+    return channel;
+}
+
+void QSocSshSession::prewarmChannels()
+{
+    if (m_session == nullptr || !m_healthy || m_busy > 0) {
+        return;
+    }
+    while (m_warmChannels.size() < m_poolSize) {
+        LIBSSH2_CHANNEL *channel = takeChannel();
+        if (channel == nullptr) {
+            return;
+        }
+        m_warmChannels.append(channel);
+    }
+}
+
+void QSocSshSession::setMaintenanceInterval(int intervalMs)
+{
+    m_maintenance->setInterval(qMax(1, intervalMs));
+}
+
+void QSocSshSession::startMaintenance()
+{
+    m_healthy           = true;
+    m_keepaliveFailures = 0;
+    m_latency.clear();
+    m_maintenance->start();
+    prewarmChannels();
+}
+
+void QSocSshSession::maintenanceTick()
+{
+    if (m_session == nullptr) {
+        m_maintenance->stop();
+        return;
+    }
+    /* A tick can land inside a nested event loop while an exec or SFTP
+     * call is mid-flight; leave the transport to that call. */
+    if (m_busy > 0) {
+        return;
+    }
+    int       nextSeconds = 0;
+    const int rc          = libssh2_keepalive_send(m_session, &nextSeconds);
+    if (rc == 0 || rc == LIBSSH2_ERROR_EAGAIN) {
+        m_keepaliveFailures = 0;
+        prewarmChannels();
+        return;
+    }
+    if (++m_keepaliveFailures >= 3) {
+        setError(QStringLiteral("SSH keepalive failed: %1").arg(libssh2ErrorString(m_session)));
+        m_healthy = false;
+        m_maintenance->stop();
+        emit connectionLost();
+    }
+}
+
 void QSocSshSession::clearConnection()
 {
+    m_maintenance->stop();
+    for (LIBSSH2_CHANNEL *channel : std::as_const(m_warmChannels)) {
+        libssh2_channel_free(channel);
+    }
+    m_warmChannels.clear();
     if (m_session != nullptr) {
         libssh2_session_disconnect(m_session, "QSoC shutting down session");
         libssh2_session_free(m_session);
@@ -652,6 +784,7 @@ QSocSshSession::ConnectStatus QSocSshSession::connectTo(
         return status;
     }
 
+    startMaintenance();
     return ConnectStatus::Ok;
 }
 
@@ -775,6 +908,7 @@ QSocSshSession::ConnectStatus QSocSshSession::connectToVia(
         clearConnection();
         return status;
     }
+    startMaintenance();
     return ConnectStatus::Ok;
 }
 
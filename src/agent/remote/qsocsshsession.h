@@ -9,15 +9,26 @@
 #include <libssh2.h>
 
 #include <functional>
+#include <QElapsedTimer>
+#include <QList>
+#include <QMap>
 #include <QObject>
 #include <QString>
 
+class QTimer;
+
 /**
  * @brief libssh2 session with TCP socket, known_hosts check, and auth chain.
  * @details Never reads SSH private key contents. IdentityFile paths are
  *          handed to `libssh2_userauth_publickey_fromfile_ex` which performs
  *          the file read inside the library. ssh-agent authentication is
  *          tried first when available.
+ *
+ *          Once connected, a maintenance timer sends keepalives and keeps
+ *          a small pool of already-opened session channels warm, so exec
+ *          calls skip the channel-open round trip. Both only run while no
+ *          Operation is in flight. Exec and SFTP calls share the session
+ *          by interleaving non-blocking channels on the owning thread.
  */
 class QSocSshSession : public QObject
 {
@@ -36,6 +47,35 @@ public:
         Timeout,
     };
 
+    /** @brief Latency totals for one kind of remote operation. */
+    struct OpStats
+    {
+        qint64 count   = 0;
+        qint64 totalMs = 0;
+        qint64 maxMs   = 0;
+    };
+
+    /**
+     * @brief Scope guard for one remote operation on this session.
+     * @details Marks the session busy, which holds back keepalives and
+     *          pool refills, and records the elapsed time under @p name
+     *          when the scope ends.
+     */
+    class Operation
+    {
+    public:
+        Operation(QSocSshSession &session, const char *name);
+        ~Operation();
+
+        Operation(const Operation &)            = delete;
+        Operation &operator=(const Operation &) = delete;
+
+    private:
+        QSocSshSession &m_session;
+        const char     *m_name;
+        QElapsedTimer   m_timer;
+    };
+
     explicit QSocSshSession(QObject *parent = nullptr);
     ~QSocSshSession() override;
 
@@ -104,6 +144,42 @@ public:
      */
     void setSecretCallback(SecretCallback callback);
 
+    /**
+     * @brief Take an opened session channel for one exec request.
+     * @details Served from the warm pool when possible, otherwise opened
+     *          on the spot. The caller owns the returned channel and frees
+     *          it; returns nullptr with @p errorMessage set on failure.
+     */
+    LIBSSH2_CHANNEL *takeChannel(QString *errorMessage = nullptr);
+
+    /** @brief Number of channels kept open ahead of use. 0 disables the pool. */
+    void setChannelPoolSize(int size);
+    int  warmChannelCount() const { return static_cast<int>(m_warmChannels.size()); }
+
+    /** @brief Open channels until the pool is full; skipped while busy. */
+    void prewarmChannels();
+
+    /**
+     * @brief Period of the keepalive and pool top-up tick.
+     * @details Defaults to a per-session jittered 15-20 s; takes effect
+     *          immediately when the session is already connected.
+     */
+    void setMaintenanceInterval(int intervalMs);
+
+    /** @brief Latency per operation name since connect. */
+    QMap<QString, OpStats> latencyStats() const { return m_latency; }
+
+    /** @brief False once keepalives failed repeatedly; reset by reconnecting. */
+    bool isHealthy() const { return m_healthy; }
+
+signals:
+    /**
+     * @brief Keepalives failed several times in a row.
+     * @details The session does not reconnect on its own; callers decide
+     *          whether to, so a flapping link cannot start a reconnect storm.
+     */
+    void connectionLost();
+
 private:
     ConnectStatus openSocket(const QString &host, int port, QString *errorMessage);
     ConnectStatus performHandshake(QString *errorMessage);
@@ -115,6 +191,9 @@ private:
 
     void clearConnection();
     void setError(const QString &msg);
+    void startMaintenance();
+    void maintenanceTick();
+    void recordLatency(const char *name, qint64 elapsedMs);
 
     /* libssh2 transport callbacks for ProxyJump tunneling. When a parent
      * channel is set, the child session's bytes ride on top of it instead
@@ -134,6 +213,14 @@ private:
     LIBSSH2_CHANNEL *m_parentChannel = nullptr;
     QString          m_lastError;
     SecretCallback   m_secretCallback;
+
+    QTimer                  *m_maintenance = nullptr;
+    QList<LIBSSH2_CHANNEL *> m_warmChannels;
+    int                      m_poolSize          = 2;
+    int                      m_busy              = 0;
+    int                      m_keepaliveFailures = 0;
+    bool                     m_healthy           = true;
+    QMap<QString, OpStats>   m_latency;
 };
 
 #endif // QSOCSSHSESSION_H
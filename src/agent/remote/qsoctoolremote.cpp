@@ -4,12 +4,15 @@
 #include "agent/remote/qsoctoolremote.h"
 
 #include "agent/qsocfilehistory.h"
+#include "agent/remote/qsocremotelister.h"
 #include "agent/remote/qsocremotepathcontext.h"
 #include "agent/remote/qsocsftpclient.h"
 #include "agent/remote/qsocsshexec.h"
 #include "agent/remote/qsocsshsession.h"
 
+#include <QCoreApplication>
 #include <QDateTime>
+#include <QElapsedTimer>
 #include <QString>
 #include <QStringList>
 
@@ -29,26 +32,116 @@ QString remoteResolve(QSocRemotePathContext *ctx, const QString &raw, bool *ok =
     return ctx->normalize(raw);
 }
 
+/* Single-quote a value for a remote POSIX shell. */
+QString shellEscape(const QString &value)
+{
+    QString result = QStringLiteral("'");
+    for (const QChar ch : value) {
+        if (ch == QLatin1Char('\'')) {
+            result += QStringLiteral("'\\''");
+        } else {
+            result += ch;
+        }
+    }
+    result += QLatin1Char('\'');
+    return result;
+}
+
 /* Wrap a user command for a remote POSIX shell running under bash -lc. */
 QString buildBashCommand(const QString &cwd, const QString &userCommand)
 {
-    auto shellEscape = [](const QString &value) {
-        QString result = QStringLiteral("'");
-        for (const QChar ch : value) {
-            if (ch == QLatin1Char('\'')) {
-                result += QStringLiteral("'\\''");
-            } else {
-                result += ch;
-            }
-        }
-        result += QLatin1Char('\'');
-        return result;
-    };
     const QString cwdEscaped = shellEscape(cwd);
     const QString cmdEscaped = shellEscape(userCommand);
     return QStringLiteral("cd %1 && /bin/bash -lc %2").arg(cwdEscaped, cmdEscaped);
 }
 
+/* Bounded capture of one output channel: the first headCap bytes and a
+ * tail ring of the last tailCap bytes, plus the total byte count. */
+class OutputWindow
+{
+public:
+    static constexpr qsizetype headCap = 20000;
+    static constexpr qsizetype tailCap = 30000;
+
+    void append(const QByteArray &chunk)
+    {
+        total += chunk.size();
+        qsizetype used = 0;
+        if (head.size() < headCap) {
+            used = qMin(headCap - head.size(), chunk.size());
+            head.append(chunk.constData(), used);
+        }
+        if (used < chunk.size()) {
+            tail.append(chunk.constData() + used, chunk.size() - used);
+            /* Trim in batches so the ring stays amortized O(1) per byte. */
+            if (tail.size() > 2 * tailCap) {
+                tail.remove(0, tail.size() - tailCap);
+            }
+        }
+    }
+
+    bool      isEmpty() const { return total == 0; }
+    bool      truncated() const { return total > head.size() + qMin(tail.size(), tailCap); }
+    qsizetype totalBytes() const { return total; }
+
+    QString render(const QString &spillHint) const
+    {
+        const QByteArray kept = tail.size() > tailCap ? tail.right(tailCap) : tail;
+        if (!truncated()) {
+            return QString::fromUtf8(head + kept);
+        }
+        const qint64 omitted = total - head.size() - kept.size();
+        QString      marker  = QStringLiteral("\n... (%1 bytes omitted").arg(omitted);
+        if (!spillHint.isEmpty()) {
+            marker += QStringLiteral("; full output via ") + spillHint;
+        }
+        marker += QStringLiteral(")\n");
+        return QString::fromUtf8(head) + marker + QString::fromUtf8(kept);
+    }
+
+private:
+    QByteArray head;
+    QByteArray tail;
+    qint64     total = 0;
+};
+
+/* Foreground spill directories kept under the jobs root; older ones go. */
+constexpr int kMaxForegroundSpills = 20;
+
+/* Run a wrapped command while the host tees both streams into a job
+ * directory that bash_manage can page. Each stream has its own result
+ * window, so the host counts them apart and drops the directory itself
+ * when neither would be truncated. Without a usable
+ * directory the command runs unspilled. The command text goes in with one
+ * multi-arg call so a '%N' inside it is never substituted. */
+QString buildSpillCommand(const QString &jobsRoot, const QString &jobDir, const QString &wrapped)
+{
+    const QString dir   = shellEscape(jobDir);
+    const QString log   = shellEscape(jobDir + QStringLiteral("/output.log"));
+    const QString spill = QStringLiteral(
+                              "date +%s > %1/start_time; "
+                              "{ { %3; printf %d $? > %1/exit_code; } 2>&1 1>&3 "
+                              "| tee -a %2 %1/stderr 1>&2; } 3>&1 | tee -a %2 %1/stdout; "
+                              "rc=$(cat %1/exit_code 2>/dev/null || echo 1); "
+                              "[ \"$(wc -c < %1/stdout)\" -le %4 ] "
+                              "&& [ \"$(wc -c < %1/stderr)\" -le %4 ] && rm -rf %1; "
+                              "rm -f %1/stdout %1/stderr; "
+                              "exit \"$rc\"")
+                              .arg(
+                                  dir,
+                                  log,
+                                  wrapped,
+                                  QString::number(OutputWindow::headCap + OutputWindow::tailCap));
+    const QString prune = QStringLiteral(
+                              "ls -1dt %1/fg-* 2>/dev/null | tail -n +%2 "
+                              "| while IFS= read -r old; do rm -rf \"$old\"; done; ")
+                              .arg(shellEscape(jobsRoot))
+                              .arg(kMaxForegroundSpills);
+    return prune
+           + QStringLiteral("if mkdir -p %1 2>/dev/null; then %2; else %3; fi")
+                 .arg(dir, spill, wrapped);
+}
+
 } // namespace
 
 /* read_file */
@@ -257,11 +350,20 @@ QString QSocToolRemoteFileWrite::execute(const json &arguments)
 /* list_files */
 
 QSocToolRemoteFileList::QSocToolRemoteFileList(
-    QObject *parent, QSocSftpClient *sftp, QSocRemotePathContext *pathCtx)
+    QObject               *parent,
+    QSocSftpClient        *sftp,
+    QSocRemotePathContext *pathCtx,
+    QSocSshSession        *session)
     : QSocTool(parent)
     , m_sftp(sftp)
     , m_pathCtx(pathCtx)
-{}
+{
+    if (session != nullptr) {
+        m_lister = std::make_unique<QSocRemoteLister>(session);
+    }
+}
+
+QSocToolRemoteFileList::~QSocToolRemoteFileList() = default;
 
 QString QSocToolRemoteFileList::getName() const
 {
@@ -270,7 +372,9 @@ QString QSocToolRemoteFileList::getName() const
 
 QString QSocToolRemoteFileList::getDescription() const
 {
-    return QStringLiteral("List files in a remote directory via SFTP.");
+    return QStringLiteral(
+        "List files in a remote directory. Set max_depth to recurse and pattern to "
+        "search by file name; the whole listing runs as one command on the host.");
 }
 
 json QSocToolRemoteFileList::getParametersSchema() const
@@ -282,7 +386,14 @@ json QSocToolRemoteFileList::getParametersSchema() const
            {{"type", "string"},
             {"description", "Remote directory path (absolute or relative to cwd)"}}},
           {"limit",
-           {{"type", "integer"}, {"description", "Maximum number of entries (default 200)"}}}}},
+           {{"type", "integer"}, {"description", "Maximum number of entries (default 200)"}}},
+          {"max_depth",
+           {{"type", "integer"},
+            {"description", "Levels to descend: 1 lists the directory itself (default), 0 is "
+                            "unlimited"}}},
+          {"pattern",
+           {{"type", "string"},
+            {"description", "Shell glob matched against file names, e.g. \"*.sv\""}}}}},
         {"required", json::array({"directory_path"})}};
 }
 
@@ -297,9 +408,6 @@ QString QSocToolRemoteFileList::execute(const json &arguments)
     if (!ok) {
         return QStringLiteral("Error: remote path context is not configured");
     }
-    if (m_sftp == nullptr) {
-        return QStringLiteral("Error: remote SFTP client is not connected");
-    }
     int limit = 200;
     if (arguments.contains("limit") && arguments["limit"].is_number_integer()) {
         limit = arguments["limit"].get<int>();
@@ -307,7 +415,45 @@ QString QSocToolRemoteFileList::execute(const json &arguments)
             limit = 200;
         }
     }
-    QString    err;
+    int maxDepth = 1;
+    if (arguments.contains("max_depth") && arguments["max_depth"].is_number_integer()) {
+        maxDepth = qMax(0, arguments["max_depth"].get<int>());
+    }
+    const QString pattern = arguments.contains("pattern") && arguments["pattern"].is_string()
+                                ? QString::fromStdString(arguments["pattern"].get<std::string>())
+                                : QString();
+
+    QString err;
+    if (m_lister != nullptr) {
+        QSocRemoteLister::Query query;
+        query.root        = remotePath;
+        query.maxDepth    = maxDepth;
+        query.limit       = limit;
+        query.namePattern = pattern;
+        QSocRemoteLister::Listing listing;
+        if (m_lister->list(query, &listing, &err)) {
+            QString out = QStringLiteral("Remote directory: %1\n").arg(remotePath);
+            for (const auto &entry : listing.entries) {
+                out += QStringLiteral("%1 %2 %3\n")
+                           .arg(entry.isDirectory ? QStringLiteral("d") : QStringLiteral("-"))
+                           .arg(entry.size, 10)
+                           .arg(entry.path);
+            }
+            if (listing.truncated) {
+                out += QStringLiteral("... (truncated at %1 entries)\n").arg(limit);
+            }
+            return out;
+        }
+        /* Only a plain one-level listing has an SFTP equivalent. */
+        if (maxDepth != 1 || !pattern.isEmpty()) {
+            return QStringLiteral("Error: %1").arg(err);
+        }
+        err.clear();
+    }
+    if (m_sftp == nullptr) {
+        return QStringLiteral("Error: remote SFTP client is not connected");
+    }
+
     const auto entries = m_sftp->listDir(remotePath, limit, &err);
     if (entries.isEmpty() && !err.isEmpty()) {
         return QStringLiteral("Error: %1").arg(err);
@@ -528,10 +674,70 @@ QString QSocToolRemoteShellBash::execute(const json &arguments)
 
     const QString wrapped = buildBashCommand(cwd, cmd);
 
-    QSocSshExec exec(*m_session);
-    m_running         = &exec;
-    const auto result = exec.run(wrapped, timeoutMs);
-    m_running         = nullptr;
+    /* Stream output as it arrives into a bounded head/tail window per
+     * channel, and report the latest complete line to the tool block. The
+     * host keeps the full output in a foreground job directory, so a
+     * truncated result can be paged with bash_manage. The exec stays on
+     * this thread (the SSH session is not thread safe); idle waits pump
+     * events so the progress lines render and cancellation is seen. */
+    QString spillJobId;
+    QString spillCommand = wrapped;
+    if (m_pathCtx != nullptr && !m_pathCtx->root().isEmpty()) {
+        const QString jobsRoot = m_pathCtx->root() + QStringLiteral("/.qsoc-agent/jobs");
+        spillJobId   = QStringLiteral("fg-") + QString::number(QDateTime::currentMSecsSinceEpoch());
+        spillCommand = buildSpillCommand(
+            jobsRoot, jobsRoot + QLatin1Char('/') + spillJobId, wrapped);
+    }
+
+    QSocToolCallContext *call = currentCallContext();
+    OutputWindow         stdoutWindow;
+    OutputWindow         stderrWindow;
+    QByteArray           pendingLine;
+    QString              lastReported;
+    QElapsedTimer        progressClock;
+    progressClock.start();
+
+    QSocSshExec         exec(*m_session);
+    QSocSshExec::Stream stream;
+    stream.onChunk = [&](const QByteArray &chunk, bool isStderr) {
+        (isStderr ? stderrWindow : stdoutWindow).append(chunk);
+        pendingLine.append(chunk);
+        const qsizetype lastNewline = pendingLine.lastIndexOf('\n');
+        if (lastNewline < 0) {
+            if (pendingLine.size() > 4096) {
+                pendingLine = pendingLine.right(4096);
+            }
+            return;
+        }
+        const qsizetype prevNewline = pendingLine.lastIndexOf('\n', lastNewline - 1);
+        const QByteArray line = pendingLine.mid(prevNewline + 1, lastNewline - prevNewline - 1);
+        if (!line.trimmed().isEmpty()) {
+            lastReported = QString::fromUtf8(line).trimmed().left(200);
+        }
+        pendingLine.remove(0, lastNewline + 1);
+    };
+    stream.onIdle = [&]() {
+        if (call != nullptr && !lastReported.isEmpty() && progressClock.elapsed() >= 250) {
+            call->reportProgress(lastReported);
+            lastReported.clear();
+            progressClock.restart();
+        }
+        QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+        if (call != nullptr && call->isCancellationRequested()) {
+            exec.requestAbort();
+        }
+    };
+
+    QSocSshExec *outer = m_running;
+    m_running          = &exec;
+    const auto result  = exec.run(spillCommand, timeoutMs, &stream);
+    m_running          = outer;
+
+    const bool    truncated = stdoutWindow.truncated() || stderrWindow.truncated();
+    const QString spillHint = spillJobId.isEmpty()
+                                  ? QString()
+                                  : QStringLiteral("bash_manage job_id=%1 action=output offset=0")
+                                        .arg(spillJobId);
 
     QString out;
     out += QStringLiteral("exit_code: %1\n").arg(result.exitCode);
@@ -541,18 +747,21 @@ QString QSocToolRemoteShellBash::execute(const json &arguments)
     if (result.aborted) {
         out += QStringLiteral("aborted: true\n");
     }
-    if (!result.stdoutBytes.isEmpty()) {
-        out += QStringLiteral("stdout:\n") + QString::fromUtf8(result.stdoutBytes);
+    if (!stdoutWindow.isEmpty()) {
+        out += QStringLiteral("stdout:\n") + stdoutWindow.render(spillHint);
         if (!out.endsWith(QLatin1Char('\n'))) {
             out += QLatin1Char('\n');
         }
     }
-    if (!result.stderrBytes.isEmpty()) {
-        out += QStringLiteral("stderr:\n") + QString::fromUtf8(result.stderrBytes);
+    if (!stderrWindow.isEmpty()) {
+        out += QStringLiteral("stderr:\n") + stderrWindow.render(spillHint);
         if (!out.endsWith(QLatin1Char('\n'))) {
             out += QLatin1Char('\n');
         }
     }
+    if (truncated && !spillJobId.isEmpty()) {
+        out += QStringLiteral("job_id: ") + spillJobId + QLatin1Char('\n');
+    }
     if (!result.errorText.isEmpty()) {
         out += QStringLiteral("error: ") + result.errorText + QLatin1Char('\n');
     }
@@ -642,7 +851,8 @@ QString QSocToolRemoteBashManage::getDescription() const
 {
     return QStringLiteral(
         "Manage a backgrounded remote command by job_id from bash(background=true). "
-        "Actions: status, output, terminate (SIGTERM), kill (SIGKILL).");
+        "Actions: status, output, terminate (SIGTERM), kill (SIGKILL). "
+        "Poll output incrementally with offset=next_offset from the previous read.");
 }
 
 json QSocToolRemoteBashManage::getParametersSchema() const
@@ -658,7 +868,15 @@ json QSocToolRemoteBashManage::getParametersSchema() const
             {"description", "status / output / terminate / kill"}}},
           {"max_lines",
            {{"type", "integer"},
-            {"description", "Max output lines to return for action=output (default 200)"}}}}},
+            {"description", "Max output lines to return for action=output (default 200)"}}},
+          {"offset",
+           {{"type", "integer"},
+            {"description",
+             "Byte offset into output.log for action=output; returns the bytes from there "
+             "and next_offset to poll with. Omit for the last max_lines lines."}}},
+          {"max_bytes",
+           {{"type", "integer"},
+            {"description", "Max bytes per offset read (default 65536)"}}}}},
         {"required", json::array({"job_id", "action"})}};
 }
 
@@ -711,6 +929,34 @@ QString QSocToolRemoteBashManage::execute(const json &arguments)
                       ? QString()
                       : QStringLiteral("stderr:\n") + QString::fromUtf8(result.stderrBytes));
     }
+    if (action == QStringLiteral("output") && arguments.contains("offset")
+        && arguments["offset"].is_number_integer()) {
+        /* Incremental tail: read only the bytes past the caller's offset on
+         * the remote side, so polling a growing log costs what is new. */
+        const qint64 offset   = qMax<qint64>(0, arguments["offset"].get<qint64>());
+        qint64       maxBytes = 65536;
+        if (arguments.contains("max_bytes") && arguments["max_bytes"].is_number_integer()) {
+            maxBytes = arguments["max_bytes"].get<qint64>();
+            if (maxBytes <= 0) {
+                maxBytes = 65536;
+            }
+        }
+        const QString script = QStringLiteral(
+                                   "tail -c +%1 %2/output.log 2>/dev/null | head -c %3; "
+                                   "stat -c%s %2/output.log >&2 2>/dev/null || true")
+                                   .arg(offset + 1)
+                                   .arg(jobDir)
+                                   .arg(maxBytes);
+        const auto   result = runShell(script, 10000);
+        const qint64 size   = QString::fromUtf8(result.stderrBytes).trimmed().toLongLong();
+        const qint64 next   = offset + result.stdoutBytes.size();
+        QString      out    = QStringLiteral("next_offset: %1\n").arg(next);
+        out += QStringLiteral("output_bytes: %1\n").arg(qMax(size, next));
+        if (!result.stdoutBytes.isEmpty()) {
+            out += QStringLiteral("output:\n") + QString::fromUtf8(result.stdoutBytes);
+        }
+        return out;
+    }
     if (action == QStringLiteral("output")) {
         int maxLines = 200;
         if (arguments.contains("max_lines") && arguments["max_lines"].is_number_integer()) {
@@ -6,6 +6,9 @@
 
 #include "agent/qsoctool.h"
 
+#include <memory>
+
+class QSocRemoteLister;
 class QSocSftpClient;
 class QSocSshSession;
 class QSocSshExec;
@@ -57,13 +60,24 @@ private:
     QSocFileHistory       *m_fileHistory = nullptr;
 };
 
-/** @brief Remote list_files via SFTP opendir/readdir. */
+/**
+ * @brief Remote list_files: one host-side `find` per listing or search.
+ * @details Uses QSocRemoteLister when a session is given, so deep listings
+ *          and name searches cost one exec and repeat calls are served from
+ *          a stamp-validated cache. Falls back to SFTP opendir/readdir for
+ *          a plain one-level listing when the host `find` is not GNU.
+ */
 class QSocToolRemoteFileList : public QSocTool
 {
     Q_OBJECT
 
 public:
-    QSocToolRemoteFileList(QObject *parent, QSocSftpClient *sftp, QSocRemotePathContext *pathCtx);
+    QSocToolRemoteFileList(
+        QObject               *parent,
+        QSocSftpClient        *sftp,
+        QSocRemotePathContext *pathCtx,
+        QSocSshSession        *session = nullptr);
+    ~QSocToolRemoteFileList() override;
 
     QString getName() const override;
     QString getDescription() const override;
@@ -72,8 +86,9 @@ public:
     bool    isReadOnly() const override { return true; }
 
 private:
-    QSocSftpClient        *m_sftp    = nullptr;
-    QSocRemotePathContext *m_pathCtx = nullptr;
+    QSocSftpClient                   *m_sftp    = nullptr;
+    QSocRemotePathContext            *m_pathCtx = nullptr;
+    std::unique_ptr<QSocRemoteLister> m_lister;
 };
 
 /** @brief Remote edit_file: read, replace, atomically write back. */
@@ -23,6 +23,7 @@
 #include <QPointer>
 #include <QProcess>
 #include <QStandardPaths>
+#include <QThread>
 #include <QTimer>
 
 QSocToolAgent::QSocToolAgent(
@@ -575,7 +576,29 @@ QString QSocToolAgent::execute(const json &arguments)
      * judge is a separate member, so hand it down too: a read-only
      * exploration child judges its own bash the same way. */
     if (childCfg.planMode && parentAgent_ != nullptr) {
-        child->setBashSafetyJudge(parentAgent_->bashSafetyJudge());
+        const QSocBashSafetyJudge judge = parentAgent_->bashSafetyJudge();
+        if (judge && taskSource_->threadedRuns()) {
+            /* The judge drives the parent's LLM service, which lives on
+             * the parent's thread; a threaded child asks over there. */
+            const QPointer<QSocAgent> judgeHost(parentAgent_);
+            child->setBashSafetyJudge([judgeHost, judge](const QString &command) {
+                QSocBashSafety verdict;
+                verdict.reason = QStringLiteral("parent agent is gone");
+                if (judgeHost.isNull()) {
+                    return verdict;
+                }
+                if (QThread::currentThread() == judgeHost->thread()) {
+                    return judge(command);
+                }
+                QMetaObject::invokeMethod(
+                    judgeHost.data(),
+                    [&verdict, &judge, &command]() { verdict = judge(command); },
+                    Qt::BlockingQueuedConnection);
+                return verdict;
+            });
+        } else {
+            child->setBashSafetyJudge(judge);
+        }
     }
     /* def is null in fork mode; a fork inherits the parent context and
      * never opts into memory injection, so guard the deref. */
@@ -911,9 +934,10 @@ QString QSocToolAgent::execute(const json &arguments)
     autoBg.stop();
 
     if (*backgrounded) {
-        /* Timed out: the child keeps running on the parent's event
-         * loop. Its terminal state arrives later as a task
-         * notification via the persistent handlers. */
+        /* Timed out: the child keeps running (on its own thread when
+         * the source threads runs, else on the parent's event loop).
+         * Its terminal state arrives later as a task notification via
+         * the persistent handlers. */
         return QString::fromUtf8(launchedResponse.dump().c_str());
     }
 
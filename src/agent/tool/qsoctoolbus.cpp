@@ -3,8 +3,11 @@
 
 #include "agent/tool/qsoctoolbus.h"
 
+#include "common/qsocconsole.h"
 #include "common/qstaticdatasedes.h"
 
+#include <memory>
+#include <QFileInfo>
 #include <QRegularExpression>
 
 /* QSocToolBusList Implementation */
@@ -213,21 +216,27 @@ json QSocToolBusImport::getParametersSchema() const
 
 QString QSocToolBusImport::execute(const json &arguments)
 {
-    if (!busManager) {
-        return "Error: Bus manager not configured";
+    return executeBlocking(arguments);
+}
+
+void QSocToolBusImport::executeAsync(
+    const json &arguments, QSocToolCallContext *call, const ResultCallback &done)
+{
+    if (!busManager || !busManager->getProjectManager()) {
+        return done("Error: Bus manager not configured");
     }
 
     if (!arguments.contains("files") || !arguments["files"].is_array()
         || arguments["files"].empty()) {
-        return "Error: At least one CSV file path is required";
+        return done("Error: At least one CSV file path is required");
     }
 
     if (!arguments.contains("library_name") || !arguments["library_name"].is_string()) {
-        return "Error: library_name is required";
+        return done("Error: library_name is required");
     }
 
     if (!arguments.contains("bus_name") || !arguments["bus_name"].is_string()) {
-        return "Error: bus_name is required";
+        return done("Error: bus_name is required");
     }
 
     /* Get file paths */
@@ -239,26 +248,65 @@ QString QSocToolBusImport::execute(const json &arguments)
     }
 
     if (filePaths.isEmpty()) {
-        return "Error: No valid file paths provided";
+        return done("Error: No valid file paths provided");
     }
 
     QString libraryName = QString::fromStdString(arguments["library_name"].get<std::string>());
     QString busName     = QString::fromStdString(arguments["bus_name"].get<std::string>());
-
-    /* Import from file list */
-    if (!busManager->importFromFileList(libraryName, busName, filePaths)) {
-        return QString("Error: Failed to import bus '%1' from file(s)").arg(busName);
+    if (libraryName.isEmpty() || busName.isEmpty()) {
+        return done("Error: library_name and bus_name must not be empty");
     }
 
-    /* Save the library */
-    if (!busManager->save(libraryName)) {
-        return QString("Warning: Imported bus '%1' but failed to save library '%2'")
-            .arg(busName, libraryName);
-    }
+    /* Import on a worker with a private bus manager; the import merges
+     * into the library file on disk */
+    auto project = std::make_shared<QSocProjectManager>();
+    project->copyFrom(*busManager->getProjectManager());
+    WorkerBody body = [project, filePaths, libraryName, busName](
+                          const QSocToolWorker &worker) -> QString {
+        QSocBusManager importer(nullptr, project.get());
+
+        /* Same steps as importFromFileList(), one file at a time */
+        QList<QSocBusSignalMode> rows;
+        QStringList              warnings;
+        for (const QString &filePath : filePaths) {
+            if (worker.isCancelled()) {
+                return "Error: Operation cancelled";
+            }
+            worker.progress(QString("Reading %1").arg(QFileInfo(filePath).fileName()));
+            rows.append(importer.parseBusCsvFiles({filePath}, &warnings));
+        }
+        for (const QString &warning : std::as_const(warnings)) {
+            QSocConsole::warn() << warning;
+        }
+        if (worker.isCancelled()) {
+            return "Error: Operation cancelled";
+        }
 
-    return QString("Successfully imported bus '%1' to library '%2' from %3 file(s).")
-        .arg(busName, libraryName)
-        .arg(filePaths.size());
+        if (!importer.saveLibraryYaml(libraryName, importer.rowsToBusYaml(busName, rows))) {
+            return QString("Error: Failed to import bus '%1' from file(s)").arg(busName);
+        }
+        return {};
+    };
+
+    /* Refresh the shared copy of the library from disk */
+    const QPointer<QSocToolBusImport> self(this);
+    const qsizetype                   fileCount = filePaths.size();
+    runOnWorker(
+        std::move(body),
+        call,
+        [self, libraryName, busName, fileCount, done](const QString &result) {
+            if (!result.isEmpty()) {
+                return done(result);
+            }
+            if (self.isNull() || !self->busManager || !self->busManager->load(libraryName)) {
+                return done(
+                    QString("Warning: Imported bus '%1' but failed to reload library '%2'")
+                        .arg(busName, libraryName));
+            }
+            done(QString("Successfully imported bus '%1' to library '%2' from %3 file(s).")
+                     .arg(busName, libraryName)
+                     .arg(fileCount));
+        });
 }
 
 void QSocToolBusImport::setBusManager(QSocBusManager *busManager)
@@ -71,7 +71,7 @@ QString QSocToolDocQuery::execute(const json &arguments)
             .arg(topic, getAvailableTopics().join(", "));
     }
 
-    QString content = readDocumentation(topicMap_[topic]);
+    QString content = readDocumentation(topicMap_.value(topic));
     if (content.isEmpty()) {
         return QString("Error: Failed to read documentation for topic '%1'").arg(topic);
     }
@@ -24,6 +24,7 @@ public:
     json    getParametersSchema() const override;
     QString execute(const json &arguments) override;
     bool    isReadOnly() const override { return true; }
+    bool    isThreadSafe() const override { return true; }
 
 private:
     /**
@@ -3,7 +3,13 @@
 
 #include "agent/tool/qsoctoolgenerate.h"
 
+#include "common/qsocbusmanager.h"
+#include "common/qsocmodulemanager.h"
+#include "common/qsocprojectmanager.h"
+
+#include <memory>
 #include <QFileInfo>
+#include <QRegularExpression>
 
 /* QSocToolGenerateVerilog Implementation */
 
@@ -44,16 +50,22 @@ json QSocToolGenerateVerilog::getParametersSchema() const
 
 QString QSocToolGenerateVerilog::execute(const json &arguments)
 {
-    if (!generateManager) {
-        return "Error: Generate manager not configured";
+    return executeBlocking(arguments);
+}
+
+void QSocToolGenerateVerilog::executeAsync(
+    const json &arguments, QSocToolCallContext *call, const ResultCallback &done)
+{
+    if (!generateManager || !generateManager->getProjectManager()) {
+        return done("Error: Generate manager not configured");
     }
 
     if (!arguments.contains("netlist_file") || !arguments["netlist_file"].is_string()) {
-        return "Error: netlist_file is required";
+        return done("Error: netlist_file is required");
     }
 
     if (!arguments.contains("output_name") || !arguments["output_name"].is_string()) {
-        return "Error: output_name is required";
+        return done("Error: output_name is required");
     }
 
     QString netlistFile = QString::fromStdString(arguments["netlist_file"].get<std::string>());
@@ -62,30 +74,57 @@ QString QSocToolGenerateVerilog::execute(const json &arguments)
     /* Check if netlist file exists */
     QFileInfo fileInfo(netlistFile);
     if (!fileInfo.exists()) {
-        return QString("Error: Netlist file not found: %1").arg(netlistFile);
+        return done(QString("Error: Netlist file not found: %1").arg(netlistFile));
     }
 
-    /* Set force overwrite if specified */
-    if (arguments.contains("force") && arguments["force"].is_boolean()) {
-        generateManager->setForceOverwrite(arguments["force"].get<bool>());
-    }
+    const bool force = arguments.contains("force") && arguments["force"].is_boolean()
+                       && arguments["force"].get<bool>();
+
+    /* Generation runs on a worker with private managers, like a CLI run */
+    auto project = std::make_shared<QSocProjectManager>();
+    project->copyFrom(*generateManager->getProjectManager());
+    WorkerBody body = [project, netlistFile, outputName, force](
+                          const QSocToolWorker &worker) -> QString {
+        QSocBusManager      busManager(nullptr, project.get());
+        QSocModuleManager   moduleManager(nullptr, project.get(), &busManager);
+        QSocGenerateManager generator(nullptr, project.get(), &moduleManager, &busManager);
+        generator.setForceOverwrite(force);
+
+        worker.progress("Loading module and bus libraries");
+        if (!moduleManager.load(QRegularExpression(".*"))) {
+            return "Error: Failed to load module libraries";
+        }
+        if (!busManager.load(QRegularExpression(".*"))) {
+            return "Error: Failed to load bus libraries";
+        }
+        if (worker.isCancelled()) {
+            return "Error: Operation cancelled";
+        }
 
-    /* Load netlist */
-    if (!generateManager->loadNetlist(netlistFile)) {
-        return QString("Error: Failed to load netlist file: %1").arg(netlistFile);
-    }
+        worker.progress(QString("Loading netlist %1").arg(netlistFile));
+        if (!generator.loadNetlist(netlistFile)) {
+            return QString("Error: Failed to load netlist file: %1").arg(netlistFile);
+        }
+        if (worker.isCancelled()) {
+            return "Error: Operation cancelled";
+        }
 
-    /* Process netlist */
-    if (!generateManager->processNetlist()) {
-        return "Error: Failed to process netlist";
-    }
+        worker.progress("Processing netlist");
+        if (!generator.processNetlist()) {
+            return "Error: Failed to process netlist";
+        }
+        if (worker.isCancelled()) {
+            return "Error: Operation cancelled";
+        }
 
-    /* Generate Verilog */
-    if (!generateManager->generateVerilog(outputName)) {
-        return QString("Error: Failed to generate Verilog for: %1").arg(outputName);
-    }
+        worker.progress(QString("Writing %1.v").arg(outputName));
+        if (!generator.generateVerilog(outputName)) {
+            return QString("Error: Failed to generate Verilog for: %1").arg(outputName);
+        }
 
-    return QString("Successfully generated Verilog: %1.v").arg(outputName);
+        return QString("Successfully generated Verilog: %1.v").arg(outputName);
+    };
+    runOnWorker(std::move(body), call, done);
 }
 
 void QSocToolGenerateVerilog::setGenerateManager(QSocGenerateManager *generateManager)
@@ -148,16 +187,22 @@ json QSocToolGenerateTemplate::getParametersSchema() const
 
 QString QSocToolGenerateTemplate::execute(const json &arguments)
 {
-    if (!generateManager) {
-        return "Error: Generate manager not configured";
+    return executeBlocking(arguments);
+}
+
+void QSocToolGenerateTemplate::executeAsync(
+    const json &arguments, QSocToolCallContext *call, const ResultCallback &done)
+{
+    if (!generateManager || !generateManager->getProjectManager()) {
+        return done("Error: Generate manager not configured");
     }
 
     if (!arguments.contains("template_file") || !arguments["template_file"].is_string()) {
-        return "Error: template_file is required";
+        return done("Error: template_file is required");
     }
 
     if (!arguments.contains("output_name") || !arguments["output_name"].is_string()) {
-        return "Error: output_name is required";
+        return done("Error: output_name is required");
     }
 
     QString templateFile = QString::fromStdString(arguments["template_file"].get<std::string>());
@@ -166,7 +211,7 @@ QString QSocToolGenerateTemplate::execute(const json &arguments)
     /* Check if template file exists */
     QFileInfo fileInfo(templateFile);
     if (!fileInfo.exists()) {
-        return QString("Error: Template file not found: %1").arg(templateFile);
+        return done(QString("Error: Template file not found: %1").arg(templateFile));
     }
 
     /* Collect data files */
@@ -216,13 +261,32 @@ QString QSocToolGenerateTemplate::execute(const json &arguments)
         }
     }
 
-    /* Render template */
-    if (!generateManager->renderTemplate(
-            templateFile, csvFiles, yamlFiles, jsonFiles, rdlFiles, rcsvFiles, outputName)) {
-        return QString("Error: Failed to render template: %1").arg(templateFile);
-    }
+    /* Render on a worker with a private project copy and generator */
+    auto project = std::make_shared<QSocProjectManager>();
+    project->copyFrom(*generateManager->getProjectManager());
+    WorkerBody body = [project,
+                       templateFile,
+                       csvFiles,
+                       yamlFiles,
+                       jsonFiles,
+                       rdlFiles,
+                       rcsvFiles,
+                       outputName](const QSocToolWorker &worker) -> QString {
+        QSocGenerateManager generator(nullptr, project.get());
+        generator.setCancelCheck([&worker]() { return worker.isCancelled(); });
+
+        worker.progress(QString("Rendering %1").arg(templateFile));
+        if (!generator.renderTemplate(
+                templateFile, csvFiles, yamlFiles, jsonFiles, rdlFiles, rcsvFiles, outputName)) {
+            if (worker.isCancelled()) {
+                return "Error: Operation cancelled";
+            }
+            return QString("Error: Failed to render template: %1").arg(templateFile);
+        }
 
-    return QString("Successfully rendered template to: %1").arg(outputName);
+        return QString("Successfully rendered template to: %1").arg(outputName);
+    };
+    runOnWorker(std::move(body), call, done);
 }
 
 void QSocToolGenerateTemplate::setGenerateManager(QSocGenerateManager *generateManager)
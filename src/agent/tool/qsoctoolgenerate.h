@@ -23,6 +23,9 @@ public:
     QString getDescription() const override;
     json    getParametersSchema() const override;
     QString execute(const json &arguments) override;
+    bool    isAsync() const override { return true; }
+    void    executeAsync(
+        const json &arguments, QSocToolCallContext *call, const ResultCallback &done) override;
 
     void setGenerateManager(QSocGenerateManager *generateManager);
 
@@ -46,6 +49,9 @@ public:
     QString getDescription() const override;
     json    getParametersSchema() const override;
     QString execute(const json &arguments) override;
+    bool    isAsync() const override { return true; }
+    void    executeAsync(
+        const json &arguments, QSocToolCallContext *call, const ResultCallback &done) override;
 
     void setGenerateManager(QSocGenerateManager *generateManager);
 
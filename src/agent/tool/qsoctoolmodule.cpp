@@ -5,7 +5,9 @@
 
 #include "common/qstaticdatasedes.h"
 
+#include <memory>
 #include <QRegularExpression>
+#include <QScopeGuard>
 
 /* QSocToolModuleList Implementation */
 
@@ -175,6 +177,15 @@ void QSocToolModuleShow::setModuleManager(QSocModuleManager *moduleManager)
 
 /* QSocToolModuleImport Implementation */
 
+/* Managers kept across imports. They are built unparented on the pool
+ * thread of the first import and handle no events, so a later import may
+ * use them from any pool thread, one import at a time. */
+struct QSocToolModuleImport::Workspace
+{
+    std::unique_ptr<QSocProjectManager> project;
+    std::unique_ptr<QSocModuleManager>  modules;
+};
+
 QSocToolModuleImport::QSocToolModuleImport(QObject *parent, QSocModuleManager *moduleManager)
     : QSocTool(parent)
     , moduleManager(moduleManager)
@@ -218,13 +229,19 @@ json QSocToolModuleImport::getParametersSchema() const
 
 QString QSocToolModuleImport::execute(const json &arguments)
 {
-    if (!moduleManager) {
-        return "Error: Module manager not configured";
+    return executeBlocking(arguments);
+}
+
+void QSocToolModuleImport::executeAsync(
+    const json &arguments, QSocToolCallContext *call, const ResultCallback &done)
+{
+    if (!moduleManager || !moduleManager->getProjectManager()) {
+        return done("Error: Module manager not configured");
     }
 
     if (!arguments.contains("files") || !arguments["files"].is_array()
         || arguments["files"].empty()) {
-        return "Error: At least one file path is required";
+        return done("Error: At least one file path is required");
     }
 
     /* Get file paths */
@@ -236,7 +253,7 @@ QString QSocToolModuleImport::execute(const json &arguments)
     }
 
     if (filePaths.isEmpty()) {
-        return "Error: No valid file paths provided";
+        return done("Error: No valid file paths provided");
     }
 
     /* Get library name */
@@ -255,15 +272,57 @@ QString QSocToolModuleImport::execute(const json &arguments)
     }
     QRegularExpression moduleRegex(regexStr);
     if (!moduleRegex.isValid()) {
-        return QString("Error: Invalid module regex: %1").arg(moduleRegex.errorString());
+        return done(QString("Error: Invalid module regex: %1").arg(moduleRegex.errorString()));
     }
 
-    /* Import from file list */
-    if (!moduleManager->importFromFileList(libraryName, moduleRegex, QString(), filePaths)) {
-        return "Error: Failed to import module(s) from file(s)";
+    /* Parse on a worker. The kept workspace serves one import at a time;
+     * a call started while it is busy parses into a throwaway one. */
+    if (!workspace) {
+        workspace = std::make_shared<Workspace>();
     }
+    const bool reuse = !workspaceBusy;
+    workspaceBusy    = true;
+    auto settings    = std::make_shared<QSocProjectManager>();
+    settings->copyFrom(*moduleManager->getProjectManager());
+
+    WorkerBody body = [kept = reuse ? workspace : nullptr,
+                       settings,
+                       libraryName,
+                       moduleRegex,
+                       filePaths](const QSocToolWorker &worker) -> QString {
+        Workspace  scratch;
+        Workspace *space = kept ? kept.get() : &scratch;
+        if (!space->project) {
+            space->project = std::make_unique<QSocProjectManager>();
+            space->modules = std::make_unique<QSocModuleManager>(nullptr, space->project.get());
+        }
+        space->project->copyFrom(*settings);
+        QSocModuleManager *modules = space->modules.get();
+
+        if (worker.isCancelled()) {
+            return "Error: Operation cancelled";
+        }
+        modules->setCancelCheck([&worker]() { return worker.isCancelled(); });
+        const auto clearCheck = qScopeGuard([modules]() { modules->setCancelCheck({}); });
+
+        worker.progress(QString("Parsing %1 file(s)").arg(filePaths.size()));
+        if (!modules->importFromFileList(libraryName, moduleRegex, QString(), filePaths)) {
+            if (worker.isCancelled()) {
+                return "Error: Operation cancelled";
+            }
+            return "Error: Failed to import module(s) from file(s)";
+        }
+
+        return QString("Successfully imported module(s) from %1 file(s).").arg(filePaths.size());
+    };
 
-    return QString("Successfully imported module(s) from %1 file(s).").arg(filePaths.size());
+    const QPointer<QSocToolModuleImport> self(this);
+    runOnWorker(std::move(body), call, [self, reuse, done](const QString &result) {
+        if (reuse && !self.isNull()) {
+            self->workspaceBusy = false;
+        }
+        done(result);
+    });
 }
 
 void QSocToolModuleImport::setModuleManager(QSocModuleManager *moduleManager)
@@ -7,6 +7,8 @@
 #include "agent/qsoctool.h"
 #include "common/qsocmodulemanager.h"
 
+#include <memory>
+
 /**
  * @brief Tool to list modules
  */
@@ -71,11 +73,20 @@ public:
     QString getDescription() const override;
     json    getParametersSchema() const override;
     QString execute(const json &arguments) override;
+    bool    isAsync() const override { return true; }
+    void    executeAsync(
+        const json &arguments, QSocToolCallContext *call, const ResultCallback &done) override;
 
     void setModuleManager(QSocModuleManager *moduleManager);
 
 private:
+    struct Workspace;
+
     QSocModuleManager *moduleManager = nullptr;
+    /* Worker-side managers, kept so the parsed compilation is reused by
+     * later imports from the same files. */
+    std::shared_ptr<Workspace> workspace;
+    bool                       workspaceBusy = false;
 };
 
 /**
@@ -4,12 +4,15 @@
 #include "agent/tool/qsoctoolweb.h"
 
 #include "common/qlongtaskmonitor.h"
+#include "common/qsocconsole.h"
 #include "common/qsocimageattach.h"
 #include "common/qsocproxy.h"
 
 #include <lexbor/dom/dom.h>
 #include <lexbor/html/html.h>
+#include <QDateTime>
 #include <QNetworkRequest>
+#include <QScopeGuard>
 #include <QSet>
 #include <QTimer>
 #include <QUrl>
@@ -277,6 +280,14 @@ QSocToolWebFetch::QSocToolWebFetch(QObject *parent, QSocConfig *config, QLLMServ
 {
     networkManager = new QNetworkAccessManager(this);
     setupProxy();
+
+    qint64 cacheMb = QSocWebCache::DEFAULT_MAX_BYTES / (1024 * 1024);
+    if (config != nullptr && config->hasKey("web.cache_max_mb")) {
+        cacheMb = config->getValue("web.cache_max_mb").toLongLong();
+    }
+    if (cacheMb > 0) {
+        webCache = QSocWebCache::shared(cacheMb * 1024 * 1024);
+    }
 }
 
 const char *QSocToolWebFetch::attachmentMarkerOpen()
@@ -872,6 +883,33 @@ QString QSocToolWebFetch::execute(const json &arguments)
         }
     }
 
+    /* Response cache: a fresh entry skips the network and the HTML pass,
+     * a stale one with validators turns the fetch into a conditional GET.
+     * The network stack negotiates Accept-Encoding and decodes the body
+     * itself, so every stored body is the decoded one. */
+    const QMap<QString, QString> variant
+        = {{QStringLiteral("user-agent"), kUserAgent},
+           {QStringLiteral("accept-encoding"), QStringLiteral("decoded")}};
+    std::optional<QSocWebCache::Entry> cached;
+    if (webCache != nullptr) {
+        cached = webCache->lookup(urlStr, variant);
+    }
+    if (cached.has_value() && cached->isFresh(QDateTime::currentMSecsSinceEpoch())) {
+        webCache->record(QSocWebCache::Outcome::Hit);
+        QSOC_DEBUG() << "web_fetch cache hit:" << urlStr
+                     << "hit rate:" << webCache->stats().hitRate();
+        return cachedFetchResult(*cached);
+    }
+
+    /* Every lookup not answered from the cache is a miss, failures included */
+    auto recordMiss = qScopeGuard([this, &urlStr]() {
+        if (webCache != nullptr) {
+            webCache->record(QSocWebCache::Outcome::Miss);
+            QSOC_DEBUG() << "web_fetch cache miss:" << urlStr
+                         << "hit rate:" << webCache->stats().hitRate();
+        }
+    });
+
     /* Build request */
     QNetworkRequest request(url);
     /* Size, stall, timeout, and cancel aborts retire live replies before EOF. */
@@ -880,6 +918,14 @@ QString QSocToolWebFetch::execute(const json &arguments)
     request.setMaximumRedirectsAllowed(10);
     request.setAttribute(
         QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::NoLessSafeRedirectPolicy);
+    if (cached.has_value()) {
+        if (!cached->etag.isEmpty()) {
+            request.setRawHeader("If-None-Match", cached->etag.toLatin1());
+        }
+        if (!cached->lastModified.isEmpty()) {
+            request.setRawHeader("If-Modified-Since", cached->lastModified.toLatin1());
+        }
+    }
 
     /* Execute request */
     QNetworkReply *reply = networkManager->get(request);
@@ -965,6 +1011,15 @@ QString QSocToolWebFetch::execute(const json &arguments)
 
     /* Check HTTP status code */
     int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (httpStatus == 304 && cached.has_value()) {
+        const auto refreshed = webCache->refresh(urlStr, variant, reply->rawHeaderPairs());
+        reply->deleteLater();
+        recordMiss.dismiss();
+        webCache->record(QSocWebCache::Outcome::Revalidated);
+        QSOC_DEBUG() << "web_fetch cache revalidated:" << urlStr
+                     << "hit rate:" << webCache->stats().hitRate();
+        return cachedFetchResult(refreshed.value_or(*cached));
+    }
     if (httpStatus < 200 || httpStatus >= 300) {
         QByteArray body    = reply->readAll();
         QString    snippet = QString::fromUtf8(body.left(500));
@@ -975,6 +1030,8 @@ QString QSocToolWebFetch::execute(const json &arguments)
     /* Read response body */
     QByteArray responseData = reply->readAll();
     QString    contentType = reply->header(QNetworkRequest::ContentTypeHeader).toString().toLower();
+    /* Cache-Control, validators and Vary for the response cache */
+    const QSocWebCache::RawHeaders responseHeaders = reply->rawHeaderPairs();
     reply->deleteLater();
 
     if (responseData.isEmpty()) {
@@ -991,6 +1048,10 @@ QString QSocToolWebFetch::execute(const json &arguments)
      * exceeds the configured token budget after resize. */
     bool isImage = contentType.startsWith("image/") && !contentType.contains("svg+xml");
     if (isImage) {
+        /* The attachment depends on the active model, so only bytes are cached */
+        if (webCache != nullptr) {
+            webCache->store(urlStr, variant, responseHeaders, contentType, responseData, QString());
+        }
         return handleImageResponse(urlStr, contentType, responseData);
     }
 
@@ -1016,7 +1077,21 @@ QString QSocToolWebFetch::execute(const json &arguments)
         text = text.left(kMaxTextSize) + "\n... (content truncated)";
     }
 
-    return text.isEmpty() ? "(no content)" : text;
+    if (text.isEmpty()) {
+        text = QStringLiteral("(no content)");
+    }
+    if (webCache != nullptr) {
+        webCache->store(urlStr, variant, responseHeaders, contentType, responseData, text);
+    }
+    return text;
+}
+
+QString QSocToolWebFetch::cachedFetchResult(const QSocWebCache::Entry &entry)
+{
+    if (entry.text.isNull()) {
+        return handleImageResponse(entry.url, entry.contentType, entry.body);
+    }
+    return entry.text;
 }
 
 void QSocToolWebFetch::abort()
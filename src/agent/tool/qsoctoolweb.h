@@ -7,6 +7,7 @@
 #include "agent/qsoctool.h"
 #include "common/qllmservice.h"
 #include "common/qsocconfig.h"
+#include "common/qsocwebcache.h"
 
 #include <QEventLoop>
 #include <QNetworkAccessManager>
@@ -93,10 +94,20 @@ public:
     QString handleImageResponse(
         const QString &sourceUrl, const QString &contentType, const QByteArray &body);
 
+    /**
+     * @brief Replace the response cache.
+     * @details The constructor attaches the shared user-level cache unless
+     *          web.cache_max_mb is 0. Tests pass a cache over a temporary
+     *          directory; nullptr disables caching. Not owned.
+     */
+    void          setWebCache(QSocWebCache *cache) { webCache = cache; }
+    QSocWebCache *getWebCache() const { return webCache; }
+
 private:
     QSocConfig            *config = nullptr;
     QPointer<QLLMService>  llmService;
     QNetworkAccessManager *networkManager = nullptr;
+    QSocWebCache          *webCache       = nullptr;
     /* In-flight synchronous waits. Tool instances are shared across
      * concurrent sub-agents, so a single slot would be trampled when
      * two fetches/searches overlap (one nested in the other's loop).
@@ -106,6 +117,9 @@ private:
     QSet<QEventLoop *>    inFlightLoops_;
 
     void setupProxy();
+    /* Tool output for a cached response; images are re-encoded for the
+     * active model. */
+    QString cachedFetchResult(const QSocWebCache::Entry &entry);
 };
 
 #endif // QSOCTOOLWEB_H
@@ -102,6 +102,37 @@ void QAgentCompletionEngine::scanRemote(QSocSshSession *session, const QString &
         return;
     }
 
+    QString prefix = remoteRoot;
+    if (!prefix.endsWith(QLatin1Char('/'))) {
+        prefix += QLatin1Char('/');
+    }
+
+    /* One bounded host-side find, validated against the directory stamp of
+     * the previous scan so an unchanged tree is not transferred again. */
+    if (remoteLister == nullptr || remoteListerSession != session) {
+        remoteLister        = std::make_unique<QSocRemoteLister>(session);
+        remoteListerSession = session;
+    }
+    QSocRemoteLister::Query query;
+    query.root       = remoteRoot;
+    query.maxDepth   = 0;
+    query.limit      = DEFAULT_SCAN_LIMIT;
+    query.filesOnly  = true;
+    query.pruneNames = QStringList(ignoreDirs.cbegin(), ignoreDirs.cend());
+    query.pruneNames.sort();
+    QSocRemoteLister::Listing listing;
+    if (remoteLister->list(query, &listing)) {
+        cachedFiles.reserve(listing.entries.size());
+        for (const auto &entry : listing.entries) {
+            cachedFiles.append(entry.path);
+        }
+        std::sort(cachedFiles.begin(), cachedFiles.end());
+        cacheValid = true;
+        cacheTimer.restart();
+        return;
+    }
+
+    /* Non-GNU find: plain `find -print` with the full list transferred. */
     auto shellEscape = [](const QString &value) {
         QString out = QStringLiteral("'");
         for (const QChar chr : value) {
@@ -140,11 +171,6 @@ void QAgentCompletionEngine::scanRemote(QSocSshSession *session, const QString &
         return;
     }
 
-    QString prefix = remoteRoot;
-    if (!prefix.endsWith(QLatin1Char('/'))) {
-        prefix += QLatin1Char('/');
-    }
-
     const QList<QByteArray> lines = res.stdoutBytes.split('\n');
     cachedFiles.reserve(lines.size());
     for (const QByteArray &line : lines) {
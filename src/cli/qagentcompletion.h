@@ -4,6 +4,9 @@
 #ifndef QAGENTCOMPLETION_H
 #define QAGENTCOMPLETION_H
 
+#include "agent/remote/qsocremotelister.h"
+
+#include <memory>
 #include <QElapsedTimer>
 #include <QSet>
 #include <QString>
@@ -33,7 +36,9 @@ public:
     void scan(const QString &projectPath);
 
     /* Rescan a remote workspace over SSH using `find`. Populates cache under
-     * the "remote:" + remoteRoot key so it does not collide with local scans. */
+     * the "remote:" + remoteRoot key so it does not collide with local scans.
+     * A rescan whose remote directory stamp is unchanged reuses the last
+     * listing without transferring it again. */
     void scanRemote(QSocSshSession *session, const QString &remoteRoot);
 
     /* Return the current cached file list (relative paths) */
@@ -70,6 +75,9 @@ private:
     int           cacheTtlMs = DEFAULT_CACHE_TTL_MS;
     QSet<QString> ignoreDirs;
 
+    std::unique_ptr<QSocRemoteLister> remoteLister;
+    QSocSshSession                   *remoteListerSession = nullptr;
+
     bool        shouldRescan(const QString &projectPath) const;
     QStringList rank(const QString &query, int maxResults) const;
 };
@@ -556,7 +556,7 @@ bool persistSessionState(
     }
 
     if (!appendOnly) {
-        if (!session->appendSnapshot(messages)) {
+        if (!session->appendSnapshot(messages, persistedMessages)) {
             return false;
         }
         persistedMessages  = messages;
@@ -582,7 +582,7 @@ bool persistRecoverySnapshot(
     }
     if (session == nullptr || !messages.is_array() || !persistedMessages.is_array()
         || messages.size() > static_cast<json::size_type>(std::numeric_limits<int>::max())
-        || !session->appendSnapshot(messages)) {
+        || !session->appendSnapshot(messages, persistedMessages)) {
         return false;
     }
     persistedMessages  = messages;
@@ -1249,6 +1249,9 @@ bool QSocCliWorker::parseAgent(const QStringList &appArguments)
     taskRegistry->registerSource(new QSocBashTaskSource(shellBashTool, this));
     taskRegistry->registerSource(monitorTaskSource);
     auto *subAgentTaskSource = new QSocSubAgentTaskSource(this);
+    /* Each admitted sub-agent gets its own thread and event loop, so a
+     * child blocked in a long turn leaves the REPL and siblings live. */
+    subAgentTaskSource->setThreadedRuns(true);
     /* Reconstruct historical (backgrounded) runs from disk meta
      * sidecars and rewrite stale "running" entries to "failed" so
      * `/agents-history` can serve them. */
@@ -1814,6 +1817,15 @@ bool QSocCliWorker::runAgentLoop(
     auto          &inputWidget     = compositor.inputLine();
     auto          &popupWidget     = compositor.completionPopup();
 
+    /* Synchronized output: auto follows the terminal, true/false force it */
+    const QString syncOutputStr = socConfig ? socConfig->getValue("agent.synchronized_output")
+                                            : QString();
+    if (syncOutputStr.isEmpty() || syncOutputStr.toLower() == "auto") {
+        compositor.setSynchronizedOutput(termCap.supportsSynchronizedOutput());
+    } else {
+        compositor.setSynchronizedOutput(syncOutputStr.toLower() == "true" || syncOutputStr == "1");
+    }
+
     /* Discoverability hint shown when the input line is empty. */
     inputWidget.setPlaceholder(
         QStringLiteral("try /help, @file, !shell, Ctrl+R to search, Ctrl+X Ctrl+E to edit"));
@@ -1915,6 +1927,25 @@ bool QSocCliWorker::runAgentLoop(
         }
     }
 
+    /* The session never reconnects by itself (a flapping link must not
+     * loop), so a run of failed keepalives is surfaced here and the user
+     * decides whether to /ssh again. */
+    const auto watchRemoteSession = [&compositor](QSocSshSession *session, const QString &target) {
+        QObject::connect(
+            session,
+            &QSocSshSession::connectionLost,
+            &compositor,
+            [&compositor, session, target]() {
+                compositor.printContent(
+                    QString("SSH connection to %1 lost: %2\n"
+                            "Run /ssh to reconnect or /local to return to the local workspace.\n")
+                        .arg(target, session->lastError()));
+            });
+    };
+    if (remoteSession != nullptr) {
+        watchRemoteSession(remoteSession, remoteTargetKey);
+    }
+
     /* Connect mouse wheel from input monitor to compositor scroll */
     QAgentInputMonitor inputMonitor(this);
     /* Teach the monitor to treat "[Pasted text #N +M lines]" chip labels as
@@ -2773,10 +2804,11 @@ bool QSocCliWorker::runAgentLoop(
      * tracks how many entries from agent->getMessages() have already hit
      * disk so each turn only appends the delta. resumeSessionId is the
      * id selected by --resume / --continue at startup; the helper at the
-     * top of QSocCliWorker stashes it before calling runAgentLoop. */
+     * top of QSocCliWorker stashes it before calling runAgentLoop. The
+     * lock is declared first so it outlives the session's final drain. */
+    std::unique_ptr<QLockFile>            sessionLock;
     std::unique_ptr<QSocSession>          currentSession;
     std::unique_ptr<QSocFileHistory>      currentFileHistory;
-    std::unique_ptr<QLockFile>            sessionLock;
     QSocSessionRecovery::Action           pendingRecoveryAction = QSocSessionRecovery::Action::Wait;
     QString                               pendingRecoveryInput;
     QString                               pendingRecoveryRunId;
@@ -2808,6 +2840,13 @@ bool QSocCliWorker::runAgentLoop(
             QString err;
             return sftp->removeFile(path, &err);
         };
+        acc.stat = [sftp](const QString &path) -> std::optional<QSocFileHistory::FileStat> {
+            QSocSftpClient::Entry entry;
+            if (!sftp->stat(path, &entry) || entry.isDirectory || entry.mtime == 0) {
+                return std::nullopt;
+            }
+            return QSocFileHistory::FileStat{entry.size, entry.mtime * 1000};
+        };
         return acc;
     };
     auto wireRemoteFileHistory =
@@ -2905,6 +2944,7 @@ bool QSocCliWorker::runAgentLoop(
         currentSession     = std::make_unique<QSocSession>(newId, sessionPath);
         currentFileHistory = std::make_unique<QSocFileHistory>(projectPath, newId);
         sessionLock        = std::move(nextLock);
+        currentSession->setBackgroundWrites(true);
         currentSession->appendMeta(
             QStringLiteral("created"), QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs));
         currentSession->appendMeta(QStringLiteral("cwd"), projectPath);
@@ -2928,6 +2968,7 @@ bool QSocCliWorker::runAgentLoop(
             return false;
         }
         const QString path = currentSession->filePath();
+        currentSession->flush();
         /* One pass over the live file BEFORE the rewrite truncates it: keep
          * the raw created/cwd-irrelevant metas. Manual title and auto title
          * stay under their own keys so an auto title is not promoted to a
@@ -2971,6 +3012,7 @@ bool QSocCliWorker::runAgentLoop(
             return;
         }
         const QString path = currentSession->filePath();
+        currentSession->flush();
         if (!QSocSession::readMeta(path, QStringLiteral("title")).isEmpty()
             || !QSocSession::readMeta(path, QStringLiteral("auto_title")).isEmpty()) {
             titleGenerated = true; /* already titled */
@@ -3489,6 +3531,9 @@ bool QSocCliWorker::runAgentLoop(
         }
         currentSession     = std::make_unique<QSocSession>(sessionId, sessionPath);
         currentFileHistory = std::make_unique<QSocFileHistory>(projectPath, sessionId);
+        /* Appends leave the interaction loop; run records still wait for
+         * the disk, which is what interrupted-run recovery reads. */
+        currentSession->setBackgroundWrites(true);
 
         /* --ssh startup: the remote tools were built before this history
          * existed, so wire them now to checkpoint remote edits for rewind. */
@@ -3733,6 +3778,10 @@ bool QSocCliWorker::runAgentLoop(
             return false;
         }
         if (terminal) {
+            /* Terminal messages may follow the run record; land them too */
+            if (!currentSession->flush()) {
+                return false;
+            }
             runTerminalPersisted = true;
             QSocSession::removeRecoveryClaim(activeRunId);
         }
@@ -3766,6 +3815,10 @@ bool QSocCliWorker::runAgentLoop(
                             agent, currentSession.get(), persistedMessages, lastPersistedIndex);
             }
         }
+        /* Turn boundary: everything queued this turn reaches the file */
+        if (currentSession != nullptr && !currentSession->flush()) {
+            saved = false;
+        }
         activeRunId          = {};
         observedTerminal     = QSocSession::RunEvent::Invalid;
         runTerminalPersisted = false;
@@ -4849,6 +4902,7 @@ bool QSocCliWorker::runAgentLoop(
                  * original timestamp; rewriteMessages truncates the file, so
                  * meta must be re-emitted afterwards. */
                 if (restoreConversation) {
+                    currentSession->flush();
                     const QSocSession::Info origInfo = QSocSession::readInfo(
                         currentSession->filePath());
                     json truncated = json::array();
@@ -5880,6 +5934,7 @@ bool QSocCliWorker::runAgentLoop(
                 /* Truncate the existing JSONL in place — keep the same id
                  * so any in-flight references stay valid, then re-stamp
                  * the creation metadata so the file isn't entirely empty. */
+                currentSession->flush();
                 QFile::remove(currentSession->filePath());
                 currentSession->appendMeta(
                     QStringLiteral("created"),
@@ -6266,6 +6321,31 @@ bool QSocCliWorker::runAgentLoop(
                         .arg(currentFileHistory->listSnapshots().size()),
                     QTuiScrollView::Dim);
             }
+            const auto frames = compositor.frameStats();
+            compositor.printContent(
+                QString("  Render:   %1 frame(s), last %2 B, avg %3 B, sync output %4\n")
+                    .arg(frames.frames)
+                    .arg(frames.lastBytes)
+                    .arg(frames.frames > 0 ? frames.bytes / frames.frames : 0)
+                    .arg(compositor.synchronizedOutput() ? "on" : "off"),
+                QTuiScrollView::Dim);
+            if (auto *reg = agent->getToolRegistry()) {
+                auto *fetchTool = dynamic_cast<QSocToolWebFetch *>(
+                    reg->getTool(QStringLiteral("web_fetch")));
+                if (fetchTool != nullptr && fetchTool->getWebCache() != nullptr) {
+                    const auto web = fetchTool->getWebCache()->stats();
+                    compositor.printContent(
+                        QString("  Web cache: %1 hit(s), %2 revalidated, %3 miss(es), "
+                                "hit rate %4%, %5 entries, %6 KiB\n")
+                            .arg(web.hits)
+                            .arg(web.revalidated)
+                            .arg(web.misses)
+                            .arg(qRound(web.hitRate() * 100))
+                            .arg(web.entries)
+                            .arg(web.bytes / 1024),
+                        QTuiScrollView::Dim);
+                }
+            }
             compositor.printContent("\n");
             continue;
         }
@@ -6310,11 +6390,19 @@ bool QSocCliWorker::runAgentLoop(
                     const auto    tools = mcpManager->toolsForClient(name);
                     const QString unit  = tools.size() == 1 ? QStringLiteral("tool")
                                                             : QStringLiteral("tools");
-                    compositor.printContent(QString("  %1  [%2]  %3 %4\n")
+                    QString       cache;
+                    if (const auto stats = mcpManager->resultCacheStats(name)) {
+                        cache = QString("  cache %1 hit / %2 miss, %3 cached")
+                                    .arg(stats->hits)
+                                    .arg(stats->misses)
+                                    .arg(stats->entries);
+                    }
+                    compositor.printContent(QString("  %1  [%2]  %3 %4%5\n")
                                                 .arg(name, -16)
                                                 .arg(status)
                                                 .arg(tools.size())
-                                                .arg(unit));
+                                                .arg(unit)
+                                                .arg(cache));
                 }
                 compositor.printContent("\n");
                 continue;
@@ -6345,6 +6433,7 @@ bool QSocCliWorker::runAgentLoop(
                 = QDir(QSocSession::sessionsDir(projectPath)).filePath(newId + ".jsonl");
 
             /* Copy session JSONL. */
+            currentSession->flush();
             QFile::copy(currentSession->filePath(), newPath);
 
             /* Append forkedFrom meta to the new session. */
@@ -6603,6 +6692,32 @@ bool QSocCliWorker::runAgentLoop(
         if (cmd.startsWith(QStringLiteral("/ssh"))) {
             QString arg = input.mid(4).trimmed();
 
+            /* `/ssh stats` reports per-operation latency on the live session. */
+            if (arg == QStringLiteral("stats")) {
+                if (remoteSession == nullptr || !remoteSession->isConnected()) {
+                    compositor.printContent("Not connected to a remote workspace.\n");
+                    continue;
+                }
+                QString text = QStringLiteral("SSH %1: %2 warm channel(s)")
+                                   .arg(remoteTargetKey)
+                                   .arg(remoteSession->warmChannelCount());
+                if (!remoteSession->isHealthy()) {
+                    text += QStringLiteral(", keepalive failing");
+                }
+                text += QLatin1Char('\n');
+                const auto stats = remoteSession->latencyStats();
+                for (auto it = stats.cbegin(); it != stats.cend(); ++it) {
+                    const auto &op = it.value();
+                    text += QStringLiteral("  %1 %2 call(s), avg %3 ms, max %4 ms\n")
+                                .arg(it.key(), -13)
+                                .arg(op.count)
+                                .arg(op.count > 0 ? op.totalMs / op.count : 0)
+                                .arg(op.maxMs);
+                }
+                compositor.printContent(text);
+                continue;
+            }
+
             /* Bare /ssh pops a picker built from the sticky binding target
              * plus concrete aliases in ~/.ssh/config. The selection feeds
              * back into `arg` so the parser below does the actual work. */
@@ -6663,7 +6778,8 @@ bool QSocCliWorker::runAgentLoop(
                         "  User defaults to the current OS user and port defaults to 22.\n"
                         "  After connect a directory browser asks for the remote workspace;\n"
                         "  the choice is stored in <project>/.qsoc/host.yml and reused on\n"
-                        "  the next connect. Use /local to return to the local workspace.\n");
+                        "  the next connect. Use /local to return to the local workspace.\n"
+                        "  /ssh stats shows per-operation latency for the live session.\n");
                     continue;
                 }
                 arg = picked;
@@ -6833,6 +6949,7 @@ bool QSocCliWorker::runAgentLoop(
             remoteJumps     = newState.jumps;
             remoteRegistry  = newState.registry;
             remoteTargetKey = newState.targetKey;
+            watchRemoteSession(remoteSession, remoteTargetKey);
 
             /* Carry the spawn tool and its status companion across
              * the swap so the parent LLM keeps seeing them; the
@@ -7628,6 +7745,17 @@ bool QSocCliWorker::runAgentLoop(
                     }
                 });
 
+            /* Worker-thread tools stream progress lines into the open block */
+            auto connToolProgress = QObject::connect(
+                agent,
+                &QSocAgent::toolProgress,
+                &compositor,
+                [&compositor](const QString &toolName, const QString &message) {
+                    if (!toolName.startsWith("todo_")) {
+                        compositor.appendToolUseBody(message + "\n");
+                    }
+                });
+
             auto connToolResult = QObject::connect(
                 agent,
                 &QSocAgent::toolResult,
@@ -8190,6 +8318,7 @@ bool QSocCliWorker::runAgentLoop(
             /* Disconnect all signals to avoid stale connections */
             QObject::disconnect(connToolCalled);
             QObject::disconnect(connToolResult);
+            QObject::disconnect(connToolProgress);
             QObject::disconnect(connTodoTrack);
             QObject::disconnect(connContentChunk);
             QObject::disconnect(connReasoning);
@@ -8306,6 +8435,17 @@ bool QSocCliWorker::runAgentLoop(
                     }
                 });
 
+            /* Worker-thread tools stream progress lines into the open block */
+            auto connToolProgress = QObject::connect(
+                agent,
+                &QSocAgent::toolProgress,
+                &compositor,
+                [&compositor](const QString &toolName, const QString &message) {
+                    if (!toolName.startsWith("todo_")) {
+                        compositor.appendToolUseBody(message + "\n");
+                    }
+                });
+
             auto connToolResult = QObject::connect(
                 agent,
                 &QSocAgent::toolResult,
@@ -8835,6 +8975,7 @@ bool QSocCliWorker::runAgentLoop(
             /* Disconnect signals */
             QObject::disconnect(connToolCalled);
             QObject::disconnect(connToolResult);
+            QObject::disconnect(connToolProgress);
             QObject::disconnect(connTodoTrack);
             QObject::disconnect(connContentChunk);
             QObject::disconnect(connRunComplete);
@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Huang Rui <vowstar@gmail.com>
+
+#include "cli/qsoccliworker.h"
+
+#include "cli/qsocdaemon.h"
+#include "common/qsocconsole.h"
+
+#include <QEventLoop>
+
+bool QSocCliWorker::parseDaemon(const QStringList &appArguments)
+{
+    /* Clear upstream positional arguments and setup subcommand */
+    parser.clearPositionalArguments();
+    parser.addOptions({
+        {"socket",
+         QCoreApplication::translate(
+             "main", "The local socket name to serve, default is a per-user name."),
+         "name"},
+        {"idle-timeout",
+         QCoreApplication::translate(
+             "main", "Exit after this many minutes without a call, 0 never exits."),
+         "minutes",
+         "30"},
+        {"stop", QCoreApplication::translate("main", "Stop the daemon serving the socket.")},
+    });
+
+    parser.parse(appArguments);
+
+    if (parser.isSet("help")) {
+        return showHelp(0);
+    }
+
+    const QString serverName = parser.isSet("socket") ? parser.value("socket")
+                                                      : QSocDaemon::defaultServerName();
+    if (parser.isSet("stop")) {
+        if (!QSocDaemon::stop(serverName)) {
+            return showError(
+                1,
+                QCoreApplication::translate("main", "Error: no daemon is serving %1.")
+                    .arg(serverName));
+        }
+        return showInfo(
+            0, QCoreApplication::translate("main", "Stopped daemon %1.").arg(serverName));
+    }
+
+    bool      minutesOk = false;
+    const int minutes   = parser.value("idle-timeout").toInt(&minutesOk);
+    if (!minutesOk || minutes < 0) {
+        return showErrorWithHelp(
+            1,
+            QCoreApplication::translate("main", "Error: invalid idle timeout: %1.")
+                .arg(parser.value("idle-timeout")));
+    }
+
+    QSocDaemon daemon;
+    QString    errorMessage;
+    if (!daemon.listen(serverName, &errorMessage)) {
+        return showError(
+            1,
+            QCoreApplication::translate("main", "Error: cannot start daemon: %1.")
+                .arg(errorMessage));
+    }
+    daemon.setIdleTimeout(minutes * 60 * 1000);
+    QSocConsole::info() << "Daemon serving" << serverName;
+
+    QEventLoop loop;
+    connect(&daemon, &QSocDaemon::finished, &loop, &QEventLoop::quit);
+    loop.exec();
+
+    const QSocYamlFileCache::Stats stats = daemon.cacheStats();
+    QSOC_DEBUG() << "Library cache:" << stats.hits << "hits," << stats.misses << "misses,"
+                 << stats.entries << "files";
+    return true;
+}
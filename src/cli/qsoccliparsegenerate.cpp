@@ -2,9 +2,12 @@
 // SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
 
 #include "cli/qsoccliworker.h"
+#include "cli/qsocgeneratewatch.h"
 #include "common/qsocconfig.h"
+#include "common/qsocconsole.h"
 #include "common/qsocgeneratemanager.h"
 #include "common/qsocmodulemanager.h"
+#include "common/qsocprofiler.h"
 #include "common/qsocprojectmanager.h"
 #include "common/qsocyamlutils.h"
 
@@ -14,8 +17,43 @@
 #include <QFile>
 #include <QFileInfo>
 #include <QGuiApplication>
+#include <QHash>
 #include <QTextStream>
 
+namespace {
+
+/* Output file name of a template: its name without the template extension */
+QString templateOutputFileName(const QString &templateFilePath)
+{
+    QString   outputFileName = QFileInfo(templateFilePath).fileName();
+    const int lastDotIndex   = static_cast<int>(outputFileName.lastIndexOf('.'));
+    if (lastDotIndex > 0) {
+        outputFileName = outputFileName.left(lastDotIndex);
+    }
+    return outputFileName;
+}
+
+/* Parse a --data-sidecar value; false for an unknown mode */
+bool parseTemplateSidecar(const QString &value, QSocGenerateManager::TemplateSidecar *format)
+{
+    using Sidecar = QSocGenerateManager::TemplateSidecar;
+    static const QHash<QString, Sidecar> modes = {
+        {QStringLiteral("off"), Sidecar::Off},
+        {QStringLiteral("pretty"), Sidecar::Pretty},
+        {QStringLiteral("compact"), Sidecar::Compact},
+        {QStringLiteral("cbor"), Sidecar::Cbor},
+        {QStringLiteral("msgpack"), Sidecar::MsgPack},
+    };
+    const auto found = modes.constFind(value.trimmed().toLower());
+    if (found == modes.constEnd()) {
+        return false;
+    }
+    *format = found.value();
+    return true;
+}
+
+} // namespace
+
 bool QSocCliWorker::parseGenerate(const QStringList &appArguments)
 {
     /* Clear upstream positional arguments and setup subcommand */
@@ -74,6 +112,15 @@ bool QSocCliWorker::parseGenerateVerilog(const QStringList &appArguments)
         {{"f", "force"},
          QCoreApplication::translate(
              "main", "Force overwrite existing primitive cell files (clock_cell.v, reset_cell.v).")},
+        {"no-diagram",
+         QCoreApplication::translate(
+             "main", "Skip Typst diagrams for reset, clock and power controllers.")},
+        {"profile",
+         QCoreApplication::translate(
+             "main", "Write a per-phase timing profile (Chrome trace and text summary).")},
+        {"watch",
+         QCoreApplication::translate(
+             "main", "Keep running and regenerate the outputs affected by each file change.")},
     });
 
     parser.addPositionalArgument(
@@ -124,17 +171,27 @@ bool QSocCliWorker::parseGenerateVerilog(const QStringList &appArguments)
                 .arg(projectManager->getOutputPath()));
     }
 
+    /* Profile only this run */
+    QSocProfiler::setEnabled(parser.isSet("profile"));
+    QSocProfiler::reset();
+
     /* Load modules */
+    QSocProfiler::Scope libraryProfile("loadLibrary");
     if (!moduleManager->load(QRegularExpression(".*"))) {
+        QSocProfiler::setEnabled(false);
         return showErrorWithHelp(
             1, QCoreApplication::translate("main", "Error: could not load library"));
     }
+    libraryProfile.finish();
 
     /* Load buses */
+    QSocProfiler::Scope busProfile("loadBus");
     if (!busManager->load(QRegularExpression(".*"))) {
+        QSocProfiler::setEnabled(false);
         return showErrorWithHelp(
             1, QCoreApplication::translate("main", "Error: could not load buses"));
     }
+    busProfile.finish();
 
     /* Check if merge mode is enabled */
     const bool mergeMode = parser.isSet("merge");
@@ -144,12 +201,41 @@ bool QSocCliWorker::parseGenerateVerilog(const QStringList &appArguments)
         generateManager->setForceOverwrite(true);
     }
 
+    /* Typst diagrams are optional side outputs */
+    generateManager->setDiagramEnabled(!parser.isSet("no-diagram"));
+
+    if (parser.isSet("watch")) {
+        QSocProfiler::setEnabled(false);
+        return watchGenerateVerilog(filePathList, mergeMode && filePathList.size() > 1);
+    }
+
+    bool result = false;
     if (mergeMode && filePathList.size() > 1) {
         /* Merge mode: combine multiple netlist files */
-        return processMergedNetlists(filePathList);
+        result = processMergedNetlists(filePathList);
+    } else {
+        /* Normal mode: process each netlist file separately */
+        result = processIndividualNetlists(filePathList);
+    }
+
+    /* Write the profile even on failure, partial timings are still useful */
+    if (QSocProfiler::isEnabled()) {
+        QSocProfiler::setEnabled(false);
+        const QDir    outputDir(projectManager->getOutputPath());
+        const QString tracePath   = outputDir.filePath("qsoc_profile.json");
+        const QString summaryPath = outputDir.filePath("qsoc_profile.txt");
+        if (QSocProfiler::writeChromeTrace(tracePath) && QSocProfiler::writeSummary(summaryPath)) {
+            QSocConsole::out() << QSocProfiler::summary() << Qt::flush;
+            showInfo(
+                0,
+                QCoreApplication::translate("main", "Profile written: %1, %2")
+                    .arg(tracePath, summaryPath));
+        } else {
+            QSocConsole::warn() << "Failed to write profile to" << outputDir.path();
+        }
     }
-    /* Normal mode: process each netlist file separately */
-    return processIndividualNetlists(filePathList);
+
+    return result;
 }
 
 bool QSocCliWorker::processMergedNetlists(const QStringList &filePathList)
@@ -181,7 +267,10 @@ bool QSocCliWorker::processMergedNetlists(const QStringList &filePathList)
         }
 
         try {
-            const YAML::Node currentNetlist = YAML::Load(fileStream);
+            /* Under --watch only edited netlists are parsed again */
+            const YAML::Node currentNetlist = netlistCache != nullptr
+                                                  ? netlistCache->load(netlistFilePath)
+                                                  : YAML::Load(fileStream);
             fileStream.close();
 
             if (i == 0) {
@@ -245,47 +334,54 @@ bool QSocCliWorker::processIndividualNetlists(const QStringList &filePathList)
 {
     /* Generate Verilog code for each netlist file individually */
     for (const QString &netlistFilePath : filePathList) {
-        /* Check if the netlist file exists before trying to load it */
-        if (!QFile::exists(netlistFilePath)) {
-            return showError(
-                1,
-                QCoreApplication::translate("main", "Error: Netlist file does not exist: \"%1\"")
-                    .arg(netlistFilePath));
+        if (!processNetlistFile(netlistFilePath)) {
+            return false;
         }
+    }
 
-        /* Load the netlist file */
-        if (!generateManager->loadNetlist(netlistFilePath)) {
-            return showError(
-                1,
-                QCoreApplication::translate("main", "Error: failed to load netlist file: %1")
-                    .arg(netlistFilePath));
-        }
+    return true;
+}
 
-        /* Process the netlist */
-        if (!generateManager->processNetlist()) {
-            return showError(
-                1,
-                QCoreApplication::translate("main", "Error: failed to process netlist file: %1")
-                    .arg(netlistFilePath));
-        }
+bool QSocCliWorker::processNetlistFile(const QString &netlistFilePath)
+{
+    /* Check if the netlist file exists before trying to load it */
+    if (!QFile::exists(netlistFilePath)) {
+        return showError(
+            1,
+            QCoreApplication::translate("main", "Error: Netlist file does not exist: \"%1\"")
+                .arg(netlistFilePath));
+    }
 
-        /* Generate Verilog code */
-        const QFileInfo fileInfo(netlistFilePath);
-        const QString   outputFileName = fileInfo.baseName();
-        if (!generateManager->generateVerilog(outputFileName)) {
-            return showError(
-                1,
-                QCoreApplication::translate("main", "Error: failed to generate Verilog code for: %1")
-                    .arg(outputFileName));
-        }
+    /* Load the netlist file */
+    if (!generateManager->loadNetlist(netlistFilePath)) {
+        return showError(
+            1,
+            QCoreApplication::translate("main", "Error: failed to load netlist file: %1")
+                .arg(netlistFilePath));
+    }
 
-        showInfo(
-            0,
-            QCoreApplication::translate("main", "Successfully generated Verilog code: %1")
-                .arg(QDir(projectManager->getOutputPath()).filePath(outputFileName + ".v")));
+    /* Process the netlist */
+    if (!generateManager->processNetlist()) {
+        return showError(
+            1,
+            QCoreApplication::translate("main", "Error: failed to process netlist file: %1")
+                .arg(netlistFilePath));
     }
 
-    return true;
+    /* Generate Verilog code */
+    const QFileInfo fileInfo(netlistFilePath);
+    const QString   outputFileName = fileInfo.baseName();
+    if (!generateManager->generateVerilog(outputFileName)) {
+        return showError(
+            1,
+            QCoreApplication::translate("main", "Error: failed to generate Verilog code for: %1")
+                .arg(outputFileName));
+    }
+
+    return showInfo(
+        0,
+        QCoreApplication::translate("main", "Successfully generated Verilog code: %1")
+            .arg(QDir(projectManager->getOutputPath()).filePath(outputFileName + ".v")));
 }
 
 bool QSocCliWorker::parseGenerateTemplate(const QStringList &appArguments)
@@ -313,6 +409,16 @@ bool QSocCliWorker::parseGenerateTemplate(const QStringList &appArguments)
          QCoreApplication::translate(
              "main", "RCSV (Register-CSV) data file (can be used multiple times)."),
          "rcsv file"},
+        {"data-sidecar",
+         QCoreApplication::translate(
+             "main",
+             "Also write the template data next to each output: off, pretty, compact, "
+             "cbor or msgpack (default: off)."),
+         "mode",
+         "off"},
+        {"watch",
+         QCoreApplication::translate(
+             "main", "Keep running and regenerate the outputs affected by each file change.")},
     });
 
     parser.addPositionalArgument(
@@ -390,48 +496,107 @@ bool QSocCliWorker::parseGenerateTemplate(const QStringList &appArguments)
         rcsvFiles = parser.values("rcsv");
     }
 
-    /* Process each template file */
+    QSocGenerateManager::TemplateSidecar sidecar = QSocGenerateManager::TemplateSidecar::Off;
+    if (!parseTemplateSidecar(parser.value("data-sidecar"), &sidecar)) {
+        return showErrorWithHelp(
+            1,
+            QCoreApplication::translate("main", "Error: invalid data sidecar mode: %1")
+                .arg(parser.value("data-sidecar")));
+    }
+    generateManager->setTemplateSidecar(sidecar);
+
+    const auto renderOne = [&](const QString &templateFilePath) {
+        return processTemplateFile(
+            templateFilePath, csvFiles, yamlFiles, jsonFiles, rdlFiles, rcsvFiles);
+    };
+
+    if (parser.isSet("watch")) {
+        /* A template change renders that template, a data change renders all */
+        const QStringList dataFiles = csvFiles + yamlFiles + jsonFiles + rdlFiles + rcsvFiles;
+        QSocGenerateWatch watch;
+        for (const QString &templateFilePath : templateFileList) {
+            watch.setInputs(templateFilePath, QStringList{templateFilePath} + dataFiles);
+        }
+        watch.setBuilder(renderOne);
+        return runGenerateWatch(&watch);
+    }
+
+    /* Render all templates as one batch, loading the data files only once */
+    QList<QPair<QString, QString>> templates;
     for (const QString &templateFilePath : templateFileList) {
-        /* Check if the template file exists before trying to load it */
         if (!QFile::exists(templateFilePath)) {
             return showError(
                 101,
                 QCoreApplication::translate("main", "Error: Template file does not exist: \"%1\"")
                     .arg(templateFilePath));
         }
+        templates.append({templateFilePath, templateOutputFileName(templateFilePath)});
+    }
 
-        /* Process the template */
-        const QFileInfo fileInfo(templateFilePath);
-        QString         outputFileName = fileInfo.fileName();
-        /* Remove only the template extension (the last extension) */
-        const int lastDotIndex = static_cast<int>(outputFileName.lastIndexOf('.'));
-        if (lastDotIndex > 0) {
-            outputFileName = outputFileName.left(lastDotIndex);
-        }
+    QStringList failedTemplates;
+    generateManager->renderTemplates(
+        templates, csvFiles, yamlFiles, jsonFiles, rdlFiles, rcsvFiles, &failedTemplates);
 
-        if (!generateManager->renderTemplate(
-                templateFilePath,
-                csvFiles,
-                yamlFiles,
-                jsonFiles,
-                rdlFiles,
-                rcsvFiles,
-                outputFileName)) {
-            return showError(
+    const QDir outputDir(projectManager->getOutputPath());
+    for (const auto &[templateFilePath, outputFileName] : std::as_const(templates)) {
+        if (failedTemplates.contains(templateFilePath)) {
+            showError(
                 1,
                 QCoreApplication::translate("main", "Error: failed to render template: %1")
                     .arg(templateFilePath));
+        } else {
+            showInfo(
+                0,
+                QCoreApplication::translate("main", "Successfully generated file from template: %1")
+                    .arg(outputDir.filePath(outputFileName)));
         }
-
-        showInfo(
-            0,
-            QCoreApplication::translate("main", "Successfully generated file from template: %1")
-                .arg(QDir(projectManager->getOutputPath()).filePath(outputFileName)));
     }
 
+    if (!failedTemplates.isEmpty()) {
+        exitCode = 1;
+        return false;
+    }
     return true;
 }
 
+bool QSocCliWorker::processTemplateFile(
+    const QString     &templateFilePath,
+    const QStringList &csvFiles,
+    const QStringList &yamlFiles,
+    const QStringList &jsonFiles,
+    const QStringList &rdlFiles,
+    const QStringList &rcsvFiles)
+{
+    /* Check if the template file exists before trying to load it */
+    if (!QFile::exists(templateFilePath)) {
+        return showError(
+            101,
+            QCoreApplication::translate("main", "Error: Template file does not exist: \"%1\"")
+                .arg(templateFilePath));
+    }
+
+    /* Process the template */
+    const QString outputFileName = templateOutputFileName(templateFilePath);
+    if (!generateManager->renderTemplate(
+            templateFilePath,
+            csvFiles,
+            yamlFiles,
+            jsonFiles,
+            rdlFiles,
+            rcsvFiles,
+            outputFileName)) {
+        return showError(
+            1,
+            QCoreApplication::translate("main", "Error: failed to render template: %1")
+                .arg(templateFilePath));
+    }
+
+    return showInfo(
+        0,
+        QCoreApplication::translate("main", "Successfully generated file from template: %1")
+            .arg(QDir(projectManager->getOutputPath()).filePath(outputFileName)));
+}
+
 bool QSocCliWorker::parseGenerateStub(const QStringList &appArguments)
 {
     /* Clear upstream positional arguments and setup subcommand */
@@ -447,6 +612,9 @@ bool QSocCliWorker::parseGenerateStub(const QStringList &appArguments)
         {{"m", "module"},
          QCoreApplication::translate("main", "The module name or regex."),
          "module name or regex"},
+        {"watch",
+         QCoreApplication::translate(
+             "main", "Keep running and regenerate the outputs affected by each file change.")},
     });
 
     parser.addPositionalArgument(
@@ -511,6 +679,10 @@ bool QSocCliWorker::parseGenerateStub(const QStringList &appArguments)
         moduleRegex = QRegularExpression(parser.value("module"));
     }
 
+    if (parser.isSet("watch")) {
+        return watchGenerateStub(stubName, libraryRegex, moduleRegex);
+    }
+
     /* Generate stub files */
     if (!generateManager->generateStub(stubName, libraryRegex, moduleRegex)) {
         return showError(
@@ -0,0 +1,208 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Huang Rui <vowstar@gmail.com>
+
+#include "cli/qsoccliworker.h"
+#include "cli/qsocgeneratewatch.h"
+#include "common/qsocconsole.h"
+#include "common/qsocyamlfilecache.h"
+#include "common/qstaticregex.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+
+namespace {
+
+/* Module names instantiated by a netlist; empty when it does not parse. */
+QSet<QString> netlistModules(const QString &netlistFilePath)
+{
+    QSet<QString> modules;
+    try {
+        const YAML::Node netlist = YAML::LoadFile(netlistFilePath.toStdString());
+        if (netlist["instance"] && netlist["instance"].IsMap()) {
+            for (const auto &instance : netlist["instance"]) {
+                const YAML::Node module = instance.second["module"];
+                if (module && module.IsScalar()) {
+                    modules.insert(QString::fromStdString(module.as<std::string>()));
+                }
+            }
+        }
+    } catch (const YAML::Exception &) {
+        /* Reported by the build; keep the previous inputs meanwhile */
+    }
+    return modules;
+}
+
+/* Library files in @p dirPath with the given glob, as absolute paths. */
+QStringList libraryFiles(const QString &dirPath, const QString &nameFilter)
+{
+    QStringList files;
+    const QDir  dir(dirPath);
+    for (const QString &name : dir.entryList({nameFilter}, QDir::Files, QDir::Name)) {
+        files.append(dir.absoluteFilePath(name));
+    }
+    return files;
+}
+
+/* Reload the library behind a changed .soc_mod; returns the modules it
+ * defined before or after, which is what dependent outputs care about. */
+QSet<QString> reloadModuleLibrary(
+    QSocModuleManager *moduleManager, const QString &path, const QRegularExpression &libraryRegex)
+{
+    const QString libraryName = QFileInfo(path).completeBaseName();
+    QStringList   touched     = moduleManager->listModulesInLibrary(libraryName);
+    if (QFileInfo::exists(path)) {
+        moduleManager->load(libraryName);
+    } else {
+        /* Gone: a fresh load is the only way to drop its modules */
+        moduleManager->resetModuleData();
+        moduleManager->load(libraryRegex);
+    }
+    touched += moduleManager->listModulesInLibrary(libraryName);
+    return QSet<QString>(touched.begin(), touched.end());
+}
+
+} // namespace
+
+bool QSocCliWorker::runGenerateWatch(QSocGenerateWatch *watch)
+{
+    const auto report = [](const QStringList &targets, int failures) {
+        if (targets.isEmpty()) {
+            return;
+        }
+        if (failures > 0) {
+            QSocConsole::warn() << "Regenerated" << targets.size() << "target(s)," << failures
+                                << "failed";
+        } else {
+            QSocConsole::info() << "Regenerated" << targets.size() << "target(s)";
+        }
+    };
+    connect(watch, &QSocGenerateWatch::rebuilt, this, report);
+
+    watch->rebuildAll();
+    QSocConsole::info() << "Watching" << watch->targets().size()
+                        << "target(s) for changes, press Ctrl+C to stop.";
+    emit watching(watch);
+    watch->exec();
+    return true;
+}
+
+bool QSocCliWorker::watchGenerateVerilog(const QStringList &filePathList, bool mergeMode)
+{
+    const QString modulePath = projectManager->getModulePath();
+    const QString busPath    = projectManager->getBusPath();
+
+    QSocYamlFileCache parsedNetlists;
+    netlistCache = &parsedNetlists;
+
+    /* One target per output: each netlist, or the first one for a merge */
+    QHash<QString, QStringList> netlistsOf;
+    if (mergeMode) {
+        netlistsOf.insert(filePathList.first(), filePathList);
+    } else {
+        for (const QString &netlistFilePath : filePathList) {
+            netlistsOf.insert(netlistFilePath, {netlistFilePath});
+        }
+    }
+
+    QSocGenerateWatch             watch;
+    QHash<QString, QSet<QString>> modulesOf;
+
+    const auto refreshInputs = [&](const QString &target) {
+        QSet<QString> modules;
+        QStringList   paths = netlistsOf.value(target);
+        for (const QString &netlistFilePath : netlistsOf.value(target)) {
+            modules.unite(netlistModules(netlistFilePath));
+        }
+        for (const QString &moduleName : std::as_const(modules)) {
+            const QString libraryName = moduleManager->getModuleLibrary(moduleName);
+            if (!libraryName.isEmpty()) {
+                paths.append(QDir(modulePath).filePath(libraryName + ".soc_mod"));
+            }
+        }
+        modulesOf.insert(target, modules);
+        watch.setInputs(target, paths + libraryFiles(busPath, QStringLiteral("*.soc_bus")));
+    };
+    const QStringList targetOrder = mergeMode ? QStringList{filePathList.first()} : filePathList;
+    for (const QString &target : targetOrder) {
+        refreshInputs(target);
+    }
+
+    watch.watchDirectory(modulePath, {QStringLiteral("*.soc_mod")});
+    watch.watchDirectory(busPath, {QStringLiteral("*.soc_bus")});
+    watch.setReloader([&](const QString &path) -> QStringList {
+        const QFileInfo info(path);
+        if (info.suffix() == QStringLiteral("soc_bus")) {
+            /* Bus libraries are small; reload them all so removals stick */
+            busManager->resetBusData();
+            busManager->load(QRegularExpression(".*"));
+            return watch.targets();
+        }
+        if (info.suffix() != QStringLiteral("soc_mod")) {
+            return {};
+        }
+        const QSet<QString> touched
+            = reloadModuleLibrary(moduleManager, path, QRegularExpression(".*"));
+        QStringList affected;
+        for (const QString &target : watch.targets()) {
+            if (modulesOf.value(target).intersects(touched)) {
+                affected.append(target);
+            }
+        }
+        return affected;
+    });
+    watch.setBuilder([&](const QString &target) {
+        const bool result = mergeMode ? processMergedNetlists(netlistsOf.value(target))
+                                      : processNetlistFile(target);
+        refreshInputs(target);
+        return result;
+    });
+
+    const bool result = runGenerateWatch(&watch);
+    netlistCache      = nullptr;
+    return result;
+}
+
+bool QSocCliWorker::watchGenerateStub(
+    const QString            &stubName,
+    const QRegularExpression &libraryRegex,
+    const QRegularExpression &moduleRegex)
+{
+    const QString modulePath = projectManager->getModulePath();
+
+    QSocGenerateWatch watch;
+
+    const auto refreshInputs = [&]() {
+        QStringList paths;
+        for (const QString &libraryName : moduleManager->listLibrary(libraryRegex)) {
+            paths.append(QDir(modulePath).filePath(libraryName + ".soc_mod"));
+        }
+        watch.setInputs(stubName, paths);
+    };
+    refreshInputs();
+
+    watch.watchDirectory(modulePath, {QStringLiteral("*.soc_mod")});
+    watch.setReloader([&](const QString &path) -> QStringList {
+        const QString libraryName = QFileInfo(path).completeBaseName();
+        if (!QStaticRegex::isNameExactMatch(libraryName, libraryRegex)) {
+            return {};
+        }
+        reloadModuleLibrary(moduleManager, path, libraryRegex);
+        return {stubName};
+    });
+    watch.setBuilder([&](const QString &) {
+        refreshInputs();
+        if (!generateManager->generateStub(stubName, libraryRegex, moduleRegex)) {
+            return showError(
+                1,
+                QCoreApplication::translate("main", "Error: failed to generate stub files for: %1")
+                    .arg(stubName));
+        }
+        return showInfo(
+            0,
+            QCoreApplication::translate("main", "Successfully generated stub files: %1")
+                .arg(stubName));
+    });
+
+    return runGenerateWatch(&watch);
+}
@@ -90,6 +90,10 @@ bool QSocCliWorker::parseModuleImport(const QStringList &appArguments)
         {{"U", "undefine"},
          QCoreApplication::translate("main", "Undefine macro KEY at the start of all source files."),
          "macro name"},
+        {{"j", "jobs"},
+         QCoreApplication::translate(
+             "main", "Parse sources on this many threads, 0 for all cores (default 1)."),
+         "count"},
     });
     parser.addPositionalArgument(
         "files",
@@ -174,6 +178,17 @@ bool QSocCliWorker::parseModuleImport(const QStringList &appArguments)
                     .arg(macro));
         }
     }
+    if (parser.isSet("jobs")) {
+        bool      ok   = false;
+        const int jobs = parser.value("jobs").toInt(&ok);
+        if (!ok || jobs < 0) {
+            return showErrorWithHelp(
+                1,
+                QCoreApplication::translate("main", "Error: invalid job count: %1")
+                    .arg(parser.value("jobs")));
+        }
+        moduleManager->setImportJobs(jobs);
+    }
     if (!moduleManager->importFromFileList(
             libraryName, moduleNameRegex, filelistPath, filePathList, macroDefines, macroUndefines)) {
         return showErrorWithHelp(1, QCoreApplication::translate("main", "Error: import failed."));
@@ -20,6 +20,26 @@ QSocCliWorker::QSocCliWorker(QObject *parent)
     , busManager(new QSocBusManager(this, projectManager))
     , moduleManager(new QSocModuleManager(this, projectManager, busManager, llmService))
     , generateManager(new QSocGenerateManager(this, projectManager, moduleManager, busManager))
+{
+    setupParser();
+}
+
+QSocCliWorker::QSocCliWorker(QSocCliWorker *resident, QObject *parent)
+    : QObject(parent)
+    , embedded(true)
+    , projectManager(resident->projectManager)
+    , socConfig(resident->socConfig)
+    , llmService(resident->llmService)
+    , busManager(resident->busManager)
+    , moduleManager(resident->moduleManager)
+    , generateManager(resident->generateManager)
+{
+    setupParser();
+}
+
+QSocCliWorker::~QSocCliWorker() = default;
+
+void QSocCliWorker::setupParser()
 {
     /* Set up application name and version */
     QCoreApplication::setApplicationName("QSoC");
@@ -30,8 +50,6 @@ QSocCliWorker::QSocCliWorker(QObject *parent)
     parser.setOptionsAfterPositionalArgumentsMode(QCommandLineParser::ParseAsOptions);
 }
 
-QSocCliWorker::~QSocCliWorker() = default;
-
 void QSocCliWorker::setup(const QStringList &appArguments, bool isGui)
 {
     /* Set up exit code */
@@ -64,6 +82,27 @@ void QSocCliWorker::run()
     emit exit(exitCode);
 }
 
+int QSocCliWorker::execute(const QStringList &appArguments)
+{
+    if (embedded) {
+        /* Same starting point as a fresh process in this directory */
+        projectManager->reset();
+        busManager->resetBusData();
+        moduleManager->resetModuleData();
+        generateManager->resetGenerateData();
+    }
+    exitCode     = 0;
+    cmdArguments = appArguments;
+    parseRoot(cmdArguments);
+    return exitCode;
+}
+
+void QSocCliWorker::setYamlCache(QSocYamlFileCache *cache)
+{
+    busManager->setYamlCache(cache);
+    moduleManager->setYamlCache(cache);
+}
+
 bool QSocCliWorker::showVersion(int exitCode)
 {
     QSocConsole::out() << QCoreApplication::applicationName() << ' '
@@ -148,7 +187,8 @@ bool QSocCliWorker::parseRoot(const QStringList &appArguments)
             "bus         Import, update of bus.\n"
             "schematic   Processing of Schematic.\n"
             "generate    Generate rtl, such as verilog, etc.\n"
-            "agent       Run interactive AI agent mode.\n"),
+            "agent       Run interactive AI agent mode.\n"
+            "daemon      Serve commands from a resident process.\n"),
         "<command> [command options]");
     parser.parse(appArguments);
     /* Resolve --color before any output-emitting code runs. */
@@ -225,10 +265,22 @@ bool QSocCliWorker::parseRoot(const QStringList &appArguments)
         if (!parseAgent(nextArguments)) {
             return false;
         }
+    } else if (command == "daemon") {
+        nextArguments.removeOne(command);
+        if (!parseDaemon(nextArguments)) {
+            return false;
+        }
     } else {
         return showHelpOrError(
             1, QCoreApplication::translate("main", "Error: unknown subcommand: %1.").arg(command));
     }
+    if (embedded) {
+        /* process() would exit the hosting process on a bad option */
+        if (!parser.parse(appArguments)) {
+            return showError(1, parser.errorText());
+        }
+        return true;
+    }
     parser.process(*QCoreApplication::instance());
     return true;
 }
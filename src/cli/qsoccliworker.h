@@ -18,6 +18,8 @@
 #include <QStringList>
 
 class QSocAgent;
+class QSocGenerateWatch;
+class QSocYamlFileCache;
 class QAgentReadline;
 class QSocMcpManager;
 class QSocPathContext;
@@ -39,6 +41,16 @@ public:
      */
     explicit QSocCliWorker(QObject *parent = nullptr);
 
+    /**
+     * @brief Constructor sharing the managers of a resident worker.
+     * @details Used by the daemon to run one invocation against managers
+     *          that stay loaded between invocations. The managers remain
+     *          owned by @p resident, which must outlive this worker.
+     * @param[in] resident worker whose managers are borrowed.
+     * @param[in] parent parent object.
+     */
+    QSocCliWorker(QSocCliWorker *resident, QObject *parent = nullptr);
+
     /**
      * @brief Destructor for QSocCliWorker.
      * @details This destructor will free the command line parser.
@@ -62,6 +74,23 @@ public:
      */
     void process();
 
+    /**
+     * @brief Run one invocation synchronously and return its exit code.
+     * @details Unlike setup(), nothing is queued on the event loop and the
+     *          application is never asked to exit. A worker built on a
+     *          resident first resets the shared managers, so the result
+     *          matches a fresh process started in the current directory.
+     * @param appArguments command line arguments, program name first.
+     * @return exit code of the invocation.
+     */
+    int execute(const QStringList &appArguments);
+
+    /**
+     * @brief Share parsed library files across invocations.
+     * @param cache cache handed to the bus and module managers, not owned.
+     */
+    void setYamlCache(QSocYamlFileCache *cache);
+
 public slots:
     /**
      * @brief Run the command line parser.
@@ -77,7 +106,10 @@ private:
     QStringList cmdArguments;
 
     /* ExitCode of the application. */
-    int exitCode;
+    int exitCode = 0;
+
+    /* Runs inside another process (daemon); never exit the application. */
+    bool embedded = false;
 
     QSocProjectManager  *projectManager  = nullptr;
     QSocConfig          *socConfig       = nullptr;
@@ -87,6 +119,14 @@ private:
     QSocGenerateManager *generateManager = nullptr;
     QSocMcpManager      *mcpManager      = nullptr;
 
+    /* Parsed netlists reused across `generate verilog --watch` rebuilds, not owned. */
+    QSocYamlFileCache *netlistCache = nullptr;
+
+    /**
+     * @brief Set up application metadata and the root command line parser.
+     */
+    void setupParser();
+
     /**
      * @brief Parse the application command line arguments.
      * @details This function will parse the application command line arguments.
@@ -346,6 +386,27 @@ private:
      */
     bool processIndividualNetlists(const QStringList &filePathList);
 
+    /**
+     * @brief Generate Verilog code for one netlist file.
+     * @param netlistFilePath Netlist file to load, process and emit.
+     * @retval true Process successfully.
+     * @retval false Process failed.
+     */
+    bool processNetlistFile(const QString &netlistFilePath);
+
+    /**
+     * @brief Generate Verilog code again whenever an input changes.
+     * @details Builds every output once, then watches the netlists, the
+     *          module libraries they use and the bus libraries. A changed
+     *          library is reloaded on its own and only the outputs whose
+     *          modules it defines are regenerated.
+     * @param filePathList Netlist files, as given on the command line.
+     * @param mergeMode Whether the netlists form one merged output.
+     * @retval true Watch ended normally.
+     * @retval false Watch could not start.
+     */
+    bool watchGenerateVerilog(const QStringList &filePathList, bool mergeMode);
+
     /**
      * @brief Parse the generate template command line arguments.
      * @details This function will parse the generate template command line arguments
@@ -356,6 +417,27 @@ private:
      */
     bool parseGenerateTemplate(const QStringList &appArguments);
 
+    /**
+     * @brief Render one template into the project output directory.
+     * @details The output name is the template file name without its last
+     *          extension.
+     * @param templateFilePath Template file to render.
+     * @param csvFiles CSV data files.
+     * @param yamlFiles YAML data files.
+     * @param jsonFiles JSON data files.
+     * @param rdlFiles SystemRDL data files.
+     * @param rcsvFiles RCSV data files.
+     * @retval true Render successfully.
+     * @retval false Render failed.
+     */
+    bool processTemplateFile(
+        const QString     &templateFilePath,
+        const QStringList &csvFiles,
+        const QStringList &yamlFiles,
+        const QStringList &jsonFiles,
+        const QStringList &rdlFiles,
+        const QStringList &rcsvFiles);
+
     /**
      * @brief Parse the generate stub command line arguments.
      * @details This function will parse the generate stub command line arguments
@@ -366,6 +448,27 @@ private:
      */
     bool parseGenerateStub(const QStringList &appArguments);
 
+    /**
+     * @brief Generate stub files again whenever a module library changes.
+     * @param stubName Base name of the stub files.
+     * @param libraryRegex Libraries the stub draws from.
+     * @param moduleRegex Modules included in the stub.
+     * @retval true Watch ended normally.
+     * @retval false Watch could not start.
+     */
+    bool watchGenerateStub(
+        const QString            &stubName,
+        const QRegularExpression &libraryRegex,
+        const QRegularExpression &moduleRegex);
+
+    /**
+     * @brief Build every target of @p watch once, then serve changes.
+     * @param watch Watch with its targets, builder and reloader set.
+     * @retval true Watch ended normally.
+     * @retval false Watch could not start.
+     */
+    bool runGenerateWatch(QSocGenerateWatch *watch);
+
     /**
      * @brief Parse the agent command line arguments.
      * @details This function will parse the agent command line arguments
@@ -376,6 +479,17 @@ private:
      */
     bool parseAgent(const QStringList &appArguments);
 
+    /**
+     * @brief Parse the daemon command line arguments.
+     * @details This function will parse the daemon command line arguments
+     *          to serve CLI invocations over a local socket, or to stop a
+     *          running daemon.
+     * @param appArguments command line arguments.
+     * @retval true Parse successfully.
+     * @retval false Parse failed.
+     */
+    bool parseDaemon(const QStringList &appArguments);
+
     /**
      * @brief Run the agent interactive loop.
      * @details This function runs the interactive REPL loop for the agent.
@@ -471,6 +585,14 @@ signals:
      * @details This signal will be emitted when quit the application.
      */
     void quit();
+
+    /**
+     * @brief A `--watch` command built its outputs and waits for changes.
+     * @details @p watch lives until the command returns; its stop() slot
+     *          ends the command.
+     * @param watch The running watch.
+     */
+    void watching(QSocGenerateWatch *watch);
 };
 
 #endif // QSOCCLIWORKER_H
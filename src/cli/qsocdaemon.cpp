@@ -0,0 +1,599 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Huang Rui <vowstar@gmail.com>
+
+#include "cli/qsocdaemon.h"
+
+#include "cli/qsoccliworker.h"
+#include "common/qsocconfig.h"
+#include "common/qsocconsole.h"
+#include "common/qsocpaths.h"
+
+#include <nlohmann/json.hpp>
+
+#include <cstdio>
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QProcessEnvironment>
+#include <QtEndian>
+
+#ifdef Q_OS_UNIX
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using json = nlohmann::json;
+
+namespace {
+
+constexpr char kFrameRequest = 'R';
+constexpr char kFrameOut     = 'O';
+constexpr char kFrameErr     = 'E';
+constexpr char kFrameExit    = 'X';
+
+/* Upper bound for one frame; a request is a few hundred bytes. */
+constexpr quint32 kMaxFrameSize = 64U * 1024U * 1024U;
+
+/* Working directories kept resident at once. */
+constexpr int kMaxResidents = 8;
+
+/* Interactive or long-running commands, and the daemon itself, never run remotely. */
+bool runsLocalOnly(const QStringList &arguments)
+{
+    for (const QString &argument : arguments.mid(1)) {
+        if (argument == QStringLiteral("agent") || argument == QStringLiteral("gui")
+            || argument == QStringLiteral("daemon") || argument == QStringLiteral("--watch")) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#ifdef Q_OS_UNIX
+/* Sockets under the shared temp directory can be squatted or spoofed by
+ * another local user; keep them in a directory only the owner can enter. */
+QString runtimeDirectory()
+{
+    const QString runtime = QString::fromLocal8Bit(qgetenv("XDG_RUNTIME_DIR"));
+    if (!runtime.isEmpty()) {
+        return QDir(runtime).filePath(QStringLiteral("qsoc"));
+    }
+    return QDir(QDir::tempPath()).filePath(QStringLiteral("qsoc-%1").arg(getuid()));
+}
+
+bool ensurePrivateDirectory(const QString &path, QString *errorMessage)
+{
+    const QByteArray native = QFile::encodeName(path);
+    if (::mkdir(native.constData(), 0700) != 0 && errno != EEXIST) {
+        if (errorMessage != nullptr) {
+            *errorMessage = QStringLiteral("cannot create %1").arg(path);
+        }
+        return false;
+    }
+    struct stat info{};
+    if (::lstat(native.constData(), &info) != 0 || !S_ISDIR(info.st_mode)
+        || info.st_uid != getuid() || (info.st_mode & 077) != 0) {
+        if (errorMessage != nullptr) {
+            *errorMessage = QStringLiteral("%1 is not a private directory of this user").arg(path);
+        }
+        return false;
+    }
+    return true;
+}
+#endif
+
+/* True when the process at the other end of @p descriptor runs as this
+ * user. Named pipes elsewhere are already limited by UserAccessOption. */
+bool peerIsCurrentUser(qintptr descriptor)
+{
+#if defined(Q_OS_LINUX)
+    struct ucred credentials{};
+    socklen_t    length = sizeof(credentials);
+    if (::getsockopt(
+            static_cast<int>(descriptor), SOL_SOCKET, SO_PEERCRED, &credentials, &length)
+        != 0) {
+        return false;
+    }
+    return credentials.uid == getuid();
+#elif defined(Q_OS_UNIX)
+    uid_t uid = 0;
+    gid_t gid = 0;
+    if (::getpeereid(static_cast<int>(descriptor), &uid, &gid) != 0) {
+        return false;
+    }
+    return uid == getuid();
+#else
+    Q_UNUSED(descriptor);
+    return true;
+#endif
+}
+
+/* The client environment for the length of one call. Config loading,
+ * path lookup and the project manager all read the live process
+ * environment, so a forwarded call only sees what a local run would once
+ * the client's variables are in place. The daemon's own come back after. */
+class ScopedEnvironment
+{
+public:
+    explicit ScopedEnvironment(const QStringList &entries)
+    {
+        if (entries.isEmpty()) {
+            return;
+        }
+        QProcessEnvironment target;
+        for (const QString &entry : entries) {
+            const qsizetype equals = entry.indexOf(QLatin1Char('='));
+            if (equals > 0) {
+                target.insert(entry.left(equals), entry.mid(equals + 1));
+            }
+        }
+        saved  = QProcessEnvironment::systemEnvironment();
+        active = true;
+        apply(target);
+    }
+
+    ~ScopedEnvironment()
+    {
+        if (active) {
+            apply(saved);
+        }
+    }
+
+    ScopedEnvironment(const ScopedEnvironment &)            = delete;
+    ScopedEnvironment &operator=(const ScopedEnvironment &) = delete;
+
+private:
+    static void apply(const QProcessEnvironment &target)
+    {
+        const QStringList current = QProcessEnvironment::systemEnvironment().keys();
+        for (const QString &key : current) {
+            if (!key.startsWith(QLatin1Char('=')) && !target.contains(key)) {
+                qunsetenv(key.toLocal8Bit().constData());
+            }
+        }
+        const QStringList keys = target.keys();
+        for (const QString &key : keys) {
+            qputenv(key.toLocal8Bit().constData(), target.value(key).toLocal8Bit());
+        }
+    }
+
+    QProcessEnvironment saved;
+    bool                active = false;
+};
+
+/* What a resident's config and LLM service were built from: the process
+ * environment and the size and mtime of every config file it loads. */
+QByteArray residentFingerprint(const QString &cwd)
+{
+    QStringList lines = QProcessEnvironment::systemEnvironment().toStringList();
+    lines.sort();
+    QStringList configs;
+    for (const QString &root : QSocPaths::resourceDirs(QString())) {
+        configs << QDir(root).filePath(QSocConfig::CONFIG_FILE_NAME);
+    }
+    configs << QDir(cwd).filePath(QSocConfig::CONFIG_FILE_PROJECT);
+    for (const QString &path : std::as_const(configs)) {
+        const QFileInfo info(path);
+        lines << (info.exists() ? QStringLiteral("%1 %2 %3")
+                                      .arg(
+                                          path,
+                                          QString::number(info.size()),
+                                          QString::number(info.lastModified().toMSecsSinceEpoch()))
+                                : path);
+    }
+    const QByteArray stamp = lines.join(QLatin1Char('\n')).toUtf8();
+    return QCryptographicHash::hash(stamp, QCryptographicHash::Sha1);
+}
+
+/* Console output of one call, sent to the client as O / E frames. */
+class FrameSink : public QIODevice
+{
+public:
+    FrameSink(QLocalSocket *socket, char kind)
+        : m_socket(socket)
+        , m_kind(kind)
+    {
+        setOpenMode(WriteOnly);
+    }
+
+protected:
+    qint64 writeData(const char *data, qint64 len) override
+    {
+        if (len > 0 && m_socket->state() == QLocalSocket::ConnectedState) {
+            m_socket->write(QSocDaemon::encodeFrame(m_kind, QByteArray(data, len)));
+            m_socket->flush();
+        }
+        return len;
+    }
+
+    qint64 readData(char * /*data*/, qint64 /*len*/) override { return -1; }
+
+private:
+    QLocalSocket *m_socket;
+    char          m_kind;
+};
+
+} // namespace
+
+QSocDaemon::QSocDaemon(QObject *parent)
+    : QObject(parent)
+{
+    idleTimer.setSingleShot(true);
+    connect(&idleTimer, &QTimer::timeout, this, [this]() {
+        QSocConsole::info() << "Daemon idle, exiting.";
+        emit finished();
+    });
+}
+
+QSocDaemon::~QSocDaemon() = default;
+
+QString QSocDaemon::defaultServerName()
+{
+#ifdef Q_OS_UNIX
+    return serverPath(QStringLiteral("daemon"));
+#else
+    QString user = QString::fromLocal8Bit(qgetenv("USER"));
+    if (user.isEmpty()) {
+        user = QString::fromLocal8Bit(qgetenv("USERNAME"));
+    }
+    return user.isEmpty() ? QStringLiteral("qsoc-daemon")
+                          : QStringLiteral("qsoc-daemon-%1").arg(user);
+#endif
+}
+
+QString QSocDaemon::serverPath(const QString &serverName)
+{
+#ifdef Q_OS_UNIX
+    if (!serverName.contains(QLatin1Char('/'))) {
+        return QDir(runtimeDirectory()).filePath(serverName);
+    }
+#endif
+    return serverName;
+}
+
+bool QSocDaemon::listen(const QString &serverName, QString *errorMessage)
+{
+    const QString path = serverPath(serverName);
+#ifdef Q_OS_UNIX
+    if (QFileInfo(path).absolutePath() == runtimeDirectory()
+        && !ensurePrivateDirectory(runtimeDirectory(), errorMessage)) {
+        return false;
+    }
+#endif
+
+    /* A live daemon answers; only then is the name really taken. */
+    QLocalSocket probe;
+    probe.connectToServer(path);
+    if (probe.waitForConnected(200)) {
+        if (errorMessage != nullptr) {
+            *errorMessage = QStringLiteral("a daemon is already serving %1").arg(path);
+        }
+        return false;
+    }
+    QLocalServer::removeServer(path);
+
+    server = new QLocalServer(this);
+    server->setSocketOptions(QLocalServer::UserAccessOption);
+    if (!server->listen(path)) {
+        if (errorMessage != nullptr) {
+            *errorMessage = server->errorString();
+        }
+        return false;
+    }
+    connect(server, &QLocalServer::newConnection, this, &QSocDaemon::onNewConnection);
+    return true;
+}
+
+void QSocDaemon::setIdleTimeout(int msec)
+{
+    idleTimer.setInterval(msec);
+    if (msec > 0) {
+        idleTimer.start();
+    } else {
+        idleTimer.stop();
+    }
+}
+
+QByteArray QSocDaemon::encodeFrame(char kind, const QByteArray &payload)
+{
+    QByteArray frame(4, '\0');
+    qToBigEndian<quint32>(static_cast<quint32>(payload.size() + 1), frame.data());
+    frame.append(kind);
+    frame.append(payload);
+    return frame;
+}
+
+bool QSocDaemon::takeFrame(QByteArray *buffer, char *kind, QByteArray *payload)
+{
+    if (buffer->size() < 5) {
+        return false;
+    }
+    const quint32 length = qFromBigEndian<quint32>(buffer->constData());
+    if (length == 0 || length > kMaxFrameSize) {
+        /* Not our protocol; drop everything and let the caller see no frame. */
+        buffer->clear();
+        return false;
+    }
+    if (static_cast<quint64>(buffer->size()) < 4ULL + length) {
+        return false;
+    }
+    *kind    = buffer->at(4);
+    *payload = buffer->mid(5, static_cast<qsizetype>(length) - 1);
+    buffer->remove(0, 4 + static_cast<qsizetype>(length));
+    return true;
+}
+
+void QSocDaemon::onNewConnection()
+{
+    while (QLocalSocket *socket = server->nextPendingConnection()) {
+        if (!peerIsCurrentUser(socket->socketDescriptor())) {
+            QSocConsole::warn() << "Daemon refused a connection from another user.";
+            socket->abort();
+            socket->deleteLater();
+            continue;
+        }
+        clients.insert(socket, Client{socket, QByteArray()});
+        connect(socket, &QLocalSocket::readyRead, this, [this, socket]() { onReadyRead(socket); });
+        connect(socket, &QLocalSocket::disconnected, this, [this, socket]() {
+            clients.remove(socket);
+            queue.removeAll(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void QSocDaemon::onReadyRead(QLocalSocket *socket)
+{
+    auto client = clients.find(socket);
+    if (client == clients.end()) {
+        return;
+    }
+    client->buffer.append(socket->readAll());
+    if (client->buffer.size() >= 5 && !queue.contains(socket)) {
+        const quint32 length = qFromBigEndian<quint32>(client->buffer.constData());
+        if (static_cast<quint64>(client->buffer.size()) >= 4ULL + length) {
+            queue.append(socket);
+        }
+    }
+    drainQueue();
+}
+
+void QSocDaemon::drainQueue()
+{
+    /* A call may spin a nested event loop; later requests wait their turn. */
+    if (busy) {
+        return;
+    }
+    busy = true;
+    while (!queue.isEmpty()) {
+        QLocalSocket *socket = queue.takeFirst();
+        auto          client = clients.find(socket);
+        if (client == clients.end()) {
+            continue;
+        }
+        char       kind = 0;
+        QByteArray payload;
+        if (!takeFrame(&client->buffer, &kind, &payload) || kind != kFrameRequest) {
+            socket->disconnectFromServer();
+            continue;
+        }
+        idleTimer.stop();
+        serve(socket, payload);
+        if (idleTimer.interval() > 0) {
+            idleTimer.start();
+        }
+    }
+    busy = false;
+}
+
+void QSocDaemon::serve(QLocalSocket *socket, const QByteArray &request)
+{
+    int  exitCode = 1;
+    bool stopping = false;
+    try {
+        const json message = json::parse(request.toStdString());
+        if (message.value("stop", false)) {
+            stopping = true;
+            exitCode = 0;
+        } else {
+            QStringList arguments;
+            for (const auto &argument : message.at("argv")) {
+                arguments.append(QString::fromStdString(argument.get<std::string>()));
+            }
+            QStringList environment;
+            for (const auto &entry : message.value("env", json::array())) {
+                environment.append(QString::fromStdString(entry.get<std::string>()));
+            }
+            exitCode = runCall(
+                socket,
+                arguments,
+                QString::fromStdString(message.value("cwd", std::string())),
+                environment,
+                message.value("color", false));
+        }
+    } catch (const json::exception &e) {
+        socket->write(encodeFrame(
+            kFrameErr, QByteArray("qsoc daemon: bad request: ") + e.what() + QByteArray("\n")));
+    }
+    socket->write(encodeFrame(kFrameExit, QByteArray::number(exitCode)));
+    socket->flush();
+    socket->disconnectFromServer();
+    if (stopping) {
+        QSocConsole::info() << "Daemon stopped by client.";
+        emit finished();
+    }
+}
+
+int QSocDaemon::runCall(
+    QLocalSocket      *socket,
+    const QStringList &arguments,
+    const QString     &cwd,
+    const QStringList &environment,
+    bool               color)
+{
+    const ScopedEnvironment scopedEnvironment(environment);
+    if (cwd.isEmpty() || !QDir::setCurrent(cwd)) {
+        socket->write(encodeFrame(
+            kFrameErr, QStringLiteral("qsoc daemon: cannot enter %1\n").arg(cwd).toUtf8()));
+        return 1;
+    }
+    if (runsLocalOnly(arguments)) {
+        socket->write(encodeFrame(
+            kFrameErr, QByteArrayLiteral("qsoc daemon: interactive commands run locally\n")));
+        return 1;
+    }
+    QSocCliWorker *resident = residentFor(QDir::currentPath());
+
+    const QSocConsole::Level     level     = QSocConsole::level();
+    const QSocConsole::ColorMode colorMode = QSocConsole::colorMode();
+    FrameSink                    outSink(socket, kFrameOut);
+    FrameSink                    errSink(socket, kFrameErr);
+    QSocConsole::setOutputDevice(&outSink);
+    QSocConsole::setErrorDevice(&errSink);
+    QSocConsole::setLevel(QSocConsole::Level::Info);
+    QSocConsole::setColorMode(
+        color ? QSocConsole::ColorMode::Always : QSocConsole::ColorMode::Never);
+
+    int exitCode = 1;
+    {
+        QSocCliWorker call(resident);
+        exitCode = call.execute(arguments);
+    }
+
+    QSocConsole::out().flush();
+    QSocConsole::err().flush();
+    QSocConsole::setOutputDevice(nullptr);
+    QSocConsole::setErrorDevice(nullptr);
+    QSocConsole::setLevel(level);
+    QSocConsole::setColorMode(colorMode);
+    return exitCode;
+}
+
+QSocCliWorker *QSocDaemon::residentFor(const QString &cwd)
+{
+    auto found = residents.find(cwd);
+    if (found != residents.end()) {
+        if (found->fingerprint == residentFingerprint(cwd)) {
+            return found->worker;
+        }
+        /* Config and LLM service are only read at construction; a new
+         * environment or an edited config needs a new resident. */
+        delete found->worker;
+        residents.erase(found);
+    }
+    if (residents.size() >= kMaxResidents) {
+        /* Managers are reset per call anyway; any one can go, the parse cache stays. */
+        auto victim = residents.begin();
+        delete victim->worker;
+        residents.erase(victim);
+    }
+    /* Constructed with cwd and the client environment current, so its
+     * config and paths follow them. */
+    auto *resident = new QSocCliWorker(this);
+    resident->setYamlCache(&yamlCache);
+    /* Stamped after construction: a first run may seed the user config. */
+    residents.insert(cwd, Resident{residentFingerprint(cwd), resident});
+    return resident;
+}
+
+bool QSocDaemon::forward(const QString &serverName, const QStringList &arguments, int *exitCode)
+{
+    QLocalSocket socket;
+    socket.connectToServer(serverPath(serverName));
+    if (!socket.waitForConnected(500)) {
+        return false;
+    }
+    /* Never hand argv and the environment to someone else's listener. */
+    if (!peerIsCurrentUser(socket.socketDescriptor())) {
+        std::fputs("qsoc: daemon socket is owned by another user, running locally\n", stderr);
+        return false;
+    }
+
+    json argv = json::array();
+    for (const QString &argument : arguments) {
+        argv.push_back(argument.toStdString());
+    }
+    json env = json::array();
+    for (const QString &entry : QProcessEnvironment::systemEnvironment().toStringList()) {
+        env.push_back(entry.toStdString());
+    }
+    const json request
+        = {{"argv", argv},
+           {"cwd", QDir::currentPath().toStdString()},
+           {"env", env},
+           {"color", QSocConsole::colorEnabled()}};
+    socket.write(encodeFrame(kFrameRequest, QByteArray::fromStdString(request.dump())));
+    socket.flush();
+
+    QByteArray buffer;
+    bool       produced = false;
+    while (true) {
+        buffer.append(socket.readAll());
+        char       kind = 0;
+        QByteArray payload;
+        while (takeFrame(&buffer, &kind, &payload)) {
+            if (kind == kFrameExit) {
+                *exitCode = payload.toInt();
+                return true;
+            }
+            FILE *stream = kind == kFrameErr ? stderr : stdout;
+            std::fwrite(payload.constData(), 1, static_cast<size_t>(payload.size()), stream);
+            std::fflush(stream);
+            produced = true;
+        }
+        if (!socket.waitForReadyRead(-1) && socket.bytesAvailable() == 0) {
+            break;
+        }
+    }
+    if (!produced) {
+        return false;
+    }
+    /* Output already went out; rerunning locally would repeat it. */
+    std::fputs("qsoc: daemon connection lost\n", stderr);
+    *exitCode = 1;
+    return true;
+}
+
+bool QSocDaemon::forwardFromEnvironment(const QStringList &arguments, int *exitCode)
+{
+    const QString setting = QString::fromLocal8Bit(qgetenv("QSOC_DAEMON"));
+    if (setting.isEmpty() || setting == QStringLiteral("0")) {
+        return false;
+    }
+    if (runsLocalOnly(arguments)) {
+        return false;
+    }
+    const QString serverName = setting == QStringLiteral("1") ? defaultServerName() : setting;
+    return forward(serverName, arguments, exitCode);
+}
+
+bool QSocDaemon::stop(const QString &serverName)
+{
+    QLocalSocket socket;
+    socket.connectToServer(serverPath(serverName));
+    if (!socket.waitForConnected(500) || !peerIsCurrentUser(socket.socketDescriptor())) {
+        return false;
+    }
+    const json request = {{"stop", true}};
+    socket.write(encodeFrame(kFrameRequest, QByteArray::fromStdString(request.dump())));
+    socket.flush();
+    QByteArray buffer;
+    while (socket.waitForReadyRead(5000)) {
+        buffer.append(socket.readAll());
+        char       kind = 0;
+        QByteArray payload;
+        while (takeFrame(&buffer, &kind, &payload)) {
+            if (kind == kFrameExit) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Huang Rui <vowstar@gmail.com>
+
+#ifndef QSOCDAEMON_H
+#define QSOCDAEMON_H
+
+#include "common/qsocyamlfilecache.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+class QLocalServer;
+class QLocalSocket;
+class QSocCliWorker;
+
+/**
+ * @brief Resident process serving `qsoc` invocations over a local socket.
+ * @details `qsoc daemon` keeps one set of project, bus, module and generate
+ *          managers per working directory, plus a parsed-library cache
+ *          keyed by file size and mtime. A client started with QSOC_DAEMON
+ *          set forwards its argv, working directory, environment and color
+ *          choice, and receives stdout, stderr and the exit code back. The
+ *          call runs under the client environment, and a resident built for
+ *          another environment or before a config file changed is rebuilt.
+ *          Every call starts from reset managers, so only the YAML parsing
+ *          and the process start-up are saved; results match a cold run.
+ *          Calls run one at a time in arrival order.
+ *
+ *          Wire format, both directions: 4-byte big-endian length, then one
+ *          kind byte and the payload. Kinds are `R` (request JSON), `O` and
+ *          `E` (stdout and stderr bytes) and `X` (decimal exit code).
+ */
+class QSocDaemon : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit QSocDaemon(QObject *parent = nullptr);
+    ~QSocDaemon() override;
+
+    /** @brief Per-user server name used when none is given. */
+    static QString defaultServerName();
+
+    /**
+     * @brief Where the socket for @p serverName lives.
+     * @details On Unix a bare name resolves inside a private per-user
+     *          directory, `$XDG_RUNTIME_DIR/qsoc` or else `<tmp>/qsoc-<uid>`,
+     *          rather than the shared temporary directory. Paths, and names
+     *          on other platforms, are returned unchanged.
+     */
+    static QString serverPath(const QString &serverName);
+
+    /**
+     * @brief Start listening; a stale socket left by a crashed daemon is removed.
+     * @details The per-user directory is created with mode 0700 and refused
+     *          when it is owned by someone else or open to others.
+     *          Connections from other users are dropped.
+     */
+    bool listen(const QString &serverName, QString *errorMessage = nullptr);
+
+    /** @brief Quit after this long without a call; 0 keeps running. */
+    void setIdleTimeout(int msec);
+
+    QSocYamlFileCache::Stats cacheStats() const { return yamlCache.stats(); }
+
+    /**
+     * @brief Run @p arguments on a daemon instead of in this process.
+     * @details Streams the daemon output to this process's stdout and
+     *          stderr as it arrives.
+     * @retval true The daemon ran the call; @p exitCode holds its result.
+     * @retval false No daemon owned by this user answered before any
+     *               output; run locally.
+     */
+    static bool forward(const QString &serverName, const QStringList &arguments, int *exitCode);
+
+    /**
+     * @brief forward() driven by the QSOC_DAEMON environment variable.
+     * @details Unset, empty or `0` disables forwarding, `1` uses the
+     *          default server name and anything else names the server.
+     *          Interactive commands (`agent`, `gui`), `--watch` loops and
+     *          `daemon` itself always run locally.
+     */
+    static bool forwardFromEnvironment(const QStringList &arguments, int *exitCode);
+
+    /** @brief Ask the daemon behind @p serverName to quit. */
+    static bool stop(const QString &serverName);
+
+    /** @brief One frame on the wire. */
+    static QByteArray encodeFrame(char kind, const QByteArray &payload);
+
+    /**
+     * @brief Take the first complete frame off the front of @p buffer.
+     * @return False while the frame is still incomplete.
+     */
+    static bool takeFrame(QByteArray *buffer, char *kind, QByteArray *payload);
+
+signals:
+    /** @brief Emitted when the daemon was stopped or sat idle too long. */
+    void finished();
+
+private:
+    struct Client
+    {
+        QLocalSocket *socket = nullptr;
+        QByteArray    buffer;
+    };
+
+    struct Resident
+    {
+        QByteArray     fingerprint; /* environment and config stamps it was built under */
+        QSocCliWorker *worker = nullptr;
+    };
+
+    void onNewConnection();
+    void onReadyRead(QLocalSocket *socket);
+    void drainQueue();
+    void serve(QLocalSocket *socket, const QByteArray &request);
+    int  runCall(
+        QLocalSocket      *socket,
+        const QStringList &arguments,
+        const QString     &cwd,
+        const QStringList &environment,
+        bool               color);
+    QSocCliWorker *residentFor(const QString &cwd);
+
+    QLocalServer                 *server = nullptr;
+    QHash<QLocalSocket *, Client> clients;
+    QList<QLocalSocket *>         queue; /* sockets with a complete request */
+    QHash<QString, Resident>      residents;
+    QSocYamlFileCache             yamlCache;
+    QTimer                        idleTimer;
+    bool                          busy = false;
+};
+
+#endif // QSOCDAEMON_H
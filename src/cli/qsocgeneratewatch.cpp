@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Huang Rui <vowstar@gmail.com>
+
+#include "cli/qsocgeneratewatch.h"
+
+#include <QDir>
+#include <QEventLoop>
+#include <QFileInfo>
+
+namespace {
+
+QString cleanPath(const QString &path)
+{
+    return QDir::cleanPath(QFileInfo(path).absoluteFilePath());
+}
+
+} // namespace
+
+QSocGenerateWatch::QSocGenerateWatch(QObject *parent)
+    : QObject(parent)
+{
+    debounceTimer.setSingleShot(true);
+    debounceTimer.setInterval(200);
+    connect(&debounceTimer, &QTimer::timeout, this, &QSocGenerateWatch::flush);
+    connect(&watcher, &QFileSystemWatcher::fileChanged, this, &QSocGenerateWatch::onPathChanged);
+    connect(
+        &watcher,
+        &QFileSystemWatcher::directoryChanged,
+        this,
+        &QSocGenerateWatch::onDirectoryChanged);
+}
+
+QSocGenerateWatch::~QSocGenerateWatch() = default;
+
+void QSocGenerateWatch::setInputs(const QString &target, const QStringList &paths)
+{
+    if (!inputs.contains(target)) {
+        targetOrder.append(target);
+    }
+    QStringList cleaned;
+    for (const QString &path : paths) {
+        const QString clean = cleanPath(path);
+        if (!cleaned.contains(clean)) {
+            cleaned.append(clean);
+        }
+        rewatch(clean);
+    }
+    inputs.insert(target, cleaned);
+}
+
+void QSocGenerateWatch::watchDirectory(const QString &path, const QStringList &nameFilters)
+{
+    const QString clean = cleanPath(path);
+    directories.insert(clean, Directory{nameFilters, scanDirectory(clean, nameFilters)});
+    if (!watcher.directories().contains(clean)) {
+        watcher.addPath(clean);
+    }
+}
+
+QHash<QString, qint64> QSocGenerateWatch::scanDirectory(
+    const QString &path, const QStringList &nameFilters) const
+{
+    QHash<QString, qint64> files;
+    const QDir             dir(path);
+    for (const QFileInfo &info : dir.entryInfoList(nameFilters, QDir::Files)) {
+        files.insert(cleanPath(info.filePath()), info.lastModified().toMSecsSinceEpoch());
+    }
+    return files;
+}
+
+void QSocGenerateWatch::rewatch(const QString &path)
+{
+    /* Editors that save by rename drop the path from the watcher */
+    if (!watcher.files().contains(path) && QFileInfo::exists(path)) {
+        watcher.addPath(path);
+    }
+}
+
+void QSocGenerateWatch::onPathChanged(const QString &path)
+{
+    pending.insert(path);
+    rewatch(path);
+    debounceTimer.start();
+}
+
+void QSocGenerateWatch::onDirectoryChanged(const QString &path)
+{
+    auto directory = directories.find(path);
+    if (directory == directories.end()) {
+        return;
+    }
+    const QHash<QString, qint64> now = scanDirectory(path, directory->nameFilters);
+    for (auto it = now.constBegin(); it != now.constEnd(); ++it) {
+        if (directory->files.value(it.key(), -1) != it.value()) {
+            pending.insert(it.key());
+        }
+    }
+    for (auto it = directory->files.constBegin(); it != directory->files.constEnd(); ++it) {
+        if (!now.contains(it.key())) {
+            pending.insert(it.key());
+        }
+    }
+    directory->files = now;
+    if (!pending.isEmpty()) {
+        debounceTimer.start();
+    }
+}
+
+void QSocGenerateWatch::flush()
+{
+    QStringList changed(pending.begin(), pending.end());
+    pending.clear();
+    changed.sort();
+    for (const QString &path : changed) {
+        rewatch(path);
+    }
+    apply(changed);
+}
+
+QStringList QSocGenerateWatch::apply(const QStringList &changedPaths)
+{
+    QSet<QString> changed;
+    QSet<QString> affected;
+    for (const QString &path : changedPaths) {
+        const QString clean = cleanPath(path);
+        changed.insert(clean);
+        if (reloader) {
+            const QStringList extra = reloader(clean);
+            affected.unite(QSet<QString>(extra.begin(), extra.end()));
+        }
+    }
+    for (const QString &target : std::as_const(targetOrder)) {
+        for (const QString &input : inputs.value(target)) {
+            if (changed.contains(input)) {
+                affected.insert(target);
+                break;
+            }
+        }
+    }
+
+    return build(affected);
+}
+
+QStringList QSocGenerateWatch::rebuildAll()
+{
+    return build(QSet<QString>(targetOrder.begin(), targetOrder.end()));
+}
+
+QStringList QSocGenerateWatch::build(const QSet<QString> &affected)
+{
+    /* Builders may update inputs, so walk a copy */
+    const QStringList order = targetOrder;
+    QStringList       rebuiltTargets;
+    int               failures = 0;
+    for (const QString &target : order) {
+        if (!affected.contains(target)) {
+            continue;
+        }
+        rebuiltTargets.append(target);
+        if (builder && !builder(target)) {
+            failures++;
+        }
+    }
+    emit rebuilt(rebuiltTargets, failures);
+    return rebuiltTargets;
+}
+
+void QSocGenerateWatch::exec()
+{
+    QEventLoop local;
+    loop = &local;
+    local.exec();
+    loop = nullptr;
+}
+
+void QSocGenerateWatch::stop()
+{
+    debounceTimer.stop();
+    if (loop != nullptr) {
+        loop->quit();
+    }
+}
@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Huang Rui <vowstar@gmail.com>
+
+#ifndef QSOCGENERATEWATCH_H
+#define QSOCGENERATEWATCH_H
+
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+#include <functional>
+
+class QEventLoop;
+
+/**
+ * @brief File-driven rebuild loop behind `qsoc generate ... --watch`.
+ * @details Each target (one output, or one group of outputs) lists the
+ *          files it was built from. A batch of changed files, collected
+ *          after a quiet period so an editor's save burst counts once, is
+ *          first handed to the reloader, which refreshes in-memory state
+ *          such as a module library and may name further affected targets.
+ *          Then only the targets depending on a changed file are rebuilt,
+ *          in the order they were added. Watched directories are listed
+ *          on every change so added and deleted files show up as changed
+ *          paths too. All paths are absolute and cleaned.
+ */
+class QSocGenerateWatch : public QObject
+{
+    Q_OBJECT
+
+public:
+    /** @brief Rebuild one target; false reports a failed build. */
+    using Builder = std::function<bool(const QString &target)>;
+
+    /** @brief Refresh state for a changed path; returns extra affected targets. */
+    using Reloader = std::function<QStringList(const QString &path)>;
+
+    explicit QSocGenerateWatch(QObject *parent = nullptr);
+    ~QSocGenerateWatch() override;
+
+    void setBuilder(Builder builder) { this->builder = std::move(builder); }
+    void setReloader(Reloader reloader) { this->reloader = std::move(reloader); }
+
+    /** @brief Quiet period before a batch is processed, 200 ms by default. */
+    void setDebounce(int msec) { debounceTimer.setInterval(msec); }
+
+    /** @brief Add a target or replace its inputs; the inputs are watched. */
+    void setInputs(const QString &target, const QStringList &paths);
+
+    /** @brief Report files added to or removed from @p path matching @p nameFilters. */
+    void watchDirectory(const QString &path, const QStringList &nameFilters);
+
+    QStringList targets() const { return targetOrder; }
+
+    /**
+     * @brief Process one batch of changed paths now.
+     * @return Targets rebuilt, in target order.
+     */
+    QStringList apply(const QStringList &changedPaths);
+
+    /** @brief Build every target once, as the initial pass before watching. */
+    QStringList rebuildAll();
+
+    /** @brief Serve change batches until stop() is called. */
+    void exec();
+
+public slots:
+    void stop();
+
+signals:
+    /** @brief Emitted after each batch with the rebuilt targets and failures. */
+    void rebuilt(const QStringList &targets, int failures);
+
+private:
+    void        onPathChanged(const QString &path);
+    void        onDirectoryChanged(const QString &path);
+    void        flush();
+    void        rewatch(const QString &path);
+    QStringList build(const QSet<QString> &affected);
+
+    struct Directory
+    {
+        QStringList            nameFilters;
+        QHash<QString, qint64> files; /* absolute path -> mtime in ms */
+    };
+
+    QHash<QString, qint64> scanDirectory(const QString &path, const QStringList &nameFilters) const;
+
+    QFileSystemWatcher          watcher;
+    QTimer                      debounceTimer;
+    QSet<QString>               pending;
+    QStringList                 targetOrder;
+    QHash<QString, QStringList> inputs;
+    QHash<QString, Directory>   directories;
+    Builder                     builder;
+    Reloader                    reloader;
+    QEventLoop                 *loop = nullptr;
+};
+
+#endif // QSOCGENERATEWATCH_H
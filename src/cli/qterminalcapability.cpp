@@ -182,6 +182,33 @@ void QTerminalCapability::refreshSize()
     detectSize();
 }
 
+bool QTerminalCapability::supportsSynchronizedOutput() const
+{
+    if (!stdoutIsatty) {
+        return false;
+    }
+
+    const QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+    if (env.contains("WT_SESSION")) {
+        return true;
+    }
+
+    static const QStringList syncPrograms
+        = {"WezTerm", "iTerm.app", "ghostty", "vscode", "contour", "rio"};
+    if (syncPrograms.contains(env.value("TERM_PROGRAM"))) {
+        return true;
+    }
+
+    static const QStringList syncTerms
+        = {"xterm-kitty", "xterm-ghostty", "foot", "alacritty", "contour"};
+    for (const QString &term : syncTerms) {
+        if (terminalType == term || terminalType.startsWith(term + "-")) {
+            return true;
+        }
+    }
+    return false;
+}
+
 QString QTerminalCapability::termType() const
 {
     return terminalType;
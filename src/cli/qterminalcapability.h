@@ -67,6 +67,15 @@ public:
      */
     void refreshSize();
 
+    /**
+     * @brief Check if the terminal implements synchronized output
+     * @details Mode 2026 lets the terminal present a frame at once. Only
+     *          terminals known to implement it qualify, since others may
+     *          show the private mode sequences or stall on them.
+     * @return True if TERM, TERM_PROGRAM or WT_SESSION names such a terminal
+     */
+    bool supportsSynchronizedOutput() const;
+
     /**
      * @brief Get terminal type from TERM environment
      * @return Terminal type string (e.g., "xterm-256color")
@@ -5,16 +5,24 @@
 #include "common/qsocconsole.h"
 #include "common/qstaticstringweaver.h"
 
+#include <QDateTime>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QProcess>
 #include <QRegularExpression>
+#include <QSet>
 #include <QTemporaryFile>
 #include <QTextStream>
+#include <QThread>
 
 #include <algorithm>
 #include <stdexcept>
 #include <string>
+#include <utility>
 
 #include <slang/ast/ASTSerializer.h>
 #include <slang/ast/ASTVisitor.h>
@@ -54,8 +62,52 @@ QSocProjectManager *QSlangDriver::getProjectManager()
     return projectManager;
 }
 
+void QSlangDriver::setParseJobs(int jobs)
+{
+    parseJobs = qMax(0, jobs);
+}
+
+bool QSlangDriver::isLastParseCached() const
+{
+    return lastParseCached;
+}
+
+void QSlangDriver::clearCompilationCache()
+{
+    cacheKey.clear();
+    cacheStamps.clear();
+    lastParseCached = false;
+}
+
+namespace {
+
+/* slang captures driver output in process-wide buffers, so drivers on
+ * different threads take turns */
+QMutex slangOutputMutex;
+
+/* Modification time and size of each file, missing files included */
+QHash<QString, QPair<qint64, qint64>> stampSources(const QStringList &filePaths)
+{
+    QHash<QString, QPair<qint64, qint64>> stamps;
+    for (const QString &filePath : filePaths) {
+        const QFileInfo info(filePath);
+        stamps.insert(
+            filePath,
+            info.exists() ? qMakePair(info.lastModified().toMSecsSinceEpoch(), info.size())
+                          : qMakePair(qint64(-1), qint64(-1)));
+    }
+    return stamps;
+}
+
+} // namespace
+
 bool QSlangDriver::parseArgs(const QString &args, bool silent)
 {
+    /* Whatever this call produces replaces the cached compilation */
+    clearCompilationCache();
+    parsedSources.clear();
+
+    const QMutexLocker locker(&slangOutputMutex);
     slang::OS::setStderrColorsEnabled(false);
     slang::OS::setStdoutColorsEnabled(false);
 
@@ -67,7 +119,7 @@ bool QSlangDriver::parseArgs(const QString &args, bool silent)
     bool result = false;
     try {
         if (!silent) {
-            QSocConsole::debug().noquote().nospace() << Q_FUNC_INFO << ":" << "Arguments:" + args;
+            QSOC_DEBUG().noquote().nospace() << Q_FUNC_INFO << ":" << "Arguments:" + args;
         }
         slang::OS::capturedStdout.clear();
         slang::OS::capturedStderr.clear();
@@ -108,6 +160,13 @@ bool QSlangDriver::parseArgs(const QString &args, bool silent)
             }
             throw std::runtime_error("Failed to parse sources");
         }
+        for (const slang::BufferID buffer : driver.sourceManager.getAllBuffers()) {
+            const QString path = QString::fromStdString(
+                driver.sourceManager.getFullPath(buffer).string());
+            if (!path.isEmpty() && QFileInfo(path).isFile()) {
+                parsedSources.insert(path);
+            }
+        }
         slang::OS::capturedStdout.clear();
         slang::OS::capturedStderr.clear();
         driver.reportMacros();
@@ -165,7 +224,7 @@ bool QSlangDriver::parseArgs(const QString &args, bool silent)
 
         /* Print partial AST */
         if (!silent) {
-            QSocConsole::debugPlain() << ast.dump(4).c_str();
+            QSOC_DEBUG_PLAIN() << ast.dump(4).c_str();
         }
     } catch (const std::exception &e) {
         /* Handle error */
@@ -173,6 +232,7 @@ bool QSlangDriver::parseArgs(const QString &args, bool silent)
             QSocConsole::error().noquote().nospace() << Q_FUNC_INFO << ":" << e.what();
         }
     }
+    lastParseStderr = QString::fromStdString(slang::OS::capturedStderr);
     return result;
 }
 
@@ -184,6 +244,7 @@ bool QSlangDriver::parseFileList(
 {
     bool    result  = false;
     QString content = "";
+    lastParseCached = false;
     if (!QFileInfo::exists(fileListPath) && filePathList.isEmpty()) {
         QSocConsole::error().noquote().nospace()
             << Q_FUNC_INFO
@@ -191,7 +252,7 @@ bool QSlangDriver::parseFileList(
     } else {
         /* Process read file list path */
         if (QFileInfo::exists(fileListPath)) {
-            QSocConsole::debug().noquote().nospace()
+            QSOC_DEBUG().noquote().nospace()
                 << Q_FUNC_INFO << ":" << "Use file list path:" + fileListPath;
             /* Read text from filelist */
             QFile inputFile(fileListPath);
@@ -205,7 +266,7 @@ bool QSlangDriver::parseFileList(
         }
         /* Process append of file path list */
         if (!filePathList.isEmpty()) {
-            QSocConsole::debug().noquote().nospace()
+            QSOC_DEBUG().noquote().nospace()
                 << Q_FUNC_INFO << ":" << "Use file path list:" + filePathList.join(",");
             /* Append file path list to the end of content */
             content.append("\n" + filePathList.join("\n"));
@@ -228,6 +289,23 @@ bool QSlangDriver::parseFileList(
         if (QFileInfo::exists(fileListPath)) {
             content = contentValidFile(content, QFileInfo(fileListPath).absoluteDir());
         }
+        QStringList sourceFiles;
+        for (const QString &line : content.split('\n', Qt::SkipEmptyParts)) {
+            const QString path = line.trimmed();
+            if (!path.startsWith('-') && !path.startsWith('+') && QFileInfo(path).isFile()) {
+                sourceFiles.append(path);
+            }
+        }
+        /* Same list, macros and unchanged sources: keep the current compilation */
+        const QString key
+            = QStringList{content, macroDefines.join('\n'), macroUndefines.join('\n')}.join(
+                QChar(0));
+        if (compilation && key == cacheKey && stampSources(cacheStamps.keys()) == cacheStamps) {
+            QSocConsole::info() << "Reusing compilation of" << cacheStamps.size()
+                                << "unchanged source files";
+            lastParseCached = true;
+            return true;
+        }
         /* Create a temporary file */
         QTemporaryFile tempFile("qsoc.fl");
         /* Do not remove file after close */
@@ -242,7 +320,6 @@ bool QSlangDriver::parseFileList(
             QString baseArgs = QStaticStringWeaver::stripCommonLeadingWhitespace(R"(
                 slang
                 --ignore-unknown-modules
-                --single-unit
                 --compat vcs
                 --timescale 1ns/10ps
                 --error-limit=0
@@ -269,16 +346,52 @@ bool QSlangDriver::parseFileList(
             }
             /* Add file list */
             baseArgs += QString(" -f \"%1\"").arg(tempFile.fileName());
-            const QString args = baseArgs;
             /* clang-format on */
 
-            QSocConsole::debug().noquote().nospace()
+            QSOC_DEBUG().noquote().nospace()
                 << Q_FUNC_INFO << ":" << "TemporaryFile name:" + tempFile.fileName();
-            QSocConsole::debug().noquote().nospace() << Q_FUNC_INFO << ":" << "Content list begin";
-            QSocConsole::debug().noquote().nospace()
+            QSOC_DEBUG().noquote().nospace() << Q_FUNC_INFO << ":" << "Content list begin";
+            QSOC_DEBUG().noquote().nospace()
                 << Q_FUNC_INFO << ":" << content.toStdString().c_str();
-            QSocConsole::debug().noquote().nospace() << Q_FUNC_INFO << ":" << "Content list end";
-            result = parseArgs(args);
+            QSOC_DEBUG().noquote().nospace() << Q_FUNC_INFO << ":" << "Content list end";
+
+            /* Separate units parse in parallel, unless macros flow across files */
+            const int threads = parseJobs == 0 ? QThread::idealThreadCount() : parseJobs;
+            if (threads > 1) {
+                QString singleUnitReason;
+                if (!findCrossFileMacroSource(sourceFiles, &singleUnitReason).isEmpty()) {
+                    QSocConsole::info() << "Parsing as a single unit," << singleUnitReason;
+                } else {
+                    QElapsedTimer timer;
+                    timer.start();
+                    /* Hold output back so a failed attempt leaves no trace */
+                    QSocConsole::Capture parallelLog;
+                    {
+                        const QSocConsole::CaptureScope scope(parallelLog);
+                        result = parseArgs(baseArgs + QString(" --threads %1").arg(threads));
+                    }
+                    if (result) {
+                        parallelLog.replay();
+                        QSocConsole::info()
+                            << QString("Parsed %1 files on %2 threads (%3 cores) in %4 ms")
+                                   .arg(sourceFiles.size())
+                                   .arg(threads)
+                                   .arg(QThread::idealThreadCount())
+                                   .arg(timer.elapsed());
+                    } else {
+                        QSocConsole::info() << "Parallel parse failed, retrying as a single unit";
+                    }
+                }
+            }
+            if (!result) {
+                result = parseArgs(baseArgs + " --single-unit");
+            }
+            if (result) {
+                QSet<QString> stamped(sourceFiles.cbegin(), sourceFiles.cend());
+                stamped.unite(parsedSources);
+                cacheKey    = key;
+                cacheStamps = stampSources(stamped.values());
+            }
             /* Delete temporary file */
             tempFile.remove();
         }
@@ -361,6 +474,93 @@ QString QSlangDriver::contentValidFile(const QString &content, const QDir &baseD
     return result.join("\n");
 }
 
+QString QSlangDriver::findCrossFileMacroSource(const QStringList &filePaths, QString *reason)
+{
+    static const QRegularExpression commentRegex(
+        R"(//[^\n]*|/\*.*?\*/)", QRegularExpression::DotMatchesEverythingOption);
+    static const QRegularExpression directiveRegex(
+        R"(`(define|undef|undefineall|ifdef|ifndef|elsif)\b\s*([A-Za-z_][A-Za-z0-9_$]*)?)"
+        R"(|`([A-Za-z_][A-Za-z0-9_$]*))");
+    static const QRegularExpression nettypeValueRegex(R"(\G\s*([A-Za-z_]+))");
+
+    const auto found = [reason](const QString &filePath, const QString &why) {
+        if (reason) {
+            *reason = why.arg(filePath);
+        }
+        return filePath;
+    };
+
+    /* Macros still defined after each file, with the file that defined them */
+    QHash<QString, QString> liveMacros;
+    /* Files whose `timescale or `default_nettype is still in effect */
+    QString liveTimescale;
+    QString liveNettype;
+    for (qsizetype index = 0; index < filePaths.size(); ++index) {
+        const QString &filePath = filePaths.at(index);
+        QFile          file(filePath);
+        if (!file.open(QIODevice::ReadOnly)) {
+            continue;
+        }
+        const QString text = QString::fromUtf8(file.readAll()).remove(commentRegex);
+        const bool    last = index + 1 == filePaths.size();
+
+        /* Last `timescale and `default_nettype state of this file; empty
+         * when untouched, "reset" after `resetall */
+        QHash<QString, QString> defined;
+        QString                 timescale;
+        QString                 nettype;
+        auto                    it = directiveRegex.globalMatch(text);
+        while (it.hasNext()) {
+            const QRegularExpressionMatch match     = it.next();
+            const QString                 directive = match.captured(1);
+            const QString                 name      = directive.isEmpty() ? match.captured(3)
+                                                                          : match.captured(2);
+            if (directive == "define") {
+                defined.insert(name, filePath);
+            } else if (directive == "undef") {
+                defined.remove(name);
+                liveMacros.remove(name);
+            } else if (directive == "undefineall") {
+                defined.clear();
+                liveMacros.clear();
+            } else if (name == "include") {
+                /* Headers are not scanned; their macros and state may leak on */
+                if (!last) {
+                    return found(filePath, QStringLiteral("%1 includes headers"));
+                }
+            } else if (name == "timescale") {
+                timescale = QStringLiteral("set");
+            } else if (name == "default_nettype") {
+                const QRegularExpressionMatch value
+                    = nettypeValueRegex.match(text, match.capturedEnd());
+                nettype = value.hasMatch() ? value.captured(1) : QStringLiteral("set");
+            } else if (name == "resetall") {
+                timescale = nettype = QStringLiteral("reset");
+            } else if (!defined.contains(name) && liveMacros.contains(name)) {
+                /* Expanded or tested here, but defined by an earlier file */
+                const QString source = liveMacros.value(name);
+                return found(source, QStringLiteral("%1 defines macros used by later files"));
+            }
+        }
+
+        /* Separate units fall back to the command line `timescale and nettype */
+        if (timescale.isEmpty() && !liveTimescale.isEmpty()) {
+            return found(liveTimescale, QStringLiteral("%1 sets `timescale for later files"));
+        }
+        if (nettype.isEmpty() && !liveNettype.isEmpty()) {
+            return found(liveNettype, QStringLiteral("%1 sets `default_nettype for later files"));
+        }
+        if (!timescale.isEmpty()) {
+            liveTimescale = timescale == "reset" ? QString() : filePath;
+        }
+        if (!nettype.isEmpty()) {
+            liveNettype = nettype == "reset" || nettype == "wire" ? QString() : filePath;
+        }
+        liveMacros.insert(defined);
+    }
+    return {};
+}
+
 QSet<QString> QSlangDriver::extractAllIdentifiers(const QString &verilogCode)
 {
     QSet<QString> identifiers;
@@ -521,9 +721,6 @@ bool QSlangDriver::parseVerilogSnippet(const QString &verilogCode, bool wrapInMo
     tempFile1.flush();
     tempFile1.close();
 
-    /* Save original stderr content */
-    std::string originalStderr = slang::OS::capturedStderr;
-
     /* Try first parse - may fail, use silent mode to suppress expected errors during probing */
     QString args1
         = QString("slang --single-unit --ignore-unknown-modules %1").arg(tempFile1.fileName());
@@ -538,10 +735,7 @@ bool QSlangDriver::parseVerilogSnippet(const QString &verilogCode, bool wrapInMo
     /* First pass failed, continue to extract undeclared identifiers */
 
     /* Extract stderr from parseArgs */
-    QString stderrOutput = QString::fromStdString(slang::OS::capturedStderr);
-
-    /* Restore original stderr */
-    slang::OS::capturedStderr = originalStderr;
+    const QString stderrOutput = lastParseStderr;
 
     /* Extract undeclared identifiers from error messages */
     QSet<QString>                   undeclaredIds;
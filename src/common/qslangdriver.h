@@ -8,7 +8,9 @@
 
 #include <memory>
 #include <QDir>
+#include <QHash>
 #include <QObject>
+#include <QSet>
 #include <QString>
 #include <QStringList>
 
@@ -57,6 +59,35 @@ public slots:
      * @return QSocProjectManager * Pointer to the current project manager.
      */
     QSocProjectManager *getProjectManager();
+
+    /**
+     * @brief Set the number of parser threads for parseFileList().
+     * @details 1 (the default) parses the file list as one compilation unit
+     *          on the calling thread. Any other value parses files as
+     *          separate units on that many threads, 0 meaning one per core.
+     *          Parallel parsing falls back to a single unit whenever macros
+     *          from one file may be visible in a later one.
+     * @param jobs Thread count, 0 for all cores.
+     */
+    void setParseJobs(int jobs);
+
+    /**
+     * @brief Check whether the last parseFileList() reused a compilation.
+     * @details parseFileList() keeps its compilation while the resolved file
+     *          list, macro options and every source file read by the parser
+     *          (includes too) are unchanged in size and modification time.
+     *          A matching call then returns at once with the same AST.
+     * @retval true The last parseFileList() call was served from the cache.
+     * @retval false The last call parsed and elaborated the sources.
+     */
+    bool isLastParseCached() const;
+
+    /**
+     * @brief Drop the reusable compilation.
+     * @details The next parseFileList() call parses the sources again.
+     */
+    void clearCompilationCache();
+
     /**
      * @brief Parse command line arguments.
      * @details This function will parse command line arguments.
@@ -173,6 +204,23 @@ public:
      */
     QString contentValidFile(const QString &content, const QDir &baseDir);
 
+    /**
+     * @brief Find a file whose preprocessor state reaches a later file.
+     * @details Single-unit parsing lets a `define in one file affect every
+     *          file after it. This scans the files in order and reports the
+     *          first file that defines a macro (not undefined again in the
+     *          same file) which a later file expands or tests with
+     *          `ifdef, `ifndef or `elsif. A `timescale or `default_nettype
+     *          that a later file does not set again counts too. Included
+     *          headers are not scanned, so any file but the last with an
+     *          `include is reported as well.
+     * @param filePaths Source files in parse order.
+     * @param reason Set to a short explanation when a file is reported.
+     * @return QString Path of the reported file, or empty when files are
+     *         independent and can be parsed as separate units.
+     */
+    QString findCrossFileMacroSource(const QStringList &filePaths, QString *reason = nullptr);
+
 private:
     /* Pointer of project manager. */
     QSocProjectManager *projectManager = nullptr;
@@ -182,6 +230,18 @@ private:
     json ast;
     /* Module list. */
     QStringList moduleList;
+    /* Parser threads for parseFileList, 1 keeps single-unit parsing. */
+    int parseJobs = 1;
+    /* Files read by the last parseArgs, as reported by the source manager. */
+    QSet<QString> parsedSources;
+    /* slang error output of the last parseArgs stage that ran. */
+    QString lastParseStderr;
+    /* Key of the parseFileList call that produced the current compilation. */
+    QString cacheKey;
+    /* Modification time and size of each source when the cache was filled. */
+    QHash<QString, QPair<qint64, qint64>> cacheStamps;
+    /* Whether the last parseFileList call reused the compilation. */
+    bool lastParseCached = false;
 };
 
 #endif // QSLANGDRIVER_H
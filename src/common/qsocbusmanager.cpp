@@ -399,6 +399,11 @@ void QSocBusManager::resetBusData()
     QSocConsole::debug() << "Bus data has been reset.";
 }
 
+void QSocBusManager::setYamlCache(QSocYamlFileCache *cache)
+{
+    yamlCache = cache;
+}
+
 bool QSocBusManager::importFromFileList(
     const QString &libraryName, const QString &busName, const QStringList &filePathList)
 {
@@ -1266,7 +1271,8 @@ bool QSocBusManager::load(const QString &libraryName)
 
     try {
         /* Load YAML content into a temporary node */
-        YAML::Node tempNode = YAML::Load(fileStream);
+        YAML::Node tempNode = yamlCache != nullptr ? yamlCache->load(filePath)
+                                                   : YAML::Load(fileStream);
 
         /* Iterate through the temporary node and add to busData */
         for (YAML::const_iterator it = tempNode.begin(); it != tempNode.end(); ++it) {
@@ -5,6 +5,7 @@
 #define QSOCBUSMANAGER_H
 
 #include "common/qsocprojectmanager.h"
+#include "common/qsocyamlfilecache.h"
 
 #include <QList>
 #include <QObject>
@@ -118,6 +119,15 @@ public slots:
      */
     void resetBusData();
 
+    /**
+     * @brief Share parsed library files across loads.
+     * @details When set, load() takes library trees from @p cache instead of
+     *          parsing each file again. The cache is not owned; nullptr (the
+     *          default) parses on every load.
+     * @param cache Cache to use, or nullptr.
+     */
+    void setYamlCache(QSocYamlFileCache *cache);
+
     /**
      * @brief Import CSV files into bus library.
      * @details Imports CSV files, specified in filePathList, into the
@@ -417,6 +427,9 @@ private:
     /* Internal used project manager. */
     QSocProjectManager *projectManager = nullptr;
 
+    /* Parsed library files shared across loads, not owned. */
+    QSocYamlFileCache *yamlCache = nullptr;
+
     /* This QMap, libraryMap, maps library names to sets of bus names.
        Each key in the map is a library name (QString).
        The corresponding value is a QSet<QString> containing the names
@@ -376,6 +376,7 @@ bool QSocConfig::createTemplateConfig(const QString &filePath)
     out << "# web:\n";
     out << "#   search_api_url: http://localhost:8080  # SearXNG API URL\n";
     out << "#   search_api_key:                        # SearXNG API key (optional)\n";
+    out << "#   cache_max_mb: 64                       # web_fetch cache size, 0 disables\n";
 
     file.close();
 
@@ -8,6 +8,7 @@
 #include <QIODevice>
 #include <QtGlobal>
 
+#include <atomic>
 #include <cstdio>
 
 #ifdef Q_OS_WIN
@@ -22,11 +23,11 @@
 
 namespace {
 
-QSocConsole::Level     g_level        = QSocConsole::Level::Info;
-QSocConsole::ColorMode g_colorMode    = QSocConsole::ColorMode::Auto;
-QtMessageHandler       g_priorHandler = nullptr;
-bool                   g_handlerOwned = false;
-bool                   g_teeToHandler = false;
+std::atomic<QSocConsole::Level> g_level{QSocConsole::Level::Info};
+QSocConsole::ColorMode          g_colorMode    = QSocConsole::ColorMode::Auto;
+QtMessageHandler                g_priorHandler = nullptr;
+bool                            g_handlerOwned = false;
+bool                            g_teeToHandler = false;
 
 bool envSetNonEmpty(const char *name)
 {
@@ -147,9 +148,67 @@ QTextStream &errStream()
     return s_stream;
 }
 
+/* Capture installed on this thread by QSocConsole::CaptureScope, if any. */
+thread_local QSocConsole::Capture *t_capture = nullptr;
+
+/* Device behind the per-thread raw streams while a capture is installed. */
+class CaptureSink : public QIODevice
+{
+public:
+    explicit CaptureSink(bool error)
+        : m_error(error)
+    {
+        setOpenMode(WriteOnly);
+    }
+
+protected:
+    qint64 writeData(const char *data, qint64 len) override
+    {
+        if (t_capture != nullptr) {
+            t_capture->append(
+                m_error ? QSocConsole::Capture::Kind::Err : QSocConsole::Capture::Kind::Out,
+                QSocConsole::Level::Silent,
+                QString::fromUtf8(data, len));
+        }
+        return len;
+    }
+
+    qint64 readData(char * /*data*/, qint64 /*len*/) override { return -1; }
+
+private:
+    bool m_error;
+};
+
+QTextStream &captureOutStream()
+{
+    thread_local CaptureSink s_sink(false);
+    thread_local QTextStream s_stream(&s_sink);
+    return s_stream;
+}
+
+QTextStream &captureErrStream()
+{
+    thread_local CaptureSink s_sink(true);
+    thread_local QTextStream s_stream(&s_sink);
+    return s_stream;
+}
+
+/* Push pending raw text into the capture so it keeps its place in order. */
+void flushCaptureStreams()
+{
+    captureOutStream().flush();
+    captureErrStream().flush();
+}
+
 void writeSeverity(QSocConsole::Level lvl, const QString &text, bool plain)
 {
-    if (lvl == QSocConsole::Level::Silent || lvl > QSocConsole::level()) {
+    if (!QSocConsole::isEnabled(lvl)) {
+        return;
+    }
+    if (t_capture != nullptr) {
+        using Kind = QSocConsole::Capture::Kind;
+        flushCaptureStreams();
+        t_capture->append(plain ? Kind::SeverityPlain : Kind::Severity, lvl, text);
         return;
     }
     QTextStream &out   = errStream();
@@ -178,6 +237,7 @@ void writeSeverity(QSocConsole::Level lvl, const QString &text, bool plain)
 QSocConsole::Stream::Stream(Routing routing, Level level)
     : m_routing(routing)
     , m_level(level)
+    , m_enabled(isEnabled(level))
 {}
 
 QSocConsole::Stream::Stream(Stream &&other) noexcept
@@ -187,13 +247,14 @@ QSocConsole::Stream::Stream(Stream &&other) noexcept
     , m_first(other.m_first)
     , m_autoSpace(other.m_autoSpace)
     , m_alive(other.m_alive)
+    , m_enabled(other.m_enabled)
 {
     other.m_alive = false;
 }
 
 QSocConsole::Stream::~Stream()
 {
-    if (!m_alive) {
+    if (!m_alive || !m_enabled) {
         return;
     }
     /* All Stream instances are Severity or SeverityPlain. The raw streams
@@ -201,146 +262,168 @@ QSocConsole::Stream::~Stream()
     writeSeverity(m_level, m_buffer, m_routing == Routing::SeverityPlain);
 }
 
-void QSocConsole::Stream::appendSpace()
+bool QSocConsole::Stream::appendSpace()
 {
+    if (!m_enabled) {
+        return false;
+    }
     if (!m_first && m_autoSpace) {
         m_buffer.append(QChar::fromLatin1(' '));
     }
     m_first = false;
+    return true;
 }
 
 QSocConsole::Stream &QSocConsole::Stream::operator<<(QStringView text)
 {
-    appendSpace();
-    m_buffer.append(text);
+    if (appendSpace()) {
+        m_buffer.append(text);
+    }
     return *this;
 }
 
 QSocConsole::Stream &QSocConsole::Stream::operator<<(const QString &text)
 {
-    appendSpace();
-    m_buffer.append(text);
+    if (appendSpace()) {
+        m_buffer.append(text);
+    }
     return *this;
 }
 
 QSocConsole::Stream &QSocConsole::Stream::operator<<(const QByteArray &bytes)
 {
-    appendSpace();
-    m_buffer.append(QString::fromUtf8(bytes));
+    if (appendSpace()) {
+        m_buffer.append(QString::fromUtf8(bytes));
+    }
     return *this;
 }
 
 QSocConsole::Stream &QSocConsole::Stream::operator<<(const QStringList &list)
 {
-    appendSpace();
-    m_buffer.append(QChar::fromLatin1('('));
-    for (qsizetype i = 0; i < list.size(); ++i) {
-        if (i > 0) {
-            m_buffer.append(QStringLiteral(", "));
+    if (appendSpace()) {
+        m_buffer.append(QChar::fromLatin1('('));
+        for (qsizetype i = 0; i < list.size(); ++i) {
+            if (i > 0) {
+                m_buffer.append(QStringLiteral(", "));
+            }
+            m_buffer.append(QChar::fromLatin1('"'));
+            m_buffer.append(list.at(i));
+            m_buffer.append(QChar::fromLatin1('"'));
         }
-        m_buffer.append(QChar::fromLatin1('"'));
-        m_buffer.append(list.at(i));
-        m_buffer.append(QChar::fromLatin1('"'));
+        m_buffer.append(QChar::fromLatin1(')'));
     }
-    m_buffer.append(QChar::fromLatin1(')'));
     return *this;
 }
 
 QSocConsole::Stream &QSocConsole::Stream::operator<<(const char *text)
 {
-    appendSpace();
-    m_buffer.append(QString::fromUtf8(text));
+    if (appendSpace()) {
+        m_buffer.append(QString::fromUtf8(text));
+    }
     return *this;
 }
 
 QSocConsole::Stream &QSocConsole::Stream::operator<<(const std::string &text)
 {
-    appendSpace();
-    m_buffer.append(QString::fromUtf8(text.data(), static_cast<qsizetype>(text.size())));
+    if (appendSpace()) {
+        m_buffer.append(QString::fromUtf8(text.data(), static_cast<qsizetype>(text.size())));
+    }
     return *this;
 }
 
 QSocConsole::Stream &QSocConsole::Stream::operator<<(std::string_view text)
 {
-    appendSpace();
-    m_buffer.append(QString::fromUtf8(text.data(), static_cast<qsizetype>(text.size())));
+    if (appendSpace()) {
+        m_buffer.append(QString::fromUtf8(text.data(), static_cast<qsizetype>(text.size())));
+    }
     return *this;
 }
 
 QSocConsole::Stream &QSocConsole::Stream::operator<<(QChar ch)
 {
-    appendSpace();
-    m_buffer.append(ch);
+    if (appendSpace()) {
+        m_buffer.append(ch);
+    }
     return *this;
 }
 
 QSocConsole::Stream &QSocConsole::Stream::operator<<(char ch)
 {
-    appendSpace();
-    m_buffer.append(QChar::fromLatin1(ch));
+    if (appendSpace()) {
+        m_buffer.append(QChar::fromLatin1(ch));
+    }
     return *this;
 }
 
 QSocConsole::Stream &QSocConsole::Stream::operator<<(bool value)
 {
-    appendSpace();
-    m_buffer.append(QString::fromLatin1(value ? "true" : "false"));
+    if (appendSpace()) {
+        m_buffer.append(QString::fromLatin1(value ? "true" : "false"));
+    }
     return *this;
 }
 
 QSocConsole::Stream &QSocConsole::Stream::operator<<(int value)
 {
-    appendSpace();
-    m_buffer.append(QString::number(value));
+    if (appendSpace()) {
+        m_buffer.append(QString::number(value));
+    }
     return *this;
 }
 
 QSocConsole::Stream &QSocConsole::Stream::operator<<(long value)
 {
-    appendSpace();
-    m_buffer.append(QString::number(value));
+    if (appendSpace()) {
+        m_buffer.append(QString::number(value));
+    }
     return *this;
 }
 
 QSocConsole::Stream &QSocConsole::Stream::operator<<(long long value)
 {
-    appendSpace();
-    m_buffer.append(QString::number(value));
+    if (appendSpace()) {
+        m_buffer.append(QString::number(value));
+    }
     return *this;
 }
 
 QSocConsole::Stream &QSocConsole::Stream::operator<<(unsigned value)
 {
-    appendSpace();
-    m_buffer.append(QString::number(value));
+    if (appendSpace()) {
+        m_buffer.append(QString::number(value));
+    }
     return *this;
 }
 
 QSocConsole::Stream &QSocConsole::Stream::operator<<(unsigned long value)
 {
-    appendSpace();
-    m_buffer.append(QString::number(value));
+    if (appendSpace()) {
+        m_buffer.append(QString::number(value));
+    }
     return *this;
 }
 
 QSocConsole::Stream &QSocConsole::Stream::operator<<(unsigned long long value)
 {
-    appendSpace();
-    m_buffer.append(QString::number(value));
+    if (appendSpace()) {
+        m_buffer.append(QString::number(value));
+    }
     return *this;
 }
 
 QSocConsole::Stream &QSocConsole::Stream::operator<<(double value)
 {
-    appendSpace();
-    m_buffer.append(QString::number(value));
+    if (appendSpace()) {
+        m_buffer.append(QString::number(value));
+    }
     return *this;
 }
 
 QSocConsole::Stream &QSocConsole::Stream::operator<<(const void *ptr)
 {
-    appendSpace();
-    m_buffer.append(QString::asprintf("%p", ptr));
+    if (appendSpace()) {
+        m_buffer.append(QString::asprintf("%p", ptr));
+    }
     return *this;
 }
 
@@ -364,6 +447,48 @@ QSocConsole::Stream &QSocConsole::Stream::space()
     return *this;
 }
 
+/* ===== Capture ===== */
+
+void QSocConsole::Capture::append(Kind kind, Level level, const QString &text)
+{
+    m_records.append({kind, level, text});
+}
+
+void QSocConsole::Capture::replay() const
+{
+    for (const Record &record : m_records) {
+        switch (record.kind) {
+        case Kind::Severity:
+            writeSeverity(record.level, record.text, false);
+            break;
+        case Kind::SeverityPlain:
+            writeSeverity(record.level, record.text, true);
+            break;
+        case Kind::Out:
+            QSocConsole::out() << record.text;
+            QSocConsole::out().flush();
+            break;
+        case Kind::Err:
+            QSocConsole::err() << record.text;
+            QSocConsole::err().flush();
+            break;
+        }
+    }
+}
+
+QSocConsole::CaptureScope::CaptureScope(Capture &capture)
+    : m_previous(t_capture)
+{
+    flushCaptureStreams();
+    t_capture = &capture;
+}
+
+QSocConsole::CaptureScope::~CaptureScope()
+{
+    flushCaptureStreams();
+    t_capture = m_previous;
+}
+
 /* ===== QSocConsole statics ===== */
 
 void QSocConsole::install()
@@ -387,12 +512,17 @@ void QSocConsole::restore()
 
 void QSocConsole::setLevel(Level lvl)
 {
-    g_level = lvl;
+    g_level.store(lvl, std::memory_order_relaxed);
 }
 
 QSocConsole::Level QSocConsole::level()
 {
-    return g_level;
+    return g_level.load(std::memory_order_relaxed);
+}
+
+bool QSocConsole::isEnabled(Level lvl)
+{
+    return lvl != Level::Silent && lvl <= level();
 }
 
 void QSocConsole::setColorMode(ColorMode mode)
@@ -405,6 +535,11 @@ QSocConsole::ColorMode QSocConsole::colorMode()
     return g_colorMode;
 }
 
+bool QSocConsole::colorEnabled()
+{
+    return colorEnabledOn(stderr);
+}
+
 QSocConsole::Stream QSocConsole::error()
 {
     return Stream(Stream::Routing::Severity, Level::Error);
@@ -449,11 +584,17 @@ QSocConsole::Stream QSocConsole::criticalPlain()
 
 QTextStream &QSocConsole::out()
 {
+    if (t_capture != nullptr) {
+        return captureOutStream();
+    }
     return outStream();
 }
 
 QTextStream &QSocConsole::err()
 {
+    if (t_capture != nullptr) {
+        return captureErrStream();
+    }
     return errStream();
 }
 
@@ -4,6 +4,7 @@
 #ifndef QSOCCONSOLE_H
 #define QSOCCONSOLE_H
 
+#include <QList>
 #include <QString>
 #include <QStringView>
 #include <QTextStream>
@@ -29,6 +30,11 @@ class QIODevice;
  * Severity functions return a Stream proxy supporting Qt-style << chains
  * with auto-spacing (qDebug.noquote() ergonomics) and auto-newline on
  * destruction. Print functions return raw QTextStream for partial writes.
+ *
+ * A Stream whose level is filtered out drops every << without formatting,
+ * but the operands are still evaluated. Where building them is expensive
+ * (AST dumps, per-net loops), use the QSOC_DEBUG() family of macros below,
+ * which skip the whole chain when the level is off.
  */
 class QSocConsole final
 {
@@ -97,7 +103,8 @@ public:
         };
 
         Stream(Routing routing, Level level);
-        void appendSpace();
+        /* Separate the next operand; false when the level is filtered out. */
+        bool appendSpace();
 
         Routing m_routing;
         Level   m_level;
@@ -105,6 +112,46 @@ public:
         bool    m_first     = true;
         bool    m_autoSpace = true;
         bool    m_alive     = true;
+        bool    m_enabled   = true;
+    };
+
+    /* Captured output of one worker task, replayed later in submission order. */
+    class Capture final
+    {
+    public:
+        enum class Kind : std::uint8_t { Severity, SeverityPlain, Out, Err };
+
+        /** Record one chunk; called by the console while a CaptureScope is active. */
+        void append(Kind kind, Level level, const QString &text);
+        /** Emit the recorded output on the calling thread, in recorded order. */
+        void replay() const;
+        /** True when nothing was recorded. */
+        bool isEmpty() const { return m_records.isEmpty(); }
+
+    private:
+        struct Record
+        {
+            Kind    kind;
+            Level   level;
+            QString text;
+        };
+
+        QList<Record> m_records;
+    };
+
+    /* RAII guard: while alive, severity and raw out()/err() output written on
+       the constructing thread goes into the given Capture instead of the
+       shared streams, so parallel workers log without racing each other. */
+    class CaptureScope final
+    {
+    public:
+        explicit CaptureScope(Capture &capture);
+        ~CaptureScope();
+        CaptureScope(const CaptureScope &)            = delete;
+        CaptureScope &operator=(const CaptureScope &) = delete;
+
+    private:
+        Capture *m_previous;
     };
 
     /* Lifecycle */
@@ -114,10 +161,14 @@ public:
     /* Verbosity */
     static void  setLevel(Level lvl);
     static Level level();
+    /** True when output at the given level would be emitted. Thread-safe. */
+    static bool isEnabled(Level lvl);
 
     /* Color */
     static void      setColorMode(ColorMode mode);
     static ColorMode colorMode();
+    /** True when severity output on stderr carries ANSI color right now. */
+    static bool colorEnabled();
 
     /* Severity, with prefix + color, level-filtered, routed to stderr. */
     static Stream error();
@@ -154,4 +205,33 @@ private:
         QtMsgType type, const QMessageLogContext &context, const QString &message);
 };
 
+/*
+ * Level-gated entry points. The operands of the << chain are only evaluated
+ * when the level is enabled, e.g.
+ *
+ *   QSOC_DEBUG_PLAIN() << ast.dump(4);
+ *
+ * Defining QSOC_STRIP_DEBUG_LOG (cmake -DENABLE_DEBUG_LOG=OFF) compiles the
+ * debug variants out entirely, for builds where even the level check in hot
+ * loops is unwanted.
+ */
+#define QSOC_LOG_IF(enabled, stream) \
+    if (!(enabled)) { \
+    } else \
+        stream
+
+#define QSOC_LOG_AT(lvl, stream) \
+    QSOC_LOG_IF(QSocConsole::isEnabled(QSocConsole::Level::lvl), stream)
+
+#define QSOC_INFO() QSOC_LOG_AT(Info, QSocConsole::info())
+#define QSOC_INFO_PLAIN() QSOC_LOG_AT(Info, QSocConsole::infoPlain())
+
+#ifdef QSOC_STRIP_DEBUG_LOG
+#define QSOC_DEBUG() QSOC_LOG_IF(false, QSocConsole::debug())
+#define QSOC_DEBUG_PLAIN() QSOC_LOG_IF(false, QSocConsole::debugPlain())
+#else
+#define QSOC_DEBUG() QSOC_LOG_AT(Debug, QSocConsole::debug())
+#define QSOC_DEBUG_PLAIN() QSOC_LOG_AT(Debug, QSocConsole::debugPlain())
+#endif
+
 #endif /* QSOCCONSOLE_H */
@@ -4,7 +4,6 @@
 #include "common/qsocgeneratemanager.h"
 #include "common/qsocgenerateprimitiveclock.h"
 #include "common/qsocgenerateprimitivecomb.h"
-#include "common/qsocgenerateprimitivefsm.h"
 #include "common/qsocgenerateprimitivepower.h"
 #include "common/qsocgenerateprimitivereset.h"
 #include "common/qsocgenerateprimitiveseq.h"
@@ -36,7 +35,6 @@ QSocGenerateManager::QSocGenerateManager(
     , resetPrimitive(new QSocResetPrimitive(this))
     , clockPrimitive(new QSocClockPrimitive(this))
     , powerPrimitive(new QSocPowerPrimitive(this))
-    , fsmPrimitive(new QSocFSMPrimitive(this))
     , combPrimitive(new QSocCombPrimitive(this))
     , seqPrimitive(new QSocSeqPrimitive(this))
 {
@@ -48,7 +46,6 @@ QSocGenerateManager::~QSocGenerateManager()
     delete resetPrimitive;
     delete clockPrimitive;
     delete powerPrimitive;
-    delete fsmPrimitive;
     delete combPrimitive;
     delete seqPrimitive;
 }
@@ -109,6 +106,21 @@ void QSocGenerateManager::setForceOverwrite(bool force)
     }
 }
 
+void QSocGenerateManager::setDiagramEnabled(bool enabled)
+{
+    diagramEnabled = enabled;
+}
+
+void QSocGenerateManager::setTemplateSidecar(TemplateSidecar format)
+{
+    templateSidecar = format;
+}
+
+void QSocGenerateManager::setCancelCheck(std::function<bool()> check)
+{
+    cancelCheck = std::move(check);
+}
+
 QString QSocGenerateManager::cleanTypeForWireDeclaration(const QString &typeStr)
 {
     if (typeStr.isEmpty()) {
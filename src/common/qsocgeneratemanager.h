@@ -15,16 +15,17 @@
 class QSocResetPrimitive;
 class QSocClockPrimitive;
 class QSocPowerPrimitive;
-class QSocFSMPrimitive;
 class QSocCombPrimitive;
 class QSocSeqPrimitive;
 
+#include <QHash>
 #include <QObject>
 #include <QPair>
 #include <QString>
 #include <QStringList>
 
 #include <cstdint>
+#include <functional>
 #include <utility>
 
 #include <yaml-cpp/yaml.h>
@@ -79,6 +80,18 @@ public:
     };
     Q_ENUM(PortType)
 
+    /**
+     * @brief Format of the data file written next to each rendered template
+     */
+    enum class TemplateSidecar : std::uint8_t {
+        Off,     /**< No data file */
+        Pretty,  /**< Indented JSON, <basename>.json */
+        Compact, /**< Single-line JSON, <basename>.json */
+        Cbor,    /**< CBOR, <basename>.cbor */
+        MsgPack  /**< MessagePack, <basename>.msgpack */
+    };
+    Q_ENUM(TemplateSidecar)
+
     /**
      * @brief Structure to represent a port connection with type information
      */
@@ -349,6 +362,33 @@ public slots:
      */
     void setForceOverwrite(bool force);
 
+    /**
+     * @brief Enable or disable Typst diagram generation.
+     * @details Reset, clock and power controllers write a Typst diagram next to
+     *          the generated Verilog by default. Disabling it skips that stage.
+     * @param enabled true to write diagrams, false to skip them.
+     */
+    void setDiagramEnabled(bool enabled);
+
+    /**
+     * @brief Choose the data file written next to each rendered template.
+     * @details The merged template data is streamed straight to the file
+     *          on a background thread while the templates render. Off by
+     *          default; the data can be large for big CSV or RDL inputs.
+     * @param format Sidecar format, TemplateSidecar::Off to write none.
+     */
+    void setTemplateSidecar(TemplateSidecar format);
+
+    /**
+     * @brief Let a long template render stop early.
+     * @details renderTemplates() polls @p check between data files and
+     *          between the parse, render and write stages. Once it is true
+     *          no further output is written and every template not yet
+     *          written counts as failed. An empty function never cancels.
+     * @param check Cancellation predicate, callable from the rendering thread.
+     */
+    void setCancelCheck(std::function<bool()> check);
+
     /**
      * @brief Load netlist file.
      * @details Loads a netlist file and creates an in-memory representation.
@@ -433,6 +473,31 @@ public slots:
         const QStringList &rcsvFiles,
         const QString     &outputFileName);
 
+    /**
+     * @brief Render several Jinja2 templates against one data set.
+     * @details Loads and merges the data files once and parses each template
+     *          once, then renders the templates concurrently. Outputs are
+     *          written and messages printed in template order, so the result
+     *          matches rendering the templates one at a time.
+     * @param templates Pairs of template file path and output file name.
+     * @param csvFiles List of CSV data files to load.
+     * @param yamlFiles List of YAML data files to load.
+     * @param jsonFiles List of JSON data files to load.
+     * @param rdlFiles List of SystemRDL data files to load.
+     * @param rcsvFiles List of RCSV (Register-CSV) data files to load.
+     * @param failedTemplates Receives the template paths that failed, in order.
+     * @retval true Every template rendered and saved successfully.
+     * @retval false The data failed to load or at least one template failed.
+     */
+    bool renderTemplates(
+        const QList<QPair<QString, QString>> &templates,
+        const QStringList                    &csvFiles,
+        const QStringList                    &yamlFiles,
+        const QStringList                    &jsonFiles,
+        const QStringList                    &rdlFiles,
+        const QStringList                    &rcsvFiles,
+        QStringList                          *failedTemplates = nullptr);
+
     /**
      * @brief Generate stub files for selected modules.
      * @details This function generates both Verilog (.v) and Liberty (.lib) stub files
@@ -471,6 +536,52 @@ public slots:
     bool generateLibStub(const QString &stubName, const QStringList &moduleNames);
 
 private:
+    /**
+     * @brief Resolution status of a module bus interface
+     */
+    enum class BusInterfaceStatus : std::uint8_t {
+        Resolved,      /**< Bus port found with a declared bus type */
+        ModuleMissing, /**< Module not found in the module library */
+        NoBusSection,  /**< Module has no bus section */
+        PortMissing,   /**< Bus port not found under any pad_ variant */
+        NoBusType      /**< Bus port found but declares no bus type */
+    };
+
+    /**
+     * @brief Module port bound to one bus signal
+     */
+    struct BusSignalPort
+    {
+        std::string portName;  /**< Mapped module port name */
+        std::string portType;  /**< Module port type, empty when undeclared */
+        std::string direction; /**< Module port direction, empty when undeclared */
+    };
+
+    /**
+     * @brief Resolved (module, bus interface) entry
+     * @details Holds everything processNetlist() needs per bus connection,
+     *          so each module bus port is looked up in the module library
+     *          once per run instead of once per connection and bus signal.
+     */
+    struct BusInterfaceInfo
+    {
+        BusInterfaceStatus            status = BusInterfaceStatus::ModuleMissing;
+        std::string                   busType;     /**< Declared bus type */
+        QHash<QString, BusSignalPort> signalPorts; /**< Bus signal to module port */
+    };
+
+    /**
+     * @brief Resolve a module bus interface through the per-run cache
+     * @details Looks the bus port up as-is, with a pad_ prefix stripped and
+     *          with a pad_ prefix added, in that priority order, and merges
+     *          the signal mappings of all variants per signal.
+     * @param moduleName Module name
+     * @param portName Bus port name as written in the netlist
+     * @return Resolved interface, cached for the rest of processNetlist()
+     */
+    BusInterfaceInfo resolveBusInterface(
+        const std::string &moduleName, const std::string &portName);
+
     /**
      * @brief Process link and uplink connections in the netlist
      * @return true if successful, false on error
@@ -544,36 +655,15 @@ private:
     bool processSeqLogic();
 
     /**
-     * @brief Generate FSM Verilog code using FSM primitive
-     * @param fsmItem The YAML node containing the FSM specification
+     * @brief Generate reset, clock, power and FSM controller modules
+     * @details Each controller is rendered into its own buffer on a thread
+     *          pool, then the buffers are written in netlist order so the
+     *          result matches a serial run. Shared cell library files are
+     *          written once per kind, and Typst diagrams are produced in a
+     *          separate parallel stage unless disabled.
      * @param out Output text stream
-     * @return true if generation successful, false otherwise
-     */
-    bool generateFSMPrimitive(const YAML::Node &fsmItem, QTextStream &out);
-
-    /**
-     * @brief Generate reset primitive controller from YAML configuration
-     * @param resetNode The YAML node containing reset configuration
-     * @param out Output text stream
-     * @return true if generation successful, false otherwise
-     */
-    bool generateResetPrimitive(const YAML::Node &resetNode, QTextStream &out);
-
-    /**
-     * @brief Generate clock control logic using Clock primitive
-     * @param clockNode YAML node containing clock configuration
-     * @param out Output text stream
-     * @return true if generation successful, false otherwise
-     */
-    bool generateClockPrimitive(const YAML::Node &clockNode, QTextStream &out);
-
-    /**
-     * @brief Generate power control logic using Power primitive
-     * @param powerNode YAML node containing power configuration
-     * @param out Output text stream
-     * @return true if generation successful, false otherwise
      */
-    bool generatePowerPrimitive(const YAML::Node &powerNode, QTextStream &out);
+    void generateControllerPrimitives(QTextStream &out);
 
     /**
      * @brief Generate sequential logic using Seq primitive
@@ -635,13 +725,20 @@ private:
     QSocResetPrimitive *resetPrimitive = nullptr;
     QSocClockPrimitive *clockPrimitive = nullptr;
     QSocPowerPrimitive *powerPrimitive = nullptr;
-    QSocFSMPrimitive   *fsmPrimitive   = nullptr;
     QSocCombPrimitive  *combPrimitive  = nullptr;
     QSocSeqPrimitive   *seqPrimitive   = nullptr;
     /** Force overwrite mode for primitive cell files */
     bool forceOverwrite = false;
+    /** Write Typst diagrams for reset, clock and power controllers */
+    bool diagramEnabled = true;
+    /** Data file written next to each rendered template */
+    TemplateSidecar templateSidecar = TemplateSidecar::Off;
+    /** Polled by renderTemplates(); empty never cancels */
+    std::function<bool()> cancelCheck;
     /** Netlist data. */
     YAML::Node netlistData;
+    /** Resolved bus interfaces, keyed by (module, bus port). */
+    QHash<QPair<QString, QString>, BusInterfaceInfo> busInterfaceCache;
 };
 
 #endif // QSOCGENERATEMANAGER_H
@@ -4,6 +4,7 @@
 #include "common/qslangdriver.h"
 #include "common/qsocconsole.h"
 #include "common/qsocgeneratemanager.h"
+#include "common/qsocprofiler.h"
 #include "common/qsocverilogutils.h"
 #include "common/qstaticstringweaver.h"
 
@@ -12,8 +13,10 @@
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QHash>
 #include <QProcess>
 #include <QRegularExpression>
+#include <QSet>
 #include <QTextStream>
 
 #include <algorithm>
@@ -22,6 +25,8 @@
 
 bool QSocGenerateManager::loadNetlist(const QString &netlistFilePath)
 {
+    const QSocProfiler::Scope profile("loadNetlist");
+
     /* Check if the file exists */
     if (!QFile::exists(netlistFilePath)) {
         QSocConsole::error() << "Netlist file does not exist:" << netlistFilePath;
@@ -81,7 +86,7 @@ bool QSocGenerateManager::loadNetlist(const QString &netlistFilePath)
 void QSocGenerateManager::resetGenerateData()
 {
     netlistData = YAML::Node();
-    QSocConsole::debug() << "Generate data has been reset.";
+    QSOC_DEBUG() << "Generate data has been reset.";
 }
 
 bool QSocGenerateManager::setNetlistData(const YAML::Node &netlistData)
@@ -130,6 +135,8 @@ bool QSocGenerateManager::setNetlistData(const YAML::Node &netlistData)
 
 bool QSocGenerateManager::processNetlist()
 {
+    QSocProfiler::Scope profile("processNetlist");
+
     try {
         /* Check if netlistData is valid - allow missing instance if primitives exist */
         bool hasInstances  = netlistData["instance"] && netlistData["instance"].IsMap();
@@ -142,6 +149,9 @@ bool QSocGenerateManager::processNetlist()
                                     "primitives found, call loadNetlist() first";
             return false;
         }
+        if (hasInstances) {
+            profile.setCount(static_cast<qint64>(netlistData["instance"].size()));
+        }
 
         /* Expand bus links before processing */
         if (!expandBusLink()) {
@@ -160,10 +170,41 @@ bool QSocGenerateManager::processNetlist()
             netlistData["net"] = YAML::Node(YAML::NodeType::Map);
         }
 
+        /* Module bus interfaces may change between runs */
+        busInterfaceCache.clear();
+
         /* Process bus section if it exists */
+        QSocProfiler::Scope busProfile("processBus");
         if (!netlistData["bus"] || !netlistData["bus"].IsMap() || netlistData["bus"].size() == 0) {
             QSocConsole::info() << "No bus section found or empty, skipping bus processing";
         } else {
+            /* yaml-cpp map lookups are linear, so index instances and net
+               names once instead of searching the maps per bus signal */
+            QHash<QString, YAML::Node> instanceIndex;
+            if (netlistData["instance"] && netlistData["instance"].IsMap()) {
+                for (const auto &instancePair : netlistData["instance"]) {
+                    if (instancePair.first.IsScalar()) {
+                        instanceIndex.insert(
+                            QString::fromStdString(instancePair.first.as<std::string>()),
+                            instancePair.second);
+                    }
+                }
+            }
+
+            YAML::Node    netSection = netlistData["net"];
+            QSet<QString> netNames;
+            QSet<QString> claimedNetNames;
+            for (const auto &netPair : netSection) {
+                if (!netPair.first.IsScalar()) {
+                    continue;
+                }
+                const QString name = QString::fromStdString(netPair.first.as<std::string>());
+                netNames.insert(name);
+                if (netPair.second.IsSequence() && netPair.second.size() > 0) {
+                    claimedNetNames.insert(name);
+                }
+            }
+
             /* Process each bus type (e.g., biu_bus) */
             for (const auto &busTypePair : netlistData["bus"]) {
                 try {
@@ -188,10 +229,12 @@ bool QSocGenerateManager::processNetlist()
                     /* Collect all valid connections */
                     struct Connection
                     {
-                        std::string instanceName;
-                        std::string portName;
-                        std::string moduleName;
-                        std::string busType;
+                        std::string      instanceName;
+                        std::string      portName;
+                        std::string      moduleName;
+                        std::string      busType;
+                        YAML::Node       instanceNode;
+                        BusInterfaceInfo busInterface;
                     };
 
                     std::vector<Connection> validConnections;
@@ -219,90 +262,55 @@ bool QSocGenerateManager::processNetlist()
                                                 << "." << portName.c_str();
 
                             /* Validate the instance exists */
-                            if (!netlistData["instance"][instanceName]) {
+                            const auto instanceIt = instanceIndex.constFind(
+                                QString::fromStdString(instanceName));
+                            if (instanceIt == instanceIndex.constEnd()) {
                                 QSocConsole::warn()
                                     << "Instance" << instanceName.c_str() << "not found in netlist";
                                 continue;
                             }
+                            const YAML::Node &instanceNode = instanceIt.value();
 
                             /* Check for module name */
-                            if (!netlistData["instance"][instanceName]["module"]
-                                || !netlistData["instance"][instanceName]["module"].IsScalar()) {
+                            if (!instanceNode["module"] || !instanceNode["module"].IsScalar()) {
                                 QSocConsole::warn()
                                     << "Invalid module for instance" << instanceName.c_str();
                                 continue;
                             }
 
-                            const auto moduleName
-                                = netlistData["instance"][instanceName]["module"].as<std::string>();
-
-                            /* Check if module exists */
-                            if (!moduleManager
-                                || !moduleManager->isModuleExist(
-                                    QString::fromStdString(moduleName))) {
-                                QSocConsole::warn()
-                                    << "Module" << moduleName.c_str() << "not found";
-                                continue;
-                            }
+                            const auto moduleName = instanceNode["module"].as<std::string>();
 
-                            /* Get module data */
-                            YAML::Node moduleData;
+                            /* Resolve the module bus port (module, bus section, bus type) */
+                            BusInterfaceInfo busInterface;
                             try {
-                                moduleData = moduleManager->getModuleYaml(
-                                    QString::fromStdString(moduleName));
+                                busInterface = resolveBusInterface(moduleName, portName);
                             } catch (const YAML::Exception &e) {
                                 QSocConsole::warn() << "failed to get module data:" << e.what();
                                 continue;
                             }
 
-                            /* Check if port exists in bus section */
-                            if (!moduleData["bus"] || !moduleData["bus"].IsMap()) {
+                            if (busInterface.status == BusInterfaceStatus::ModuleMissing) {
                                 QSocConsole::warn()
-                                    << "No bus section in module" << moduleName.c_str();
+                                    << "Module" << moduleName.c_str() << "not found";
                                 continue;
                             }
-
-                            /* Check if port exists in bus section - try multiple name variations */
-                            bool portFound = false;
-                            if (moduleData["bus"][portName]
-                                || (portName.starts_with("pad_")
-                                    && moduleData["bus"][portName.substr(4)])
-                                || moduleData["bus"]["pad_" + portName]) {
-                                portFound = true;
+                            if (busInterface.status == BusInterfaceStatus::NoBusSection) {
+                                QSocConsole::warn()
+                                    << "No bus section in module" << moduleName.c_str();
+                                continue;
                             }
-
-                            if (!portFound) {
+                            if (busInterface.status == BusInterfaceStatus::PortMissing) {
                                 QSocConsole::warn() << "Port" << portName.c_str()
                                                     << "not found in module" << moduleName.c_str();
                                 continue;
                             }
-
-                            /* Check bus type */
-                            std::string currentBusType;
-
-                            /* Try to find bus type declaration in module */
-                            if (moduleData["bus"][portName] && moduleData["bus"][portName]["bus"]
-                                && moduleData["bus"][portName]["bus"].IsScalar()) {
-                                currentBusType
-                                    = moduleData["bus"][portName]["bus"].as<std::string>();
-                            } else if (
-                                portName.starts_with("pad_")
-                                && moduleData["bus"][portName.substr(4)]
-                                && moduleData["bus"][portName.substr(4)]["bus"]
-                                && moduleData["bus"][portName.substr(4)]["bus"].IsScalar()) {
-                                currentBusType
-                                    = moduleData["bus"][portName.substr(4)]["bus"].as<std::string>();
-                            } else if (
-                                moduleData["bus"]["pad_" + portName]
-                                && moduleData["bus"]["pad_" + portName]["bus"]
-                                && moduleData["bus"]["pad_" + portName]["bus"].IsScalar()) {
-                                currentBusType
-                                    = moduleData["bus"]["pad_" + portName]["bus"].as<std::string>();
-                            } else {
+                            if (busInterface.status == BusInterfaceStatus::NoBusType) {
                                 QSocConsole::warn() << "No bus type for port" << portName.c_str();
                                 continue;
                             }
 
+                            const std::string &currentBusType = busInterface.busType;
+
                             /* Check if this bus type exists */
                             if (!busManager
                                 || !busManager->isBusExist(QString::fromStdString(currentBusType))) {
@@ -329,6 +337,8 @@ bool QSocGenerateManager::processNetlist()
                             conn.portName     = portName;
                             conn.moduleName   = moduleName;
                             conn.busType      = currentBusType;
+                            conn.instanceNode = instanceNode;
+                            conn.busInterface = busInterface;
                             validConnections.push_back(conn);
 
                         } catch (const YAML::Exception &e) {
@@ -376,18 +386,19 @@ bool QSocGenerateManager::processNetlist()
                             continue;
                         }
 
-                        const auto  signalName = portPair.first.as<std::string>();
-                        std::string netName    = busTypeName;
+                        const auto    signalName = portPair.first.as<std::string>();
+                        const QString signalKey  = QString::fromStdString(signalName);
+                        std::string   netName    = busTypeName;
                         netName += "_";
                         netName += signalName;
+                        const QString netKey = QString::fromStdString(netName);
 
                         QSocConsole::info() << "Creating net for bus signal:" << signalName.c_str();
 
                         /* If a manually written net already claims this name, the
                            bus expansion would otherwise wipe it. Refuse to overwrite
                            and surface the collision so the user can rename. */
-                        if (netlistData["net"][netName] && netlistData["net"][netName].IsSequence()
-                            && netlistData["net"][netName].size() > 0) {
+                        if (claimedNetNames.contains(netKey)) {
                             QSocConsole::warn()
                                 << "Bus signal" << signalName.c_str() << "would synthesize net"
                                 << netName.c_str()
@@ -396,96 +407,33 @@ bool QSocGenerateManager::processNetlist()
                             continue;
                         }
 
-                        /* Create a net for this signal using List format for consistency */
-                        netlistData["net"][netName] = YAML::Node(YAML::NodeType::Sequence);
+                        /* Build the net using List format for consistency */
+                        YAML::Node netNode = YAML::Node(YAML::NodeType::Sequence);
 
                         /* Add each connection to this net */
                         for (const Connection &conn : validConnections) {
                             try {
-                                /* Skip if module definition not available */
-                                if (!moduleManager->isModuleExist(conn.moduleName.c_str())) {
-                                    QSocConsole::warn() << "Module" << conn.moduleName.c_str()
-                                                        << "not found, skipping";
-                                    continue;
-                                }
-
-                                YAML::Node moduleData = moduleManager->getModuleYaml(
-                                    QString::fromStdString(conn.moduleName));
-
-                                if (!moduleData["bus"] || !moduleData["bus"].IsMap()) {
-                                    QSocConsole::warn() << "No bus section in module"
-                                                        << conn.moduleName.c_str() << ", skipping";
-                                    continue;
-                                }
-
                                 /* Find the mapped port for this signal */
-                                std::string mappedPortName;
-                                bool        mappingFound = false;
-
-                                /* Try with direct port name */
-                                if (moduleData["bus"][conn.portName]
-                                    && moduleData["bus"][conn.portName]["mapping"]
-                                    && moduleData["bus"][conn.portName]["mapping"].IsMap()
-                                    && moduleData["bus"][conn.portName]["mapping"][signalName]
-                                    && moduleData["bus"][conn.portName]["mapping"][signalName]
-                                           .IsScalar()) {
-                                    mappedPortName
-                                        = moduleData["bus"][conn.portName]["mapping"][signalName]
-                                              .as<std::string>();
-                                    mappingFound = true;
-                                }
-                                /* Try with pad_ stripped port name */
-                                else if (
-                                    conn.portName.starts_with("pad_")
-                                    && moduleData["bus"][conn.portName.substr(4)]
-                                    && moduleData["bus"][conn.portName.substr(4)]["mapping"]
-                                    && moduleData["bus"][conn.portName.substr(4)]["mapping"].IsMap()
-                                    && moduleData["bus"][conn.portName.substr(4)]["mapping"]
-                                                 [signalName]
-                                    && moduleData["bus"][conn.portName.substr(4)]["mapping"]
-                                                 [signalName]
-                                                     .IsScalar()) {
-                                    mappedPortName = moduleData["bus"][conn.portName.substr(4)]
-                                                               ["mapping"][signalName]
-                                                                   .as<std::string>();
-                                    mappingFound   = true;
-                                }
-                                /* Try with prefixed port name (with pad_ prefix) */
-                                else if (
-                                    moduleData["bus"]["pad_" + conn.portName]
-                                    && moduleData["bus"]["pad_" + conn.portName]["mapping"]
-                                    && moduleData["bus"]["pad_" + conn.portName]["mapping"].IsMap()
-                                    && moduleData["bus"]["pad_" + conn.portName]["mapping"]
-                                                 [signalName]
-                                    && moduleData["bus"]["pad_" + conn.portName]["mapping"]
-                                                 [signalName]
-                                                     .IsScalar()) {
-                                    mappedPortName = moduleData["bus"]["pad_" + conn.portName]
-                                                               ["mapping"][signalName]
-                                                                   .as<std::string>();
-                                    mappingFound   = true;
-                                }
-
-                                if (!mappingFound || mappedPortName.empty()) {
+                                const auto mapped = conn.busInterface.signalPorts.constFind(
+                                    signalKey);
+                                if (mapped == conn.busInterface.signalPorts.constEnd()
+                                    || mapped->portName.empty()) {
                                     /* Skip this signal for this connection */
                                     continue;
                                 }
+                                const std::string &mappedPortName = mapped->portName;
 
                                 /* Mirror the bus uplink fix: a per-port `tie:`
                                    or `link:` override means the user wants this
                                    specific signal routed elsewhere. Without
                                    this guard the bus expansion would race the
                                    override into a cross-net duplicate. */
-                                if (netlistData["instance"][conn.instanceName]
-                                    && netlistData["instance"][conn.instanceName]["port"]
-                                    && netlistData["instance"][conn.instanceName]["port"]
-                                                  [mappedPortName]
-                                    && netlistData["instance"][conn.instanceName]["port"]
-                                                  [mappedPortName]
-                                                      .IsMap()) {
-                                    const auto &existing = netlistData["instance"][conn.instanceName]
-                                                                      ["port"][mappedPortName];
-                                    if (existing["tie"] || existing["link"]) {
+                                const YAML::Node instancePort
+                                    = conn.instanceNode["port"]
+                                          ? conn.instanceNode["port"][mappedPortName]
+                                          : YAML::Node();
+                                if (instancePort && instancePort.IsMap()) {
+                                    if (instancePort["tie"] || instancePort["link"]) {
                                         QSocConsole::warn()
                                             << "Bus link expansion for" << conn.instanceName.c_str()
                                             << "." << mappedPortName.c_str()
@@ -501,42 +449,25 @@ bool QSocGenerateManager::processNetlist()
                                 connectionNode["port"]     = mappedPortName;
 
                                 /* Preserve port type/width information from module definition */
-                                if (moduleData["port"] && moduleData["port"].IsMap()
-                                    && moduleData["port"][mappedPortName]
-                                    && moduleData["port"][mappedPortName]["type"]
-                                    && moduleData["port"][mappedPortName]["type"].IsScalar()) {
-                                    connectionNode["type"]
-                                        = moduleData["port"][mappedPortName]["type"]
-                                              .as<std::string>();
+                                if (!mapped->portType.empty()) {
+                                    connectionNode["type"] = mapped->portType;
                                 }
 
                                 /* Forward a per-port `bits:` override from the
                                    instance YAML. Pre-fix the bus expander built
                                    the connection from the bus mapping alone and
                                    silently dropped any user-specified slice. */
-                                if (netlistData["instance"][conn.instanceName]
-                                    && netlistData["instance"][conn.instanceName]["port"]
-                                    && netlistData["instance"][conn.instanceName]["port"]
-                                                  [mappedPortName]
-                                    && netlistData["instance"][conn.instanceName]["port"]
-                                                  [mappedPortName]
-                                                      .IsMap()
-                                    && netlistData["instance"][conn.instanceName]["port"]
-                                                  [mappedPortName]["bits"]
-                                    && netlistData["instance"][conn.instanceName]["port"]
-                                                  [mappedPortName]["bits"]
-                                                      .IsScalar()) {
+                                if (instancePort && instancePort.IsMap() && instancePort["bits"]
+                                    && instancePort["bits"].IsScalar()) {
                                     const std::string portBits
-                                        = netlistData["instance"][conn.instanceName]["port"]
-                                                     [mappedPortName]["bits"]
-                                                         .as<std::string>();
+                                        = instancePort["bits"].as<std::string>();
                                     if (!portBits.empty()) {
                                         connectionNode["bits"] = portBits;
                                     }
                                 }
 
                                 /* Add connection to the net using List format */
-                                netlistData["net"][netName].push_back(connectionNode);
+                                netNode.push_back(connectionNode);
 
                             } catch (const YAML::Exception &e) {
                                 QSocConsole::warn()
@@ -549,9 +480,19 @@ bool QSocGenerateManager::processNetlist()
                             }
                         }
 
-                        /* If no connections were added to this net, remove it */
-                        if (netlistData["net"][netName].size() == 0) {
-                            netlistData["net"].remove(netName);
+                        /* Store the net, or drop a stale entry when nothing connected */
+                        if (netNode.size() > 0) {
+                            if (netNames.contains(netKey)) {
+                                netSection[netName] = netNode;
+                            } else {
+                                /* Name is known to be new, skip the linear key search */
+                                netSection.force_insert(netName, netNode);
+                                netNames.insert(netKey);
+                            }
+                            claimedNetNames.insert(netKey);
+                        } else if (netNames.contains(netKey)) {
+                            netSection.remove(netName);
+                            netNames.remove(netKey);
                         }
                     }
 
@@ -565,6 +506,8 @@ bool QSocGenerateManager::processNetlist()
             }
         }
 
+        busProfile.finish();
+
         /* Clean up by removing the bus section */
         netlistData.remove("bus");
 
@@ -602,6 +545,8 @@ bool QSocGenerateManager::processNetlist()
 
 bool QSocGenerateManager::expandBusLink()
 {
+    const QSocProfiler::Scope profile("expandBusLink");
+
     try {
         /* Check if instance section exists */
         if (!netlistData["instance"] || !netlistData["instance"].IsMap()) {
@@ -614,6 +559,30 @@ bool QSocGenerateManager::expandBusLink()
             netlistData["bus"] = YAML::Node(YAML::NodeType::Map);
         }
 
+        /* Index bus entries and their instance.port members so placing and
+           deduplicating a link does not rescan the bus section per link */
+        YAML::Node                    busSection = netlistData["bus"];
+        QHash<QString, YAML::Node>    busIndex;
+        QHash<QString, QSet<QString>> busMembers;
+        for (const auto &busPair : busSection) {
+            if (!busPair.first.IsScalar()) {
+                continue;
+            }
+            const QString busName = QString::fromStdString(busPair.first.as<std::string>());
+            busIndex.insert(busName, busPair.second);
+            if (!busPair.second.IsSequence()) {
+                continue;
+            }
+            QSet<QString> &members = busMembers[busName];
+            for (const auto &existingConn : busPair.second) {
+                if (existingConn["instance"] && existingConn["port"]) {
+                    members.insert(
+                        QString::fromStdString(existingConn["instance"].as<std::string>()) + "."
+                        + QString::fromStdString(existingConn["port"].as<std::string>()));
+                }
+            }
+        }
+
         /* Iterate through all instances */
         for (auto instancePair : netlistData["instance"]) {
             if (!instancePair.first.IsScalar()) {
@@ -647,28 +616,25 @@ bool QSocGenerateManager::expandBusLink()
                                     << busPortName.c_str() << " -> " << linkName.c_str();
 
                 /* Create or update the bus in netlist bus section */
-                if (!netlistData["bus"][linkName]) {
-                    netlistData["bus"][linkName] = YAML::Node(YAML::NodeType::Sequence);
-                }
-
-                /* Add connection to the bus */
-                YAML::Node connection;
-                connection["instance"] = instanceName;
-                connection["port"]     = busPortName;
-
-                /* Check if this connection already exists to avoid duplicates */
-                bool exists = false;
-                for (const auto &existingConn : netlistData["bus"][linkName]) {
-                    if (existingConn["instance"] && existingConn["port"]
-                        && existingConn["instance"].as<std::string>() == instanceName
-                        && existingConn["port"].as<std::string>() == busPortName) {
-                        exists = true;
-                        break;
-                    }
+                const QString linkKey = QString::fromStdString(linkName);
+                auto          linkIt  = busIndex.find(linkKey);
+                if (linkIt == busIndex.end()) {
+                    YAML::Node linkNode = YAML::Node(YAML::NodeType::Sequence);
+                    /* Name is known to be new, skip the linear key search */
+                    busSection.force_insert(linkName, linkNode);
+                    linkIt = busIndex.insert(linkKey, linkNode);
                 }
 
-                if (!exists) {
-                    netlistData["bus"][linkName].push_back(connection);
+                /* Add connection to the bus unless it already exists */
+                const QString memberKey = QString::fromStdString(instanceName) + "."
+                                          + QString::fromStdString(busPortName);
+                QSet<QString> &members = busMembers[linkKey];
+                if (!members.contains(memberKey)) {
+                    YAML::Node connection;
+                    connection["instance"] = instanceName;
+                    connection["port"]     = busPortName;
+                    linkIt.value().push_back(connection);
+                    members.insert(memberKey);
                 }
 
                 /* Remove the link attribute from instance bus node (keep other attributes) */
@@ -691,8 +657,100 @@ bool QSocGenerateManager::expandBusLink()
     }
 }
 
+QSocGenerateManager::BusInterfaceInfo QSocGenerateManager::resolveBusInterface(
+    const std::string &moduleName, const std::string &portName)
+{
+    const QPair<QString, QString> key(
+        QString::fromStdString(moduleName), QString::fromStdString(portName));
+    const auto cached = busInterfaceCache.constFind(key);
+    if (cached != busInterfaceCache.constEnd()) {
+        return cached.value();
+    }
+
+    BusInterfaceInfo info;
+
+    /* Check if module exists */
+    if (!moduleManager || !moduleManager->isModuleExist(key.first)) {
+        info.status = BusInterfaceStatus::ModuleMissing;
+        busInterfaceCache.insert(key, info);
+        return info;
+    }
+
+    const YAML::Node moduleData = moduleManager->getModuleYaml(key.first);
+    if (!moduleData["bus"] || !moduleData["bus"].IsMap()) {
+        info.status = BusInterfaceStatus::NoBusSection;
+        busInterfaceCache.insert(key, info);
+        return info;
+    }
+
+    /* Candidate bus port names in priority order: as written, pad_ stripped, pad_ added */
+    std::vector<YAML::Node> candidates;
+    if (moduleData["bus"][portName]) {
+        candidates.push_back(moduleData["bus"][portName]);
+    }
+    if (portName.starts_with("pad_") && moduleData["bus"][portName.substr(4)]) {
+        candidates.push_back(moduleData["bus"][portName.substr(4)]);
+    }
+    if (moduleData["bus"]["pad_" + portName]) {
+        candidates.push_back(moduleData["bus"]["pad_" + portName]);
+    }
+
+    if (candidates.empty()) {
+        info.status = BusInterfaceStatus::PortMissing;
+        busInterfaceCache.insert(key, info);
+        return info;
+    }
+
+    /* Bus type comes from the first candidate that declares one */
+    for (const YAML::Node &candidate : candidates) {
+        if (candidate["bus"] && candidate["bus"].IsScalar()) {
+            info.busType = candidate["bus"].as<std::string>();
+            break;
+        }
+    }
+    info.status = info.busType.empty() ? BusInterfaceStatus::NoBusType
+                                       : BusInterfaceStatus::Resolved;
+
+    /* Each signal maps through the first candidate that maps it */
+    const YAML::Node modulePorts = moduleData["port"];
+    for (const YAML::Node &candidate : candidates) {
+        if (!candidate["mapping"] || !candidate["mapping"].IsMap()) {
+            continue;
+        }
+        for (const auto &mappingPair : candidate["mapping"]) {
+            if (!mappingPair.first.IsScalar() || !mappingPair.second.IsScalar()) {
+                continue;
+            }
+            const QString signalKey = QString::fromStdString(mappingPair.first.as<std::string>());
+            if (info.signalPorts.contains(signalKey)) {
+                continue;
+            }
+
+            BusSignalPort signalPort;
+            signalPort.portName = mappingPair.second.as<std::string>();
+            if (modulePorts && modulePorts.IsMap() && !signalPort.portName.empty()) {
+                const YAML::Node portNode = modulePorts[signalPort.portName];
+                if (portNode && portNode.IsMap()) {
+                    if (portNode["type"] && portNode["type"].IsScalar()) {
+                        signalPort.portType = portNode["type"].as<std::string>();
+                    }
+                    if (portNode["direction"] && portNode["direction"].IsScalar()) {
+                        signalPort.direction = portNode["direction"].as<std::string>();
+                    }
+                }
+            }
+            info.signalPorts.insert(signalKey, signalPort);
+        }
+    }
+
+    busInterfaceCache.insert(key, info);
+    return info;
+}
+
 bool QSocGenerateManager::expandBusUplink()
 {
+    const QSocProfiler::Scope profile("expandBusUplink");
+
     try {
         /* Check if instance section exists */
         if (!netlistData["instance"] || !netlistData["instance"].IsMap()) {
@@ -1524,6 +1582,8 @@ bool QSocGenerateManager::guardsAreDisjoint(const PortDetailInfo &lhs, const Por
  */
 bool QSocGenerateManager::processLinkConnections()
 {
+    const QSocProfiler::Scope profile("processLinkConnections");
+
     try {
         /* Ensure net section exists */
         if (!netlistData["net"]) {
@@ -1985,6 +2045,8 @@ int QSocGenerateManager::calculatePortWidth(const std::string &portType)
  */
 bool QSocGenerateManager::processCombLogic()
 {
+    const QSocProfiler::Scope profile("processCombLogic");
+
     try {
         /* Check if comb section exists */
         if (!netlistData["comb"]) {
@@ -2189,6 +2251,8 @@ bool QSocGenerateManager::processCombLogic()
 
 bool QSocGenerateManager::processSeqLogic()
 {
+    const QSocProfiler::Scope profile("processSeqLogic");
+
     try {
         if (!netlistData["seq"]) {
             QSocConsole::info() << "No sequential logic section found, skipping";
@@ -2379,8 +2443,8 @@ QList<QSocGenerateManager::PortDetailInfo> QSocGenerateManager::collectCombSeqFs
                     if (combItem["bits"] && combItem["bits"].IsScalar()) {
                         bitSelect = QSocVerilogUtils::normalizeBitSelect(
                             QString::fromStdString(combItem["bits"].as<std::string>()));
-                        QSocConsole::debug() << "Using bits attribute for comb output:" << baseName
-                                             << "bits:" << bitSelect;
+                        QSOC_DEBUG() << "Using bits attribute for comb output:" << baseName
+                                     << "bits:" << bitSelect;
                     }
 
                     // Find port width for this output
@@ -2468,8 +2532,8 @@ QList<QSocGenerateManager::PortDetailInfo> QSocGenerateManager::collectCombSeqFs
                     // Check if bits attribute exists and override bitSelect if present
                     if (seqItem["bits"] && seqItem["bits"].IsScalar()) {
                         bitSelect = QString::fromStdString(seqItem["bits"].as<std::string>());
-                        QSocConsole::debug() << "Using bits attribute for seq output:" << baseName
-                                             << "bits:" << bitSelect;
+                        QSOC_DEBUG() << "Using bits attribute for seq output:" << baseName
+                                     << "bits:" << bitSelect;
                     }
 
                     // Find port width for this output
@@ -31,6 +31,39 @@ void QSocClockPrimitive::setForceOverwrite(bool force)
 }
 
 bool QSocClockPrimitive::generateClockController(const YAML::Node &clockNode, QTextStream &out)
+{
+    ClockControllerConfig config;
+    if (!prepareClockController(clockNode, config)) {
+        return false;
+    }
+
+    // Generate or update clock_cell.v file
+    if (m_parent && m_parent->getProjectManager()) {
+        QString outputDir = m_parent->getProjectManager()->getOutputPath();
+        if (!generateClockCellFile(outputDir)) {
+            QSocConsole::warn() << "Failed to generate clock_cell.v file";
+            return false;
+        }
+    }
+
+    // Generate Verilog code (without template cells)
+    emitClockController(config, out);
+
+    // Generate Typst clock diagram (failure does not affect Verilog generation)
+    if (m_parent && m_parent->getProjectManager()) {
+        QString outputDir = m_parent->getProjectManager()->getOutputPath();
+        QString typstPath = outputDir + QStringLiteral("/") + config.moduleName
+                            + QStringLiteral(".typ");
+        if (!generateTypstDiagram(config, typstPath)) {
+            QSocConsole::warn() << "Failed to generate Typst diagram (non-critical):" << typstPath;
+        }
+    }
+
+    return true;
+}
+
+bool QSocClockPrimitive::prepareClockController(
+    const YAML::Node &clockNode, ClockControllerConfig &config)
 {
     if (!clockNode || !clockNode.IsMap()) {
         QSocConsole::warn() << "Invalid clock node provided";
@@ -38,7 +71,7 @@ bool QSocClockPrimitive::generateClockController(const YAML::Node &clockNode, QT
     }
 
     // Parse configuration
-    ClockControllerConfig config = parseClockConfig(clockNode);
+    config = parseClockConfig(clockNode);
 
     if (config.inputs.isEmpty() || config.targets.isEmpty()) {
         QSocConsole::warn() << "Clock configuration must have at least one input and target";
@@ -51,16 +84,11 @@ bool QSocClockPrimitive::generateClockController(const YAML::Node &clockNode, QT
        like `rst_sw_dcmi_n`). Do NOT warn about undeclared sources here;
        the typo case surfaces downstream as an unwired controller pin. */
 
-    // Generate or update clock_cell.v file
-    if (m_parent && m_parent->getProjectManager()) {
-        QString outputDir = m_parent->getProjectManager()->getOutputPath();
-        if (!generateClockCellFile(outputDir)) {
-            QSocConsole::warn() << "Failed to generate clock_cell.v file";
-            return false;
-        }
-    }
+    return true;
+}
 
-    // Generate Verilog code (without template cells)
+void QSocClockPrimitive::emitClockController(const ClockControllerConfig &config, QTextStream &out)
+{
     generateModuleHeader(config, out);
     generateWireDeclarations(config, out);
     generateClockLogic(config, out);
@@ -68,18 +96,6 @@ bool QSocClockPrimitive::generateClockController(const YAML::Node &clockNode, QT
 
     // Close module
     out << "\nendmodule\n\n";
-
-    // Generate Typst clock diagram (failure does not affect Verilog generation)
-    if (m_parent && m_parent->getProjectManager()) {
-        QString outputDir = m_parent->getProjectManager()->getOutputPath();
-        QString typstPath = outputDir + QStringLiteral("/") + config.moduleName
-                            + QStringLiteral(".typ");
-        if (!generateTypstDiagram(config, typstPath)) {
-            QSocConsole::warn() << "Failed to generate Typst diagram (non-critical):" << typstPath;
-        }
-    }
-
-    return true;
 }
 
 QSocClockPrimitive::ClockControllerConfig QSocClockPrimitive::parseClockConfig(
@@ -178,6 +178,31 @@ public:
      */
     bool generateClockController(const YAML::Node &clockNode, QTextStream &out);
 
+    /**
+     * @brief Parse and validate clock configuration for emission
+     * @details First half of generateClockController(), free of side files.
+     * @param clockNode YAML node containing clock configuration
+     * @param config Parsed configuration structure, valid on success
+     * @return true if the controller can be emitted, false otherwise
+     */
+    bool prepareClockController(const YAML::Node &clockNode, ClockControllerConfig &config);
+
+    /**
+     * @brief Emit clock controller Verilog for a prepared configuration
+     * @details Writes the module text only; clock_cell.v and the Typst
+     *          diagram are left to the caller.
+     * @param config Configuration accepted by prepareClockController()
+     * @param out Output text stream for generated Verilog
+     */
+    void emitClockController(const ClockControllerConfig &config, QTextStream &out);
+
+    /**
+     * @brief Generate or update clock_cell.v file with template cells
+     * @param outputDir Output directory path
+     * @return true if successful, false otherwise
+     */
+    bool generateClockCellFile(const QString &outputDir);
+
     /**
      * @brief Parse clock configuration from YAML
      * @param clockNode YAML node containing clock configuration
@@ -200,13 +225,6 @@ public:
     bool generateTypstDiagram(const ClockControllerConfig &config, const QString &outputPath);
 
 private:
-    /**
-     * @brief Generate or update clock_cell.v file with template cells
-     * @param outputDir Output directory path
-     * @return true if successful, false otherwise
-     */
-    bool generateClockCellFile(const QString &outputDir);
-
     /**
      * @brief Check if clock_cell.v file exists and is complete
      * @param filePath Path to clock_cell.v file
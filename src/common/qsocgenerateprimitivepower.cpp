@@ -21,6 +21,39 @@ void QSocPowerPrimitive::setForceOverwrite(bool force)
 }
 
 bool QSocPowerPrimitive::generatePowerController(const YAML::Node &powerNode, QTextStream &out)
+{
+    PowerControllerConfig config;
+    if (!preparePowerController(powerNode, config)) {
+        return false;
+    }
+
+    // Generate or update power_cell.v file
+    if (m_parent && m_parent->getProjectManager()) {
+        QString outputDir = m_parent->getProjectManager()->getOutputPath();
+        if (!generatePowerCellFile(outputDir)) {
+            QSocConsole::warn() << "Failed to generate power_cell.v file";
+            return false;
+        }
+    }
+
+    // Generate Verilog code
+    emitPowerController(config, out);
+
+    // Generate Typst power diagram (failure does not affect Verilog generation)
+    if (m_parent && m_parent->getProjectManager()) {
+        QString outputDir = m_parent->getProjectManager()->getOutputPath();
+        QString typstPath = outputDir + QStringLiteral("/") + config.moduleName
+                            + QStringLiteral(".typ");
+        if (!generateTypstDiagram(config, typstPath)) {
+            QSocConsole::warn() << "Failed to generate Typst diagram (non-critical):" << typstPath;
+        }
+    }
+
+    return true;
+}
+
+bool QSocPowerPrimitive::preparePowerController(
+    const YAML::Node &powerNode, PowerControllerConfig &config)
 {
     if (!powerNode || !powerNode.IsMap()) {
         QSocConsole::warn() << "Invalid power node provided";
@@ -28,7 +61,7 @@ bool QSocPowerPrimitive::generatePowerController(const YAML::Node &powerNode, QT
     }
 
     // Parse configuration
-    PowerControllerConfig config = parsePowerConfig(powerNode);
+    config = parsePowerConfig(powerNode);
 
     if (config.domains.isEmpty()) {
         QSocConsole::warn() << "Power configuration must have at least one domain";
@@ -55,16 +88,11 @@ bool QSocPowerPrimitive::generatePowerController(const YAML::Node &powerNode, QT
         }
     }
 
-    // Generate or update power_cell.v file
-    if (m_parent && m_parent->getProjectManager()) {
-        QString outputDir = m_parent->getProjectManager()->getOutputPath();
-        if (!generatePowerCellFile(outputDir)) {
-            QSocConsole::warn() << "Failed to generate power_cell.v file";
-            return false;
-        }
-    }
+    return true;
+}
 
-    // Generate Verilog code
+void QSocPowerPrimitive::emitPowerController(const PowerControllerConfig &config, QTextStream &out)
+{
     generateModuleHeader(config, out);
     generateWireDeclarations(config, out);
     generatePowerLogic(config, out);
@@ -72,18 +100,6 @@ bool QSocPowerPrimitive::generatePowerController(const YAML::Node &powerNode, QT
 
     // Close module
     out << "\nendmodule\n\n";
-
-    // Generate Typst power diagram (failure does not affect Verilog generation)
-    if (m_parent && m_parent->getProjectManager()) {
-        QString outputDir = m_parent->getProjectManager()->getOutputPath();
-        QString typstPath = outputDir + QStringLiteral("/") + config.moduleName
-                            + QStringLiteral(".typ");
-        if (!generateTypstDiagram(config, typstPath)) {
-            QSocConsole::warn() << "Failed to generate Typst diagram (non-critical):" << typstPath;
-        }
-    }
-
-    return true;
 }
 
 QSocPowerPrimitive::PowerControllerConfig QSocPowerPrimitive::parsePowerConfig(
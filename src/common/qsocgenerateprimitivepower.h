@@ -92,6 +92,32 @@ public:
      */
     bool generatePowerController(const YAML::Node &powerNode, QTextStream &out);
 
+    /**
+     * @brief Parse and validate power configuration for emission
+     * @details First half of generatePowerController(), free of side files.
+     * @param powerNode YAML node containing power configuration
+     * @param config Parsed configuration structure, valid on success
+     * @return true if the controller can be emitted, false otherwise
+     */
+    bool preparePowerController(const YAML::Node &powerNode, PowerControllerConfig &config);
+
+    /**
+     * @brief Emit power controller Verilog for a prepared configuration
+     * @details Writes the module text only; power_cell.v and the Typst
+     *          diagram are left to the caller. Must run on the same
+     *          primitive that prepared the configuration.
+     * @param config Configuration accepted by preparePowerController()
+     * @param out Output text stream for generated Verilog
+     */
+    void emitPowerController(const PowerControllerConfig &config, QTextStream &out);
+
+    /**
+     * @brief Generate or update power_cell.v file with template cells
+     * @param outputDir Output directory path
+     * @return true if successful, false otherwise
+     */
+    bool generatePowerCellFile(const QString &outputDir);
+
     /**
      * @brief Parse power configuration from YAML
      * @param powerNode YAML node containing power configuration
@@ -142,13 +168,6 @@ private:
      */
     void generateOutputAssignments(const PowerControllerConfig &config, QTextStream &out);
 
-    /**
-     * @brief Generate or update power_cell.v file with template cells
-     * @param outputDir Output directory path
-     * @return true if successful, false otherwise
-     */
-    bool generatePowerCellFile(const QString &outputDir);
-
     /**
      * @brief Check if power_cell.v file exists and is complete
      * @param filePath Path to power_cell.v file
@@ -18,6 +18,39 @@ void QSocResetPrimitive::setForceOverwrite(bool force)
 }
 
 bool QSocResetPrimitive::generateResetController(const YAML::Node &resetNode, QTextStream &out)
+{
+    ResetControllerConfig config;
+    if (!prepareResetController(resetNode, config)) {
+        return false;
+    }
+
+    // Generate or update reset_cell.v file
+    if (m_parent && m_parent->getProjectManager()) {
+        QString outputDir = m_parent->getProjectManager()->getOutputPath();
+        if (!generateResetCellFile(outputDir)) {
+            QSocConsole::warn() << "Failed to generate reset_cell.v file";
+            return false;
+        }
+    }
+
+    // Generate Verilog code
+    emitResetController(config, out);
+
+    // Generate Typst reset diagram (failure does not affect Verilog generation)
+    if (m_parent && m_parent->getProjectManager()) {
+        QString outputDir = m_parent->getProjectManager()->getOutputPath();
+        QString typstPath = outputDir + QStringLiteral("/") + config.moduleName
+                            + QStringLiteral(".typ");
+        if (!generateTypstDiagram(config, typstPath)) {
+            QSocConsole::warn() << "Failed to generate Typst diagram (non-critical):" << typstPath;
+        }
+    }
+
+    return true;
+}
+
+bool QSocResetPrimitive::prepareResetController(
+    const YAML::Node &resetNode, ResetControllerConfig &config)
 {
     if (!resetNode || !resetNode.IsMap()) {
         QSocConsole::warn() << "Invalid reset node provided";
@@ -25,7 +58,7 @@ bool QSocResetPrimitive::generateResetController(const YAML::Node &resetNode, QT
     }
 
     // Parse configuration
-    ResetControllerConfig config = parseResetConfig(resetNode);
+    config = parseResetConfig(resetNode);
 
     if (config.targets.isEmpty()) {
         QSocConsole::warn() << "Reset configuration must have at least one target";
@@ -47,16 +80,11 @@ bool QSocResetPrimitive::generateResetController(const YAML::Node &resetNode, QT
        like `rst_sw_dcmi_n`). Do NOT warn about undeclared sources here;
        the typo case surfaces downstream as an unwired controller pin. */
 
-    // Generate or update reset_cell.v file
-    if (m_parent && m_parent->getProjectManager()) {
-        QString outputDir = m_parent->getProjectManager()->getOutputPath();
-        if (!generateResetCellFile(outputDir)) {
-            QSocConsole::warn() << "Failed to generate reset_cell.v file";
-            return false;
-        }
-    }
+    return true;
+}
 
-    // Generate Verilog code
+void QSocResetPrimitive::emitResetController(const ResetControllerConfig &config, QTextStream &out)
+{
     generateModuleHeader(config, out);
     generateWireDeclarations(config, out);
     generateResetLogic(config, out);
@@ -69,18 +97,6 @@ bool QSocResetPrimitive::generateResetController(const YAML::Node &resetNode, QT
 
     // Close module
     out << "\nendmodule\n\n";
-
-    // Generate Typst reset diagram (failure does not affect Verilog generation)
-    if (m_parent && m_parent->getProjectManager()) {
-        QString outputDir = m_parent->getProjectManager()->getOutputPath();
-        QString typstPath = outputDir + QStringLiteral("/") + config.moduleName
-                            + QStringLiteral(".typ");
-        if (!generateTypstDiagram(config, typstPath)) {
-            QSocConsole::warn() << "Failed to generate Typst diagram (non-critical):" << typstPath;
-        }
-    }
-
-    return true;
 }
 
 QSocResetPrimitive::ResetControllerConfig QSocResetPrimitive::parseResetConfig(
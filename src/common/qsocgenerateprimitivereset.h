@@ -128,6 +128,31 @@ public:
      */
     bool generateResetController(const YAML::Node &resetNode, QTextStream &out);
 
+    /**
+     * @brief Parse and validate reset configuration for emission
+     * @details First half of generateResetController(), free of side files.
+     * @param resetNode YAML node containing reset configuration
+     * @param config Parsed configuration structure, valid on success
+     * @return true if the controller can be emitted, false otherwise
+     */
+    bool prepareResetController(const YAML::Node &resetNode, ResetControllerConfig &config);
+
+    /**
+     * @brief Emit reset controller Verilog for a prepared configuration
+     * @details Writes the module text only; reset_cell.v and the Typst
+     *          diagram are left to the caller.
+     * @param config Configuration accepted by prepareResetController()
+     * @param out Output text stream for generated Verilog
+     */
+    void emitResetController(const ResetControllerConfig &config, QTextStream &out);
+
+    /**
+     * @brief Generate or update reset_cell.v file with template cells
+     * @param outputDir Output directory path
+     * @return true if successful, false otherwise
+     */
+    bool generateResetCellFile(const QString &outputDir);
+
     /**
      * @brief Parse reset configuration from YAML
      * @param resetNode YAML node containing reset configuration
@@ -191,13 +216,6 @@ private:
      */
     void generateResetCellFile(QTextStream &out);
 
-    /**
-     * @brief Generate or update reset_cell.v file with template cells
-     * @param outputDir Output directory path
-     * @return true if successful, false otherwise
-     */
-    bool generateResetCellFile(const QString &outputDir);
-
     /**
      * @brief Generate single reset component instance
      * @param targetName Target name for instance naming
@@ -3,6 +3,8 @@
 
 #include "common/qsocconsole.h"
 #include "common/qsocgeneratemanager.h"
+#include "common/qsocprofiler.h"
+#include "common/qsocrdlcache.h"
 
 #include <QCoreApplication>
 #include <QDir>
@@ -10,7 +12,10 @@
 #include <QFileInfo>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QSet>
 #include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
 
 #include <systemrdl_api.h>
 
@@ -18,27 +23,148 @@
 #include <fmt/format.h>
 #include <fstream>
 #include <inja/inja.hpp>
+#include <iomanip>
+#include <memory>
 #include <nlohmann/json.hpp>
 #include <rapidcsv.h>
 #include <sstream>
+#include <stdexcept>
+#include <vector>
 
-bool QSocGenerateManager::renderTemplate(
-    const QString     &templateFilePath,
-    const QStringList &csvFiles,
-    const QStringList &yamlFiles,
-    const QStringList &jsonFiles,
-    const QStringList &rdlFiles,
-    const QStringList &rcsvFiles,
-    const QString     &outputFileName)
+namespace {
+
+using json    = nlohmann::json;
+using Sidecar = QSocGenerateManager::TemplateSidecar;
+
+/* One template of a batch, rendered on a worker against the shared data */
+struct TemplateTask
+{
+    QString              templateFilePath;
+    QString              outputFileName;
+    inja::Template       parsed;
+    std::string          text; /* Rendered output */
+    bool                 parsedOk = false;
+    bool                 success  = false;
+    QSocConsole::Capture log;
+};
+
+/* Run body(i) for every i in [0, count) on a private pool and wait for all */
+template<typename Body>
+void runParallel(qsizetype count, const Body &body)
+{
+    if (count <= 0) {
+        return;
+    }
+    if (count == 1) {
+        body(0);
+        return;
+    }
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(static_cast<int>(qMin<qsizetype>(QThread::idealThreadCount(), count)));
+    for (qsizetype i = 0; i < count; ++i) {
+        pool.start([&body, i]() { body(i); });
+    }
+    pool.waitForDone();
+}
+
+/* Elaborate a SystemRDL file to simplified JSON; failures are reported */
+bool elaborateRdlFile(const QString &rdlFilePath, json &rdlJson)
+{
+    /* Use SystemRDL library to elaborate the RDL file to simplified JSON */
+    const systemrdl::Result result = systemrdl::file::elaborate_simplified(
+        rdlFilePath.toStdString());
+
+    if (!result.ok()) {
+        QSocConsole::error() << QCoreApplication::translate(
+                                    "generate", "failed to elaborate SystemRDL file \"%1\": %2")
+                                    .arg(rdlFilePath)
+                                    .arg(QString::fromStdString(result.error()));
+        return false;
+    }
+
+    /* Parse the elaborated JSON result */
+    rdlJson = json::parse(result.value());
+    return true;
+}
+
+/* Convert an RCSV file to SystemRDL and elaborate it; failures are reported */
+bool elaborateRcsvFile(const QString &rcsvFilePath, json &rcsvJson)
+{
+    /* Use SystemRDL library to convert RCSV file to SystemRDL */
+    const systemrdl::Result csvToRdlResult = systemrdl::file::csv_to_rdl(rcsvFilePath.toStdString());
+
+    if (!csvToRdlResult.ok()) {
+        QSocConsole::error() << QCoreApplication::translate(
+                                    "generate", "failed to convert RCSV file \"%1\": %2")
+                                    .arg(rcsvFilePath)
+                                    .arg(QString::fromStdString(csvToRdlResult.error()));
+        return false;
+    }
+
+    /* Use SystemRDL library to elaborate the converted SystemRDL to simplified JSON */
+    const systemrdl::Result result = systemrdl::elaborate_simplified(csvToRdlResult.value());
+
+    if (!result.ok()) {
+        QSocConsole::error() << QCoreApplication::translate(
+                                    "generate", "failed to elaborate RCSV file \"%1\": %2")
+                                    .arg(rcsvFilePath)
+                                    .arg(QString::fromStdString(result.error()));
+        return false;
+    }
+
+    /* Parse the elaborated JSON result */
+    rcsvJson = json::parse(result.value());
+    return true;
+}
+
+/* Elaborated JSON of an RDL or RCSV file, taken from the on-disk cache
+ * while the file and everything it includes are unchanged */
+bool loadElaborated(QSocRdlCache::Kind kind, const QString &filePath, json &result)
+{
+    QSocRdlCache *cache = QSocRdlCache::shared();
+    const QString key   = cache != nullptr ? QSocRdlCache::keyFor(kind, filePath) : QString();
+    if (cache != nullptr) {
+        const QSocProfiler::Scope profile("rdlCacheLookup");
+        if (cache->lookup(key, result)) {
+            return true;
+        }
+    }
+
+    const QSocProfiler::Scope profile("rdlElaborate");
+
+    const bool elaborated = kind == QSocRdlCache::Kind::Rdl ? elaborateRdlFile(filePath, result)
+                                                            : elaborateRcsvFile(filePath, result);
+    /* A source edited while elaborating would file the new result under
+     * the old content's key; leave the store to the next run then. */
+    if (elaborated && cache != nullptr && QSocRdlCache::keyFor(kind, filePath) == key) {
+        cache->store(key, result);
+    }
+    return elaborated;
+}
+
+/* Load every data file and merge it into @p dataObject, the template context.
+ * @p cancelled is polled before each file; true stops the load with false. */
+bool loadTemplateData(
+    const QStringList           &csvFiles,
+    const QStringList           &yamlFiles,
+    const QStringList           &jsonFiles,
+    const QStringList           &rdlFiles,
+    const QStringList           &rcsvFiles,
+    json                        &dataObject,
+    const std::function<bool()> &cancelled)
 {
-    using json      = nlohmann::json;
-    json dataObject = json::object();
+    const QSocProfiler::Scope profile("templateData");
+    dataObject = json::object();
 
     /* Create a global data array for all CSV data */
     json globalDataArray = json::array();
 
     /* Process CSV files */
     for (const QString &csvFilePath : csvFiles) {
+        if (cancelled()) {
+            return false;
+        }
         if (!QFile::exists(csvFilePath)) {
             QSocConsole::error() << QCoreApplication::translate(
                                         "generate", "CSV file does not exist: \"%1\"")
@@ -163,6 +289,9 @@ bool QSocGenerateManager::renderTemplate(
 
     /* Process YAML files */
     for (const QString &yamlFilePath : yamlFiles) {
+        if (cancelled()) {
+            return false;
+        }
         if (!QFile::exists(yamlFilePath)) {
             QSocConsole::error() << QCoreApplication::translate(
                                         "generate", "YAML file does not exist: \"%1\"")
@@ -252,6 +381,9 @@ bool QSocGenerateManager::renderTemplate(
 
     /* Process JSON files */
     for (const QString &jsonFilePath : jsonFiles) {
+        if (cancelled()) {
+            return false;
+        }
         if (!QFile::exists(jsonFilePath)) {
             QSocConsole::error() << QCoreApplication::translate(
                                         "generate", "JSON file does not exist: \"%1\"")
@@ -317,6 +449,9 @@ bool QSocGenerateManager::renderTemplate(
 
     /* Process SystemRDL files */
     for (const QString &rdlFilePath : rdlFiles) {
+        if (cancelled()) {
+            return false;
+        }
         if (!QFile::exists(rdlFilePath)) {
             QSocConsole::error() << QCoreApplication::translate(
                                         "generate", "SystemRDL file does not exist: \"%1\"")
@@ -325,22 +460,11 @@ bool QSocGenerateManager::renderTemplate(
         }
 
         try {
-            /* Use SystemRDL library to elaborate the RDL file to simplified JSON */
-            const systemrdl::Result result = systemrdl::file::elaborate_simplified(
-                rdlFilePath.toStdString());
-
-            if (!result.ok()) {
-                QSocConsole::error()
-                    << QCoreApplication::translate(
-                           "generate", "failed to elaborate SystemRDL file \"%1\": %2")
-                           .arg(rdlFilePath)
-                           .arg(QString::fromStdString(result.error()));
+            json rdlJson;
+            if (!loadElaborated(QSocRdlCache::Kind::Rdl, rdlFilePath, rdlJson)) {
                 return false;
             }
 
-            /* Parse the elaborated JSON result */
-            const json rdlJson = json::parse(result.value());
-
             /* Get file basename for keying */
             const QFileInfo fileInfo(rdlFilePath);
             const QString   baseName = fileInfo.baseName();
@@ -359,6 +483,9 @@ bool QSocGenerateManager::renderTemplate(
 
     /* Process RCSV files */
     for (const QString &rcsvFilePath : rcsvFiles) {
+        if (cancelled()) {
+            return false;
+        }
         if (!QFile::exists(rcsvFilePath)) {
             QSocConsole::error() << QCoreApplication::translate(
                                         "generate", "RCSV file does not exist: \"%1\"")
@@ -367,32 +494,11 @@ bool QSocGenerateManager::renderTemplate(
         }
 
         try {
-            /* Use SystemRDL library to convert RCSV file to SystemRDL */
-            const systemrdl::Result csvToRdlResult = systemrdl::file::csv_to_rdl(
-                rcsvFilePath.toStdString());
-
-            if (!csvToRdlResult.ok()) {
-                QSocConsole::error() << QCoreApplication::translate(
-                                            "generate", "failed to convert RCSV file \"%1\": %2")
-                                            .arg(rcsvFilePath)
-                                            .arg(QString::fromStdString(csvToRdlResult.error()));
-                return false;
-            }
-
-            /* Use SystemRDL library to elaborate the converted SystemRDL to simplified JSON */
-            const systemrdl::Result result = systemrdl::elaborate_simplified(csvToRdlResult.value());
-
-            if (!result.ok()) {
-                QSocConsole::error() << QCoreApplication::translate(
-                                            "generate", "failed to elaborate RCSV file \"%1\": %2")
-                                            .arg(rcsvFilePath)
-                                            .arg(QString::fromStdString(result.error()));
+            json rcsvJson;
+            if (!loadElaborated(QSocRdlCache::Kind::Rcsv, rcsvFilePath, rcsvJson)) {
                 return false;
             }
 
-            /* Parse the elaborated JSON result */
-            const json rcsvJson = json::parse(result.value());
-
             /* Get file basename for keying */
             const QFileInfo fileInfo(rcsvFilePath);
             const QString   baseName = fileInfo.baseName();
@@ -409,20 +515,195 @@ bool QSocGenerateManager::renderTemplate(
         }
     }
 
-    /* Process template file */
+    return true;
+}
+
+/* Write one rendered template */
+bool writeTemplateOutput(const QString &outputDir, const TemplateTask &task)
+{
+    /* Create output file */
+    const QString outputPath = outputDir + QDir::separator() + task.outputFileName;
+    QFile         outputFile(outputPath);
+    if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        QSocConsole::error() << QCoreApplication::translate(
+                                    "generate", "Could not create output file \"%1\"")
+                                    .arg(outputPath);
+        return false;
+    }
+
+    QTextStream stream(&outputFile);
+    stream << QString::fromStdString(task.text);
+    outputFile.close();
+    return true;
+}
+
+/* Data file next to an output: <basename>.json, .cbor or .msgpack */
+QString sidecarPath(const QString &outputDir, const QString &outputFileName, Sidecar format)
+{
+    const char *suffix = ".json";
+    if (format == Sidecar::Cbor) {
+        suffix = ".cbor";
+    } else if (format == Sidecar::MsgPack) {
+        suffix = ".msgpack";
+    }
+    return outputDir + QDir::separator() + QFileInfo(outputFileName).baseName()
+           + QLatin1String(suffix);
+}
+
+/* Format name for messages about a data file */
+QString sidecarFormatName(Sidecar format)
+{
+    if (format == Sidecar::Cbor) {
+        return QStringLiteral("CBOR");
+    }
+    if (format == Sidecar::MsgPack) {
+        return QStringLiteral("MessagePack");
+    }
+    return QStringLiteral("JSON");
+}
+
+/* Stream the template data to a file for debugging and third-party tools.
+ * The serializers write straight to the stream, so no text copy of the
+ * whole data set is built in memory. The data goes to <path>.part first and
+ * is renamed into place once complete, so a failed write never leaves a
+ * truncated sidecar behind. Returns false when nothing was written. */
+bool writeSidecar(const QString &path, const json &dataObject, Sidecar format)
+{
+    const QSocProfiler::Scope profile("templateSidecar");
+
+    const QString partPath = path + QStringLiteral(".part");
+    std::ofstream stream(QFile::encodeName(partPath).toStdString(), std::ios::binary);
+    if (!stream) {
+        QSocConsole::warn() << QCoreApplication::translate(
+                                   "generate", "Warning: Could not create %1 data file \"%2\"")
+                                   .arg(sidecarFormatName(format), path);
+        return false;
+    }
+
     try {
-        /* Read template file */
-        QFile templateFile(templateFilePath);
-        if (!templateFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            QSocConsole::error() << QCoreApplication::translate(
-                                        "generate", "Could not open template file \"%1\"")
-                                        .arg(templateFilePath);
-            return false;
+        switch (format) {
+        case Sidecar::Pretty:
+            stream << std::setw(4) << dataObject; /* 4 spaces indentation */
+            break;
+        case Sidecar::Compact:
+            stream << dataObject;
+            break;
+        case Sidecar::Cbor:
+            json::to_cbor(dataObject, stream);
+            break;
+        case Sidecar::MsgPack:
+            json::to_msgpack(dataObject, stream);
+            break;
+        case Sidecar::Off:
+            break;
+        }
+        stream.close();
+        if (stream.fail()) {
+            throw std::runtime_error(QFile::encodeName(partPath).toStdString() + ": write failed");
         }
+    } catch (const std::exception &e) {
+        stream.close();
+        QFile::remove(partPath);
+        QSocConsole::warn() << QCoreApplication::translate(
+                                   "generate", "Warning: Failed to create %1 data file: %2")
+                                   .arg(sidecarFormatName(format), QString::fromUtf8(e.what()));
+        return false;
+    }
+
+    QFile::remove(path);
+    if (!QFile::rename(partPath, path)) {
+        QFile::remove(partPath);
+        QSocConsole::warn() << QCoreApplication::translate(
+                                   "generate", "Warning: Could not create %1 data file \"%2\"")
+                                   .arg(sidecarFormatName(format), path);
+        return false;
+    }
+    return true;
+}
 
-        const QByteArray templateData = templateFile.readAll();
-        templateFile.close();
+} // namespace
 
+bool QSocGenerateManager::renderTemplate(
+    const QString     &templateFilePath,
+    const QStringList &csvFiles,
+    const QStringList &yamlFiles,
+    const QStringList &jsonFiles,
+    const QStringList &rdlFiles,
+    const QStringList &rcsvFiles,
+    const QString     &outputFileName)
+{
+    return renderTemplates(
+        {{templateFilePath, outputFileName}}, csvFiles, yamlFiles, jsonFiles, rdlFiles, rcsvFiles);
+}
+
+bool QSocGenerateManager::renderTemplates(
+    const QList<QPair<QString, QString>> &templates,
+    const QStringList                    &csvFiles,
+    const QStringList                    &yamlFiles,
+    const QStringList                    &jsonFiles,
+    const QStringList                    &rdlFiles,
+    const QStringList                    &rcsvFiles,
+    QStringList                          *failedTemplates)
+{
+    const QSocProfiler::Scope profile("renderTemplates");
+
+    std::vector<TemplateTask> tasks;
+    tasks.reserve(static_cast<size_t>(templates.size()));
+    for (const auto &entry : templates) {
+        TemplateTask task;
+        task.templateFilePath = entry.first;
+        task.outputFileName   = entry.second;
+        tasks.push_back(std::move(task));
+    }
+
+    const auto reportFailures = [&]() {
+        bool result = true;
+        for (const TemplateTask &task : tasks) {
+            if (!task.success) {
+                result = false;
+                if (failedTemplates) {
+                    failedTemplates->append(task.templateFilePath);
+                }
+            }
+        }
+        return result;
+    };
+
+    /* Polled between data files and stages; warns once when it trips */
+    bool       stopped   = false;
+    const auto cancelled = [this, &stopped]() {
+        if (!stopped && cancelCheck && cancelCheck()) {
+            QSocConsole::warn() << QCoreApplication::translate(
+                "generate", "Template rendering cancelled");
+            stopped = true;
+        }
+        return stopped;
+    };
+
+    /* The data set is loaded and merged once for the whole batch */
+    json dataObject;
+    if (!loadTemplateData(
+            csvFiles, yamlFiles, jsonFiles, rdlFiles, rcsvFiles, dataObject, cancelled)) {
+        reportFailures();
+        return false;
+    }
+
+    /* The sidecar needs only the data, so it is written while templates render */
+    const QString            outputDir = projectManager->getOutputPath();
+    QString                  firstSidecarPath;
+    bool                     sidecarWritten = false;
+    QSocConsole::Capture     sidecarLog;
+    std::unique_ptr<QThread> sidecarWriter;
+    if (templateSidecar != TemplateSidecar::Off && !tasks.empty()) {
+        firstSidecarPath = sidecarPath(outputDir, tasks.front().outputFileName, templateSidecar);
+        sidecarWriter.reset(QThread::create([&, format = templateSidecar]() {
+            const QSocConsole::CaptureScope scope(sidecarLog);
+            sidecarWritten = writeSidecar(firstSidecarPath, dataObject, format);
+        }));
+        sidecarWriter->start();
+    }
+
+    try {
         /* Setup inja environment */
         inja::Environment env;
 
@@ -651,58 +932,107 @@ bool QSocGenerateManager::renderTemplate(
             }
         });
 
-        /* Render template */
-        const std::string templateStr = templateData.toStdString();
-        const std::string result      = env.render(templateStr, dataObject);
-
-        /* Create output file */
-        const QString outputPath = projectManager->getOutputPath() + QDir::separator()
-                                   + outputFileName;
-        QFile         outputFile(outputPath);
-        if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            QSocConsole::error() << QCoreApplication::translate(
-                                        "generate", "Could not create output file \"%1\"")
-                                        .arg(outputPath);
-            return false;
-        }
+        /* Parse every template once, in order: parsing registers includes in env */
+        QSocProfiler::Scope parseProfile("templateParse");
+        parseProfile.setCount(static_cast<qint64>(tasks.size()));
+        for (TemplateTask &task : tasks) {
+            const QSocConsole::CaptureScope scope(task.log);
+            QFile                           templateFile(task.templateFilePath);
+            if (!templateFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+                QSocConsole::error() << QCoreApplication::translate(
+                                            "generate", "Could not open template file \"%1\"")
+                                            .arg(task.templateFilePath);
+                continue;
+            }
 
-        QTextStream stream(&outputFile);
-        stream << QString::fromStdString(result);
-        outputFile.close();
+            const QByteArray templateData = templateFile.readAll();
+            templateFile.close();
 
-        /* Generate corresponding JSON data file for debugging/third-party tools */
-        const QFileInfo outputFileInfo(outputFileName);
-        const QString   jsonFileName = outputFileInfo.baseName() + ".json";
-        const QString jsonPath = projectManager->getOutputPath() + QDir::separator() + jsonFileName;
-        QFile         jsonFile(jsonPath);
-        if (!jsonFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            QSocConsole::warn() << QCoreApplication::translate(
-                                       "generate", "Warning: Could not create JSON data file \"%1\"")
-                                       .arg(jsonPath);
-        } else {
             try {
-                /* Serialize dataObject to formatted JSON */
-                const std::string formattedJson = dataObject.dump(4); /* 4 spaces indentation */
-
-                QTextStream stream(&jsonFile);
-                stream.setEncoding(QStringConverter::Utf8);
-                stream << QString::fromStdString(formattedJson);
-                jsonFile.close();
+                task.parsed   = env.parse(templateData.toStdString());
+                task.parsedOk = true;
             } catch (const std::exception &e) {
-                QSocConsole::warn()
-                    << QCoreApplication::translate(
-                           "generate", "Warning: Failed to create JSON data file: %1")
-                           .arg(e.what());
+                QSocConsole::error() << QCoreApplication::translate(
+                                            "generate", "failed to render template \"%1\": %2")
+                                            .arg(task.templateFilePath)
+                                            .arg(e.what());
+            }
+        }
+        parseProfile.finish();
+        if (cancelled()) {
+            for (TemplateTask &task : tasks) {
+                task.parsedOk = false;
             }
         }
 
-        return true;
+        /* Render concurrently; env and dataObject are only read from here on */
+        QSocProfiler::Scope renderProfile("templateRender");
+        renderProfile.setCount(static_cast<qint64>(tasks.size()));
+        runParallel(static_cast<qsizetype>(tasks.size()), [&env, &tasks, &dataObject](qsizetype i) {
+            TemplateTask &task = tasks[i];
+            if (!task.parsedOk) {
+                return;
+            }
+            const QSocConsole::CaptureScope scope(task.log);
+            try {
+                task.text    = env.render(task.parsed, dataObject);
+                task.success = true;
+            } catch (const std::exception &e) {
+                QSocConsole::error() << QCoreApplication::translate(
+                                            "generate", "failed to render template \"%1\": %2")
+                                            .arg(task.templateFilePath)
+                                            .arg(e.what());
+            }
+        });
+        renderProfile.finish();
+
+        /* Write and report in template order, as a one-by-one run would */
+        const bool keep = !cancelled();
+        for (TemplateTask &task : tasks) {
+            task.log.replay();
+            if (task.success) {
+                task.success = keep && writeTemplateOutput(outputDir, task);
+            }
+        }
 
     } catch (const std::exception &e) {
         QSocConsole::error() << QCoreApplication::translate(
-                                    "generate", "failed to render template \"%1\": %2")
-                                    .arg(templateFilePath)
+                                    "generate", "failed to set up template environment: %1")
                                     .arg(e.what());
-        return false;
     }
+
+    /* Every output carries the same data, so the others get a copy; the
+     * first one goes again when its own template failed. A failed write
+     * leaves nothing new on disk, so nothing is copied either. */
+    if (sidecarWriter) {
+        sidecarWriter->wait();
+        sidecarLog.replay();
+    }
+    if (sidecarWritten) {
+        QSet<QString> written{firstSidecarPath};
+        bool          firstUsed = false;
+        for (const TemplateTask &task : tasks) {
+            if (!task.success) {
+                continue;
+            }
+            const QString path = sidecarPath(outputDir, task.outputFileName, templateSidecar);
+            if (path == firstSidecarPath) {
+                firstUsed = true;
+            } else if (!written.contains(path)) {
+                QFile::remove(path);
+                if (!QFile::copy(firstSidecarPath, path)) {
+                    QSocConsole::warn()
+                        << QCoreApplication::translate(
+                               "generate", "Warning: Could not create %1 data file \"%2\"")
+                               .arg(sidecarFormatName(templateSidecar), path);
+                }
+                written.insert(path);
+            }
+        }
+        if (!firstUsed) {
+            QFile::remove(firstSidecarPath);
+        }
+    }
+
+    return reportFailures();
 }
@@ -7,6 +7,7 @@
 #include "common/qsocgenerateprimitivecomb.h"
 #include "common/qsocgenerateprimitivepower.h"
 #include "common/qsocgenerateprimitiveseq.h"
+#include "common/qsocprofiler.h"
 #include "common/qsocgeneratereportunconnected.h"
 #include "common/qsocverilogutils.h"
 #include "common/qstaticstringweaver.h"
@@ -21,12 +22,78 @@
 #include <QProcess>
 #include <QRegularExpression>
 #include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
 
+#include <algorithm>
+#include <exception>
 #include <fstream>
 #include <iostream>
+#include <vector>
+
+namespace {
+
+enum class ControllerKind { Reset, Clock, Power, Fsm };
+
+/* One reset/clock/power/fsm entry, rendered independently of its siblings */
+struct ControllerTask
+{
+    ControllerKind       kind;
+    size_t               index = 0;     /* Position inside its netlist section */
+    bool                 last  = false; /* Last entry of its netlist section */
+    YAML::Node           node;          /* Private clone, safe to read off-thread */
+    QString              text;          /* Rendered Verilog */
+    bool                 success = false;
+    std::exception_ptr   error;
+    QSocConsole::Capture log;
+    QSocConsole::Capture diagramLog;
+
+    QSocResetPrimitive::ResetControllerConfig resetConfig;
+    QSocClockPrimitive::ClockControllerConfig clockConfig;
+    QSocPowerPrimitive::PowerControllerConfig powerConfig;
+};
+
+const char *controllerKindName(ControllerKind kind)
+{
+    switch (kind) {
+    case ControllerKind::Reset:
+        return "reset";
+    case ControllerKind::Clock:
+        return "clock";
+    case ControllerKind::Power:
+        return "power";
+    case ControllerKind::Fsm:
+        return "FSM";
+    }
+    return "";
+}
+
+/* Run body(i) for every i in [0, count) on a private pool and wait for all */
+template<typename Body>
+void runParallel(qsizetype count, const Body &body)
+{
+    if (count <= 0) {
+        return;
+    }
+    if (count == 1) {
+        body(0);
+        return;
+    }
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(static_cast<int>(qMin<qsizetype>(QThread::idealThreadCount(), count)));
+    for (qsizetype i = 0; i < count; ++i) {
+        pool.start([&body, i]() { body(i); });
+    }
+    pool.waitForDone();
+}
+
+} // namespace
 
 bool QSocGenerateManager::generateVerilog(const QString &outputFileName)
 {
+    const QSocProfiler::Scope profile("generateVerilog");
+
     /* Create unconnected port reporter for collecting data */
     QSocGenerateReportUnconnected unconnectedPortReporter;
 
@@ -99,99 +166,8 @@ bool QSocGenerateManager::generateVerilog(const QString &outputFileName)
 
     out << "`timescale 1ns / 1ps\n\n";
 
-    /* Generate reset primitive controllers first (before top-level module) */
-    if (netlistData["reset"] && netlistData["reset"].IsSequence()
-        && netlistData["reset"].size() > 0) {
-        for (size_t i = 0; i < netlistData["reset"].size(); ++i) {
-            const YAML::Node &resetItem = netlistData["reset"][i];
-
-            if (!resetItem.IsMap()) {
-                QSocConsole::warn() << "Skipping invalid reset item at index" << i;
-                continue;
-            }
-
-            if (!generateResetPrimitive(resetItem, out)) {
-                QSocConsole::warn() << "Failed to generate reset primitive at index" << i;
-                continue;
-            }
-
-            /* Add blank line between different reset blocks */
-            if (i < netlistData["reset"].size() - 1) {
-                out << "\n";
-            }
-        }
-    }
-
-    /* Generate clock primitive controllers second (before top-level module) */
-    if (netlistData["clock"] && netlistData["clock"].IsSequence()
-        && netlistData["clock"].size() > 0) {
-        for (size_t i = 0; i < netlistData["clock"].size(); ++i) {
-            const YAML::Node &clockItem = netlistData["clock"][i];
-
-            if (!clockItem.IsMap()) {
-                QSocConsole::warn() << "Skipping invalid clock item at index" << i;
-                continue;
-            }
-
-            if (!generateClockPrimitive(clockItem, out)) {
-                QSocConsole::warn() << "Failed to generate clock primitive at index" << i;
-                continue;
-            }
-
-            /* Add blank line between different clock blocks */
-            if (i < netlistData["clock"].size() - 1) {
-                out << "\n";
-            }
-        }
-    }
-
-    /* Generate power primitive controllers third (before top-level module) */
-    if (netlistData["power"] && netlistData["power"].IsSequence()
-        && netlistData["power"].size() > 0) {
-        for (size_t i = 0; i < netlistData["power"].size(); ++i) {
-            const YAML::Node &powerItem = netlistData["power"][i];
-
-            if (!powerItem.IsMap()) {
-                QSocConsole::warn() << "Skipping invalid power item at index" << i;
-                continue;
-            }
-
-            if (!generatePowerPrimitive(powerItem, out)) {
-                QSocConsole::warn() << "Failed to generate power primitive at index" << i;
-                continue;
-            }
-
-            /* Add blank line between different power blocks */
-            if (i < netlistData["power"].size() - 1) {
-                out << "\n";
-            }
-        }
-    }
-
-    /* Generate FSM primitive controllers fourth (before top-level module) */
-    if (netlistData["fsm"] && netlistData["fsm"].IsSequence() && netlistData["fsm"].size() > 0) {
-        for (size_t i = 0; i < netlistData["fsm"].size(); ++i) {
-            const YAML::Node &fsmItem = netlistData["fsm"][i];
-
-            if (!fsmItem.IsMap() || !fsmItem["name"] || !fsmItem["name"].IsScalar()
-                || !fsmItem["clk"] || !fsmItem["clk"].IsScalar() || !fsmItem["rst"]
-                || !fsmItem["rst"].IsScalar() || !fsmItem["rst_state"]
-                || !fsmItem["rst_state"].IsScalar()) {
-                QSocConsole::warn() << "FSM" << i << "has invalid format, skipping";
-                continue; /* Skip invalid FSM items */
-            }
-
-            if (!generateFSMPrimitive(fsmItem, out)) {
-                QSocConsole::warn() << "Failed to generate FSM primitive at index" << i;
-                continue;
-            }
-
-            /* Add blank line between different FSM blocks */
-            if (i < netlistData["fsm"].size() - 1) {
-                out << "\n";
-            }
-        }
-    }
+    /* Generate reset, clock, power and FSM controllers (before top-level module) */
+    generateControllerPrimitives(out);
 
     /* Check if we need to generate a top-level module */
     bool hasPorts = netlistData["port"] && netlistData["port"].IsMap()
@@ -561,6 +537,11 @@ bool QSocGenerateManager::generateVerilog(const QString &outputFileName)
     /* Add connections (wires) section comment */
     out << "    /* Wire declarations */\n";
 
+    QSocProfiler::Scope wireProfile("wires");
+    if (netlistData["net"] && netlistData["net"].IsMap()) {
+        wireProfile.setCount(static_cast<qint64>(netlistData["net"].size()));
+    }
+
     /* Generate wire declarations FIRST */
     if (netlistData["net"]) {
         if (!netlistData["net"].IsMap()) {
@@ -1338,9 +1319,16 @@ bool QSocGenerateManager::generateVerilog(const QString &outputFileName)
             << "No 'net' section in netlist, no wire declarations will be generated";
     }
 
+    wireProfile.finish();
+
     /* Add instances section comment */
     out << "    /* Module instantiations */\n";
 
+    QSocProfiler::Scope instanceProfile("instances");
+    if (netlistData["instance"] && netlistData["instance"].IsMap()) {
+        instanceProfile.setCount(static_cast<qint64>(netlistData["instance"].size()));
+    }
+
     /* Generate instance declarations after wire declarations */
     if (netlistData["instance"] && netlistData["instance"].IsMap()) {
         /* yaml-cpp's iterator may visit duplicate keys without merging.
@@ -1836,6 +1824,8 @@ bool QSocGenerateManager::generateVerilog(const QString &outputFileName)
         }
     }
 
+    instanceProfile.finish();
+
     /* Generate combinational logic after module instantiations */
     if (!generateCombPrimitive(netlistData, out)) {
         QSocConsole::warn() << "Failed to generate combinational logic primitives";
@@ -1919,6 +1909,8 @@ bool QSocGenerateManager::generateVerilog(const QString &outputFileName)
 
     /* Generate unconnected port report if we have unconnected ports */
     if (unconnectedPortReporter.getUnconnectedPortCount() > 0) {
+        QSocProfiler::Scope reportProfile("unconnectedReport");
+        reportProfile.setCount(unconnectedPortReporter.getUnconnectedPortCount());
         const QString reportOutputPath = projectManager->getOutputPath();
         if (unconnectedPortReporter.generateReport(reportOutputPath, outputFileName)) {
             QSocConsole::info() << "Successfully generated unconnected port report:"
@@ -1936,6 +1928,8 @@ bool QSocGenerateManager::generateVerilog(const QString &outputFileName)
 
 bool QSocGenerateManager::formatVerilogFile(const QString &filePath)
 {
+    const QSocProfiler::Scope profile("formatVerilogFile");
+
     /* Verible formatting is a runtime convenience only. Tests set
      * QSOC_SKIP_VERIBLE_FORMAT=1 so generated output is deterministic and
      * independent of whether (or which) verible-verilog-format is on PATH. */
@@ -1996,6 +1990,8 @@ bool QSocGenerateManager::formatVerilogFile(const QString &filePath)
 
 bool QSocGenerateManager::generateCombPrimitive(const YAML::Node &netlistData, QTextStream &out)
 {
+    const QSocProfiler::Scope profile("comb", "primitive");
+
     if (!combPrimitive) {
         QSocConsole::warn() << "Comb primitive generator not initialized";
         return false;
@@ -2004,53 +2000,227 @@ bool QSocGenerateManager::generateCombPrimitive(const YAML::Node &netlistData, Q
     return combPrimitive->generateCombLogic(netlistData, out);
 }
 
-/**
- * @brief Generate FSM Verilog code for a single FSM
- * @param fsmItem The YAML node containing the FSM specification
- * @param out Output text stream
- */
-bool QSocGenerateManager::generateFSMPrimitive(const YAML::Node &fsmNode, QTextStream &out)
+void QSocGenerateManager::generateControllerPrimitives(QTextStream &out)
 {
-    if (!fsmPrimitive) {
-        QSocConsole::warn() << "FSM primitive generator not initialized";
-        return false;
-    }
+    std::vector<ControllerTask> tasks;
 
-    return fsmPrimitive->generateFSMVerilog(fsmNode, out);
-}
+    /* Validate and clone serially: yaml-cpp nodes share memory and are not thread-safe */
+    const auto collect = [this, &tasks](const char *section, ControllerKind kind) {
+        const YAML::Node items = netlistData[section];
+        if (!items || !items.IsSequence() || items.size() == 0) {
+            return;
+        }
+        for (size_t i = 0; i < items.size(); ++i) {
+            const YAML::Node item = items[i];
 
-bool QSocGenerateManager::generateResetPrimitive(const YAML::Node &resetNode, QTextStream &out)
-{
-    if (!resetPrimitive) {
-        QSocConsole::warn() << "Reset primitive generator not initialized";
-        return false;
+            if (kind != ControllerKind::Fsm && !item.IsMap()) {
+                QSocConsole::warn() << "Skipping invalid" << section << "item at index" << i;
+                continue;
+            }
+            if (kind == ControllerKind::Fsm
+                && (!item.IsMap() || !item["name"] || !item["name"].IsScalar() || !item["clk"]
+                    || !item["clk"].IsScalar() || !item["rst"] || !item["rst"].IsScalar()
+                    || !item["rst_state"] || !item["rst_state"].IsScalar())) {
+                QSocConsole::warn() << "FSM" << i << "has invalid format, skipping";
+                continue;
+            }
+
+            ControllerTask task;
+            task.kind  = kind;
+            task.index = i;
+            task.last  = (i == items.size() - 1);
+            task.node  = YAML::Clone(item);
+            tasks.push_back(std::move(task));
+        }
+    };
+    collect("reset", ControllerKind::Reset);
+    collect("clock", ControllerKind::Clock);
+    collect("power", ControllerKind::Power);
+    collect("fsm", ControllerKind::Fsm);
+
+    if (tasks.empty()) {
+        return;
     }
 
-    return resetPrimitive->generateResetController(resetNode, out);
-}
+    QSocProfiler::Scope renderProfile("controllers");
+    renderProfile.setCount(static_cast<qint64>(tasks.size()));
+
+    /* Render every controller into its own buffer, each with private primitives */
+    runParallel(static_cast<qsizetype>(tasks.size()), [this, &tasks](qsizetype i) {
+        ControllerTask                &task = tasks[i];
+        const QSocConsole::CaptureScope scope(task.log);
+        const QSocProfiler::Scope       profile(
+            [&task] {
+                return QStringLiteral("%1[%2]").arg(controllerKindName(task.kind)).arg(task.index);
+            },
+            "primitive");
+        QTextStream stream(&task.text);
+        try {
+            switch (task.kind) {
+            case ControllerKind::Reset: {
+                QSocResetPrimitive primitive(this);
+                task.success = primitive.prepareResetController(task.node, task.resetConfig);
+                if (task.success) {
+                    primitive.emitResetController(task.resetConfig, stream);
+                }
+                break;
+            }
+            case ControllerKind::Clock: {
+                QSocClockPrimitive primitive(this);
+                task.success = primitive.prepareClockController(task.node, task.clockConfig);
+                if (task.success) {
+                    primitive.emitClockController(task.clockConfig, stream);
+                }
+                break;
+            }
+            case ControllerKind::Power: {
+                QSocPowerPrimitive primitive(this);
+                task.success = primitive.preparePowerController(task.node, task.powerConfig);
+                if (task.success) {
+                    primitive.emitPowerController(task.powerConfig, stream);
+                }
+                break;
+            }
+            case ControllerKind::Fsm: {
+                QSocFSMPrimitive primitive(this);
+                task.success = primitive.generateFSMVerilog(task.node, stream);
+                break;
+            }
+            }
+        } catch (...) {
+            task.error = std::current_exception();
+        }
+        stream.flush();
+    });
+
+    renderProfile.finish();
+
+    /* Shared cell libraries are written once per kind, after all controllers rendered */
+    const QString outputDir  = projectManager ? projectManager->getOutputPath() : QString();
+    const auto    writeCells = [&](ControllerKind kind) -> bool {
+        switch (kind) {
+        case ControllerKind::Reset:
+            return resetPrimitive && resetPrimitive->generateResetCellFile(outputDir);
+        case ControllerKind::Clock:
+            return clockPrimitive && clockPrimitive->generateClockCellFile(outputDir);
+        case ControllerKind::Power:
+            return powerPrimitive && powerPrimitive->generatePowerCellFile(outputDir);
+        case ControllerKind::Fsm:
+            return true;
+        }
+        return true;
+    };
+    QHash<int, bool> cellWritten;
 
-bool QSocGenerateManager::generateClockPrimitive(const YAML::Node &clockNode, QTextStream &out)
-{
-    if (!clockPrimitive) {
-        QSocConsole::warn() << "Clock primitive generator not initialized";
-        return false;
+    /* Assemble in netlist order so the output matches a serial run byte for byte */
+    for (ControllerTask &task : tasks) {
+        task.log.replay();
+        if (task.error) {
+            std::rethrow_exception(task.error);
+        }
+
+        if (task.success && task.kind != ControllerKind::Fsm && projectManager) {
+            const int key = static_cast<int>(task.kind);
+            if (!cellWritten.contains(key)) {
+                cellWritten.insert(key, writeCells(task.kind));
+            }
+            if (!cellWritten.value(key)) {
+                QSocConsole::warn() << QStringLiteral("Failed to generate %1_cell.v file")
+                                           .arg(controllerKindName(task.kind));
+                task.success = false;
+                task.text.clear();
+            }
+        }
+
+        out << task.text;
+        if (!task.success) {
+            QSocConsole::warn() << "Failed to generate" << controllerKindName(task.kind)
+                                << "primitive at index" << task.index;
+            continue;
+        }
+
+        /* Add blank line between different blocks of the same kind */
+        if (!task.last) {
+            out << "\n";
+        }
     }
 
-    return clockPrimitive->generateClockController(clockNode, out);
-}
+    if (!diagramEnabled || !projectManager) {
+        return;
+    }
 
-bool QSocGenerateManager::generatePowerPrimitive(const YAML::Node &powerNode, QTextStream &out)
-{
-    if (!powerPrimitive) {
-        QSocConsole::warn() << "Power primitive generator not initialized";
-        return false;
+    /* Typst diagrams are independent of the Verilog text; later entries win on name clashes */
+    QHash<QString, qsizetype> diagramOwner;
+    for (qsizetype i = 0; i < static_cast<qsizetype>(tasks.size()); ++i) {
+        const ControllerTask &task = tasks[i];
+        QString               moduleName;
+        switch (task.kind) {
+        case ControllerKind::Reset:
+            moduleName = task.resetConfig.moduleName;
+            break;
+        case ControllerKind::Clock:
+            moduleName = task.clockConfig.moduleName;
+            break;
+        case ControllerKind::Power:
+            moduleName = task.powerConfig.moduleName;
+            break;
+        case ControllerKind::Fsm:
+            break;
+        }
+        if (task.success && !moduleName.isEmpty()) {
+            diagramOwner.insert(
+                outputDir + QStringLiteral("/") + moduleName + QStringLiteral(".typ"), i);
+        }
     }
 
-    return powerPrimitive->generatePowerController(powerNode, out);
+    QList<QPair<qsizetype, QString>> diagrams;
+    for (auto it = diagramOwner.cbegin(); it != diagramOwner.cend(); ++it) {
+        diagrams.append({it.value(), it.key()});
+    }
+    std::sort(diagrams.begin(), diagrams.end());
+
+    QSocProfiler::Scope diagramProfile("diagrams");
+    diagramProfile.setCount(diagrams.size());
+
+    runParallel(diagrams.size(), [this, &tasks, &diagrams](qsizetype n) {
+        ControllerTask                &task      = tasks[diagrams[n].first];
+        const QString                 &typstPath = diagrams[n].second;
+        const QSocConsole::CaptureScope scope(task.diagramLog);
+        const QSocProfiler::Scope       profile(
+            [&typstPath] { return QFileInfo(typstPath).fileName(); }, "diagram");
+        bool                            ok = false;
+        try {
+            switch (task.kind) {
+            case ControllerKind::Reset:
+                ok = QSocResetPrimitive(this).generateTypstDiagram(task.resetConfig, typstPath);
+                break;
+            case ControllerKind::Clock:
+                ok = QSocClockPrimitive(this).generateTypstDiagram(task.clockConfig, typstPath);
+                break;
+            case ControllerKind::Power:
+                ok = QSocPowerPrimitive(this).generateTypstDiagram(task.powerConfig, typstPath);
+                break;
+            case ControllerKind::Fsm:
+                ok = true;
+                break;
+            }
+        } catch (const std::exception &e) {
+            QSocConsole::debug() << "Typst diagram error:" << e.what();
+        }
+        if (!ok) {
+            QSocConsole::warn() << "Failed to generate Typst diagram (non-critical):" << typstPath;
+        }
+    });
+
+    for (const auto &diagram : diagrams) {
+        tasks[diagram.first].diagramLog.replay();
+    }
 }
 
 bool QSocGenerateManager::generateSeqPrimitive(const YAML::Node &netlistData, QTextStream &out)
 {
+    const QSocProfiler::Scope profile("seq", "primitive");
+
     if (!seqPrimitive) {
         QSocConsole::warn() << "Seq primitive generator not initialized";
         return false;
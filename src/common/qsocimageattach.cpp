@@ -8,11 +8,22 @@
 
 #include <nlohmann/json.hpp>
 #include <QBuffer>
+#include <QCache>
+#include <QCryptographicHash>
 #include <QImage>
 #include <QImageReader>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QSize>
+#include <QThread>
+#include <QThreadPool>
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <vector>
 
 namespace QSocImageAttach {
 
@@ -61,6 +72,170 @@ QByteArray encodeImage(const QImage &img, const char *format, int qualityOverrid
     return out;
 }
 
+/* Source image shared by several ladder candidates, derived once by
+ * whichever worker needs it first. */
+class LazyImage
+{
+public:
+    explicit LazyImage(std::function<QImage()> make)
+        : make(std::move(make))
+    {}
+
+    const QImage &get()
+    {
+        std::call_once(once, [this]() { image = make(); });
+        return image;
+    }
+
+private:
+    std::function<QImage()> make;
+    std::once_flag          once;
+    QImage                  image;
+};
+
+/* One rung of the re-encode cascade */
+struct LadderStep
+{
+    LazyImage  *source;
+    const char *format;
+    int         quality;
+};
+
+/* Encoded attachment for one (bytes, model limits) pair. Empty data
+ * means the image was refused; reason says why. */
+struct EncodedImage
+{
+    QByteArray  data;
+    QString     reason;
+    const char *mime       = "image/jpeg";
+    int         width      = 0;
+    int         height     = 0;
+    int         estTokens  = 0;
+    bool        resized    = false;
+    bool        downgraded = false;
+    int         quality    = -1;
+};
+
+/* Process-wide, content-addressed; cost is the encoded byte size */
+constexpr int kEncodeCacheBytes = 64 * 1024 * 1024;
+
+struct EncodeCache
+{
+    QMutex                        mutex;
+    QCache<QString, EncodedImage> entries{kEncodeCacheBytes};
+    qint64                        hits   = 0;
+    qint64                        misses = 0;
+};
+
+EncodeCache &encodeCache()
+{
+    static EncodeCache cache;
+    return cache;
+}
+
+QString encodeCacheKey(const QByteArray &body, const QString &mimeHint, const LLMModelConfig &cfg)
+{
+    return QString::fromLatin1(QCryptographicHash::hash(body, QCryptographicHash::Sha256).toHex())
+           + QStringLiteral("|%1|%2|%3|%4|%5")
+                 .arg(mimeHint)
+                 .arg(cfg.imageMaxDimension)
+                 .arg(cfg.imageMaxBytes)
+                 .arg(cfg.imageMaxTokens)
+                 .arg(cfg.imageProviderHint);
+}
+
+/* Decode, resize and re-encode within the model's limits */
+EncodedImage encodeForModel(
+    QImageReader             &reader,
+    const QSize              &dims,
+    const QString            &mimeHint,
+    const LLMModelConfig     &modelCfg,
+    QSocImageTokens::Provider provider)
+{
+    EncodedImage result;
+    result.width     = dims.width();
+    result.height    = dims.height();
+    result.estTokens = QSocImageTokens::estimateImageTokens(dims.width(), dims.height(), provider);
+
+    QImage decoded = reader.read();
+    if (decoded.isNull()) {
+        /* Header parsed but pixels are bad; do not pretend to inline. */
+        result.reason = QStringLiteral("image decode failed");
+        return result;
+    }
+
+    auto needsResize = [&]() {
+        if (result.estTokens > modelCfg.imageMaxTokens) {
+            return true;
+        }
+        if (modelCfg.imageMaxDimension > 0
+            && std::max(result.width, result.height) > modelCfg.imageMaxDimension) {
+            return true;
+        }
+        return false;
+    };
+
+    if (needsResize() && modelCfg.imageMaxDimension > 0) {
+        const int target = modelCfg.imageMaxDimension;
+        QImage    scaled
+            = decoded.scaled(target, target, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        if (!scaled.isNull()) {
+            decoded          = scaled;
+            result.width     = scaled.width();
+            result.height    = scaled.height();
+            result.resized   = true;
+            result.estTokens = QSocImageTokens::estimateImageTokens(
+                result.width, result.height, provider);
+        }
+    }
+
+    if (result.estTokens > modelCfg.imageMaxTokens) {
+        result.reason = QString("est_tokens %1 > image_max_tokens %2 even after resize")
+                            .arg(result.estTokens)
+                            .arg(modelCfg.imageMaxTokens);
+        return result;
+    }
+
+    const char *encFormat = encodingFormatFor(decoded, mimeHint);
+    QByteArray  encoded;
+
+    if (modelCfg.imageMaxBytes > 0) {
+        CompressOutcome outcome = compressWithinBudget(decoded, mimeHint, modelCfg.imageMaxBytes);
+        if (outcome.data.isEmpty()) {
+            result.reason = QStringLiteral("re-encode failed");
+            return result;
+        }
+        if (outcome.data.size() > modelCfg.imageMaxBytes) {
+            result.reason = QString("encoded %1 KB > image_max_bytes %2 KB even after cascade")
+                                .arg(outcome.data.size() / 1024)
+                                .arg(modelCfg.imageMaxBytes / 1024);
+            return result;
+        }
+        encoded           = outcome.data;
+        encFormat         = outcome.format;
+        result.downgraded = outcome.downgraded;
+        result.quality    = outcome.finalQuality;
+        if (outcome.finalWidth > 0 && outcome.finalHeight > 0
+            && (outcome.finalWidth != result.width || outcome.finalHeight != result.height)) {
+            result.width     = outcome.finalWidth;
+            result.height    = outcome.finalHeight;
+            result.resized   = true;
+            result.estTokens = QSocImageTokens::estimateImageTokens(
+                result.width, result.height, provider);
+        }
+    } else {
+        encoded = encodeImage(decoded, encFormat);
+        if (encoded.isEmpty()) {
+            result.reason = QStringLiteral("re-encode failed");
+            return result;
+        }
+    }
+
+    result.data = encoded;
+    result.mime = outboundMimeFor(encFormat);
+    return result;
+}
+
 } // namespace
 
 CompressOutcome compressWithinBudget(const QImage &img, const QString &sourceMime, int maxBytes)
@@ -80,95 +255,102 @@ CompressOutcome compressWithinBudget(const QImage &img, const QString &sourceMim
         return outcome;
     }
 
-    /* Quality ladder for JPEG / WEBP first; PNG with alpha drops to
-     * indexed palette before falling all the way to lossy JPEG. */
+    /* The rest of the cascade, best first: quality ladder for JPEG /
+     * WEBP; for PNG with alpha an indexed palette, then dropping alpha
+     * onto the JPEG ladder; finally one halving step with a JPEG ladder.
+     * One halving step is sufficient for the budgets a real model ever
+     * publishes; deeper recursion would just turn the image to mush. */
+    LazyImage original([&img]() { return img; });
+    LazyImage paletted([&img]() { return img.convertToFormat(QImage::Format_Indexed8); });
+    LazyImage opaque([&img]() { return img.convertToFormat(QImage::Format_RGB32); });
+    LazyImage shrunk([&img]() {
+        const int    newWidth  = std::max(64, img.width() / 2);
+        const int    newHeight = std::max(64, img.height() / 2);
+        const QImage scaled
+            = img.scaled(newWidth, newHeight, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        return scaled.hasAlphaChannel() ? scaled.convertToFormat(QImage::Format_RGB32) : scaled;
+    });
+
+    std::vector<LadderStep> ladder;
     if (qstrcmp(outcome.format, "JPEG") == 0 || qstrcmp(outcome.format, "WEBP") == 0) {
         for (int quality : {65, 50, 40}) {
-            QByteArray attempt = encodeImage(img, outcome.format, quality);
-            if (!attempt.isEmpty() && attempt.size() <= maxBytes) {
-                outcome.data         = attempt;
-                outcome.finalQuality = quality;
-                outcome.downgraded   = true;
-                return outcome;
-            }
-            if (!attempt.isEmpty() && attempt.size() < outcome.data.size()) {
-                outcome.data         = attempt;
-                outcome.finalQuality = quality;
-                outcome.downgraded   = true;
-            }
+            ladder.push_back({&original, outcome.format, quality});
         }
     } else if (preferPng) {
-        const QImage paletted = img.convertToFormat(QImage::Format_Indexed8);
-        if (!paletted.isNull()) {
-            QByteArray attempt = encodeImage(paletted, "PNG");
-            if (!attempt.isEmpty() && attempt.size() <= maxBytes) {
-                outcome.data       = attempt;
-                outcome.format     = "PNG";
-                outcome.downgraded = true;
-                return outcome;
-            }
-            if (!attempt.isEmpty() && attempt.size() < outcome.data.size()) {
-                outcome.data       = attempt;
-                outcome.downgraded = true;
-            }
-        }
-        /* Final PNG escape: drop alpha and ride the JPEG ladder. */
-        const QImage opaque = img.convertToFormat(QImage::Format_RGB32);
+        ladder.push_back({&paletted, "PNG", -1});
         for (int quality : {65, 50, 40}) {
-            QByteArray attempt = encodeImage(opaque, "JPEG", quality);
-            if (!attempt.isEmpty() && attempt.size() <= maxBytes) {
-                outcome.data         = attempt;
-                outcome.format       = "JPEG";
-                outcome.finalQuality = quality;
-                outcome.downgraded   = true;
-                return outcome;
-            }
-            if (!attempt.isEmpty() && attempt.size() < outcome.data.size()) {
-                outcome.data         = attempt;
-                outcome.format       = "JPEG";
-                outcome.finalQuality = quality;
-                outcome.downgraded   = true;
-            }
+            ladder.push_back({&opaque, "JPEG", quality});
         }
     }
-
-    if (outcome.data.size() <= maxBytes) {
-        return outcome;
+    for (int quality : {50, 40, 30}) {
+        ladder.push_back({&shrunk, "JPEG", quality});
     }
 
-    /* Last resort: shrink dimensions and re-run the JPEG ladder. One
-     * halving step is sufficient for the budgets a real model ever
-     * publishes; deeper recursion would just turn the image to mush. */
-    const int    newWidth  = std::max(64, img.width() / 2);
-    const int    newHeight = std::max(64, img.height() / 2);
-    const QImage shrunk
-        = img.scaled(newWidth, newHeight, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-    if (shrunk.isNull()) {
-        return outcome;
-    }
-    outcome.finalWidth  = shrunk.width();
-    outcome.finalHeight = shrunk.height();
-    outcome.downgraded  = true;
-    for (int quality : {50, 40, 30}) {
-        QByteArray attempt = encodeImage(
-            shrunk.hasAlphaChannel() ? shrunk.convertToFormat(QImage::Format_RGB32) : shrunk,
-            "JPEG",
-            quality);
+    /* Encode every rung concurrently. Once a rung fits, rungs ranked
+     * below it can no longer win and are skipped if not yet started. */
+    const int               count = static_cast<int>(ladder.size());
+    std::vector<QByteArray> attempts(ladder.size());
+    std::atomic<int>        firstFit{count};
+    const auto              runStep = [&](int index) {
+        if (index > firstFit.load(std::memory_order_acquire)) {
+            return;
+        }
+        const LadderStep &step    = ladder[index];
+        QByteArray        attempt = encodeImage(step.source->get(), step.format, step.quality);
         if (!attempt.isEmpty() && attempt.size() <= maxBytes) {
-            outcome.data         = attempt;
-            outcome.format       = "JPEG";
-            outcome.finalQuality = quality;
-            return outcome;
+            int current = firstFit.load(std::memory_order_acquire);
+            while (index < current
+                   && !firstFit.compare_exchange_weak(current, index, std::memory_order_acq_rel)) {
+            }
         }
-        if (!attempt.isEmpty() && attempt.size() < outcome.data.size()) {
-            outcome.data         = attempt;
-            outcome.format       = "JPEG";
-            outcome.finalQuality = quality;
+        attempts[index] = std::move(attempt);
+    };
+    QThreadPool pool;
+    pool.setMaxThreadCount(std::min(QThread::idealThreadCount(), count));
+    for (int index = 0; index < count; index++) {
+        pool.start([&runStep, index]() { runStep(index); });
+    }
+    pool.waitForDone();
+
+    /* The best-ranked rung that fits; otherwise the smallest sample */
+    int pick = firstFit.load() < count ? firstFit.load() : -1;
+    if (pick < 0) {
+        qsizetype smallest = outcome.data.size();
+        for (int index = 0; index < count; index++) {
+            if (!attempts[index].isEmpty() && attempts[index].size() < smallest) {
+                smallest = attempts[index].size();
+                pick     = index;
+            }
         }
     }
+    if (pick >= 0) {
+        const LadderStep &step = ladder[pick];
+        outcome.data           = attempts[pick];
+        outcome.format         = step.format;
+        outcome.finalQuality   = step.quality;
+        outcome.finalWidth     = step.source->get().width();
+        outcome.finalHeight    = step.source->get().height();
+        outcome.downgraded     = true;
+    }
     return outcome;
 }
 
+EncodeCacheStats encodeCacheStats()
+{
+    EncodeCache       &cache = encodeCache();
+    const QMutexLocker locker(&cache.mutex);
+    return EncodeCacheStats{cache.hits, cache.misses, cache.entries.size()};
+}
+
+void clearEncodeCache()
+{
+    EncodeCache       &cache = encodeCache();
+    const QMutexLocker locker(&cache.mutex);
+    cache.entries.clear();
+    cache.hits   = 0;
+    cache.misses = 0;
+}
+
 QString detectMimeByMagic(const QByteArray &bytes)
 {
     /* PNG: 89 50 4E 47 0D 0A 1A 0A */
@@ -256,96 +438,53 @@ QString buildAttachmentResult(
         return fallback(QStringLiteral("current model does not accept images"));
     }
 
-    QImage decoded = reader.read();
-    if (decoded.isNull()) {
-        /* Header parsed but pixels are bad; do not pretend to inline. */
-        return fallback(QStringLiteral("image decode failed"));
-    }
-
-    int  finalW    = dims.width();
-    int  finalH    = dims.height();
-    bool didResize = false;
-
-    auto needsResize = [&]() {
-        if (estTok > modelCfg.imageMaxTokens) {
-            return true;
-        }
-        if (modelCfg.imageMaxDimension > 0
-            && std::max(finalW, finalH) > modelCfg.imageMaxDimension) {
-            return true;
-        }
-        return false;
-    };
-
-    if (needsResize() && modelCfg.imageMaxDimension > 0) {
-        const int target = modelCfg.imageMaxDimension;
-        QImage    scaled
-            = decoded.scaled(target, target, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-        if (!scaled.isNull()) {
-            decoded   = scaled;
-            finalW    = scaled.width();
-            finalH    = scaled.height();
-            didResize = true;
-            estTok    = QSocImageTokens::estimateImageTokens(finalW, finalH, provider);
+    /* The same bytes under the same model limits always encode the same
+     * way: re-attaching a screenshot skips decode and the whole cascade. */
+    EncodeCache                &cache = encodeCache();
+    const QString               key   = encodeCacheKey(body, mimeHint, modelCfg);
+    std::optional<EncodedImage> encoded;
+    {
+        const QMutexLocker locker(&cache.mutex);
+        if (const EncodedImage *hit = cache.entries.object(key)) {
+            encoded = *hit;
+            cache.hits++;
+        } else {
+            cache.misses++;
         }
     }
-
-    if (estTok > modelCfg.imageMaxTokens) {
-        return fallback(QString("est_tokens %1 > image_max_tokens %2 even after resize")
-                            .arg(estTok)
-                            .arg(modelCfg.imageMaxTokens));
+    if (!encoded.has_value()) {
+        encoded = encodeForModel(reader, dims, mimeHint, modelCfg, provider);
+        const QMutexLocker locker(&cache.mutex);
+        cache.entries.insert(
+            key,
+            new EncodedImage(*encoded),
+            static_cast<int>(std::max<qsizetype>(1, encoded->data.size())));
     }
 
-    const char *encFormat = encodingFormatFor(decoded, mimeHint);
-    QByteArray  encoded;
-    bool        compressDowngrade = false;
-    int         compressQuality   = -1;
-
-    if (modelCfg.imageMaxBytes > 0) {
-        CompressOutcome outcome = compressWithinBudget(decoded, mimeHint, modelCfg.imageMaxBytes);
-        if (outcome.data.isEmpty()) {
-            return fallback(QStringLiteral("re-encode failed"));
-        }
-        if (outcome.data.size() > modelCfg.imageMaxBytes) {
-            return fallback(QString("encoded %1 KB > image_max_bytes %2 KB even after cascade")
-                                .arg(outcome.data.size() / 1024)
-                                .arg(modelCfg.imageMaxBytes / 1024));
-        }
-        encoded           = outcome.data;
-        encFormat         = outcome.format;
-        compressDowngrade = outcome.downgraded;
-        compressQuality   = outcome.finalQuality;
-        if (outcome.finalWidth > 0 && outcome.finalHeight > 0
-            && (outcome.finalWidth != finalW || outcome.finalHeight != finalH)) {
-            finalW    = outcome.finalWidth;
-            finalH    = outcome.finalHeight;
-            didResize = true;
-            estTok    = QSocImageTokens::estimateImageTokens(finalW, finalH, provider);
-        }
-    } else {
-        encoded = encodeImage(decoded, encFormat);
-        if (encoded.isEmpty()) {
-            return fallback(QStringLiteral("re-encode failed"));
-        }
+    estTok = encoded->estTokens;
+    if (encoded->data.isEmpty()) {
+        return fallback(encoded->reason);
     }
 
-    const QByteArray b64     = encoded.toBase64();
-    const char      *outMime = outboundMimeFor(encFormat);
-    QString          notes;
-    if (didResize) {
+    const int         finalW  = encoded->width;
+    const int         finalH  = encoded->height;
+    const QByteArray  b64     = encoded->data.toBase64();
+    const char *const outMime = encoded->mime;
+    QString           notes;
+    if (encoded->resized) {
         notes += QStringLiteral(", resized");
     }
-    if (compressDowngrade) {
+    if (encoded->downgraded) {
         notes += QStringLiteral(", recompressed");
     }
-    if (compressQuality > 0) {
-        notes += QStringLiteral(" q=%1").arg(compressQuality);
+    if (encoded->quality > 0) {
+        notes += QStringLiteral(" q=%1").arg(encoded->quality);
     }
     const QString summary = QString("[image attached: %1x%2 ~%3 tokens (%4 KB %5) from %6%7]")
                                 .arg(finalW)
                                 .arg(finalH)
                                 .arg(estTok)
-                                .arg(encoded.size() / 1024)
+                                .arg(encoded->data.size() / 1024)
                                 .arg(QString::fromLatin1(outMime))
                                 .arg(sourceLabel)
                                 .arg(notes);
@@ -356,9 +495,9 @@ QString buildAttachmentResult(
         {"source_url", sourceLabel.toStdString()},
         {"width", finalW},
         {"height", finalH},
-        {"byte_size", encoded.size()},
+        {"byte_size", encoded->data.size()},
         {"est_tokens", estTok},
-        {"resized", didResize},
+        {"resized", encoded->resized},
     };
 
     QString result;
@@ -98,6 +98,11 @@ struct CompressOutcome
  *             and ride the JPEG ladder.
  *          3. Halve dimensions once and run a final JPEG ladder at
  *             50 / 40 / 30 quality.
+ *          The default encode runs first; if it overflows, the remaining
+ *          rungs are encoded concurrently on a private thread pool. The
+ *          best-ranked rung that fits wins, exactly as in a serial walk,
+ *          and rungs ranked below a fitting one are skipped if they have
+ *          not started yet.
  * @param img       Decoded source image; already dimension-capped by
  *                  the caller's earlier resize step.
  * @param sourceMime MIME hint used only to pick the preferred encoder.
@@ -108,6 +113,26 @@ struct CompressOutcome
  */
 CompressOutcome compressWithinBudget(const QImage &img, const QString &sourceMime, int maxBytes);
 
+/**
+ * @brief Counters of the attachment encode cache.
+ * @details buildAttachmentResult caches its encode result, including the
+ *          token estimate, by (source sha256, MIME hint, max dimension,
+ *          byte cap, token cap, provider hint). The cache is process-wide
+ *          and bounded to 64 MiB of encoded bytes, least recently used
+ *          first out.
+ */
+struct EncodeCacheStats
+{
+    qint64    hits    = 0;
+    qint64    misses  = 0;
+    qsizetype entries = 0;
+};
+
+EncodeCacheStats encodeCacheStats();
+
+/** @brief Drop every cached encode and reset the counters. */
+void clearEncodeCache();
+
 } // namespace QSocImageAttach
 
 #endif // QSOCIMAGEATTACH_H
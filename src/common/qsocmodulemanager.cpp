@@ -462,7 +462,22 @@ void QSocModuleManager::resetModuleData()
     /* Reset the module data by creating a new empty YAML node */
     moduleData = YAML::Node();
 
-    QSocConsole::debug() << "Module data has been reset.";
+    QSOC_DEBUG() << "Module data has been reset.";
+}
+
+void QSocModuleManager::setYamlCache(QSocYamlFileCache *cache)
+{
+    yamlCache = cache;
+}
+
+void QSocModuleManager::setCancelCheck(std::function<bool()> check)
+{
+    cancelCheck = std::move(check);
+}
+
+void QSocModuleManager::setImportJobs(int jobs)
+{
+    slangDriver->setParseJobs(jobs);
 }
 
 bool QSocModuleManager::importFromFileList(
@@ -484,7 +499,18 @@ bool QSocModuleManager::importFromFileList(
         return false;
     }
 
+    const auto cancelled = [this]() {
+        if (cancelCheck && cancelCheck()) {
+            QSocConsole::warn() << "Module import cancelled.";
+            return true;
+        }
+        return false;
+    };
+
     if (slangDriver->parseFileList(fileListPath, filePathList, macroDefines, macroUndefines)) {
+        if (cancelled()) {
+            return false;
+        }
         /* Parse success */
         QStringList moduleList = slangDriver->getModuleList();
         if (moduleList.isEmpty()) {
@@ -498,10 +524,10 @@ bool QSocModuleManager::importFromFileList(
         if (moduleNameRegex.pattern().isEmpty()) {
             /* Pick first module if pattern is empty */
             const QString &moduleName = moduleList.first();
-            QSocConsole::debug() << "Pick first module:" << moduleName;
+            QSOC_DEBUG() << "Pick first module:" << moduleName;
             if (effectiveName.isEmpty()) {
                 effectiveName = moduleName.toLower();
-                QSocConsole::debug() << "Pick library filename:" << effectiveName;
+                QSOC_DEBUG() << "Pick library filename:" << effectiveName;
             }
             const json       &moduleAst  = slangDriver->getModuleAst(moduleName);
             const YAML::Node &moduleYaml = getModuleYaml(moduleAst);
@@ -513,12 +539,15 @@ bool QSocModuleManager::importFromFileList(
         /* Find module by pattern */
         bool hasMatch = false;
         for (const QString &moduleName : moduleList) {
+            if (cancelled()) {
+                return false;
+            }
             if (QStaticRegex::isNameExactMatch(moduleName, moduleNameRegex)) {
-                QSocConsole::debug() << "Found module:" << moduleName;
+                QSOC_DEBUG() << "Found module:" << moduleName;
                 if (effectiveName.isEmpty()) {
                     /* Use first module name as library filename */
                     effectiveName = moduleName.toLower();
-                    QSocConsole::debug() << "Pick library filename:" << effectiveName;
+                    QSOC_DEBUG() << "Pick library filename:" << effectiveName;
                 }
                 const json       &moduleAst           = slangDriver->getModuleAst(moduleName);
                 const YAML::Node &moduleYaml          = getModuleYaml(moduleAst);
@@ -1296,7 +1325,7 @@ bool QSocModuleManager::saveLibraryYaml(const QString &libraryName, const YAML::
         /* Load library YAML file */
         std::ifstream inputFileStream(filePath.toStdString());
         localLibraryYaml = mergeNodes(YAML::Load(inputFileStream), libraryYaml);
-        QSocConsole::debug() << "Load and merge";
+        QSOC_DEBUG() << "Load and merge";
     } else {
         localLibraryYaml = libraryYaml;
     }
@@ -1414,7 +1443,8 @@ bool QSocModuleManager::load(const QString &libraryName)
 
     try {
         /* Load YAML content into a temporary node */
-        YAML::Node tempNode = YAML::Load(fileStream);
+        YAML::Node tempNode = yamlCache != nullptr ? yamlCache->load(filePath)
+                                                   : YAML::Load(fileStream);
         if (!tempNode || !tempNode.IsMap()) {
             tempNode = YAML::Node(YAML::NodeType::Map);
         }
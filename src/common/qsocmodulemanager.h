@@ -8,6 +8,7 @@
 #include "common/qslangdriver.h"
 #include "common/qsocbusmanager.h"
 #include "common/qsocprojectmanager.h"
+#include "common/qsocyamlfilecache.h"
 
 #include <QList>
 #include <QMap>
@@ -16,6 +17,8 @@
 #include <QSet>
 #include <QStringList>
 
+#include <functional>
+
 #include <nlohmann/json.hpp>
 #include <yaml-cpp/yaml.h>
 
@@ -194,6 +197,30 @@ public slots:
      */
     void resetModuleData();
 
+    /**
+     * @brief Share parsed library files across loads.
+     * @details When set, load() takes library trees from @p cache instead of
+     *          parsing each file again. The cache is not owned; nullptr (the
+     *          default) parses on every load.
+     * @param cache Cache to use, or nullptr.
+     */
+    void setYamlCache(QSocYamlFileCache *cache);
+
+    /**
+     * @brief Let a long import stop early.
+     * @details importFromFileList() polls @p check after parsing and between
+     *          modules, and returns false without saving once it is true.
+     *          An empty function (the default) never cancels.
+     * @param check Cancellation predicate, callable from the importing thread.
+     */
+    void setCancelCheck(std::function<bool()> check);
+
+    /**
+     * @brief Set the number of threads used to parse imported sources.
+     * @param jobs Thread count, 1 for single-unit parsing, 0 for all cores.
+     */
+    void setImportJobs(int jobs);
+
     /**
      * @brief Import verilog files from file list.
      * @details This function will import verilog files from file list, and
@@ -624,6 +651,12 @@ private:
     /* Slang driver. */
     QSlangDriver *slangDriver = nullptr;
 
+    /* Parsed library files shared across loads, not owned. */
+    QSocYamlFileCache *yamlCache = nullptr;
+
+    /* Polled by importFromFileList(); empty never cancels. */
+    std::function<bool()> cancelCheck;
+
     /* This QMap, libraryMap, maps library names to sets of module names.
        Each key in the map is a library name (QString).
        The corresponding value is a QSet<QString> containing the names
@@ -71,8 +71,8 @@ bool QSocModuleManager::addModuleBus(
     }
 
     /* Print extracted lists for debugging */
-    QSocConsole::debug() << "Module ports:" << groupModule;
-    QSocConsole::debug() << "Bus signals:" << groupBus;
+    QSOC_DEBUG() << "Module ports:" << groupModule;
+    QSOC_DEBUG() << "Bus signals:" << groupBus;
 
     /* Use QStaticStringWeaver to match bus signals to module ports */
     /* Step 1: Extract candidate substrings for clustering */
@@ -101,12 +101,11 @@ bool QSocModuleManager::addModuleBus(
         = QStaticStringWeaver::findBestGroupMarkerForHint(busInterface, candidateMarkers);
     if (!bestMarker.isEmpty()) {
         bestHintGroupMarkers.append(bestMarker);
-        QSocConsole::debug() << "Best matching marker:" << bestMarker
-                             << "for hint:" << busInterface;
+        QSOC_DEBUG() << "Best matching marker:" << bestMarker << "for hint:" << busInterface;
     } else {
         /* If no marker found, use empty string */
         bestHintGroupMarkers.append("");
-        QSocConsole::debug() << "No suitable group marker found, using empty string";
+        QSOC_DEBUG() << "No suitable group marker found, using empty string";
     }
 
     /* Collect all module ports from groups whose keys match any of the best hint group markers */
@@ -123,7 +122,7 @@ bool QSocModuleManager::addModuleBus(
         }
 
         if (matches) {
-            QSocConsole::debug() << "Including ports from group:" << groupKey;
+            QSOC_DEBUG() << "Including ports from group:" << groupKey;
             for (const QString &portStr : it.value()) {
                 filteredModulePorts.append(portStr);
             }
@@ -132,10 +131,10 @@ bool QSocModuleManager::addModuleBus(
 
     /* If no filtered ports found, fall back to all ports */
     if (filteredModulePorts.isEmpty()) {
-        QSocConsole::debug() << "No ports found in matching groups, using all ports";
+        QSOC_DEBUG() << "No ports found in matching groups, using all ports";
         filteredModulePorts = groupModule;
     } else {
-        QSocConsole::debug() << "Using filtered ports for matching:" << filteredModulePorts;
+        QSOC_DEBUG() << "Using filtered ports for matching:" << filteredModulePorts;
     }
 
     /* Find optimal matching between bus signals and filtered module ports */
@@ -143,9 +142,10 @@ bool QSocModuleManager::addModuleBus(
         = QStaticStringWeaver::findOptimalMatching(filteredModulePorts, groupBus, bestMarker);
 
     /* Debug output */
-    for (auto it = matching.begin(); it != matching.end(); ++it) {
-        QSocConsole::debug() << "Bus signal:" << it.key()
-                             << "matched with module port:" << it.value();
+    if (QSocConsole::isEnabled(QSocConsole::Level::Debug)) {
+        for (auto it = matching.begin(); it != matching.end(); ++it) {
+            QSOC_DEBUG() << "Bus signal:" << it.key() << "matched with module port:" << it.value();
+        }
     }
 
     /* Add bus interface to module YAML */
@@ -237,8 +237,8 @@ bool QSocModuleManager::addModuleBusWithLLM(
         return false;
     }
 
-    QSocConsole::debug() << "Module ports:" << groupModule;
-    QSocConsole::debug() << "Bus signals:" << groupBus;
+    QSOC_DEBUG() << "Module ports:" << groupModule;
+    QSOC_DEBUG() << "Bus signals:" << groupBus;
 
     /* Build prompt */
     /* clang-format off */
@@ -289,9 +289,10 @@ bool QSocModuleManager::addModuleBusWithLLM(
     }
 
     /* Debug output */
-    for (auto it = matching.begin(); it != matching.end(); ++it) {
-        QSocConsole::debug() << "Bus signal:" << it.key()
-                             << "matched with module port:" << it.value();
+    if (QSocConsole::isEnabled(QSocConsole::Level::Debug)) {
+        for (auto it = matching.begin(); it != matching.end(); ++it) {
+            QSOC_DEBUG() << "Bus signal:" << it.key() << "matched with module port:" << it.value();
+        }
     }
 
     /* Add bus interface to module YAML */
@@ -334,7 +335,7 @@ bool QSocModuleManager::removeModuleBus(
 
     /* Check if the module has any bus interfaces defined */
     if (!moduleYaml["bus"]) {
-        QSocConsole::debug() << "Module doesn't have any bus interfaces:" << moduleName;
+        QSOC_DEBUG() << "Module doesn't have any bus interfaces:" << moduleName;
         return true; /* Return true as there's nothing to remove */
     }
 
@@ -350,7 +351,7 @@ bool QSocModuleManager::removeModuleBus(
         const QString busInterfaceName    = QString::fromStdString(busInterfaceNameStd);
 
         if (QStaticRegex::isNameExactMatch(busInterfaceName, busInterfaceRegex)) {
-            QSocConsole::debug() << "Found matching bus interface to remove:" << busInterfaceName;
+            QSOC_DEBUG() << "Found matching bus interface to remove:" << busInterfaceName;
             interfacesToRemove.push_back(busInterfaceNameStd);
             removedAny = true;
         }
@@ -402,7 +403,7 @@ QStringList QSocModuleManager::listModuleBus(
 
     /* Check if the module has any bus interfaces defined */
     if (!moduleYaml["bus"]) {
-        QSocConsole::debug() << "Module doesn't have any bus interfaces:" << moduleName;
+        QSOC_DEBUG() << "Module doesn't have any bus interfaces:" << moduleName;
         return result;
     }
 
@@ -464,7 +465,7 @@ YAML::Node QSocModuleManager::showModuleBus(
 
     /* Check if the module has any bus interfaces defined */
     if (!moduleYaml["bus"]) {
-        QSocConsole::debug() << "Module doesn't have any bus interfaces:" << moduleName;
+        QSOC_DEBUG() << "Module doesn't have any bus interfaces:" << moduleName;
         return result;
     }
 
@@ -477,7 +478,7 @@ YAML::Node QSocModuleManager::showModuleBus(
         const QString busInterfaceName    = QString::fromStdString(busInterfaceNameStd);
 
         if (QStaticRegex::isNameExactMatch(busInterfaceName, busInterfaceRegex)) {
-            QSocConsole::debug() << "Found matching bus interface:" << busInterfaceName;
+            QSOC_DEBUG() << "Found matching bus interface:" << busInterfaceName;
             result["bus"][busInterfaceNameStd] = it->second;
         }
     }
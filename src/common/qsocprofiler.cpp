@@ -0,0 +1,330 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Huang Rui <vowstar@gmail.com>
+
+#include "common/qsocprofiler.h"
+
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QTextStream>
+#include <QThread>
+
+#include <atomic>
+#include <chrono>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+/* psapi.h depends on windows.h */
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <ctime>
+#endif
+
+namespace {
+
+struct ProfileEvent
+{
+    QString     name;
+    const char *category = nullptr;
+    qint64      startUs  = 0;
+    qint64      wallUs   = 0;
+    qint64      cpuUs    = 0;
+    qint64      rssKb    = 0;
+    qint64      count    = -1;
+    int         thread   = 0;
+};
+
+std::atomic<bool> s_enabled{false};
+
+/* Trace clock origin; reset() moves it, reads need no lock */
+std::atomic<qint64> s_originUs{0};
+
+QMutex                 s_mutex;
+QList<ProfileEvent>    s_events;
+QHash<Qt::HANDLE, int> s_threads;
+
+/* Caller holds s_mutex */
+int threadIndex()
+{
+    const Qt::HANDLE handle = QThread::currentThreadId();
+    auto             it     = s_threads.constFind(handle);
+    if (it != s_threads.constEnd()) {
+        return it.value();
+    }
+    const int index = static_cast<int>(s_threads.size()) + 1;
+    s_threads.insert(handle, index);
+    return index;
+}
+
+qint64 steadyUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+qint64 nowUs()
+{
+    qint64 origin = s_originUs.load(std::memory_order_relaxed);
+    if (origin == 0) {
+        qint64 expected = 0;
+        s_originUs.compare_exchange_strong(expected, steadyUs(), std::memory_order_relaxed);
+        origin = s_originUs.load(std::memory_order_relaxed);
+    }
+    return steadyUs() - origin;
+}
+
+/* CPU time consumed by the calling thread */
+qint64 threadCpuUs()
+{
+#ifdef Q_OS_WIN
+    FILETIME creation;
+    FILETIME exitTime;
+    FILETIME kernel;
+    FILETIME user;
+    if (!GetThreadTimes(GetCurrentThread(), &creation, &exitTime, &kernel, &user)) {
+        return 0;
+    }
+    const auto toUs = [](const FILETIME &time) {
+        return static_cast<qint64>(
+                   (static_cast<quint64>(time.dwHighDateTime) << 32) | time.dwLowDateTime)
+               / 10;
+    };
+    return toUs(kernel) + toUs(user);
+#else
+    timespec spec{};
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &spec) != 0) {
+        return 0;
+    }
+    return static_cast<qint64>(spec.tv_sec) * 1000000 + spec.tv_nsec / 1000;
+#endif
+}
+
+/* Peak resident set size of the process */
+qint64 processPeakRssKb()
+{
+#ifdef Q_OS_WIN
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+    return static_cast<qint64>(counters.PeakWorkingSetSize / 1024);
+#else
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef Q_OS_MACOS
+    return static_cast<qint64>(usage.ru_maxrss) / 1024; /* bytes on macOS */
+#else
+    return static_cast<qint64>(usage.ru_maxrss);
+#endif
+#endif
+}
+
+QString formatMs(qint64 us)
+{
+    return QString::number(static_cast<double>(us) / 1000.0, 'f', 3);
+}
+
+} // namespace
+
+QSocProfiler::Scope::Scope(const char *name, const char *category)
+{
+    if (QSocProfiler::isEnabled()) {
+        m_literal = name;
+        start(category);
+    }
+}
+
+QSocProfiler::Scope::Scope(const QString &name, const char *category)
+{
+    if (QSocProfiler::isEnabled()) {
+        m_name = name;
+        start(category);
+    }
+}
+
+void QSocProfiler::Scope::start(const char *category)
+{
+    m_category = category;
+    m_active   = true;
+    m_cpuUs    = threadCpuUs();
+    m_startUs  = nowUs();
+}
+
+QSocProfiler::Scope::~Scope()
+{
+    finish();
+}
+
+void QSocProfiler::Scope::finish()
+{
+    if (!m_active) {
+        return;
+    }
+    m_active = false;
+
+    ProfileEvent event;
+    event.name     = m_literal ? QString::fromUtf8(m_literal) : m_name;
+    event.category = m_category;
+    event.startUs  = m_startUs;
+    event.wallUs   = nowUs() - m_startUs;
+    event.cpuUs    = threadCpuUs() - m_cpuUs;
+    event.rssKb    = processPeakRssKb();
+    event.count    = m_count;
+
+    const QMutexLocker locker(&s_mutex);
+    event.thread = threadIndex();
+    s_events.append(event);
+}
+
+void QSocProfiler::Scope::setCount(qint64 count)
+{
+    m_count = count;
+}
+
+void QSocProfiler::setEnabled(bool enabled)
+{
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool QSocProfiler::isEnabled()
+{
+    return s_enabled.load(std::memory_order_relaxed);
+}
+
+void QSocProfiler::reset()
+{
+    const QMutexLocker locker(&s_mutex);
+    s_events.clear();
+    s_threads.clear();
+    s_originUs.store(steadyUs(), std::memory_order_relaxed);
+}
+
+qsizetype QSocProfiler::eventCount()
+{
+    const QMutexLocker locker(&s_mutex);
+    return s_events.size();
+}
+
+qint64 QSocProfiler::peakRssKb()
+{
+    return processPeakRssKb();
+}
+
+bool QSocProfiler::writeChromeTrace(const QString &filePath)
+{
+    QJsonArray traceEvents;
+    {
+        const QMutexLocker locker(&s_mutex);
+        for (const ProfileEvent &event : std::as_const(s_events)) {
+            QJsonObject args;
+            args["cpu_us"]      = event.cpuUs;
+            args["peak_rss_kb"] = event.rssKb;
+            if (event.count >= 0) {
+                args["count"] = event.count;
+            }
+
+            QJsonObject object;
+            object["name"] = event.name;
+            object["cat"]  = QString::fromUtf8(event.category);
+            object["ph"]   = "X";
+            object["ts"]   = event.startUs;
+            object["dur"]  = event.wallUs;
+            object["pid"]  = 1;
+            object["tid"]  = event.thread;
+            object["args"] = args;
+            traceEvents.append(object);
+        }
+    }
+
+    QJsonObject root;
+    root["traceEvents"]     = traceEvents;
+    root["displayTimeUnit"] = "ms";
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    return true;
+}
+
+QString QSocProfiler::summary()
+{
+    struct Row
+    {
+        QString name;
+        QString category;
+        qint64  calls  = 0;
+        qint64  wallUs = 0;
+        qint64  cpuUs  = 0;
+        qint64  rssKb  = 0;
+        qint64  count  = -1;
+    };
+
+    QList<Row>          rows;
+    QHash<QString, int> rowIndex;
+    {
+        const QMutexLocker locker(&s_mutex);
+        for (const ProfileEvent &event : std::as_const(s_events)) {
+            const QString category = QString::fromUtf8(event.category);
+            const QString key      = category + QLatin1Char('\x1f') + event.name;
+            auto          it       = rowIndex.constFind(key);
+            if (it == rowIndex.constEnd()) {
+                it = rowIndex.insert(key, static_cast<int>(rows.size()));
+                rows.append(Row{event.name, category});
+            }
+            Row &row = rows[it.value()];
+            row.calls++;
+            row.wallUs += event.wallUs;
+            row.cpuUs += event.cpuUs;
+            row.rssKb = qMax(row.rssKb, event.rssKb);
+            if (event.count >= 0) {
+                row.count = qMax<qint64>(row.count, 0) + event.count;
+            }
+        }
+    }
+
+    int nameWidth = 5;
+    for (const Row &row : std::as_const(rows)) {
+        nameWidth = qMax(nameWidth, static_cast<int>(row.category.size() + row.name.size() + 1));
+    }
+
+    QString     text;
+    QTextStream stream(&text);
+    stream << QString("phase").leftJustified(nameWidth) << "  "
+           << QString("calls").rightJustified(6) << "  "
+           << QString("wall ms").rightJustified(12) << "  "
+           << QString("cpu ms").rightJustified(12) << "  "
+           << QString("peak rss kb").rightJustified(12) << "  "
+           << QString("items").rightJustified(8) << "\n";
+    for (const Row &row : std::as_const(rows)) {
+        stream << (row.category + QLatin1Char(':') + row.name).leftJustified(nameWidth) << "  "
+               << QString::number(row.calls).rightJustified(6) << "  "
+               << formatMs(row.wallUs).rightJustified(12) << "  "
+               << formatMs(row.cpuUs).rightJustified(12) << "  "
+               << QString::number(row.rssKb).rightJustified(12) << "  "
+               << (row.count >= 0 ? QString::number(row.count) : QString("-")).rightJustified(8)
+               << "\n";
+    }
+    stream.flush();
+    return text;
+}
+
+bool QSocProfiler::writeSummary(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        return false;
+    }
+    file.write(summary().toUtf8());
+    return true;
+}
@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Huang Rui <vowstar@gmail.com>
+
+#ifndef QSOCPROFILER_H
+#define QSOCPROFILER_H
+
+#include <QString>
+#include <QtGlobal>
+
+#include <type_traits>
+
+/**
+ * @brief Process-wide phase profiler for the qsoc CLI.
+ * @details Disabled by default; a Scope then costs one atomic load and
+ *          builds no name, so give formatted names as a callable. When
+ *          enabled, every Scope records wall time, CPU time of the calling
+ *          thread, process peak RSS at scope exit and an optional item
+ *          count. Recording is thread-safe so scopes may be opened from
+ *          worker threads.
+ *
+ *          Results are exported as a Chrome trace (chrome://tracing,
+ *          Perfetto) and as a plain-text summary aggregated by phase name.
+ */
+class QSocProfiler final
+{
+public:
+    QSocProfiler()  = delete;
+    ~QSocProfiler() = delete;
+
+    /* RAII timer for one phase. Name and category must outlive the scope. */
+    class Scope final
+    {
+    public:
+        explicit Scope(const char *name, const char *category = "phase");
+        Scope(const QString &name, const char *category);
+
+        /* Name built by @p makeName only when profiling is enabled */
+        template<
+            typename NameFn,
+            typename = std::enable_if_t<std::is_invocable_r_v<QString, NameFn &>>>
+        Scope(NameFn &&makeName, const char *category)
+        {
+            if (QSocProfiler::isEnabled()) {
+                m_name = makeName();
+                start(category);
+            }
+        }
+
+        ~Scope();
+        Scope(const Scope &)            = delete;
+        Scope &operator=(const Scope &) = delete;
+
+        /** Attach an item count (instances, nets, controllers...) to the phase. */
+        void setCount(qint64 count);
+
+        /** Record the phase now instead of at destruction; later calls are no-ops. */
+        void finish();
+
+    private:
+        void start(const char *category);
+
+        QString     m_name;
+        const char *m_literal  = nullptr; /* used when m_name is empty */
+        const char *m_category = nullptr;
+        qint64      m_startUs  = 0;
+        qint64      m_cpuUs    = 0;
+        qint64      m_count    = -1;
+        bool        m_active   = false;
+    };
+
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    /** Drop all recorded events and restart the trace clock. */
+    static void reset();
+
+    /** Number of events recorded since the last reset(). */
+    static qsizetype eventCount();
+
+    /** Peak resident set size of this process in KiB, 0 if unavailable. */
+    static qint64 peakRssKb();
+
+    /**
+     * @brief Write recorded events in Chrome trace event format.
+     * @param filePath Destination JSON file.
+     * @return true on success, false if the file could not be written.
+     */
+    static bool writeChromeTrace(const QString &filePath);
+
+    /**
+     * @brief Render a per-phase summary table.
+     * @details One row per (category, name) in first-seen order, with call
+     *          count, total wall and CPU time, peak RSS and summed items.
+     */
+    static QString summary();
+
+    /**
+     * @brief Write summary() to a text file.
+     * @param filePath Destination text file.
+     * @return true on success, false if the file could not be written.
+     */
+    static bool writeSummary(const QString &filePath);
+};
+
+#endif // QSOCPROFILER_H
@@ -27,6 +27,14 @@ QSocProjectManager::QSocProjectManager(QObject *parent)
             env[keyAndValue[0]] = keyAndValue[1];
         }
     }
+    reset();
+}
+
+QSocProjectManager::~QSocProjectManager() = default;
+
+void QSocProjectManager::reset()
+{
+    projectNode = YAML::Node();
     /* Set project default name */
     setProjectName("");
     /* Initialize current path */
@@ -39,8 +47,6 @@ QSocProjectManager::QSocProjectManager(QObject *parent)
     setOutputPath(QDir(currentPath).filePath("output"));
 }
 
-QSocProjectManager::~QSocProjectManager() = default;
-
 void QSocProjectManager::setEnv(const QString &key, const QString &value)
 {
     env[key] = value;
@@ -501,3 +507,16 @@ const QString &QSocProjectManager::getCurrentPath()
 {
     return currentPath;
 }
+
+void QSocProjectManager::copyFrom(const QSocProjectManager &other)
+{
+    env           = other.env;
+    projectNode   = YAML::Clone(other.projectNode);
+    projectName   = other.projectName;
+    projectPath   = other.projectPath;
+    busPath       = other.busPath;
+    modulePath    = other.modulePath;
+    schematicPath = other.schematicPath;
+    outputPath    = other.outputPath;
+    currentPath   = other.currentPath;
+}
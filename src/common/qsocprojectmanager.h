@@ -35,6 +35,15 @@ public:
     ~QSocProjectManager() override;
 
 public slots:
+    /**
+     * @brief Reset to the state of a freshly constructed manager.
+     * @details Forgets the loaded project and derives the project, bus,
+     *          module, schematic and output paths from the current working
+     *          directory again. Environment variables are kept. Used when
+     *          one manager serves several command invocations.
+     */
+    void reset();
+
     /**
      * @brief Set project environment variable.
      * @details This function will set project environment variable.
@@ -322,6 +331,15 @@ public slots:
      */
     void setCurrentPath(const QString &currentPath);
 
+    /**
+     * @brief Copy project settings from another project manager.
+     * @details Copies the name, paths, environment and a deep clone of the
+     *          project node, so the copy can be handed to a worker thread
+     *          while the original stays in use.
+     * @param other The project manager to copy from.
+     */
+    void copyFrom(const QSocProjectManager &other);
+
 private:
     /* Project environment variables map. */
     QMap<QString, QString> env;
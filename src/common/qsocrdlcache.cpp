@@ -0,0 +1,211 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Huang Rui <vowstar@gmail.com>
+
+#include "common/qsocrdlcache.h"
+
+#include "common/config.h"
+#include "common/qsocpaths.h"
+
+#include <map>
+#include <memory>
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QSet>
+#include <QStringList>
+
+#ifndef QSOC_SYSTEMRDL_VERSION
+#define QSOC_SYSTEMRDL_VERSION "unknown"
+#endif
+
+using json = nlohmann::json;
+
+namespace {
+
+/* Bump when the stored layout or the key material changes */
+constexpr const char *kFormat = "qsoc-rdl-cache/1";
+
+/* Feed a file and, depth first, every file it `include`s into the hash.
+ * Both include forms resolve against the including file, then the
+ * top-level file. An unresolved `include "file"` stays in the key, so
+ * creating the file later is a miss. An unresolved `include <file>` may
+ * be found on a search path the key cannot see, so it makes the input
+ * uncacheable. */
+void hashSources(
+    QCryptographicHash &hash,
+    const QString      &filePath,
+    const QDir         &topDir,
+    QSet<QString>      &visited,
+    bool               *readable)
+{
+    const QString canonical = QFileInfo(filePath).canonicalFilePath();
+    if (canonical.isEmpty() || visited.contains(canonical)) {
+        return;
+    }
+    visited.insert(canonical);
+
+    QFile file(canonical);
+    if (!file.open(QIODevice::ReadOnly)) {
+        *readable = false;
+        return;
+    }
+    const QByteArray content = file.readAll();
+    hash.addData(topDir.relativeFilePath(canonical).toUtf8());
+    hash.addData(QByteArray::number(content.size()) + '\0');
+    hash.addData(content);
+
+    static const QRegularExpression includeRegex(
+        QStringLiteral("`include\\s+(?:\"([^\"]+)\"|<([^>]+)>)"));
+
+    const QDir fileDir  = QFileInfo(canonical).absoluteDir();
+    auto       iterator = includeRegex.globalMatch(QString::fromUtf8(content));
+    while (iterator.hasNext()) {
+        const QRegularExpressionMatch match    = iterator.next();
+        const bool                    quoted   = match.capturedStart(1) >= 0;
+        const QString                 name     = quoted ? match.captured(1) : match.captured(2);
+        QString                       resolved = fileDir.filePath(name);
+        if (!QFileInfo::exists(resolved)) {
+            resolved = topDir.filePath(name);
+        }
+        if (QFileInfo::exists(resolved)) {
+            hashSources(hash, resolved, topDir, visited, readable);
+        } else if (quoted) {
+            hash.addData(QByteArray("missing:") + name.toUtf8() + '\0');
+        } else {
+            *readable = false;
+        }
+    }
+}
+
+} // namespace
+
+QSocRdlCache::QSocRdlCache(const QString &directory, int maxEntries)
+    : cacheDir(directory)
+    , maxEntries(maxEntries)
+{}
+
+QString QSocRdlCache::defaultDirectory()
+{
+    return QDir(QSocPaths::userRoot()).filePath(QStringLiteral("cache/rdl"));
+}
+
+QSocRdlCache *QSocRdlCache::shared()
+{
+    /* Read on every call: the daemon applies each client's environment for
+     * the length of its call. Instances stay alive, one per directory. */
+    const QString setting = qEnvironmentVariable("QSOC_RDL_CACHE");
+    if (setting == QStringLiteral("0")) {
+        return nullptr;
+    }
+    const QString directory = setting.isEmpty() ? defaultDirectory() : setting;
+
+    static QMutex                                           instancesMutex;
+    static std::map<QString, std::unique_ptr<QSocRdlCache>> instances;
+    const QMutexLocker                                      locker(&instancesMutex);
+    std::unique_ptr<QSocRdlCache>                          &instance = instances[directory];
+    if (!instance) {
+        instance = std::make_unique<QSocRdlCache>(directory);
+    }
+    return instance.get();
+}
+
+QString QSocRdlCache::keyFor(Kind kind, const QString &filePath)
+{
+    const QFileInfo info(filePath);
+    if (!info.isFile()) {
+        return QString();
+    }
+    const QDir topDir = info.absoluteDir();
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(QByteArray(kFormat) + '\0');
+    hash.addData(QByteArray(QSOC_VERSION) + '\0' + QSOC_SYSTEMRDL_VERSION + '\0');
+    hash.addData(kind == Kind::Rdl ? QByteArray("rdl") : QByteArray("rcsv"));
+    hash.addData('\0' + topDir.absolutePath().toUtf8() + '\0');
+
+    QSet<QString> visited;
+    bool          readable = true;
+    hashSources(hash, info.absoluteFilePath(), topDir, visited, &readable);
+    if (!readable) {
+        return QString();
+    }
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+QString QSocRdlCache::pathFor(const QString &key) const
+{
+    return QDir(cacheDir).filePath(key + QStringLiteral(".cbor"));
+}
+
+bool QSocRdlCache::lookup(const QString &key, json &result)
+{
+    bool found = false;
+    if (!key.isEmpty()) {
+        QFile file(pathFor(key));
+        if (file.open(QIODevice::ReadOnly)) {
+            const QByteArray data = file.readAll();
+            /* A truncated or foreign file decodes as discarded: a miss */
+            json decoded = json::from_cbor(data.cbegin(), data.cend(), true, false);
+            if (!decoded.is_discarded()) {
+                result = std::move(decoded);
+                found  = true;
+                /* Eviction goes by mtime, so a hit keeps the entry recent */
+                file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+            }
+        }
+    }
+
+    const QMutexLocker locker(&mutex);
+    if (found) {
+        counters.hits++;
+    } else {
+        counters.misses++;
+    }
+    return found;
+}
+
+void QSocRdlCache::store(const QString &key, const json &result)
+{
+    if (key.isEmpty() || !QDir().mkpath(cacheDir)) {
+        return;
+    }
+
+    const std::vector<std::uint8_t> data = json::to_cbor(result);
+    QSaveFile                       file(pathFor(key));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    file.write(reinterpret_cast<const char *>(data.data()), static_cast<qint64>(data.size()));
+    if (file.commit()) {
+        evict();
+    }
+}
+
+QSocRdlCache::Stats QSocRdlCache::stats() const
+{
+    const QMutexLocker locker(&mutex);
+    return counters;
+}
+
+void QSocRdlCache::evict()
+{
+    const QDir        dir(cacheDir);
+    const QStringList entries
+        = dir.entryList({QStringLiteral("*.cbor")}, QDir::Files, QDir::Time); /* newest first */
+
+    qint64 evicted = 0;
+    for (qsizetype index = maxEntries; index < entries.size(); ++index) {
+        if (QFile::remove(dir.filePath(entries.at(index)))) {
+            evicted++;
+        }
+    }
+
+    const QMutexLocker locker(&mutex);
+    counters.evictions += evicted;
+}
@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Huang Rui <vowstar@gmail.com>
+
+#ifndef QSOCRDLCACHE_H
+#define QSOCRDLCACHE_H
+
+#include <QMutex>
+#include <QString>
+
+#include <cstdint>
+#include <nlohmann/json.hpp>
+
+/**
+ * @brief On-disk cache of SystemRDL and RCSV elaboration results.
+ * @details Elaborating a large register map dominates template generation,
+ *          yet the simplified JSON only depends on the input text. Entries
+ *          are keyed by a SHA-256 over the cache format, the qsoc and
+ *          SystemRDL library versions, the input kind, the directory that
+ *          includes resolve against, and the content of the input file and
+ *          of every file it includes, followed transitively. A change to
+ *          any of them selects a new entry, so nothing is ever invalidated.
+ *
+ *          Entries are stored as CBOR, one `<key>.cbor` file each, so a hit
+ *          decodes binary data instead of parsing JSON text. Writes are
+ *          atomic, which lets several processes share the directory. A hit
+ *          refreshes the entry's mtime, and the least recently used entries
+ *          beyond the cap are evicted on store. Thread-safe.
+ */
+class QSocRdlCache
+{
+public:
+    enum class Kind : std::uint8_t {
+        Rdl,  /* SystemRDL source */
+        Rcsv, /* Register CSV, converted to SystemRDL first */
+    };
+
+    struct Stats
+    {
+        qint64 hits      = 0;
+        qint64 misses    = 0;
+        qint64 evictions = 0;
+    };
+
+    /** @brief Default number of entries kept. */
+    static constexpr int DEFAULT_MAX_ENTRIES = 256;
+
+    /**
+     * @brief Open (or create) a cache rooted at a directory.
+     * @param directory Cache directory; created on first store.
+     * @param maxEntries Entries kept before the oldest are evicted.
+     */
+    explicit QSocRdlCache(const QString &directory, int maxEntries = DEFAULT_MAX_ENTRIES);
+
+    /** @brief User-level cache directory: <userRoot>/cache/rdl. */
+    static QString defaultDirectory();
+
+    /**
+     * @brief Process-wide cache, or nullptr when caching is disabled.
+     * @details QSOC_RDL_CACHE set to `0` disables the cache; any other
+     *          non-empty value names the directory to use instead of
+     *          defaultDirectory(). The variable is read on every call, and
+     *          each directory keeps one instance for the process lifetime.
+     */
+    static QSocRdlCache *shared();
+
+    QString directory() const { return cacheDir; }
+
+    /**
+     * @brief Cache key of an input file.
+     * @return Hex digest, or an empty string when the file cannot be read.
+     */
+    static QString keyFor(Kind kind, const QString &filePath);
+
+    /**
+     * @brief Load the elaborated JSON stored under @p key.
+     * @retval true @p result holds the cached JSON.
+     * @retval false No usable entry; elaborate and store() instead.
+     */
+    bool lookup(const QString &key, nlohmann::json &result);
+
+    /** @brief Store the elaborated JSON for @p key; empty keys are ignored. */
+    void store(const QString &key, const nlohmann::json &result);
+
+    Stats stats() const;
+
+private:
+    QString cacheDir;
+    int     maxEntries;
+
+    mutable QMutex mutex;
+    Stats          counters;
+
+    QString pathFor(const QString &key) const;
+    void    evict();
+};
+
+#endif // QSOCRDLCACHE_H
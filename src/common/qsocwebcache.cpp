@@ -0,0 +1,423 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Huang Rui <vowstar@gmail.com>
+
+#include "common/qsocwebcache.h"
+
+#include "common/qsocpaths.h"
+
+#include <nlohmann/json.hpp>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QLocale>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QTimeZone>
+#include <QUrl>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+
+using json = nlohmann::json;
+
+namespace {
+
+/* Heuristic freshness for responses with only Last-Modified */
+constexpr qint64 kHeuristicCapMs = 24LL * 60 * 60 * 1000;
+
+QByteArray headerValue(const QSocWebCache::RawHeaders &headers, const QByteArray &name)
+{
+    for (const auto &pair : headers) {
+        if (pair.first.compare(name, Qt::CaseInsensitive) == 0) {
+            return pair.second.trimmed();
+        }
+    }
+    return QByteArray();
+}
+
+/* Every header the response varies on must be part of the key */
+bool varyCoveredBy(const QSocWebCache::RawHeaders &headers, const QMap<QString, QString> &variant)
+{
+    for (const auto &pair : headers) {
+        if (pair.first.compare("Vary", Qt::CaseInsensitive) != 0) {
+            continue;
+        }
+        for (const QByteArray &raw : pair.second.split(',')) {
+            const QString name = QString::fromLatin1(raw.trimmed()).toLower();
+            if (name.isEmpty()) {
+                continue;
+            }
+            const bool covered = std::any_of(
+                variant.keyBegin(), variant.keyEnd(), [&name](const QString &key) {
+                    return key.compare(name, Qt::CaseInsensitive) == 0;
+                });
+            if (!covered) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+QByteArray readAll(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+bool writeAll(const QString &path, const QByteArray &data)
+{
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    file.write(data);
+    return file.commit();
+}
+
+} // namespace
+
+double QSocWebCache::Stats::hitRate() const
+{
+    const qint64 lookups = hits + revalidated + misses;
+    return lookups == 0 ? 0.0 : static_cast<double>(hits + revalidated) / lookups;
+}
+
+QSocWebCache::QSocWebCache(const QString &directory, qint64 maxBytes)
+    : cacheDir(directory)
+    , maxBytes(maxBytes)
+{}
+
+QString QSocWebCache::defaultDirectory()
+{
+    return QDir(QSocPaths::userRoot()).filePath(QStringLiteral("cache/web"));
+}
+
+QSocWebCache *QSocWebCache::shared(qint64 maxBytes)
+{
+    const QString setting = qEnvironmentVariable("QSOC_WEB_CACHE");
+    if (setting == QStringLiteral("0")) {
+        return nullptr;
+    }
+    const QString directory = setting.isEmpty() ? defaultDirectory() : setting;
+
+    static QMutex                                           instancesMutex;
+    static std::map<QString, std::unique_ptr<QSocWebCache>> instances;
+    QSocWebCache                                           *cache = nullptr;
+    {
+        const QMutexLocker             locker(&instancesMutex);
+        std::unique_ptr<QSocWebCache> &instance = instances[directory];
+        if (!instance) {
+            instance = std::make_unique<QSocWebCache>(directory, maxBytes);
+        }
+        cache = instance.get();
+    }
+    cache->setMaxBytes(maxBytes);
+    return cache;
+}
+
+void QSocWebCache::setMaxBytes(qint64 maxBytes)
+{
+    const QMutexLocker locker(&mutex);
+    this->maxBytes = maxBytes;
+    if (indexLoaded) {
+        evict();
+    }
+}
+
+QString QSocWebCache::keyFor(const QString &url, const QMap<QString, QString> &variant)
+{
+    QByteArray material = QUrl(url).adjusted(QUrl::RemoveFragment).toEncoded();
+    for (auto it = variant.constBegin(); it != variant.constEnd(); ++it) {
+        material += '\n' + it.key().toLower().toUtf8() + ':' + it.value().toUtf8();
+    }
+    return QString::fromLatin1(
+        QCryptographicHash::hash(material, QCryptographicHash::Sha256).toHex());
+}
+
+QString QSocWebCache::pathFor(const QString &key, const char *suffix) const
+{
+    return QDir(cacheDir).filePath(key + QLatin1String(suffix));
+}
+
+qint64 QSocWebCache::parseHttpDate(const QByteArray &value)
+{
+    /* IMF-fixdate, the only format senders may generate (RFC 9110):
+     * "Sun, 06 Nov 1994 08:49:37 GMT" */
+    const QString text = QString::fromLatin1(value.trimmed());
+    if (text.size() != 29 || !text.endsWith(QLatin1String(" GMT"))) {
+        return 0;
+    }
+    const QDate date = QLocale::c().toDate(text.left(16), QStringLiteral("ddd, dd MMM yyyy"));
+    const QTime time = QTime::fromString(text.mid(17, 8), QStringLiteral("HH:mm:ss"));
+    if (!date.isValid() || !time.isValid()) {
+        return 0;
+    }
+    return QDateTime(date, time, QTimeZone::utc()).toMSecsSinceEpoch();
+}
+
+qint64 QSocWebCache::freshnessLifetime(const RawHeaders &headers, bool *noCache)
+{
+    bool   revalidate = false;
+    qint64 maxAgeMs   = -1;
+
+    const QByteArray control = headerValue(headers, "Cache-Control").toLower();
+    for (const QByteArray &raw : control.split(',')) {
+        const QByteArray directive = raw.trimmed();
+        if (directive == "no-store") {
+            return -1;
+        }
+        if (directive == "no-cache" || directive.startsWith("no-cache=")) {
+            revalidate = true;
+        } else if (directive.startsWith("max-age=")) {
+            bool         ok      = false;
+            const qint64 seconds = directive.mid(8).replace('"', "").toLongLong(&ok);
+            if (ok) {
+                maxAgeMs = qMax<qint64>(0, seconds) * 1000;
+            }
+        }
+    }
+    if (control.isEmpty() && headerValue(headers, "Pragma").toLower() == "no-cache") {
+        revalidate = true;
+    }
+    if (headerValue(headers, "Vary").trimmed() == "*") {
+        return -1;
+    }
+    if (noCache != nullptr) {
+        *noCache = revalidate;
+    }
+
+    const qint64 ageMs = qMax<qint64>(0, headerValue(headers, "Age").toLongLong()) * 1000;
+    if (maxAgeMs >= 0) {
+        return qMax<qint64>(0, maxAgeMs - ageMs);
+    }
+
+    const qint64 dateMs = parseHttpDate(headerValue(headers, "Date"));
+    const qint64 baseMs = dateMs > 0 ? dateMs : QDateTime::currentMSecsSinceEpoch();
+    if (!headerValue(headers, "Expires").isEmpty()) {
+        /* Unparsable Expires (often "0") means already expired */
+        const qint64 expiresMs = parseHttpDate(headerValue(headers, "Expires"));
+        return qMax<qint64>(0, expiresMs - baseMs - ageMs);
+    }
+
+    const qint64 modifiedMs = parseHttpDate(headerValue(headers, "Last-Modified"));
+    if (modifiedMs > 0 && modifiedMs < baseMs) {
+        return qMin(kHeuristicCapMs, (baseMs - modifiedMs) / 10);
+    }
+    return 0;
+}
+
+void QSocWebCache::loadIndex()
+{
+    if (indexLoaded) {
+        return;
+    }
+    indexLoaded = true;
+    index.clear();
+    totalBytes = 0;
+
+    const QDir dir(cacheDir);
+    for (const QFileInfo &info : dir.entryInfoList({QStringLiteral("*.json")}, QDir::Files)) {
+        const json meta = json::parse(readAll(info.filePath()).toStdString(), nullptr, false);
+        if (!meta.is_object() || !meta.contains("bytes") || !meta["bytes"].is_number_integer()) {
+            continue;
+        }
+        IndexRecord record;
+        record.accessMs = meta.value("access_ms", static_cast<qint64>(0));
+        record.bytes    = meta["bytes"].get<qint64>();
+        index.insert(info.completeBaseName(), record);
+        totalBytes += record.bytes;
+    }
+}
+
+bool QSocWebCache::writeMeta(const QString &key, const Entry &entry, qint64 accessMs, qint64 bytes)
+{
+    json meta;
+    meta["url"]           = entry.url.toStdString();
+    meta["content_type"]  = entry.contentType.toStdString();
+    meta["etag"]          = entry.etag.toStdString();
+    meta["last_modified"] = entry.lastModified.toStdString();
+    meta["stored_ms"]     = entry.storedMs;
+    meta["fresh_ms"]      = entry.freshMs;
+    meta["no_cache"]      = entry.noCache;
+    meta["has_text"]      = !entry.text.isNull();
+    meta["access_ms"]     = accessMs;
+    meta["bytes"]         = bytes;
+    return writeAll(pathFor(key, ".json"), QByteArray::fromStdString(meta.dump()));
+}
+
+void QSocWebCache::removeEntry(const QString &key)
+{
+    QFile::remove(pathFor(key, ".json"));
+    QFile::remove(pathFor(key, ".body"));
+    QFile::remove(pathFor(key, ".txt"));
+    const auto it = index.find(key);
+    if (it != index.end()) {
+        totalBytes -= it->bytes;
+        index.erase(it);
+    }
+}
+
+void QSocWebCache::evict()
+{
+    while (totalBytes > maxBytes && !index.isEmpty()) {
+        const auto oldest = std::min_element(
+            index.cbegin(), index.cend(), [](const IndexRecord &lhs, const IndexRecord &rhs) {
+                return lhs.accessMs < rhs.accessMs;
+            });
+        const QString key = oldest.key();
+        removeEntry(key);
+        counters.evictions++;
+    }
+}
+
+std::optional<QSocWebCache::Entry> QSocWebCache::lookup(
+    const QString &url, const QMap<QString, QString> &variant)
+{
+    const QMutexLocker locker(&mutex);
+    loadIndex();
+    const QString key = keyFor(url, variant);
+    const auto    it  = index.find(key);
+    if (it == index.end()) {
+        return std::nullopt;
+    }
+
+    const json meta = json::parse(readAll(pathFor(key, ".json")).toStdString(), nullptr, false);
+    QFile      bodyFile(pathFor(key, ".body"));
+    if (!meta.is_object() || !bodyFile.open(QIODevice::ReadOnly)) {
+        removeEntry(key);
+        return std::nullopt;
+    }
+    Entry entry;
+    entry.url          = QString::fromStdString(meta.value("url", std::string()));
+    entry.contentType  = QString::fromStdString(meta.value("content_type", std::string()));
+    entry.etag         = QString::fromStdString(meta.value("etag", std::string()));
+    entry.lastModified = QString::fromStdString(meta.value("last_modified", std::string()));
+    entry.storedMs     = meta.value("stored_ms", static_cast<qint64>(0));
+    entry.freshMs      = meta.value("fresh_ms", static_cast<qint64>(0));
+    entry.noCache      = meta.value("no_cache", false);
+    entry.body         = bodyFile.readAll();
+    if (meta.value("has_text", false)) {
+        QFile textFile(pathFor(key, ".txt"));
+        if (!textFile.open(QIODevice::ReadOnly)) {
+            removeEntry(key);
+            return std::nullopt;
+        }
+        entry.text = QString::fromUtf8(textFile.readAll());
+    }
+
+    it->accessMs = QDateTime::currentMSecsSinceEpoch();
+    writeMeta(key, entry, it->accessMs, it->bytes);
+    return entry;
+}
+
+bool QSocWebCache::store(
+    const QString                &url,
+    const QMap<QString, QString> &variant,
+    const RawHeaders             &responseHeaders,
+    const QString                &contentType,
+    const QByteArray             &body,
+    const QString                &text)
+{
+    Entry entry;
+    entry.freshMs = freshnessLifetime(responseHeaders, &entry.noCache);
+    if (entry.freshMs < 0 || !varyCoveredBy(responseHeaders, variant)) {
+        return false;
+    }
+    entry.url          = url;
+    entry.contentType  = contentType;
+    entry.body         = body;
+    entry.text         = text;
+    entry.etag         = QString::fromLatin1(headerValue(responseHeaders, "ETag"));
+    entry.lastModified = QString::fromLatin1(headerValue(responseHeaders, "Last-Modified"));
+    entry.storedMs     = QDateTime::currentMSecsSinceEpoch();
+    if (!entry.hasValidator() && (entry.noCache || entry.freshMs == 0)) {
+        return false; /* could never be served */
+    }
+
+    const QByteArray textBytes = text.toUtf8();
+    const qint64     bytes     = body.size() + textBytes.size();
+
+    const QMutexLocker locker(&mutex);
+    loadIndex();
+    const QString key = keyFor(url, variant);
+    removeEntry(key);
+    if (bytes > maxBytes || !QDir().mkpath(cacheDir)) {
+        return false;
+    }
+    if (!writeAll(pathFor(key, ".body"), body)
+        || (!text.isNull() && !writeAll(pathFor(key, ".txt"), textBytes))
+        || !writeMeta(key, entry, entry.storedMs, bytes)) {
+        removeEntry(key);
+        return false;
+    }
+    index.insert(key, IndexRecord{entry.storedMs, bytes});
+    totalBytes += bytes;
+    evict();
+    return index.contains(key);
+}
+
+std::optional<QSocWebCache::Entry> QSocWebCache::refresh(
+    const QString &url, const QMap<QString, QString> &variant, const RawHeaders &headers)
+{
+    std::optional<Entry> entry = lookup(url, variant);
+    if (!entry.has_value()) {
+        return std::nullopt;
+    }
+
+    /* A 304 carries the updated freshness and validators (RFC 9111 4.3.4) */
+    bool         noCache = false;
+    const qint64 freshMs = freshnessLifetime(headers, &noCache);
+
+    const QMutexLocker locker(&mutex);
+    const QString      key = keyFor(url, variant);
+    if (freshMs < 0) {
+        removeEntry(key);
+        return entry;
+    }
+    entry->storedMs = QDateTime::currentMSecsSinceEpoch();
+    entry->freshMs  = freshMs;
+    entry->noCache  = noCache;
+    if (!headerValue(headers, "ETag").isEmpty()) {
+        entry->etag = QString::fromLatin1(headerValue(headers, "ETag"));
+    }
+    if (!headerValue(headers, "Last-Modified").isEmpty()) {
+        entry->lastModified = QString::fromLatin1(headerValue(headers, "Last-Modified"));
+    }
+    const auto it = index.constFind(key);
+    if (it != index.constEnd()) {
+        writeMeta(key, *entry, it->accessMs, it->bytes);
+    }
+    return entry;
+}
+
+void QSocWebCache::record(Outcome outcome)
+{
+    const QMutexLocker locker(&mutex);
+    switch (outcome) {
+    case Outcome::Hit:
+        counters.hits++;
+        break;
+    case Outcome::Revalidated:
+        counters.revalidated++;
+        break;
+    case Outcome::Miss:
+        counters.misses++;
+        break;
+    }
+}
+
+QSocWebCache::Stats QSocWebCache::stats() const
+{
+    const QMutexLocker locker(&mutex);
+    Stats result   = counters;
+    result.entries = index.size();
+    result.bytes   = totalBytes;
+    return result;
+}
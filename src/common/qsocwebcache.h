@@ -0,0 +1,171 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Huang Rui <vowstar@gmail.com>
+
+#ifndef QSOCWEBCACHE_H
+#define QSOCWEBCACHE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QPair>
+#include <QString>
+
+#include <cstdint>
+#include <optional>
+
+/**
+ * @brief On-disk HTTP response cache for the web_fetch tool.
+ * @details Each entry is keyed by the request URL (fragment stripped) plus
+ *          the request headers that can select a variant, and keeps both
+ *          the raw body and the text the tool produced from it, so a hit
+ *          skips the network and the HTML-to-Markdown pass alike.
+ *
+ *          Freshness follows the response's Cache-Control max-age, then
+ *          Expires, then the usual 10% of Last-Modified age heuristic
+ *          (capped at one day). no-store responses, and responses whose
+ *          Vary names a header outside the key's variant (including Vary: *),
+ *          are never stored; no-cache ones are stored but always revalidated.
+ *          Stale
+ *          entries that carry an ETag or Last-Modified are revalidated with
+ *          a conditional request, and a 304 refreshes them in place.
+ *
+ *          Layout under the cache directory, per entry:
+ *            <key>.json - metadata (url, validators, freshness, LRU stamp)
+ *            <key>.body - raw response body
+ *            <key>.txt  - converted text, absent for image responses
+ *
+ *          Total size is capped; the least recently used entries are
+ *          evicted first. Thread-safe.
+ */
+class QSocWebCache
+{
+public:
+    using RawHeaders = QList<QPair<QByteArray, QByteArray>>;
+
+    struct Entry
+    {
+        QString    url;
+        QString    contentType;
+        QByteArray body;
+        QString    text; /* tool output for text responses, empty for images */
+        QString    etag;
+        QString    lastModified;
+        qint64     storedMs = 0; /* when the response was received or revalidated */
+        qint64     freshMs  = 0; /* freshness lifetime from storedMs */
+        bool       noCache  = false;
+
+        bool isFresh(qint64 nowMs) const { return !noCache && nowMs < storedMs + freshMs; }
+        bool hasValidator() const { return !etag.isEmpty() || !lastModified.isEmpty(); }
+    };
+
+    enum class Outcome : std::uint8_t {
+        Hit,         /* served fresh from disk */
+        Revalidated, /* served from disk after a 304 */
+        Miss,        /* fetched in full */
+    };
+
+    struct Stats
+    {
+        qint64 hits        = 0;
+        qint64 revalidated = 0;
+        qint64 misses      = 0;
+        qint64 evictions   = 0;
+        qint64 entries     = 0;
+        qint64 bytes       = 0;
+
+        /** Fraction of lookups served without downloading the body. */
+        double hitRate() const;
+    };
+
+    /** @brief Default cap when web.cache_max_mb is not configured. */
+    static constexpr qint64 DEFAULT_MAX_BYTES = 64LL * 1024 * 1024;
+
+    /**
+     * @brief Open (or create) a cache rooted at a directory.
+     * @param directory Cache directory; created on first store.
+     * @param maxBytes Size cap over bodies and converted text.
+     */
+    explicit QSocWebCache(const QString &directory, qint64 maxBytes = DEFAULT_MAX_BYTES);
+
+    /** @brief User-level cache directory: <userRoot>/cache/web. */
+    static QString defaultDirectory();
+
+    /**
+     * @brief Process-wide cache, or nullptr when caching is disabled.
+     * @details Tool instances share it so the LRU index stays coherent.
+     *          QSOC_WEB_CACHE set to `0` disables the cache; any other
+     *          non-empty value names the directory to use instead of
+     *          defaultDirectory(). Each directory keeps one instance, and
+     *          the cap is updated on every call.
+     */
+    static QSocWebCache *shared(qint64 maxBytes);
+
+    QString directory() const { return cacheDir; }
+    void    setMaxBytes(qint64 maxBytes);
+
+    /**
+     * @brief Find the stored response for a request, fresh or stale.
+     * @param url Request URL.
+     * @param variant Request headers that may select a representation.
+     */
+    std::optional<Entry> lookup(const QString &url, const QMap<QString, QString> &variant);
+
+    /**
+     * @brief Store a 2xx response if its headers allow it.
+     * @details A response whose Vary names a header missing from @p variant
+     *          is refused, since the key could not tell its variants apart.
+     * @return true if the entry was written.
+     */
+    bool store(
+        const QString                &url,
+        const QMap<QString, QString> &variant,
+        const RawHeaders             &responseHeaders,
+        const QString                &contentType,
+        const QByteArray             &body,
+        const QString                &text);
+
+    /**
+     * @brief Refresh a stored entry from a 304 response.
+     * @return The refreshed entry, or nullopt if it is gone.
+     */
+    std::optional<Entry> refresh(
+        const QString &url, const QMap<QString, QString> &variant, const RawHeaders &headers);
+
+    void  record(Outcome outcome);
+    Stats stats() const;
+
+    /** @brief Freshness lifetime in ms granted by the headers, -1 for no-store. */
+    static qint64 freshnessLifetime(const RawHeaders &headers, bool *noCache = nullptr);
+
+    /** @brief Parse an IMF-fixdate HTTP date to ms since epoch, 0 if invalid. */
+    static qint64 parseHttpDate(const QByteArray &value);
+
+private:
+    struct IndexRecord
+    {
+        qint64 accessMs = 0;
+        qint64 bytes    = 0;
+    };
+
+    QString cacheDir;
+    qint64  maxBytes;
+
+    mutable QMutex              mutex;
+    bool                        indexLoaded = false;
+    QHash<QString, IndexRecord> index;
+    qint64                      totalBytes = 0;
+    Stats                       counters;
+
+    static QString keyFor(const QString &url, const QMap<QString, QString> &variant);
+    QString        pathFor(const QString &key, const char *suffix) const;
+
+    /* Callers hold mutex */
+    void loadIndex();
+    bool writeMeta(const QString &key, const Entry &entry, qint64 accessMs, qint64 bytes);
+    void removeEntry(const QString &key);
+    void evict();
+};
+
+#endif // QSOCWEBCACHE_H
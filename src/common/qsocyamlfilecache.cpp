@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Huang Rui <vowstar@gmail.com>
+
+#include "common/qsocyamlfilecache.h"
+
+#include <QDateTime>
+#include <QFileInfo>
+#include <QMutexLocker>
+
+QSocYamlFileCache::QSocYamlFileCache(int maxFiles)
+    : entries(qMax(1, maxFiles))
+{}
+
+YAML::Node QSocYamlFileCache::load(const QString &filePath)
+{
+    const QFileInfo info(filePath);
+    const QString   key     = info.absoluteFilePath();
+    const qint64    size    = info.size();
+    const qint64    mtimeMs = info.lastModified().toMSecsSinceEpoch();
+
+    {
+        const QMutexLocker locker(&mutex);
+        const Entry       *entry = entries.object(key);
+        if (entry != nullptr && entry->size == size && entry->mtimeMs == mtimeMs) {
+            hits++;
+            return YAML::Clone(entry->node);
+        }
+        misses++;
+    }
+
+    /* Parse outside the lock; a racing load of the same file only parses twice. */
+    const YAML::Node node = YAML::LoadFile(filePath.toStdString());
+
+    auto *entry    = new Entry;
+    entry->node    = YAML::Clone(node);
+    entry->size    = size;
+    entry->mtimeMs = mtimeMs;
+    const QMutexLocker locker(&mutex);
+    entries.insert(key, entry, 1);
+    return node;
+}
+
+void QSocYamlFileCache::clear()
+{
+    const QMutexLocker locker(&mutex);
+    entries.clear();
+}
+
+QSocYamlFileCache::Stats QSocYamlFileCache::stats() const
+{
+    const QMutexLocker locker(&mutex);
+    return Stats{hits, misses, entries.size()};
+}
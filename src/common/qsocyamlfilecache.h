@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Huang Rui <vowstar@gmail.com>
+
+#ifndef QSOCYAMLFILECACHE_H
+#define QSOCYAMLFILECACHE_H
+
+#include <QCache>
+#include <QMutex>
+#include <QString>
+
+#include <yaml-cpp/yaml.h>
+
+/**
+ * @brief Parsed YAML files kept across loads of the same library.
+ * @details Used by the resident daemon so repeated commands do not parse
+ *          every `.soc_mod` / `.soc_bus` again. An entry is reused only
+ *          while the file size and modification time match what was seen
+ *          when it was parsed; anything else reparses. Callers get a deep
+ *          copy and may edit it freely. Bounded by file count with
+ *          least-recently-used eviction. Thread safe.
+ */
+class QSocYamlFileCache
+{
+public:
+    struct Stats
+    {
+        qint64    hits    = 0;
+        qint64    misses  = 0;
+        qsizetype entries = 0;
+    };
+
+    explicit QSocYamlFileCache(int maxFiles = 4096);
+
+    /**
+     * @brief Parse @p filePath, or copy the cached tree when still current.
+     * @details Throws the same YAML::Exception types as YAML::LoadFile.
+     */
+    YAML::Node load(const QString &filePath);
+
+    /** @brief Drop every entry; counters are kept. */
+    void clear();
+
+    Stats stats() const;
+
+private:
+    struct Entry
+    {
+        YAML::Node node;
+        qint64     size    = -1;
+        qint64     mtimeMs = -1;
+    };
+
+    mutable QMutex         mutex;
+    QCache<QString, Entry> entries;
+    qint64                 hits   = 0;
+    qint64                 misses = 0;
+};
+
+#endif // QSOCYAMLFILECACHE_H
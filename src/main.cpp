@@ -2,6 +2,7 @@
 // SPDX-FileCopyrightText: 2023-2025 Huang Rui <vowstar@gmail.com>
 
 #include "cli/qsoccliworker.h"
+#include "cli/qsocdaemon.h"
 #include "common/qsocconsole.h"
 #include "common/qsocproxy.h"
 #include "common/qsocwinconsole.h"
@@ -57,9 +58,13 @@ int main(int argc, char *argv[])
     } else {
         const QCoreApplication app(argc, argv);
         QStaticTranslator::setup();
-        QSocCliWorker socCliWorker;
-        socCliWorker.setup(app.arguments(), false);
-        result = app.exec();
+        /* With QSOC_DAEMON set, a running `qsoc daemon` serves the call
+         * from its resident managers; otherwise run it here. */
+        if (!QSocDaemon::forwardFromEnvironment(app.arguments(), &result)) {
+            QSocCliWorker socCliWorker;
+            socCliWorker.setup(app.arguments(), false);
+            result = app.exec();
+        }
     }
 
     /* Restore original message handler before exiting */
@@ -3,6 +3,7 @@
 
 #include "tui/qtuicompositor.h"
 
+#include "common/qsocprofiler.h"
 #include "tui/qtuiassistanttextblock.h"
 #include "tui/qtuicodeblock.h"
 #include "tui/qtuitoolblock.h"
@@ -32,6 +33,17 @@ QTuiCompositor::~QTuiCompositor()
     }
 }
 
+QTuiCompositor::FrameStats QTuiCompositor::frameStats() const
+{
+    return {frameCount, frameBytes, lastFrameSize};
+}
+
+void QTuiCompositor::setSynchronizedOutput(bool enabled)
+{
+    syncOutput = enabled;
+    screen.setSynchronizedOutput(enabled);
+}
+
 void QTuiCompositor::setFocusOwner(FocusOwner owner)
 {
     focusOwner_ = owner;
@@ -524,8 +536,24 @@ void QTuiCompositor::render()
         applySelectionHighlight();
     }
 
-    QString ansi = screen.toAnsi();
-    fputs(ansi.toUtf8().constData(), stdout);
+    /* Let the terminal scroll the transcript pane itself while streaming.
+     * Not while graphics are placed: a terminal scroll would drag their
+     * placements along with the text. */
+    if (graphicsShown) {
+        screen.setScrollRegion(0, 0);
+    } else {
+        screen.setScrollRegion(layout.contentStart, layout.contentStart + layout.contentHeight);
+    }
+    QSocProfiler::Scope frameScope("frame", "tui");
+    const QByteArray   &frame = screen.encode();
+    fwrite(frame.constData(), 1, static_cast<size_t>(frame.size()), stdout);
+    frameScope.setCount(frame.size());
+    frameScope.finish();
+    if (!frame.isEmpty()) {
+        frameCount++;
+        frameBytes += frame.size();
+        lastFrameSize = frame.size();
+    }
 
     /* Graphics overlay: each visible block that owns a graphics
      * payload (image preview, future plot widgets) emits its raw
@@ -537,6 +565,7 @@ void QTuiCompositor::render()
     if (!graphicsOverlay.isEmpty()) {
         fputs(graphicsOverlay.toUtf8().constData(), stdout);
     }
+    graphicsShown = !graphicsOverlay.isEmpty();
 
     /* Park real cursor at input line for IME support.
      * Terminal emulators render IME preedit at the physical cursor.
@@ -136,8 +136,13 @@ private:
     QTuiCompletionPopup popupWidget;
     QTuiTaskOverlay     taskOverlayWidget;
 
-    QTimer    *timer  = nullptr;
-    bool       active = false;
+    QTimer    *timer         = nullptr;
+    bool       active        = false;
+    bool       graphicsShown = false; /* Last frame placed terminal graphics */
+    bool       syncOutput    = false; /* Frames wrapped in DEC mode 2026 */
+    qint64     frameCount    = 0;     /* Non-empty cell-grid frames written */
+    qint64     frameBytes    = 0;     /* Bytes of those frames */
+    qsizetype  lastFrameSize = 0;     /* Bytes of the latest of them */
     QString    title;
     FocusOwner focusOwner_ = FocusOwner::Input;
 
@@ -216,6 +221,21 @@ private:
 public:
     int  getTerminalWidth() const;
     int  getTerminalHeight() const;
+
+    /* Output volume of the cell grid, shown by /status */
+    struct FrameStats
+    {
+        qint64    frames    = 0; /* non-empty frames written */
+        qint64    bytes     = 0; /* bytes of those frames */
+        qsizetype lastBytes = 0; /* bytes of the latest of them */
+    };
+    FrameStats frameStats() const;
+
+    /* Wrap frames in synchronized update mode (DEC 2026). Off by default;
+     * the CLI turns it on for terminals that implement the mode. */
+    void setSynchronizedOutput(bool enabled);
+    bool synchronizedOutput() const { return syncOutput; }
+
     void scrollContentUp(int lines = 3);
     void scrollContentDown(int lines = 3);
 
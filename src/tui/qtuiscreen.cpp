@@ -5,6 +5,8 @@
 
 #include "tui/qtuiwidget.h"
 
+#include <QHash>
+
 QTuiCell QTuiScreen::defaultCell;
 
 QTuiScreen::QTuiScreen(int width, int height)
@@ -136,149 +138,417 @@ void QTuiScreen::hline(int row, QChar ch)
     }
 }
 
-QString QTuiScreen::toAnsi()
+namespace {
+
+const QTuiCell kBlankCell;
+
+/* Unchanged runs at least this long are skipped with a cursor move
+ * instead of being repainted; shorter ones are cheaper to reprint. */
+constexpr int kSkipGap = 8;
+
+bool isWide(const QTuiCell &cell)
 {
-    QString output;
-    output.reserve(rows * cols * 2);
+    return QTuiText::isWideChar(cell.character.unicode());
+}
 
-    /* Cursor home */
-    output += "\033[H";
+quint64 rowHash(const QVector<QTuiCell> &line)
+{
+    /* FNV-1a over the packed cell attributes */
+    quint64 hash = 14695981039346656037ULL;
+    for (const QTuiCell &cell : line) {
+        quint64 packed = cell.character.unicode();
+        packed |= static_cast<quint64>(
+                      cell.bold | cell.italic << 1 | cell.dim << 2 | cell.underline << 3
+                      | cell.inverted << 4 | cell.decorative << 5)
+                  << 16;
+        packed |= static_cast<quint64>(cell.fgColor) << 24;
+        packed |= static_cast<quint64>(cell.bgColor) << 32;
+        if (!cell.hyperlink.isEmpty()) {
+            packed ^= static_cast<quint64>(qHash(cell.hyperlink)) << 40;
+        }
+        hash = (hash ^ packed) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+void appendNumber(QByteArray &out, int value)
+{
+    char digits[12];
+    int  length = 0;
+    do {
+        digits[length++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    while (length > 0) {
+        out.append(digits[--length]);
+    }
+}
 
-    bool        currentBold      = false;
-    bool        currentItalic    = false;
-    bool        currentDim       = false;
-    bool        currentUnderline = false;
-    bool        currentInverted  = false;
-    QTuiFgColor currentColor     = QTuiFgColor::Default;
-    QTuiBgColor currentBg        = BG_DEFAULT;
-    QString     currentLink;
+void appendUtf8(QByteArray &out, char32_t code)
+{
+    if (code < 0x80) {
+        out.append(static_cast<char>(code));
+    } else if (code < 0x800) {
+        out.append(static_cast<char>(0xC0 | (code >> 6)));
+        out.append(static_cast<char>(0x80 | (code & 0x3F)));
+    } else if (code < 0x10000) {
+        out.append(static_cast<char>(0xE0 | (code >> 12)));
+        out.append(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        out.append(static_cast<char>(0x80 | (code & 0x3F)));
+    } else {
+        out.append(static_cast<char>(0xF0 | (code >> 18)));
+        out.append(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+        out.append(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        out.append(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+}
 
+} // namespace
+
+/* SGR and OSC 8 state the terminal is in while a frame is encoded */
+struct QTuiScreen::Pen
+{
+    bool        bold      = false;
+    bool        italic    = false;
+    bool        dim       = false;
+    bool        underline = false;
+    bool        inverted  = false;
+    QTuiFgColor fgColor   = QTuiFgColor::Default;
+    QTuiBgColor bgColor   = BG_DEFAULT;
+    QString     link;
+
+    bool matches(const QTuiCell &cell) const
+    {
+        return cell.bold == bold && cell.italic == italic && cell.dim == dim
+               && cell.underline == underline && cell.inverted == inverted
+               && cell.fgColor == fgColor && cell.bgColor == bgColor;
+    }
+
+    /* One SGR that resets and applies the cell's attributes */
+    void apply(QByteArray &out, const QTuiCell &cell)
+    {
+        if (matches(cell)) {
+            return;
+        }
+        out.append("\033[0");
+        if (cell.bold) {
+            out.append(";1");
+        }
+        if (cell.dim) {
+            out.append(";2");
+        }
+        if (cell.italic) {
+            out.append(";3");
+        }
+        if (cell.underline) {
+            out.append(";4");
+        }
+        if (cell.inverted) {
+            out.append(";7");
+        }
+        if (cell.fgColor != QTuiFgColor::Default) {
+            out.append(";38;5;");
+            appendNumber(out, static_cast<int>(cell.fgColor));
+        }
+        if (cell.bgColor != BG_DEFAULT) {
+            out.append(";48;5;");
+            appendNumber(out, static_cast<int>(cell.bgColor));
+        }
+        out.append('m');
+        bold      = cell.bold;
+        italic    = cell.italic;
+        dim       = cell.dim;
+        underline = cell.underline;
+        inverted  = cell.inverted;
+        fgColor   = cell.fgColor;
+        bgColor   = cell.bgColor;
+    }
+
+    /* OSC 8 hyperlink wrapping: open when entering a non-empty link
+     * target, close when leaving it, so adjacent cells with the same
+     * hyperlink share one open/close pair. */
+    void setLink(QByteArray &out, const QString &target)
+    {
+        if (target == link) {
+            return;
+        }
+        if (!link.isEmpty()) {
+            out.append("\x1b]8;;\x1b\\");
+        }
+        if (!target.isEmpty()) {
+            out.append("\x1b]8;;");
+            out.append(target.toUtf8());
+            out.append("\x1b\\");
+        }
+        link = target;
+    }
+
+    /* Erase fills with the current background, so go back to defaults */
+    void reset(QByteArray &out)
+    {
+        setLink(out, QString());
+        apply(out, kBlankCell);
+    }
+};
+
+const QByteArray &QTuiScreen::encode()
+{
+    /* resize(0) keeps the allocation for the next frame */
+    frame.resize(0);
+    if (rows <= 0 || cols <= 0) {
+        return frame;
+    }
+
+    QVector<quint64> hashes(rows);
     for (int row = 0; row < rows; row++) {
-        /* Check if this row changed (skip unchanged rows for performance) */
-        if (!fullRedraw && row < prevCells.size()) {
-            bool rowChanged = false;
-            for (int col = 0; col < cols; col++) {
-                if (cells[row][col] != prevCells[row][col]) {
-                    rowChanged = true;
-                    break;
-                }
-            }
-            if (!rowChanged) {
-                /* Move cursor to next row */
-                if (row < rows - 1) {
-                    output += QString("\033[%1;1H").arg(row + 2);
-                }
-                continue;
-            }
+        hashes[row] = rowHash(cells[row]);
+    }
+    if (prevHashes.size() != rows) {
+        fullRedraw = true;
+    }
+
+    if (syncOutput) {
+        frame.append("\033[?2026h");
+    }
+    const qsizetype header = frame.size();
+    cursorRow              = -1;
+    cursorCol              = -1;
+
+    if (!fullRedraw) {
+        const int shift = detectScroll(hashes);
+        if (shift != 0) {
+            frame.append("\033[");
+            appendNumber(frame, qMax(0, scrollTop) + 1);
+            frame.append(';');
+            appendNumber(frame, qMin(scrollBottom, rows));
+            frame.append("r\033[");
+            appendNumber(frame, qAbs(shift));
+            frame.append(shift > 0 ? "S" : "T");
+            /* Dropping the margins homes the cursor */
+            frame.append("\033[r");
+            scrollPrevious(shift);
+        }
+    }
+
+    Pen pen;
+    for (int row = 0; row < rows; row++) {
+        if (fullRedraw) {
+            encodeRow(row, true, pen);
+        } else if (hashes[row] != prevHashes[row] || cells[row] != prevCells[row]) {
+            encodeRow(row, false, pen);
         }
+    }
+
+    /* Leave the terminal with default attributes and no open hyperlink,
+     * otherwise text typed in the input line would inherit them. */
+    pen.reset(frame);
+
+    if (frame.size() == header) {
+        frame.resize(0);
+    } else if (syncOutput) {
+        frame.append("\033[?2026l");
+    }
+
+    /* Save current frame as previous */
+    prevCells  = cells;
+    prevHashes = hashes;
+    fullRedraw = false;
 
-        /* Position cursor at row start, then clear any stale content
-         * for the row before painting. Doing the clear BEFORE the paint
-         * matters with auto-wrap disabled (DECAWM off): if the clear
-         * came after the paint, painting the rightmost cell would
-         * leave the cursor at column W with no auto-advance, and the
-         * subsequent EL would erase the cell we just drew. */
-        output += QString("\033[%1;1H\033[K").arg(row + 1);
-
-        for (int col = 0; col < cols;) {
-            const QTuiCell &cell = cells[row][col];
-            /* Wide chars (CJK, emoji) occupy two cells visually. The
-             * second cell is left as the default ' ' by paintRow but
-             * must not be emitted, otherwise the terminal renders an
-             * extra space and pushes following content one cell to the
-             * right. Detect, emit once, skip the trailing cell. */
-            const int charWidth = QTuiText::isWideChar(cell.character.unicode()) ? 2 : 1;
-
-            /* Emit style changes */
-            bool needReset = false;
-            if (cell.bold != currentBold || cell.italic != currentItalic || cell.dim != currentDim
-                || cell.underline != currentUnderline || cell.inverted != currentInverted
-                || cell.fgColor != currentColor || cell.bgColor != currentBg) {
-                needReset = true;
+    return frame;
+}
+
+QString QTuiScreen::toAnsi()
+{
+    return QString::fromUtf8(encode());
+}
+
+int QTuiScreen::detectScroll(const QVector<quint64> &hashes) const
+{
+    const int top    = qMax(0, scrollTop);
+    const int bottom = qMin(scrollBottom, rows);
+    if (bottom - top < 2) {
+        return 0;
+    }
+
+    /* Rows of the region that would need no repaint after the shift */
+    const auto reused = [&](int shift) {
+        int count = 0;
+        for (int row = top; row < bottom; row++) {
+            const int source = row + shift;
+            if (source >= top && source < bottom && hashes[row] == prevHashes[source]
+                && cells[row] == prevCells[source]) {
+                count++;
             }
+        }
+        return count;
+    };
 
-            if (needReset) {
-                output += "\033[0m";
-                currentBold      = false;
-                currentItalic    = false;
-                currentDim       = false;
-                currentUnderline = false;
-                currentInverted  = false;
-                currentColor     = QTuiFgColor::Default;
-                currentBg        = BG_DEFAULT;
-
-                QString attrs;
-                if (cell.bold) {
-                    attrs += "1;";
-                }
-                if (cell.dim) {
-                    attrs += "2;";
-                }
-                if (cell.italic) {
-                    attrs += "3;";
-                }
-                if (cell.underline) {
-                    attrs += "4;";
-                }
-                if (cell.inverted) {
-                    attrs += "7;";
-                }
-                if (cell.fgColor != QTuiFgColor::Default) {
-                    attrs += "38;5;" + QString::number(static_cast<int>(cell.fgColor)) + ";";
-                }
-                if (cell.bgColor != BG_DEFAULT) {
-                    attrs += "48;5;" + QString::number(static_cast<int>(cell.bgColor)) + ";";
-                }
-                if (!attrs.isEmpty()) {
-                    attrs.chop(1);
-                    output += "\033[" + attrs + "m";
-                }
-                currentBold      = cell.bold;
-                currentItalic    = cell.italic;
-                currentDim       = cell.dim;
-                currentUnderline = cell.underline;
-                currentInverted  = cell.inverted;
-                currentColor     = cell.fgColor;
-                currentBg        = cell.bgColor;
+    int best      = 0;
+    int bestCount = reused(0);
+    for (int distance = 1; distance < bottom - top - bestCount; distance++) {
+        for (const int shift : {distance, -distance}) {
+            const int count = reused(shift);
+            if (count > bestCount) {
+                best      = shift;
+                bestCount = count;
             }
+        }
+    }
+    return best;
+}
 
-            /* OSC 8 hyperlink wrapping: open when entering a non-empty
-             * link target, close when leaving it. The cell-level state
-             * machine emits each transition exactly once so adjacent
-             * cells with the same hyperlink share one open/close pair. */
-            if (cell.hyperlink != currentLink) {
-                if (!currentLink.isEmpty()) {
-                    output += "\x1b]8;;\x1b\\";
-                }
-                if (!cell.hyperlink.isEmpty()) {
-                    output += "\x1b]8;;";
-                    output += cell.hyperlink;
-                    output += "\x1b\\";
-                }
-                currentLink = cell.hyperlink;
+void QTuiScreen::scrollPrevious(int shift)
+{
+    /* Mirror the terminal: lines move by shift, vacated lines are blank */
+    const int               top       = qMax(0, scrollTop);
+    const int               bottom    = qMin(scrollBottom, rows);
+    const QVector<QTuiCell> blankLine(cols);
+    const quint64           blankHash = rowHash(blankLine);
+
+    const auto moveLine = [&](int row) {
+        const int source = row + shift;
+        if (source >= top && source < bottom) {
+            prevCells[row]  = prevCells[source];
+            prevHashes[row] = prevHashes[source];
+        } else {
+            prevCells[row]  = blankLine;
+            prevHashes[row] = blankHash;
+        }
+    };
+    if (shift > 0) {
+        for (int row = top; row < bottom; row++) {
+            moveLine(row);
+        }
+    } else {
+        for (int row = bottom - 1; row >= top; row--) {
+            moveLine(row);
+        }
+    }
+}
+
+void QTuiScreen::moveTo(int row, int col)
+{
+    if (row == cursorRow && col == cursorCol) {
+        return;
+    }
+    frame.append("\033[");
+    appendNumber(frame, row + 1);
+    frame.append(';');
+    appendNumber(frame, col + 1);
+    frame.append('H');
+    cursorRow = row;
+    cursorCol = col;
+}
+
+void QTuiScreen::encodeRow(int row, bool whole, Pen &pen)
+{
+    const QVector<QTuiCell> &line = cells[row];
+    const QVector<QTuiCell> &prev = prevCells[row];
+
+    /* Trailing blank cells are cleared with one EL instead of painted */
+    int tail = cols;
+    while (tail > 0 && line[tail - 1] == kBlankCell) {
+        tail--;
+    }
+
+    /* Damaged span [first, last]; grown so it never splits a wide glyph
+     * or a surrogate pair, in this frame or the previous one. */
+    const auto differs = [&](int col) { return whole || line[col] != prev[col]; };
+    const auto widen   = [&](int col) {
+        if (col > 0
+            && (isWide(line[col - 1]) || isWide(prev[col - 1])
+                || line[col].character.isLowSurrogate())) {
+            return col - 1;
+        }
+        return col;
+    };
+    int first = 0;
+    while (first < cols && !differs(first)) {
+        first++;
+    }
+    if (first == cols) {
+        return;
+    }
+    int last = cols - 1;
+    while (last > first && !differs(last)) {
+        last--;
+    }
+    first = widen(first);
+    if (last < cols - 1
+        && (isWide(line[last]) || isWide(prev[last]) || line[last].character.isHighSurrogate())) {
+        last++;
+    }
+
+    const int paintEnd = qMin(last + 1, tail);
+    for (int col = first; col < paintEnd;) {
+        /* Jump over a long unchanged run rather than reprinting it */
+        if (!whole) {
+            int next = col;
+            while (next < paintEnd && !differs(next)) {
+                next++;
+            }
+            if (next - col >= kSkipGap) {
+                col = next < paintEnd ? widen(next) : paintEnd;
+                continue;
             }
-            output += cell.character;
-            col += charWidth;
         }
+
+        const QTuiCell &cell = line[col];
+        const QChar     chr  = cell.character;
+        /* Low half of a pair was written together with its high half */
+        if (chr.isLowSurrogate() && col > 0 && line[col - 1].character.isHighSurrogate()) {
+            col++;
+            continue;
+        }
+        moveTo(row, col);
+        pen.apply(frame, cell);
+        pen.setLink(frame, cell.hyperlink);
+        if (chr.isHighSurrogate() && col + 1 < cols && line[col + 1].character.isLowSurrogate()) {
+            appendUtf8(frame, QChar::surrogateToUcs4(chr, line[col + 1].character));
+        } else if (chr.isSurrogate()) {
+            appendUtf8(frame, QChar::ReplacementCharacter);
+        } else {
+            appendUtf8(frame, chr.unicode());
+        }
+        /* Wide chars (CJK, emoji) occupy two cells visually. The second
+         * cell is left as the default ' ' by paintRow but must not be
+         * emitted, otherwise the terminal renders an extra space and
+         * pushes following content one cell to the right. */
+        col += isWide(cell) ? 2 : 1;
+        /* With auto-wrap off the cursor parks on the last column */
+        cursorCol = col < cols ? col : -1;
     }
 
-    /* Close any in-flight OSC 8 hyperlink so the cursor leaves the
-     * frame in a clean state — otherwise text typed in the input
-     * line would inherit the last cell's link target. */
-    if (!currentLink.isEmpty()) {
-        output += "\x1b]8;;\x1b\\";
+    if (tail > last) {
+        return;
+    }
+    /* Clear from the end of the painted glyphs. When the last glyph
+     * reached the right edge nothing is left to clear, and an EL there
+     * would erase the cell just drawn since DECAWM is off. */
+    int eraseFrom = qMax(first, tail);
+    if (cursorRow == row && cursorCol < 0) {
+        return;
+    }
+    if (cursorRow == row && cursorCol > eraseFrom) {
+        eraseFrom = cursorCol;
     }
-    /* Reset attributes at end */
-    if (currentBold || currentDim || currentInverted || currentColor != QTuiFgColor::Default
-        || currentBg != BG_DEFAULT) {
-        output += "\033[0m";
+    if (eraseFrom >= cols) {
+        return;
     }
+    pen.reset(frame);
+    moveTo(row, eraseFrom);
+    frame.append("\033[K");
+}
 
-    /* Save current frame as previous */
-    prevCells  = cells;
-    fullRedraw = false;
+void QTuiScreen::setScrollRegion(int top, int bottom)
+{
+    scrollTop    = top;
+    scrollBottom = bottom;
+}
 
-    return output;
+void QTuiScreen::setSynchronizedOutput(bool enabled)
+{
+    syncOutput = enabled;
 }
 
 void QTuiScreen::invalidate()
@@ -4,6 +4,7 @@
 #ifndef QTUISCREEN_H
 #define QTUISCREEN_H
 
+#include <QByteArray>
 #include <QString>
 #include <QVector>
 
@@ -97,7 +98,11 @@ struct QTuiStyledRun
 /**
  * @brief 2D terminal screen buffer with ANSI output
  * @details Full-screen buffer that renders to ANSI escape sequences.
- *          Tracks previous frame for differential output.
+ *          Tracks previous frame for differential output: only the
+ *          damaged span of each changed row is repainted, trailing
+ *          blanks are cleared with one erase, and a vertical shift of
+ *          the scroll region is replayed with DECSTBM + SU/SD so the
+ *          terminal moves the unchanged lines itself.
  */
 class QTuiScreen
 {
@@ -138,20 +143,49 @@ public:
     /* Draw a horizontal line of a character across full width */
     void hline(int row, QChar ch = '-');
 
-    /* Convert current buffer to ANSI escape sequence string.
-     * Compares with previous frame for minimal output. */
+    /* Encode the frame as UTF-8 ANSI into a buffer reused across frames.
+     * Compares with previous frame for minimal output; an unchanged frame
+     * encodes to an empty buffer. Valid until the next encode(). */
+    const QByteArray &encode();
+
+    /* Same as encode(), decoded to a QString */
     QString toAnsi();
 
-    /* Force full redraw on next toAnsi() call */
+    /* Force full redraw on next encode() call */
     void invalidate();
 
+    /* Rows [top, bottom) that scroll as one pane, e.g. the transcript.
+     * Shifts inside it are sent as terminal scrolls. Empty disables. */
+    void setScrollRegion(int top, int bottom);
+
+    /* Wrap each non-empty frame in synchronized update mode (DEC 2026) so
+     * the terminal presents it atomically. Terminals without the mode
+     * ignore the private mode sequences. */
+    void setSynchronizedOutput(bool enabled);
+
 private:
+    struct Pen;
+
+    int  detectScroll(const QVector<quint64> &hashes) const;
+    void scrollPrevious(int shift);
+    void encodeRow(int row, bool whole, Pen &pen);
+    void moveTo(int row, int col);
+
     int                        cols = 0;
     int                        rows = 0;
     QVector<QVector<QTuiCell>> cells;
-    QVector<QVector<QTuiCell>> prevCells; /* Previous frame for diff */
+    QVector<QVector<QTuiCell>> prevCells;  /* Previous frame for diff */
+    QVector<quint64>           prevHashes; /* Row hashes of prevCells */
     bool                       fullRedraw = true;
 
+    /* Encoder state */
+    QByteArray frame;
+    int        scrollTop    = 0;
+    int        scrollBottom = 0;
+    bool       syncOutput   = false;
+    int        cursorRow    = -1; /* -1: terminal cursor position unknown */
+    int        cursorCol    = -1;
+
     static QTuiCell defaultCell;
 };
 
@@ -36,6 +36,16 @@ private slots:
     void parseFileList_validFiles();
     void parseFileList_invalidFiles();
     void parseFileList_emptyList();
+    void parseFileList_parallelJobs();
+    void parseFileList_parallelCrossFileMacro();
+    void parseFileList_reusesCompilation();
+
+    /* Cross-file macro detection tests */
+    void findCrossFileMacroSource_used();
+    void findCrossFileMacroSource_undefined();
+    void findCrossFileMacroSource_independent();
+    void findCrossFileMacroSource_includedHeader();
+    void findCrossFileMacroSource_nettype();
 
     /* Test utility functions */
     void contentCleanComment_singleLine();
@@ -210,6 +220,176 @@ void Test::parseFileList_emptyList()
     QVERIFY(!result);
 }
 
+void Test::parseFileList_parallelJobs()
+{
+    const QString verilogFile1 = createTemporaryVerilogFile(R"(
+        module par_a(input a, output b);
+            assign b = a;
+        endmodule
+    )");
+    const QString verilogFile2 = createTemporaryVerilogFile(R"(
+        module par_b(input c, output d);
+            assign d = ~c;
+        endmodule
+    )");
+    QVERIFY(!verilogFile1.isEmpty());
+    QVERIFY(!verilogFile2.isEmpty());
+
+    /* Independent files parse as separate units on all cores */
+    QSlangDriver driver;
+    driver.setParseJobs(0);
+    QVERIFY(driver.parseFileList("", {verilogFile1, verilogFile2}));
+
+    const QStringList modules = driver.getModuleList();
+    QVERIFY(modules.contains("par_a"));
+    QVERIFY(modules.contains("par_b"));
+    QCOMPARE(modules.size(), 2);
+}
+
+void Test::parseFileList_parallelCrossFileMacro()
+{
+    const QString verilogFile1 = createTemporaryVerilogFile(R"(
+        `define PAR_WIDTH 8
+        module par_def(input [`PAR_WIDTH-1:0] a, output [`PAR_WIDTH-1:0] b);
+            assign b = a;
+        endmodule
+    )");
+    const QString verilogFile2 = createTemporaryVerilogFile(R"(
+        module par_use(input [`PAR_WIDTH-1:0] c, output [`PAR_WIDTH-1:0] d);
+            assign d = c;
+        endmodule
+    )");
+    QVERIFY(!verilogFile1.isEmpty());
+    QVERIFY(!verilogFile2.isEmpty());
+
+    /* The second file needs the first file's macro, so one unit is kept */
+    QSlangDriver driver;
+    driver.setParseJobs(4);
+    QVERIFY(driver.parseFileList("", {verilogFile1, verilogFile2}));
+
+    const QStringList modules = driver.getModuleList();
+    QVERIFY(modules.contains("par_def"));
+    QVERIFY(modules.contains("par_use"));
+}
+
+void Test::parseFileList_reusesCompilation()
+{
+    const QString verilogFile = createTemporaryVerilogFile(R"(
+        module cached_a(input a, output b);
+            assign b = a;
+        endmodule
+    )");
+    QVERIFY(!verilogFile.isEmpty());
+
+    QSlangDriver driver;
+    QVERIFY(driver.parseFileList("", {verilogFile}));
+    QVERIFY(!driver.isLastParseCached());
+
+    /* Unchanged inputs reuse the compilation */
+    QVERIFY(driver.parseFileList("", {verilogFile}));
+    QVERIFY(driver.isLastParseCached());
+    QCOMPARE(driver.getModuleList(), QStringList{"cached_a"});
+
+    /* Different macros parse again */
+    QVERIFY(driver.parseFileList("", {verilogFile}, {"CACHE_TEST"}));
+    QVERIFY(!driver.isLastParseCached());
+
+    /* A changed source parses again and sees the new module */
+    QFile file(verilogFile);
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text));
+    file.write("module cached_renamed(input a, output b);\n    assign b = ~a;\nendmodule\n");
+    file.close();
+    QVERIFY(driver.parseFileList("", {verilogFile}, {"CACHE_TEST"}));
+    QVERIFY(!driver.isLastParseCached());
+    QCOMPARE(driver.getModuleList(), QStringList{"cached_renamed"});
+
+    /* Any direct parse replaces the compilation and drops the cache */
+    QVERIFY(driver.parseArgs(QString("slang --single-unit %1").arg(verilogFile)));
+    QVERIFY(driver.parseFileList("", {verilogFile}, {"CACHE_TEST"}));
+    QVERIFY(!driver.isLastParseCached());
+}
+
+void Test::findCrossFileMacroSource_used()
+{
+    const QString defineFile = createTemporaryVerilogFile(
+        "`define MACRO_USED 1\nmodule m1; endmodule\n");
+    const QString plainFile = createTemporaryVerilogFile("module m2; endmodule\n");
+    const QString useFile   = createTemporaryVerilogFile(
+        "module m3;\n`ifdef MACRO_USED\nwire w;\n`endif\nendmodule\n");
+
+    QSlangDriver driver;
+    QCOMPARE(driver.findCrossFileMacroSource({defineFile, plainFile, useFile}), defineFile);
+}
+
+void Test::findCrossFileMacroSource_undefined()
+{
+    const QString defineFile = createTemporaryVerilogFile(
+        "`define MACRO_LOCAL 4\nmodule m1; wire [`MACRO_LOCAL:0] w; endmodule\n"
+        "`undef MACRO_LOCAL\n");
+    const QString useFile = createTemporaryVerilogFile(
+        "module m2;\n`ifndef MACRO_LOCAL\nwire w;\n`endif\nendmodule\n");
+
+    /* Undefined before the file ends, so nothing reaches the next file */
+    QSlangDriver driver;
+    QVERIFY(driver.findCrossFileMacroSource({defineFile, useFile}).isEmpty());
+}
+
+void Test::findCrossFileMacroSource_independent()
+{
+    const QString firstFile = createTemporaryVerilogFile(
+        "`define MACRO_FIRST 1\nmodule m1; endmodule\n");
+    const QString secondFile = createTemporaryVerilogFile(
+        "// `MACRO_FIRST in a comment\n`define MACRO_SECOND 2\n"
+        "module m2; wire [`MACRO_SECOND:0] w; endmodule\n");
+
+    /* Comments and a file's own macros do not count as cross-file use */
+    QSlangDriver driver;
+    QVERIFY(driver.findCrossFileMacroSource({firstFile, secondFile}).isEmpty());
+    QVERIFY(driver.findCrossFileMacroSource({}).isEmpty());
+}
+
+void Test::findCrossFileMacroSource_includedHeader()
+{
+    /* The macro lives only in the header the first file includes */
+    QFile header(tempDir.path() + "/cross_hdr.vh");
+    QVERIFY(header.open(QIODevice::WriteOnly | QIODevice::Text));
+    header.write("`define HDR_WIDTH 6\n");
+    header.close();
+    const QString includeFile = createTemporaryVerilogFile(
+        "`include \"cross_hdr.vh\"\n"
+        "module hdr_def(input [`HDR_WIDTH-1:0] a, output [`HDR_WIDTH-1:0] b);\n"
+        "    assign b = a;\nendmodule\n");
+    const QString useFile = createTemporaryVerilogFile(
+        "module hdr_use(input [`HDR_WIDTH-1:0] c, output [`HDR_WIDTH-1:0] d);\n"
+        "    assign d = c;\nendmodule\n");
+
+    QSlangDriver driver;
+    QString      reason;
+    QCOMPARE(driver.findCrossFileMacroSource({includeFile, useFile}, &reason), includeFile);
+    QVERIFY(reason.contains("includes headers"));
+    /* Includes in the last file reach no other file */
+    QVERIFY(driver.findCrossFileMacroSource({useFile, includeFile}).isEmpty());
+
+    driver.setParseJobs(4);
+    QVERIFY(driver.parseFileList("", {includeFile, useFile}));
+    QVERIFY(driver.getModuleList().contains("hdr_use"));
+    const json &useAst = driver.getModuleAst("hdr_use");
+    QVERIFY(QString::fromStdString(useAst.dump()).contains("[5:0]"));
+}
+
+void Test::findCrossFileMacroSource_nettype()
+{
+    const QString noneFile = createTemporaryVerilogFile(
+        "`default_nettype none\nmodule nt1; endmodule\n");
+    const QString restoreFile = createTemporaryVerilogFile(
+        "`default_nettype none\nmodule nt2; endmodule\n`default_nettype wire\n");
+    const QString plainFile = createTemporaryVerilogFile("module nt3; endmodule\n");
+
+    QSlangDriver driver;
+    QCOMPARE(driver.findCrossFileMacroSource({noneFile, plainFile}), noneFile);
+    QVERIFY(driver.findCrossFileMacroSource({restoreFile, plainFile}).isEmpty());
+}
+
 void Test::contentCleanComment_singleLine()
 {
     QSlangDriver driver;
@@ -35,6 +35,32 @@ struct TestApp
     }
 };
 
+/* Tool whose body runs through runOnWorker */
+class WorkerProbeTool final : public QSocTool
+{
+public:
+    using QSocTool::QSocTool;
+
+    QString getName() const override { return "worker_probe"; }
+    QString getDescription() const override { return "Worker probe"; }
+    json    getParametersSchema() const override { return {{"type", "object"}}; }
+    bool    isAsync() const override { return true; }
+    QString execute(const json &arguments) override { return executeBlocking(arguments); }
+
+    void executeAsync(
+        const json &arguments, QSocToolCallContext *call, const ResultCallback &done) override
+    {
+        runOnWorker(
+            [body = body, arguments](const QSocToolWorker &worker) {
+                return body(worker, arguments);
+            },
+            call,
+            done);
+    }
+
+    std::function<QString(const QSocToolWorker &, const json &)> body;
+};
+
 class Test : public QObject
 {
     Q_OBJECT
@@ -669,6 +695,152 @@ private slots:
         QVERIFY(!result.isEmpty());
     }
 
+    void testRegistryWorkerToolProgress()
+    {
+        QSocToolRegistry registry;
+        WorkerProbeTool  tool;
+        QObject          owner;
+        QThread         *bodyThread = nullptr;
+        tool.body = [&bodyThread](const QSocToolWorker &worker, const json &) {
+            bodyThread = QThread::currentThread();
+            worker.progress("step one");
+            worker.progress("step two");
+            return QString("done");
+        };
+        registry.registerTool(&tool);
+
+        QStringList progress;
+        connect(
+            &registry,
+            &QSocToolRegistry::toolProgress,
+            this,
+            [&](QObject *caller, const QString &toolName, const QString &message) {
+                QCOMPARE(caller, &owner);
+                QCOMPARE(toolName, QString("worker_probe"));
+                progress.append(message);
+            });
+
+        QString result;
+        registry.executeToolAsync(
+            "worker_probe", json::object(), &owner, [&result](const QString &text) {
+                result = text;
+            });
+        QVERIFY(result.isEmpty());
+        QTRY_COMPARE(result, QString("done"));
+        QVERIFY(bodyThread != nullptr);
+        QVERIFY(bodyThread != QThread::currentThread());
+        QCOMPARE(progress, QStringList({"step one", "step two"}));
+    }
+
+    void testRegistryWorkerToolCancel()
+    {
+        QSocToolRegistry registry;
+        WorkerProbeTool  tool;
+        QObject          owner;
+        tool.body = [](const QSocToolWorker &worker, const json &) {
+            for (int tick = 0; tick < 1000; ++tick) {
+                if (worker.isCancelled()) {
+                    return QString("cancelled");
+                }
+                QThread::msleep(5);
+            }
+            return QString("timeout");
+        };
+        registry.registerTool(&tool);
+
+        /* The calling thread keeps serving timers while the body runs */
+        int    ticks = 0;
+        QTimer ticker;
+        connect(&ticker, &QTimer::timeout, this, [&ticks]() { ticks++; });
+        ticker.start(5);
+        QTimer::singleShot(100, this, [&registry, &owner]() { registry.abortCalls(&owner); });
+
+        QString result;
+        registry.executeToolAsync(
+            "worker_probe", json::object(), &owner, [&result](const QString &text) {
+                result = text;
+            });
+        QTRY_COMPARE(result, QString("cancelled"));
+        QVERIFY(ticks > 0);
+    }
+
+    void testRegistryWorkerToolBlockingRunsInline()
+    {
+        QSocToolRegistry registry;
+        WorkerProbeTool  tool;
+        QThread         *bodyThread = nullptr;
+        tool.body = [&bodyThread](const QSocToolWorker &, const json &) {
+            bodyThread = QThread::currentThread();
+            return QString("done");
+        };
+        registry.registerTool(&tool);
+
+        QCOMPARE(registry.executeTool("worker_probe", json::object()), QString("done"));
+        QCOMPARE(bodyThread, QThread::currentThread());
+    }
+
+    void testRegistryWorkerToolsFinishInAnyOrder()
+    {
+        if (QThread::idealThreadCount() < 2) {
+            QSKIP("Needs two worker threads");
+        }
+        QSocToolRegistry registry;
+        WorkerProbeTool  tool;
+        QObject          owner;
+        tool.body = [](const QSocToolWorker &, const json &arguments) {
+            const QString name = QString::fromStdString(arguments["name"].get<std::string>());
+            if (name == "slow") {
+                QThread::msleep(200);
+            }
+            return name;
+        };
+        registry.registerTool(&tool);
+
+        /* Each result arrives when its own body is done, not in stack order */
+        QStringList finished;
+        for (const char *name : {"slow", "fast"}) {
+            registry.executeToolAsync(
+                "worker_probe", json{{"name", name}}, &owner, [&finished](const QString &text) {
+                    finished.append(text);
+                });
+        }
+        QTRY_COMPARE(finished.size(), 2);
+        QCOMPARE(finished, QStringList({"fast", "slow"}));
+    }
+
+    void testGenerateCancelCheckStopsBetweenDataFiles()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        QSocProjectManager project;
+        project.setOutputPath(dir.path());
+        const QString firstData    = dir.filePath("first.yaml");
+        const QString secondData   = dir.filePath("second.yaml");
+        const QString templatePath = dir.filePath("cancel.txt.j2");
+        for (const auto &[path, content] :
+             {std::pair<QString, QByteArray>{firstData, "a: 1\n"},
+              std::pair<QString, QByteArray>{secondData, "b: 2\n"},
+              std::pair<QString, QByteArray>{templatePath, "{{ a }}{{ b }}"}}) {
+            QFile file(path);
+            QVERIFY(file.open(QIODevice::WriteOnly));
+            file.write(content);
+        }
+
+        /* Trips before the second data file: nothing is written */
+        QSocGenerateManager generator(nullptr, &project);
+        int                 polls = 0;
+        generator.setCancelCheck([&polls]() { return ++polls > 1; });
+        QVERIFY(!generator.renderTemplate(
+            templatePath, {}, {firstData, secondData}, {}, {}, {}, "cancel.txt"));
+        QCOMPARE(polls, 2);
+        QVERIFY(!QFile::exists(dir.filePath("cancel.txt")));
+
+        generator.setCancelCheck({});
+        QVERIFY(generator.renderTemplate(
+            templatePath, {}, {firstData, secondData}, {}, {}, {}, "cancel.txt"));
+        QVERIFY(QFile::exists(dir.filePath("cancel.txt")));
+    }
+
     void testRegistryExecuteNonexistent()
     {
         QSocToolRegistry registry;
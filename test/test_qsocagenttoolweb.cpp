@@ -518,6 +518,7 @@ private slots:
         QSocToolWebFetch tool(&registry);
         QObject          ownerA;
         QObject          ownerB;
+        tool.setWebCache(nullptr);
         registry.registerTool(&tool);
 
         bool    innerStarted = false;
@@ -586,6 +587,7 @@ private slots:
             "web.search_api_url", QStringLiteral("http://127.0.0.1:%1").arg(server.serverPort()));
         QSocToolWebFetch  fetchTool(this);
         QSocToolWebSearch searchTool(this, &config);
+        fetchTool.setWebCache(nullptr);
 
         bool fetchHttp2Allowed  = true;
         bool searchHttp2Allowed = true;
@@ -2980,6 +2980,130 @@ net:
             "axi_bus1_rdata should be declared as input");
     }
 
+    void testBusLinkExpansionDedupAndPadVariant()
+    {
+        messageList.clear();
+
+        const QString masterModuleContent = R"(
+bus_dedup_master:
+  port:
+    m_arvalid:
+      type: logic
+      direction: out
+    m_arready:
+      type: logic
+      direction: in
+  bus:
+    axim:
+      bus: bus_dedup_axi
+      direction: master
+      mapping:
+        arvalid: m_arvalid
+        arready: m_arready
+)";
+
+        const QString slaveModuleContent = R"(
+bus_dedup_slave:
+  port:
+    s_arvalid:
+      type: logic
+      direction: in
+    s_arready:
+      type: logic
+      direction: out
+  bus:
+    axis:
+      bus: bus_dedup_axi
+      direction: slave
+      mapping:
+        arvalid: s_arvalid
+        arready: s_arready
+)";
+
+        const QString busContent = R"(
+bus_dedup_axi:
+  port:
+    arvalid:
+      type: logic
+      direction: out
+    arready:
+      type: logic
+      direction: in
+)";
+
+        const QDir moduleDir(projectManager.getModulePath());
+        QFile      masterModuleFile(moduleDir.filePath("bus_dedup_master.soc_mod"));
+        if (masterModuleFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            QTextStream stream(&masterModuleFile);
+            stream << masterModuleContent;
+            masterModuleFile.close();
+        }
+        QFile slaveModuleFile(moduleDir.filePath("bus_dedup_slave.soc_mod"));
+        if (slaveModuleFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            QTextStream stream(&slaveModuleFile);
+            stream << slaveModuleContent;
+            slaveModuleFile.close();
+        }
+        const QDir busDir(projectManager.getBusPath());
+        QFile      busFile(busDir.filePath("bus_dedup_axi.soc_bus"));
+        if (busFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            QTextStream stream(&busFile);
+            stream << busContent;
+            busFile.close();
+        }
+
+        /* The explicit bus section already lists u_master.axim, so the
+           instance-level link must not add it a second time. The slave
+           connects through the pad_ spelling of its bus port. */
+        const QString netlistContent = R"(
+---
+version: "1.0"
+module: "test_bus_link_dedup"
+instance:
+  u_master:
+    module: bus_dedup_master
+    bus:
+      axim:
+        link: dedup_bus
+  u_slave:
+    module: bus_dedup_slave
+bus:
+  dedup_bus:
+    - instance: u_master
+      port: axim
+    - instance: u_slave
+      port: pad_axis
+)";
+
+        const QString filePath = createTempFile("test_bus_link_dedup.soc_net", netlistContent);
+
+        messageList.clear();
+
+        QSocCliWorker     socCliWorker;
+        const QStringList appArguments
+            = {"qsoc", "generate", "verilog", "-d", projectManager.getCurrentPath(), filePath};
+        socCliWorker.setup(appArguments, false);
+        socCliWorker.run();
+
+        QVERIFY(verifyVerilogOutputExistence("test_bus_link_dedup"));
+
+        QVERIFY2(
+            verifyVerilogContent("test_bus_link_dedup", ".m_arvalid(dedup_bus_arvalid)"),
+            "Master port should join the synthesized bus net");
+        QVERIFY2(
+            verifyVerilogContent("test_bus_link_dedup", ".s_arvalid(dedup_bus_arvalid)"),
+            "Slave port should resolve through the pad_ bus port variant");
+        QVERIFY2(
+            verifyVerilogContent("test_bus_link_dedup", ".s_arready(dedup_bus_arready)"),
+            "Slave port should resolve through the pad_ bus port variant");
+
+        /* A duplicated master member would drive the net twice */
+        QVERIFY2(
+            !verifyVerilogContent(
+                "test_bus_link_dedup", "Net dedup_bus_arvalid has multiple drivers"),
+            "Duplicate bus link member should be deduplicated");
+    }
+
     /* Test conditional compilation: no condition (backward compatibility) */
     void testConditionalNoCondition()
     {
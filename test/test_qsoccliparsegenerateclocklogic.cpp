@@ -2632,6 +2632,80 @@ clock:
         QVERIFY(verifyVerilogContentNormalized(verilogContent, ".clk_out(clk_out_inv_out)"));
     }
 
+    void test_multiple_controllers_order_without_diagram()
+    {
+        // Controllers render in parallel but must keep netlist order
+        QString netlistContent = R"(
+port:
+  osc_a:
+    direction: input
+    type: logic
+  osc_b:
+    direction: input
+    type: logic
+  clk_a:
+    direction: output
+    type: logic
+  clk_b:
+    direction: output
+    type: logic
+
+instance: {}
+
+net: {}
+
+clock:
+  - name: order_second_ctrl
+    input:
+      osc_b:
+        freq: 24MHz
+    target:
+      clk_b:
+        freq: 24MHz
+        link:
+          osc_b:
+  - name: order_first_ctrl
+    input:
+      osc_a:
+        freq: 24MHz
+    target:
+      clk_a:
+        freq: 24MHz
+        link:
+          osc_a:
+)";
+
+        QString netlistPath = createTempFile("test_controller_order.soc_net", netlistContent);
+        QVERIFY(!netlistPath.isEmpty());
+
+        const QDir outputDir(projectManager.getOutputPath());
+        QFile::remove(outputDir.filePath("order_second_ctrl.typ"));
+        QFile::remove(outputDir.filePath("order_first_ctrl.typ"));
+
+        {
+            QSocCliWorker socCliWorker;
+            QStringList   args;
+            args << "qsoc" << "generate" << "verilog" << "--no-diagram" << "-d"
+                 << projectManager.getCurrentPath() << netlistPath;
+
+            socCliWorker.setup(args, false);
+            socCliWorker.run();
+        }
+
+        QString verilogContent = readGeneratedVerilog("test_controller_order.v");
+        QVERIFY(!verilogContent.isEmpty());
+
+        const qsizetype secondPos = verilogContent.indexOf("module order_second_ctrl");
+        const qsizetype firstPos  = verilogContent.indexOf("module order_first_ctrl");
+        QVERIFY(secondPos >= 0);
+        QVERIFY(firstPos > secondPos);
+
+        // Diagrams are skipped, the cell library is still written
+        QVERIFY(!QFile::exists(outputDir.filePath("order_second_ctrl.typ")));
+        QVERIFY(!QFile::exists(outputDir.filePath("order_first_ctrl.typ")));
+        QVERIFY(verifyClockCellFileComplete());
+    }
+
 private:
     QString readGeneratedVerilog(const QString &filename)
     {
@@ -17,6 +17,8 @@
 #include <QtCore>
 #include <QtTest>
 
+#include <nlohmann/json.hpp>
+
 class Test : public QObject
 {
     Q_OBJECT
@@ -571,6 +573,121 @@ endmodule // {{ module.name }})";
         QVERIFY(verifyTemplateContent("module_implementation", "endmodule // cpu_wrapper"));
     }
 
+    /* One broken template in a batch fails alone; the others still render, in order */
+    void testGenerateTemplateBatchWithOneFailure()
+    {
+        messageList.clear();
+        const QDir projectDir(projectManager.getCurrentPath());
+
+        const QString yamlFilePath = createTempFile("batch_data.yaml", "chip: batch_soc\n");
+        const QString goodPath1    = projectDir.filePath("batch_first.txt.j2");
+        const QString brokenPath   = projectDir.filePath("batch_broken.txt.j2");
+        const QString goodPath2    = projectDir.filePath("batch_second.txt.j2");
+        for (const auto &[path, content] :
+             {std::pair<QString, QString>{goodPath1, "first {{ chip }}"},
+              std::pair<QString, QString>{brokenPath, "{{ chip }"},
+              std::pair<QString, QString>{goodPath2, "second {{ upper(chip) }}"}}) {
+            QFile file(path);
+            QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Text));
+            file.write(content.toUtf8());
+        }
+
+        QSocCliWorker     socCliWorker;
+        const QStringList appArguments
+            = {"qsoc",
+               "generate",
+               "template",
+               "-d",
+               projectManager.getCurrentPath(),
+               "--yaml",
+               yamlFilePath,
+               goodPath1,
+               brokenPath,
+               goodPath2};
+        socCliWorker.setup(appArguments, false);
+        socCliWorker.run();
+
+        QVERIFY(verifyTemplateContent("batch_first.txt", "first batch_soc"));
+        QVERIFY(verifyTemplateContent("batch_second.txt", "second BATCH_SOC"));
+        QVERIFY(!messageList.filter(QRegularExpression("Error:.*render.*batch_broken")).empty());
+
+        /* Reports follow the command line order */
+        const QRegularExpression firstReport(".*batch_first\\.txt\\s*");
+        const QRegularExpression secondReport(".*batch_second\\.txt\\s*");
+        const qsizetype          first  = messageList.indexOf(firstReport);
+        const qsizetype          second = messageList.indexOf(secondReport);
+        QVERIFY(first >= 0);
+        QVERIFY(second > first);
+
+        QFile::remove(goodPath1);
+        QFile::remove(brokenPath);
+        QFile::remove(goodPath2);
+    }
+
+    void testGenerateTemplateDataSidecar()
+    {
+        messageList.clear();
+        const QDir    projectDir(projectManager.getCurrentPath());
+        const QDir    outputDir(projectManager.getOutputPath());
+        const QString yamlFilePath = createTempFile("sidecar_data.yaml", "chip: sidecar_soc\n");
+        const QString templatePath = projectDir.filePath("sidecar_out.txt.j2");
+        {
+            QFile file(templatePath);
+            QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Text));
+            file.write("{{ chip }}");
+        }
+        QFile::remove(outputDir.filePath("sidecar_out.json"));
+        QFile::remove(outputDir.filePath("sidecar_out.cbor"));
+
+        const auto runWith = [&](const QStringList &extraArguments) {
+            QSocCliWorker socCliWorker;
+            socCliWorker.setup(
+                QStringList{"qsoc", "generate", "template", "-d", projectManager.getCurrentPath()}
+                    + extraArguments + QStringList{"--yaml", yamlFilePath, templatePath},
+                false);
+            socCliWorker.run();
+        };
+
+        /* No data file unless asked for */
+        runWith({});
+        QVERIFY(verifyTemplateContent("sidecar_out.txt", "sidecar_soc"));
+        QVERIFY(!QFile::exists(outputDir.filePath("sidecar_out.json")));
+
+        runWith({"--data-sidecar", "cbor"});
+        QFile sidecar(outputDir.filePath("sidecar_out.cbor"));
+        QVERIFY(sidecar.open(QIODevice::ReadOnly));
+        const QByteArray     data    = sidecar.readAll();
+        const nlohmann::json decoded = nlohmann::json::from_cbor(data.cbegin(), data.cend());
+        QCOMPARE(decoded["chip"].get<std::string>(), std::string("sidecar_soc"));
+        sidecar.remove();
+
+        /* A sidecar that cannot be put in place warns and leaves no partial file */
+        const QString blockedPath = outputDir.filePath("sidecar_out.json");
+        QVERIFY(QDir().mkpath(QDir(blockedPath).filePath("keep")));
+        messageList.clear();
+        runWith({"--data-sidecar", "pretty"});
+        QVERIFY(verifyTemplateContent("sidecar_out.txt", "sidecar_soc"));
+        QVERIFY(!messageList.filter(QRegularExpression("Could not create JSON data file")).empty());
+        QVERIFY(QFileInfo(blockedPath).isDir());
+        QVERIFY(!QFile::exists(blockedPath + ".part"));
+        QDir(blockedPath).removeRecursively();
+
+        /* The warning names the format actually asked for */
+        const QString blockedCbor = outputDir.filePath("sidecar_out.cbor");
+        QVERIFY(QDir().mkpath(QDir(blockedCbor).filePath("keep")));
+        messageList.clear();
+        runWith({"--data-sidecar", "cbor"});
+        QVERIFY(!messageList.filter(QRegularExpression("Could not create CBOR data file")).empty());
+        QVERIFY(messageList.filter(QRegularExpression("JSON data file")).empty());
+        QDir(blockedCbor).removeRecursively();
+
+        messageList.clear();
+        runWith({"--data-sidecar", "xml"});
+        QVERIFY(!messageList.filter(QRegularExpression("Error:.*data sidecar mode")).empty());
+
+        QFile::remove(templatePath);
+    }
+
     void testGenerateTemplateWithFormatFilter()
     {
         messageList.clear();
@@ -0,0 +1,265 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Huang Rui <vowstar@gmail.com>
+
+#include "cli/qsoccliworker.h"
+#include "cli/qsocgeneratewatch.h"
+#include "common/config.h"
+#include "common/qsocconsole.h"
+#include "common/qsocprojectmanager.h"
+#include "qsoc_test.h"
+
+#include <QDir>
+#include <QFile>
+#include <QPair>
+#include <QStringList>
+#include <QTimer>
+#include <QtCore>
+#include <QtTest>
+
+struct TestApp
+{
+    static auto &instance()
+    {
+        static auto                  argc      = 1;
+        static char                  appName[] = "qsoc";
+        static std::array<char *, 1> argv      = {{appName}};
+        /* Use QCoreApplication for cli test */
+        static const QCoreApplication app = QCoreApplication(argc, argv.data());
+        return app;
+    }
+};
+
+/* cpu lives in a library of its own name; uart in a differently named one,
+ * so the watch has to map module -> library to find the file to follow. */
+const QByteArray cpuLibrary = R"(
+cpu:
+  port:
+    clk:
+      type: logic
+      direction: in
+    irq:
+      type: logic
+      direction: out
+)";
+
+const QByteArray cpuLibraryEdited = R"(
+cpu:
+  port:
+    clk:
+      type: logic
+      direction: in
+    irq:
+      type: logic
+      direction: out
+    nmi:
+      type: logic
+      direction: in
+)";
+
+const QByteArray periphLibrary = R"(
+uart:
+  port:
+    clk:
+      type: logic
+      direction: in
+    tx:
+      type: logic
+      direction: out
+)";
+
+const QByteArray periphLibraryEdited = R"(
+uart:
+  port:
+    clk:
+      type: logic
+      direction: in
+    tx:
+      type: logic
+      direction: out
+    rx:
+      type: logic
+      direction: in
+)";
+
+using Edit = QPair<QString, QByteArray>;
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private:
+    static QStringList messageList;
+    QString            projectName;
+    QSocProjectManager projectManager;
+
+    static void messageOutput(QtMsgType type, const QMessageLogContext &context, const QString &msg)
+    {
+        Q_UNUSED(type);
+        Q_UNUSED(context);
+        messageList << msg;
+    }
+
+    static void writeFile(const QString &path, const QByteArray &content)
+    {
+        QFile file(path);
+        if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            file.write(content);
+        }
+    }
+
+    QString modulePath(const QString &fileName) const
+    {
+        return QDir(projectManager.getModulePath()).filePath(fileName);
+    }
+
+    QString outputPath(const QString &fileName) const
+    {
+        return QDir(projectManager.getOutputPath()).filePath(fileName);
+    }
+
+    QString readOutput(const QString &fileName) const
+    {
+        QFile file(outputPath(fileName));
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            return {};
+        }
+        return QString::fromUtf8(file.readAll());
+    }
+
+    /* Run a `--watch` command, make one edit after the initial build and one
+     * more after each rebuild, then stop. Returns the file names of the
+     * targets each rebuild touched. */
+    QList<QStringList> runWatch(const QStringList &appArguments, const QList<Edit> &edits)
+    {
+        QList<QStringList> rebuilds;
+        int                next = 0;
+        QSocCliWorker      socCliWorker;
+        connect(&socCliWorker, &QSocCliWorker::watching, this, [&](QSocGenerateWatch *watch) {
+            watch->setDebounce(100);
+            QTimer::singleShot(20000, watch, &QSocGenerateWatch::stop);
+            const auto editNext = [&, watch]() {
+                if (next >= edits.size()) {
+                    watch->stop();
+                    return;
+                }
+                writeFile(edits.at(next).first, edits.at(next).second);
+                next++;
+            };
+            connect(
+                watch,
+                &QSocGenerateWatch::rebuilt,
+                watch,
+                [&rebuilds, editNext](const QStringList &targets, int) {
+                    QStringList names;
+                    for (const QString &target : targets) {
+                        names.append(QFileInfo(target).fileName());
+                    }
+                    rebuilds.append(names);
+                    editNext();
+                });
+            editNext();
+        });
+        socCliWorker.execute(appArguments);
+        return rebuilds;
+    }
+
+private slots:
+    void initTestCase()
+    {
+        TestApp::instance();
+        /* Re-enable message handler for collecting CLI output */
+        qInstallMessageHandler(messageOutput);
+        QSocConsole::setTeeToMessageHandler(true);
+        /* Set project name */
+        projectName = QFileInfo(__FILE__).baseName() + "_data";
+        /* Setup project manager */
+        projectManager.setProjectName(projectName);
+        projectManager.setCurrentPath(QDir::current().filePath(projectName));
+        projectManager.mkpath();
+        projectManager.save(projectName);
+        projectManager.load(projectName);
+    }
+
+    void init()
+    {
+        writeFile(modulePath("cpu.soc_mod"), cpuLibrary);
+        writeFile(modulePath("periph.soc_mod"), periphLibrary);
+        QFile::remove(modulePath("dsp.soc_mod"));
+    }
+
+    void cleanupTestCase()
+    {
+#ifdef ENABLE_TEST_CLEANUP
+        /* Clean up the test project directory */
+        QDir projectDir(projectManager.getCurrentPath());
+        if (projectDir.exists()) {
+            projectDir.removeRecursively();
+        }
+#endif // ENABLE_TEST_CLEANUP
+    }
+
+    /* Each library edit regenerates only the netlist instantiating one of
+     * its modules, with the new port in the output. */
+    void testVerilogRebuildsNetlistsUsingEditedLibrary()
+    {
+        const QString top = outputPath("watch_top.soc_net");
+        const QString io  = outputPath("watch_io.soc_net");
+        writeFile(top, "instance:\n  u_cpu:\n    module: cpu\n");
+        writeFile(io, "instance:\n  u_uart:\n    module: uart\n");
+        QFile::remove(outputPath("watch_top.v"));
+        QFile::remove(outputPath("watch_io.v"));
+
+        messageList.clear();
+        const QList<QStringList> rebuilds = runWatch(
+            {"qsoc",
+             "generate",
+             "verilog",
+             "-d",
+             projectManager.getCurrentPath(),
+             "--watch",
+             top,
+             io},
+            {{modulePath("periph.soc_mod"), periphLibraryEdited},
+             {modulePath("cpu.soc_mod"), cpuLibraryEdited}});
+
+        QCOMPARE(
+            rebuilds,
+            (QList<QStringList>{
+                {QStringLiteral("watch_io.soc_net")}, {QStringLiteral("watch_top.soc_net")}}));
+        QVERIFY(readOutput("watch_io.v").contains(".rx("));
+        QVERIFY(readOutput("watch_top.v").contains(".nmi("));
+    }
+
+    /* A new library outside the stub's selection rebuilds nothing; an
+     * edit to a selected one regenerates the stub. */
+    void testStubFollowsSelectedLibraryOnly()
+    {
+        QFile::remove(outputPath("watch_stub.v"));
+
+        messageList.clear();
+        const QList<QStringList> rebuilds = runWatch(
+            {"qsoc",
+             "generate",
+             "stub",
+             "-d",
+             projectManager.getCurrentPath(),
+             "-l",
+             "periph",
+             "--watch",
+             "watch_stub"},
+            {{modulePath("dsp.soc_mod"), "dsp:\n  port: {}\n"},
+             {modulePath("periph.soc_mod"), periphLibraryEdited}});
+
+        QCOMPARE(rebuilds, (QList<QStringList>{QStringList(), {QStringLiteral("watch_stub")}}));
+        const QString stub = readOutput("watch_stub.v");
+        QVERIFY(stub.contains("module uart"));
+        QVERIFY(stub.contains("rx"));
+        QVERIFY(!stub.contains("module cpu"));
+    }
+};
+
+QStringList Test::messageList;
+
+QSOC_TEST_MAIN(Test)
+
+#include "test_qsoccliparsegeneratewatch.moc"
@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Huang Rui <vowstar@gmail.com>
+
+#include "common/qsocprofiler.h"
+#include "qsoc_test.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QtTest>
+
+class TestQSocProfiler : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init()
+    {
+        QSocProfiler::setEnabled(false);
+        QSocProfiler::reset();
+    }
+
+    void cleanup()
+    {
+        QSocProfiler::setEnabled(false);
+        QSocProfiler::reset();
+    }
+
+    void disabledRecordsNothing()
+    {
+        {
+            QSocProfiler::Scope scope("idle");
+            scope.setCount(3);
+        }
+        QCOMPARE(QSocProfiler::eventCount(), qsizetype(0));
+    }
+
+    void lazyNameBuiltOnlyWhenEnabled()
+    {
+        int        built    = 0;
+        const auto makeName = [&built] {
+            built++;
+            return QStringLiteral("item[%1]").arg(built);
+        };
+        {
+            const QSocProfiler::Scope scope(makeName, "primitive");
+        }
+        QCOMPARE(built, 0);
+
+        QSocProfiler::setEnabled(true);
+        {
+            const QSocProfiler::Scope scope(makeName, "primitive");
+        }
+        QCOMPARE(built, 1);
+        QVERIFY(QSocProfiler::summary().contains(QStringLiteral("primitive:item[1]")));
+    }
+
+    void finishRecordsOnce()
+    {
+        QSocProfiler::setEnabled(true);
+        {
+            QSocProfiler::Scope scope("phase_a");
+            scope.finish();
+            scope.finish();
+        }
+        QCOMPARE(QSocProfiler::eventCount(), qsizetype(1));
+    }
+
+    void chromeTraceHasEvents()
+    {
+        QSocProfiler::setEnabled(true);
+        {
+            QSocProfiler::Scope outer("outer");
+            {
+                QSocProfiler::Scope inner("inner", "primitive");
+                inner.setCount(7);
+            }
+        }
+        QThread *worker = QThread::create([] { const QSocProfiler::Scope scope("worker"); });
+        worker->start();
+        QVERIFY(worker->wait(5000));
+        delete worker;
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString path = dir.filePath("trace.json");
+        QVERIFY(QSocProfiler::writeChromeTrace(path));
+
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        const QJsonArray events = QJsonDocument::fromJson(file.readAll())
+                                      .object()
+                                      .value("traceEvents")
+                                      .toArray();
+        QCOMPARE(events.size(), qsizetype(3));
+
+        /* Inner closes first; outer must span it */
+        const QJsonObject inner = events.at(0).toObject();
+        const QJsonObject outer = events.at(1).toObject();
+        QCOMPARE(inner.value("name").toString(), QString("inner"));
+        QCOMPARE(inner.value("cat").toString(), QString("primitive"));
+        QCOMPARE(inner.value("ph").toString(), QString("X"));
+        QCOMPARE(inner.value("args").toObject().value("count").toInt(), 7);
+        QCOMPARE(outer.value("name").toString(), QString("outer"));
+        QVERIFY(outer.value("args").toObject().contains("cpu_us"));
+        QVERIFY(!outer.value("args").toObject().contains("count"));
+        const auto micros = [](const QJsonObject &event, const char *key) {
+            return event.value(key).toVariant().toLongLong();
+        };
+        QVERIFY(micros(outer, "ts") <= micros(inner, "ts"));
+        QVERIFY(
+            micros(outer, "ts") + micros(outer, "dur")
+            >= micros(inner, "ts") + micros(inner, "dur"));
+
+        /* Worker thread gets its own track */
+        const QJsonObject workerEvent = events.at(2).toObject();
+        QCOMPARE(workerEvent.value("name").toString(), QString("worker"));
+        QVERIFY(workerEvent.value("tid").toInt() != outer.value("tid").toInt());
+    }
+
+    void summaryAggregatesByName()
+    {
+        QSocProfiler::setEnabled(true);
+        for (int i = 0; i < 3; ++i) {
+            QSocProfiler::Scope scope("repeat");
+            scope.setCount(2);
+        }
+
+        const QStringList lines = QSocProfiler::summary().split('\n', Qt::SkipEmptyParts);
+        QCOMPARE(lines.size(), qsizetype(2));
+        QVERIFY(lines.at(0).startsWith("phase"));
+        const QStringList columns = lines.at(1).split(' ', Qt::SkipEmptyParts);
+        QCOMPARE(columns.first(), QString("phase:repeat"));
+        QCOMPARE(columns.at(1), QString("3"));
+        QCOMPARE(columns.last(), QString("6"));
+    }
+};
+
+QSOC_TEST_MAIN(TestQSocProfiler)
+
+#include "test_qsoccommonqsocprofiler.moc"
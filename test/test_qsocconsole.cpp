@@ -4,6 +4,8 @@
 #include "common/qsocconsole.h"
 #include "qsoc_test.h"
 
+#include <QBuffer>
+#include <QThread>
 #include <QtTest>
 
 #ifndef Q_OS_WIN
@@ -128,6 +130,80 @@ private slots:
         QSocConsole::setLevel(QSocConsole::Level::Error);
         QCOMPARE(QSocConsole::level(), QSocConsole::Level::Error);
     }
+
+    /* Gated macros skip operand evaluation when the level is off. */
+    void gatedMacrosSkipFilteredOperands()
+    {
+        QSocConsole::setColorMode(QSocConsole::ColorMode::Never);
+        QBuffer sink;
+        sink.open(QIODevice::WriteOnly);
+        QSocConsole::setErrorDevice(&sink);
+
+        int        evaluated = 0;
+        const auto operand   = [&evaluated]() {
+            ++evaluated;
+            return QStringLiteral("payload");
+        };
+
+        QSocConsole::setLevel(QSocConsole::Level::Info);
+        QVERIFY(QSocConsole::isEnabled(QSocConsole::Level::Info));
+        QVERIFY(!QSocConsole::isEnabled(QSocConsole::Level::Debug));
+        QVERIFY(!QSocConsole::isEnabled(QSocConsole::Level::Silent));
+        QSOC_DEBUG() << operand();
+        QSOC_DEBUG_PLAIN() << operand();
+        QCOMPARE(evaluated, 0);
+        QSOC_INFO() << operand();
+        QCOMPARE(evaluated, 1);
+
+        QSocConsole::setLevel(QSocConsole::Level::Debug);
+        QSOC_DEBUG_PLAIN() << operand();
+#ifdef QSOC_STRIP_DEBUG_LOG
+        QCOMPARE(evaluated, 1);
+#else
+        QCOMPARE(evaluated, 2);
+#endif
+
+        QSocConsole::setErrorDevice(nullptr);
+        QSocConsole::setLevel(QSocConsole::Level::Info);
+#ifdef QSOC_STRIP_DEBUG_LOG
+        QCOMPARE(QString::fromUtf8(sink.data()), QStringLiteral("info: payload\n"));
+#else
+        QCOMPARE(QString::fromUtf8(sink.data()), QStringLiteral("info: payload\npayload\n"));
+#endif
+    }
+
+    /* Output written under a CaptureScope on a worker thread stays off the
+       shared stream until replay(), then appears in its original order. */
+    void captureReplaysInOrder()
+    {
+        QSocConsole::setLevel(QSocConsole::Level::Info);
+        QSocConsole::setColorMode(QSocConsole::ColorMode::Never);
+        QBuffer sink;
+        sink.open(QIODevice::WriteOnly);
+        QSocConsole::setErrorDevice(&sink);
+
+        QSocConsole::Capture capture;
+        QThread *worker = QThread::create([&capture]() {
+            const QSocConsole::CaptureScope scope(capture);
+            QSocConsole::warn() << "first";
+            QSocConsole::err() << "second" << "\n";
+            QSocConsole::debug() << "filtered";
+            QSocConsole::info() << "third";
+        });
+        worker->start();
+        QVERIFY(worker->wait(5000));
+        delete worker;
+
+        QVERIFY(sink.data().isEmpty());
+        QVERIFY(!capture.isEmpty());
+
+        capture.replay();
+        QSocConsole::setErrorDevice(nullptr);
+
+        QCOMPARE(
+            QString::fromUtf8(sink.data()),
+            QStringLiteral("warning: first\nsecond\ninfo: third\n"));
+    }
 };
 
 QSOC_TEST_MAIN(Test)
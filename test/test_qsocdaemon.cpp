@@ -0,0 +1,222 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Huang Rui <vowstar@gmail.com>
+
+#include "cli/qsocdaemon.h"
+#include "common/qsocyamlfilecache.h"
+#include "qsoc_test.h"
+
+#include <QLocalSocket>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QtCore>
+#include <QtTest>
+
+#ifndef Q_OS_WIN
+#include <unistd.h>
+#endif
+
+namespace {
+
+struct TestApp
+{
+    static auto &instance()
+    {
+        static auto                   argc      = 1;
+        static char                   appName[] = "qsoc";
+        static std::array<char *, 1>  argv      = {{appName}};
+        static const QCoreApplication app       = QCoreApplication(argc, argv.data());
+        return app;
+    }
+};
+
+struct Reply
+{
+    QByteArray out;
+    QByteArray err;
+    int        exitCode = -1;
+};
+
+/* Client side of one call, driven by the test event loop so the daemon
+ * living on the same thread can answer. */
+Reply call(const QString &serverName, const QByteArray &request)
+{
+    Reply        reply;
+    QByteArray   buffer;
+    QLocalSocket socket;
+    QObject::connect(&socket, &QLocalSocket::readyRead, [&]() {
+        buffer.append(socket.readAll());
+        char       kind = 0;
+        QByteArray payload;
+        while (QSocDaemon::takeFrame(&buffer, &kind, &payload)) {
+            if (kind == 'O') {
+                reply.out += payload;
+            } else if (kind == 'E') {
+                reply.err += payload;
+            } else if (kind == 'X') {
+                reply.exitCode = payload.toInt();
+            }
+        }
+    });
+    socket.connectToServer(serverName);
+    socket.write(QSocDaemon::encodeFrame('R', request));
+    socket.flush();
+    QTest::qWaitFor([&]() { return reply.exitCode >= 0; }, 10000);
+    return reply;
+}
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private:
+    QString serverName;
+
+private slots:
+    void initTestCase()
+    {
+        TestApp::instance();
+        serverName = QSocDaemon::serverPath(
+            QStringLiteral("qsoc-test-daemon-%1").arg(QCoreApplication::applicationPid()));
+    }
+
+    void testFramesSplitAndJoin()
+    {
+        QByteArray wire = QSocDaemon::encodeFrame('O', "hello")
+                          + QSocDaemon::encodeFrame('X', "3");
+        QByteArray buffer = wire.left(7);
+        char       kind   = 0;
+        QByteArray payload;
+        QVERIFY(!QSocDaemon::takeFrame(&buffer, &kind, &payload));
+        buffer += wire.mid(7);
+        QVERIFY(QSocDaemon::takeFrame(&buffer, &kind, &payload));
+        QCOMPARE(kind, 'O');
+        QCOMPARE(payload, QByteArray("hello"));
+        QVERIFY(QSocDaemon::takeFrame(&buffer, &kind, &payload));
+        QCOMPARE(kind, 'X');
+        QCOMPARE(payload, QByteArray("3"));
+        QVERIFY(buffer.isEmpty());
+    }
+
+    /* Unchanged files come from the cache; a rewrite is parsed again. */
+    void testYamlCacheFollowsFileChanges()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString path = dir.filePath(QStringLiteral("lib.soc_mod"));
+        QFile         file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("top:\n  port: 1\n");
+        file.close();
+
+        QSocYamlFileCache cache;
+        YAML::Node        first = cache.load(path);
+        first["top"]["port"]    = 5;
+        const YAML::Node second = cache.load(path);
+        QCOMPARE(second["top"]["port"].as<int>(), 1);
+        QCOMPARE(cache.stats().hits, qint64(1));
+
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write("top:\n  port: 22\n");
+        file.close();
+        QCOMPARE(cache.load(path)["top"]["port"].as<int>(), 22);
+        QCOMPARE(cache.stats().misses, qint64(2));
+    }
+
+    void testServesCallInClientDirectory()
+    {
+        QSocDaemon daemon;
+        QString    err;
+        QVERIFY2(daemon.listen(serverName, &err), qPrintable(err));
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QByteArray request = QStringLiteral(R"({"argv":["qsoc","--version"],"cwd":"%1"})")
+                                       .arg(dir.path())
+                                       .toUtf8();
+        const Reply reply = call(serverName, request);
+        QCOMPARE(reply.exitCode, 0);
+        QVERIFY(reply.out.contains("QSoC"));
+    }
+
+    /* A call runs under the client environment: a resident built for one
+     * XDG_CONFIG_HOME is replaced when the next call brings another, and
+     * the daemon's own environment is back once the call is done. */
+    void testCallRunsUnderClientEnvironment()
+    {
+        QSocDaemon daemon;
+        QVERIFY(daemon.listen(serverName));
+
+        QTemporaryDir dir;
+        QTemporaryDir configA;
+        QTemporaryDir configB;
+        QVERIFY(dir.isValid() && configA.isValid() && configB.isValid());
+        const QByteArray before  = qgetenv("XDG_CONFIG_HOME");
+        const auto       request = [&dir](const QString &configHome) {
+            QStringList env = QProcessEnvironment::systemEnvironment().toStringList();
+            env << QStringLiteral("XDG_CONFIG_HOME=%1").arg(configHome);
+            const QJsonObject message{
+                {"argv", QJsonArray{"qsoc", "--version"}},
+                {"cwd", dir.path()},
+                {"env", QJsonArray::fromStringList(env)}};
+            return QJsonDocument(message).toJson(QJsonDocument::Compact);
+        };
+
+        QCOMPARE(call(serverName, request(configA.path())).exitCode, 0);
+        QVERIFY(QFile::exists(configA.filePath(QStringLiteral("qsoc/qsoc.yml"))));
+        QCOMPARE(call(serverName, request(configB.path())).exitCode, 0);
+        QVERIFY(QFile::exists(configB.filePath(QStringLiteral("qsoc/qsoc.yml"))));
+        QCOMPARE(qgetenv("XDG_CONFIG_HOME"), before);
+    }
+
+    /* Bare names land in a per-user directory nobody else can enter. */
+    void testSocketDirectoryIsPrivate()
+    {
+#ifdef Q_OS_WIN
+        QSKIP("named pipes have no socket directory");
+#else
+        QSocDaemon daemon;
+        QString    err;
+        QVERIFY2(daemon.listen(serverName, &err), qPrintable(err));
+
+        const QFileInfo socketDir(QFileInfo(serverName).absolutePath());
+        QVERIFY(socketDir.isDir());
+        QVERIFY(!socketDir.isSymLink());
+        QCOMPARE(socketDir.ownerId(), static_cast<uint>(getuid()));
+        const QFileDevice::Permissions shared
+            = QFileDevice::ReadGroup | QFileDevice::WriteGroup | QFileDevice::ExeGroup
+              | QFileDevice::ReadOther | QFileDevice::WriteOther | QFileDevice::ExeOther;
+        QCOMPARE(socketDir.permissions() & shared, QFileDevice::Permissions());
+        QCOMPARE(QSocDaemon::serverPath(serverName), serverName);
+#endif
+    }
+
+    void testRejectsInteractiveCommands()
+    {
+        QSocDaemon daemon;
+        QVERIFY(daemon.listen(serverName));
+
+        const Reply reply = call(
+            serverName,
+            QStringLiteral(R"({"argv":["qsoc","agent"],"cwd":"%1"})")
+                .arg(QDir::currentPath())
+                .toUtf8());
+        QCOMPARE(reply.exitCode, 1);
+        QVERIFY(reply.err.contains("locally"));
+    }
+
+    void testStopRequestFinishes()
+    {
+        QSocDaemon daemon;
+        QVERIFY(daemon.listen(serverName));
+        QSignalSpy finished(&daemon, &QSocDaemon::finished);
+
+        const Reply reply = call(serverName, QByteArray(R"({"stop":true})"));
+        QCOMPARE(reply.exitCode, 0);
+        QCOMPARE(finished.count(), 1);
+    }
+};
+
+} // namespace
+
+QSOC_TEST_MAIN(Test)
+#include "test_qsocdaemon.moc"
@@ -9,6 +9,7 @@
 #include <nlohmann/json.hpp>
 #include <QDir>
 #include <QFile>
+#include <QRandomGenerator>
 #include <QTemporaryDir>
 #include <QTextStream>
 #include <QtCore>
@@ -506,6 +507,161 @@ private slots:
         history.applySnapshot(0);
         QVERIFY(!store.contains(rpath)); /* deleted via accessor.remove */
     }
+
+    /* An accessor that can stat lets unchanged files skip the read; files
+     * whose mtime is too close to the capture are re-read regardless. */
+    void testStatGateSkipsUnchangedFiles()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        QSocFileHistory history(tempDir.path(), QStringLiteral("stat-gate"));
+
+        QHash<QString, QString>                   store;
+        QHash<QString, QSocFileHistory::FileStat> stats;
+        int                                       reads = 0;
+        QSocFileHistory::LiveFileAccessor         acc;
+        acc.exists = [&store](const QString &path) { return store.contains(path); };
+        acc.read   = [&store, &reads](const QString &path) -> std::optional<QString> {
+            reads++;
+            if (!store.contains(path)) {
+                return std::nullopt;
+            }
+            return store.value(path);
+        };
+        acc.stat = [&stats](const QString &path) -> std::optional<QSocFileHistory::FileStat> {
+            if (!stats.contains(path)) {
+                return std::nullopt;
+            }
+            return stats.value(path);
+        };
+        acc.localClock = true;
+        history.setLiveAccessor(acc);
+
+        const QString rpath = QStringLiteral("/vfs/remote/gate.txt");
+        history.trackEdit(rpath, true, QStringLiteral("v0"));
+        store.insert(rpath, QStringLiteral("v1"));
+        stats.insert(rpath, {2, 1000});
+        QVERIFY(history.makeSnapshot(1));
+        QCOMPARE(reads, 1);
+
+        QVERIFY(history.makeSnapshot(2));
+        QCOMPARE(reads, 1);
+        QCOMPARE(history.contentAt(rpath, 2), QStringLiteral("v1"));
+
+        store.insert(rpath, QStringLiteral("v22"));
+        stats.insert(rpath, {3, 5000});
+        QVERIFY(history.makeSnapshot(3));
+        QCOMPARE(reads, 2);
+        QCOMPARE(history.contentAt(rpath, 3), QStringLiteral("v22"));
+
+        /* Same size and mtime but captured within the racy window */
+        store.insert(rpath, QStringLiteral("v33"));
+        stats.insert(rpath, {3, QDateTime::currentMSecsSinceEpoch()});
+        QVERIFY(history.makeSnapshot(4));
+        QVERIFY(history.makeSnapshot(5));
+        QCOMPARE(reads, 4);
+        QCOMPARE(history.contentAt(rpath, 5), QStringLiteral("v33"));
+    }
+
+    /* A remote mtime says nothing about the local clock: an hour-old stamp
+     * from a skewed host is re-read until a window has passed since the
+     * stat was first seen. */
+    void testStatGateRemoteClockSkew()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        QSocFileHistory history(tempDir.path(), QStringLiteral("stat-skew"));
+
+        QHash<QString, QString>           store;
+        QSocFileHistory::FileStat         remoteStat;
+        int                               reads = 0;
+        QSocFileHistory::LiveFileAccessor acc;
+        acc.exists = [&store](const QString &path) { return store.contains(path); };
+        acc.read   = [&store, &reads](const QString &path) -> std::optional<QString> {
+            reads++;
+            return store.value(path);
+        };
+        acc.stat = [&remoteStat](const QString &) -> std::optional<QSocFileHistory::FileStat> {
+            return remoteStat;
+        };
+        history.setLiveAccessor(acc);
+
+        const QString rpath = QStringLiteral("/vfs/remote/skew.txt");
+        remoteStat          = {2, QDateTime::currentMSecsSinceEpoch() - 3600 * 1000};
+        history.trackEdit(rpath, true, QStringLiteral("v0"));
+        store.insert(rpath, QStringLiteral("v1"));
+        QVERIFY(history.makeSnapshot(1));
+        QCOMPARE(reads, 1);
+
+        /* Same-second rewrite on the remote host keeps size and mtime */
+        store.insert(rpath, QStringLiteral("v2"));
+        QVERIFY(history.makeSnapshot(2));
+        QCOMPARE(reads, 2);
+        QCOMPARE(history.contentAt(rpath, 2), QStringLiteral("v2"));
+
+        /* One read after the window settles the capture */
+        QTest::qWait(2100);
+        QVERIFY(history.makeSnapshot(3));
+        QVERIFY(history.makeSnapshot(4));
+        QCOMPARE(reads, 3);
+        QCOMPARE(history.contentAt(rpath, 4), QStringLiteral("v2"));
+    }
+
+    /* Small edits to a large file store deltas; every version must still
+     * round-trip, across chain resets and after truncation. */
+    void testDeltaBlobsRoundTrip()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        QRandomGenerator random(63);
+        QStringList      lines;
+        for (int index = 0; index < 400; index++) {
+            lines.append(QString::number(random.generate64(), 36));
+        }
+        const QString fpath = writeFile(tempDir.filePath("big.txt"), lines.join(QLatin1Char('\n')));
+
+        QSocFileHistory history(tempDir.path(), QStringLiteral("delta"));
+        history.trackEdit(fpath, true, lines.join(QLatin1Char('\n')));
+        QStringList versions = {lines.join(QLatin1Char('\n'))};
+        for (int turn = 1; turn <= QSocFileHistory::MAX_DELTA_CHAIN + 3; turn++) {
+            const int pick = random.bounded(static_cast<int>(lines.size()));
+            lines[pick]    = QStringLiteral("turn %1").arg(turn);
+            versions.append(lines.join(QLatin1Char('\n')));
+            writeFile(fpath, versions.last());
+            QVERIFY(history.makeSnapshot(turn));
+        }
+
+        const qint64 fullSize
+            = QFileInfo(history.backupPathFor(QSocFileHistory::sha256Hex(versions.first()))).size();
+        const qint64 deltaSize
+            = QFileInfo(history.backupPathFor(QSocFileHistory::sha256Hex(versions.at(1)))).size();
+        QVERIFY(deltaSize > 0);
+        QVERIFY(deltaSize * 4 < fullSize);
+
+        for (int turn = 0; turn < versions.size(); turn++) {
+            QCOMPARE(history.contentAt(fpath, turn), versions.at(turn));
+        }
+        history.truncateAfter(3);
+        for (int turn = 0; turn <= 3; turn++) {
+            QCOMPARE(history.contentAt(fpath, turn), versions.at(turn));
+        }
+    }
+
+    /* Blobs written before compression existed are plain UTF-8 files. */
+    void testLegacyRawBlobStillReadable()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        const QString fpath = writeFile(tempDir.filePath("a.txt"), "legacy");
+
+        QSocFileHistory history(tempDir.path(), QStringLiteral("legacy"));
+        const QString   sha = QSocFileHistory::sha256Hex(QStringLiteral("legacy"));
+        writeFile(history.backupPathFor(sha), QStringLiteral("legacy"));
+        history.trackEdit(fpath, true, QStringLiteral("legacy"));
+
+        QCOMPARE(readFile(history.backupPathFor(sha)), QStringLiteral("legacy"));
+        QCOMPARE(history.contentAt(fpath, 0), QStringLiteral("legacy"));
+    }
 };
 
 QSOC_TEST_MAIN(Test)
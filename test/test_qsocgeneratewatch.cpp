@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Huang Rui <vowstar@gmail.com>
+
+#include "cli/qsocgeneratewatch.h"
+#include "qsoc_test.h"
+
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QtCore>
+#include <QtTest>
+
+namespace {
+
+struct TestApp
+{
+    static auto &instance()
+    {
+        static auto                   argc      = 1;
+        static char                   appName[] = "qsoc";
+        static std::array<char *, 1>  argv      = {{appName}};
+        static const QCoreApplication app       = QCoreApplication(argc, argv.data());
+        return app;
+    }
+};
+
+void writeFile(const QString &path, const QByteArray &content)
+{
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write(content);
+}
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase() { TestApp::instance(); }
+
+    /* Only targets listing a changed file are rebuilt, in target order. */
+    void testApplyRebuildsDependentsOnly()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString shared = dir.filePath(QStringLiteral("shared.soc_mod"));
+        const QString top    = dir.filePath(QStringLiteral("top.soc_net"));
+        const QString peri   = dir.filePath(QStringLiteral("peri.soc_net"));
+
+        QSocGenerateWatch watch;
+        QStringList       built;
+        watch.setBuilder([&](const QString &target) {
+            built.append(target);
+            return true;
+        });
+        watch.setInputs(QStringLiteral("top"), {top, shared});
+        watch.setInputs(QStringLiteral("peri"), {peri, shared});
+
+        QCOMPARE(watch.apply({peri}), QStringList{QStringLiteral("peri")});
+        QCOMPARE(
+            watch.apply({shared}), (QStringList{QStringLiteral("top"), QStringLiteral("peri")}));
+        QCOMPARE(watch.apply({dir.filePath(QStringLiteral("other.v"))}), QStringList());
+        QCOMPARE(built.size(), 3);
+    }
+
+    /* The reloader can pull in targets that do not list the path. */
+    void testReloaderNamesExtraTargets()
+    {
+        QSocGenerateWatch watch;
+        QStringList       reloaded;
+        watch.setInputs(QStringLiteral("a"), {QStringLiteral("/tmp/a.soc_net")});
+        watch.setInputs(QStringLiteral("b"), {QStringLiteral("/tmp/b.soc_net")});
+        watch.setReloader([&](const QString &path) {
+            reloaded.append(path);
+            return QStringList{QStringLiteral("b"), QStringLiteral("unknown")};
+        });
+        int failures = -1;
+        connect(&watch, &QSocGenerateWatch::rebuilt, this, [&](const QStringList &, int failed) {
+            failures = failed;
+        });
+        watch.setBuilder([](const QString &) { return false; });
+
+        QCOMPARE(
+            watch.apply({QStringLiteral("/tmp/new.soc_mod")}), QStringList{QStringLiteral("b")});
+        QCOMPARE(reloaded, QStringList{QStringLiteral("/tmp/new.soc_mod")});
+        QCOMPARE(failures, 1);
+    }
+
+    /* A burst of writes to one input turns into a single rebuild. */
+    void testSaveBurstIsDebounced()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString netlist = dir.filePath(QStringLiteral("top.soc_net"));
+        const QString other   = dir.filePath(QStringLiteral("peri.soc_net"));
+        writeFile(netlist, "instance: {}\n");
+        writeFile(other, "instance: {}\n");
+
+        QSocGenerateWatch watch;
+        watch.setDebounce(100);
+        watch.setInputs(QStringLiteral("top"), {netlist});
+        watch.setInputs(QStringLiteral("peri"), {other});
+        watch.setBuilder([](const QString &) { return true; });
+        QSignalSpy rebuilt(&watch, &QSocGenerateWatch::rebuilt);
+
+        writeFile(netlist, "instance: {u0: {module: a}}\n");
+        writeFile(netlist, "instance: {u0: {module: b}}\n");
+        QTRY_COMPARE_WITH_TIMEOUT(rebuilt.count(), 1, 5000);
+        QTest::qWait(300);
+        QCOMPARE(rebuilt.count(), 1);
+        QCOMPARE(rebuilt.first().first().toStringList(), QStringList{QStringLiteral("top")});
+    }
+
+    /* Files appearing in a watched directory reach the reloader. */
+    void testDirectoryReportsNewLibrary()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        writeFile(dir.filePath(QStringLiteral("base.soc_mod")), "a: {}\n");
+
+        QSocGenerateWatch watch;
+        watch.setDebounce(50);
+        watch.watchDirectory(dir.path(), {QStringLiteral("*.soc_mod")});
+        QStringList reloaded;
+        watch.setReloader([&](const QString &path) {
+            reloaded.append(QFileInfo(path).fileName());
+            return QStringList();
+        });
+
+        writeFile(dir.filePath(QStringLiteral("notes.txt")), "ignored\n");
+        writeFile(dir.filePath(QStringLiteral("extra.soc_mod")), "b: {}\n");
+        QTRY_COMPARE_WITH_TIMEOUT(reloaded, QStringList{QStringLiteral("extra.soc_mod")}, 5000);
+    }
+};
+
+} // namespace
+
+QSOC_TEST_MAIN(Test)
+#include "test_qsocgeneratewatch.moc"
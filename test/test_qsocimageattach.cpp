@@ -137,6 +137,31 @@ private slots:
         QCOMPARE(QString::fromLatin1(out.format), QStringLiteral("JPEG"));
     }
 
+    /* The ladder runs concurrently but must pick the same rung a serial
+     * walk would: with a budget between the q65 and q50 sizes, q50 wins
+     * even though q40 also fits and may finish first. */
+    void compressParallelLadderKeepsBestFittingRung()
+    {
+        const QImage src     = gradient(512, 512);
+        const auto   encoded = [&src](int quality) {
+            QBuffer buf;
+            buf.open(QIODevice::WriteOnly);
+            src.save(&buf, "JPEG", quality);
+            return buf.data();
+        };
+        const QByteArray q65 = encoded(65);
+        const QByteArray q50 = encoded(50);
+        QVERIFY(q50.size() < q65.size());
+
+        const int  target = static_cast<int>((q65.size() + q50.size()) / 2);
+        const auto out
+            = QSocImageAttach::compressWithinBudget(src, QStringLiteral("image/jpeg"), target);
+        QCOMPARE(out.finalQuality, 50);
+        QCOMPARE(out.data, q50);
+        QCOMPARE(QString::fromLatin1(out.format), QStringLiteral("JPEG"));
+        QVERIFY(out.downgraded);
+    }
+
     void compressFallsBackToDimensionHalvingForBrutalBudget()
     {
         const QImage src    = gradient(1024, 1024);
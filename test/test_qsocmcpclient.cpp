@@ -42,6 +42,17 @@ bool waitForState(const QSocMcpClient *client, QSocMcpClient::State target, int
     return true;
 }
 
+QList<int> sentRequestIds(const QsocMcpFakeTransport *transport, const char *method)
+{
+    QList<int> ids;
+    for (const auto &message : transport->sent()) {
+        if (message.contains("id") && message.value("method", std::string()) == method) {
+            ids.append(message["id"].get<int>());
+        }
+    }
+    return ids;
+}
+
 bool waitForSignal(QSignalSpy &spy, int minCount, int timeoutMs = 2000)
 {
     QElapsedTimer timer;
@@ -1864,6 +1875,114 @@ private slots:
         QCOMPARE(client.state(), QSocMcpClient::State::Ready);
     }
 
+    void requestsBeyondLimitWaitForSlot()
+    {
+        McpServerConfig cfg       = basicConfig();
+        cfg.maxConcurrentRequests = 2;
+        auto         *transport   = new QsocMcpFakeTransport;
+        QSocMcpClient client(cfg, transport);
+        QSignalSpy    responseSpy(&client, &QSocMcpClient::responseReceived);
+        client.start();
+
+        nlohmann::json initResponse;
+        initResponse["jsonrpc"]                = "2.0";
+        initResponse["id"]                     = transport->firstSentId();
+        initResponse["result"]["capabilities"] = nlohmann::json::object();
+        transport->simulateMessage(initResponse);
+        QCOMPARE(client.state(), QSocMcpClient::State::Ready);
+
+        const int first  = client.request(QStringLiteral("work"));
+        const int second = client.request(QStringLiteral("work"));
+        const int third  = client.request(QStringLiteral("work"));
+        QVERIFY(third > second);
+        QCOMPARE(sentRequestIds(transport, "work"), (QList<int>{first, second}));
+
+        /* A response for a request the server never saw is not accepted */
+        nlohmann::json response;
+        response["jsonrpc"] = "2.0";
+        response["id"]      = third;
+        response["result"]  = {"early"};
+        transport->simulateMessage(response);
+        QCOMPARE(responseSpy.size(), 0);
+
+        response["id"]     = second;
+        response["result"] = {"ok"};
+        transport->simulateMessage(response);
+        QCOMPARE(responseSpy.size(), 1);
+        QCoreApplication::processEvents();
+        QCOMPARE(sentRequestIds(transport, "work"), (QList<int>{first, second, third}));
+        client.stop();
+    }
+
+    void requestIssuedOnCompletionWaitsBehindQueue()
+    {
+        McpServerConfig cfg       = basicConfig();
+        cfg.maxConcurrentRequests = 1;
+        auto         *transport   = new QsocMcpFakeTransport;
+        QSocMcpClient client(cfg, transport);
+        client.start();
+
+        nlohmann::json initResponse;
+        initResponse["jsonrpc"]                = "2.0";
+        initResponse["id"]                     = transport->firstSentId();
+        initResponse["result"]["capabilities"] = nlohmann::json::object();
+        transport->simulateMessage(initResponse);
+        QCOMPARE(client.state(), QSocMcpClient::State::Ready);
+
+        const int first  = client.request(QStringLiteral("work"));
+        const int second = client.request(QStringLiteral("work"));
+        int       third  = -1;
+        connect(&client, &QSocMcpClient::responseReceived, &client, [&](int id) {
+            if (id == first) {
+                third = client.request(QStringLiteral("work"));
+            }
+        });
+
+        nlohmann::json response;
+        response["jsonrpc"] = "2.0";
+        response["id"]      = first;
+        response["result"]  = {"ok"};
+        transport->simulateMessage(response);
+        QVERIFY(third > second);
+        QCoreApplication::processEvents();
+        QCOMPARE(sentRequestIds(transport, "work"), (QList<int>{first, second}));
+
+        response["id"] = second;
+        transport->simulateMessage(response);
+        QCoreApplication::processEvents();
+        QCOMPARE(sentRequestIds(transport, "work"), (QList<int>{first, second, third}));
+        client.stop();
+    }
+
+    void queuedRequestTimesOutWithoutCancellation()
+    {
+        McpServerConfig cfg       = basicConfig();
+        cfg.maxConcurrentRequests = 1;
+        auto         *transport   = new QsocMcpFakeTransport;
+        QSocMcpClient client(cfg, transport);
+        QSignalSpy    failureSpy(&client, &QSocMcpClient::requestFailed);
+        client.start();
+
+        nlohmann::json initResponse;
+        initResponse["jsonrpc"]                = "2.0";
+        initResponse["id"]                     = transport->firstSentId();
+        initResponse["result"]["capabilities"] = nlohmann::json::object();
+        transport->simulateMessage(initResponse);
+
+        const int sent   = client.request(QStringLiteral("slow"));
+        const int queued = client.request(QStringLiteral("slow"), nlohmann::json::object(), 20);
+        QVERIFY(waitForSignal(failureSpy, 1));
+        QCOMPARE(failureSpy.first().at(0).toInt(), queued);
+
+        /* Never written, so neither abandoned on the wire nor cancelled */
+        QCOMPARE(sentRequestIds(transport, "slow"), QList<int>{sent});
+        QVERIFY(!transport->abandonedRequestIds().contains(queued));
+        for (const auto &message : transport->sent()) {
+            QVERIFY(message.value("method", std::string()) != "notifications/cancelled");
+        }
+        client.stop();
+    }
+
     void reentrantStopFailsPendingOnce()
     {
         auto         *transport = new QsocMcpFakeTransport;
@@ -71,7 +71,11 @@ private slots:
             "  url: http://127.0.0.1:8080/mcp\n"
             "  headers:\n"
             "    X-Test-Mode: local\n"
-            "  request_timeout_ms: 5000\n");
+            "  request_timeout_ms: 5000\n"
+            "  max_concurrent_requests: 2\n"
+            "  result_cache:\n"
+            "    ttl_seconds: 30\n"
+            "    tools: [spec_search]\n");
 
         const auto list = McpServerConfig::parseList(node);
         QCOMPARE(list.size(), qsizetype(1));
@@ -81,9 +85,30 @@ private slots:
         QCOMPARE(cfg.url, QStringLiteral("http://127.0.0.1:8080/mcp"));
         QCOMPARE(cfg.headers.value("X-Test-Mode"), QStringLiteral("local"));
         QCOMPARE(cfg.requestTimeoutMs, 5000);
+        QCOMPARE(cfg.maxConcurrentRequests, 2);
+        QCOMPARE(cfg.resultCacheTtlMs, 30000);
+        QCOMPARE(cfg.resultCacheMaxEntries, 128);
+        QVERIFY(cfg.cachesTool(QStringLiteral("spec_search"), false, false));
+        QVERIFY(!cfg.cachesTool(QStringLiteral("write_reg"), true, true));
         QVERIFY(cfg.isValid());
     }
 
+    void resultCacheDefaultNeedsReadOnlyAndIdempotent()
+    {
+        const YAML::Node node = loadYaml(
+            "- name: hinted\n"
+            "  command: /bin/echo\n"
+            "  result_cache:\n"
+            "    ttl_seconds: 30\n");
+
+        const auto list = McpServerConfig::parseList(node);
+        QCOMPARE(list.size(), qsizetype(1));
+        const auto &cfg = list.at(0);
+        QVERIFY(cfg.cachesTool(QStringLiteral("lookup"), true, true));
+        QVERIFY(!cfg.cachesTool(QStringLiteral("clock"), true, false));
+        QVERIFY(!cfg.cachesTool(QStringLiteral("upsert"), false, true));
+    }
+
     void typeDefaultsToStdio()
     {
         const YAML::Node node = loadYaml(
@@ -94,6 +119,8 @@ private slots:
         QCOMPARE(list.size(), qsizetype(1));
         QCOMPARE(list.at(0).type, QStringLiteral("stdio"));
         QCOMPARE(list.at(0).stdioFraming, McpStdioFraming::ContentLength);
+        QCOMPARE(list.at(0).maxConcurrentRequests, 0);
+        QVERIFY(!list.at(0).cachesTool(QStringLiteral("anything"), true, true));
     }
 
     void parsesExplicitLegacyFraming()
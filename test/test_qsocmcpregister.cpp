@@ -3,6 +3,7 @@
 
 #include "agent/mcp/qsocmcpclient.h"
 #include "agent/mcp/qsocmcpmanager.h"
+#include "agent/mcp/qsocmcpresultcache.h"
 #include "agent/mcp/qsocmcptool.h"
 #include "agent/mcp/qsocmcptransport.h"
 #include "agent/mcp/qsocmcptypes.h"
@@ -11,6 +12,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <memory>
 #include <nlohmann/json.hpp>
 #include <utility>
 
@@ -302,6 +304,68 @@ private slots:
         QVERIFY(transport->cancelledRequestIds().isEmpty());
     }
 
+    void cachedToolSkipsRepeatedRoundTrip()
+    {
+        auto         *transport = new FakeTransport;
+        QSocMcpClient client(makeConfig("svr"), transport);
+        QVERIFY(driveClientToReady(&client, transport));
+
+        int calls = 0;
+        transport->setSendHook([transport, &calls](const nlohmann::json &message) {
+            if (message.value("method", std::string()) != "tools/call") {
+                return;
+            }
+            const bool fail = message["params"]["arguments"].contains("fail");
+            nlohmann::json result;
+            result["content"] = nlohmann::json::array(
+                {{{"type", "text"}, {"text", QString("reply %1").arg(++calls).toStdString()}}});
+            result["isError"] = fail;
+            replyToolResult(transport, message["id"].get<int>(), result);
+        });
+
+        McpToolDescriptor desc;
+        desc.serverName = "svr";
+        desc.toolName   = "lookup";
+        QSocMcpTool tool(&client, desc);
+        const auto  cache = std::make_shared<QSocMcpResultCache>(60000, 8);
+        tool.setResultCache(cache);
+
+        /* Argument order does not change the key */
+        QCOMPARE(tool.execute({{"reg", "CTRL"}, {"block", "uart0"}}), QStringLiteral("reply 1"));
+        QCOMPARE(tool.execute({{"block", "uart0"}, {"reg", "CTRL"}}), QStringLiteral("reply 1"));
+        QCOMPARE(tool.execute({{"reg", "STAT"}, {"block", "uart0"}}), QStringLiteral("reply 2"));
+        QCOMPARE(transport->requestIdsForMethod("tools/call").size(), qsizetype(2));
+
+        /* Tool errors are never memoized */
+        QCOMPARE(tool.execute({{"fail", true}}), QStringLiteral("[mcp tool error] reply 3"));
+        QCOMPARE(tool.execute({{"fail", true}}), QStringLiteral("[mcp tool error] reply 4"));
+
+        QCOMPARE(cache->stats().hits, qint64(1));
+        QCOMPARE(cache->stats().misses, qint64(4));
+        QCOMPARE(cache->stats().entries, qsizetype(2));
+
+        cache->clear();
+        QCOMPARE(tool.execute({{"reg", "CTRL"}, {"block", "uart0"}}), QStringLiteral("reply 5"));
+        transport->setSendHook({});
+    }
+
+    void resultCacheEntriesExpireAndEvict()
+    {
+        QSocMcpResultCache cache(200, 2);
+        cache.store(QStringLiteral("a"), {{"k", 1}}, QStringLiteral("one"));
+        cache.store(QStringLiteral("a"), {{"k", 2}}, QStringLiteral("two"));
+        QCOMPARE(
+            cache.lookup(QStringLiteral("a"), {{"k", 1}}).value_or(QString()),
+            QStringLiteral("one"));
+        cache.store(QStringLiteral("b"), {{"k", 1}}, QStringLiteral("three"));
+        QVERIFY(!cache.lookup(QStringLiteral("a"), {{"k", 2}}).has_value());
+        QVERIFY(cache.lookup(QStringLiteral("b"), {{"k", 1}}).has_value());
+
+        QTest::qWait(250);
+        QVERIFY(!cache.lookup(QStringLiteral("a"), {{"k", 1}}).has_value());
+        QCOMPARE(cache.stats().entries, qsizetype(1));
+    }
+
     void toolReportsBusinessError()
     {
         auto         *transport = new FakeTransport;
@@ -961,6 +1025,40 @@ private slots:
         QCOMPARE(transport->abandonedRequestIds(), QList<int>{requestIds.first()});
     }
 
+    void asyncCallsFinishInReplyOrder()
+    {
+        auto         *transport = new FakeTransport;
+        QSocMcpClient client(makeConfig("svr"), transport);
+        QVERIFY(driveClientToReady(&client, transport));
+
+        McpToolDescriptor desc;
+        desc.serverName  = "svr";
+        desc.toolName    = "wait";
+        desc.inputSchema = {{"type", "object"}};
+
+        QSocToolRegistry registry;
+        QSocMcpTool      tool(&client, desc);
+        QObject          owner;
+        registry.registerTool(&tool);
+
+        QStringList finished;
+        for (const char *name : {"first", "second"}) {
+            registry.executeToolAsync(
+                tool.getName(), nlohmann::json{{"name", name}}, &owner, [&](const QString &text) {
+                    finished.append(text);
+                });
+        }
+        const QList<int> ids = transport->requestIdsForMethod(QStringLiteral("tools/call"));
+        QCOMPARE(ids.size(), 2);
+        QVERIFY(finished.isEmpty());
+
+        /* The later call is answered first and must not wait for the other */
+        replyToolSuccess(transport, ids.last(), QStringLiteral("second"));
+        QTRY_COMPARE(finished, QStringList({"second"}));
+        replyToolSuccess(transport, ids.first(), QStringLiteral("first"));
+        QTRY_COMPARE(finished, QStringList({"second", "first"}));
+    }
+
     void abortWithDisabledTimeoutDisownsRequest()
     {
         McpServerConfig config  = makeConfig("svr");
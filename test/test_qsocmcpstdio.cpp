@@ -92,22 +92,26 @@ private slots:
     void newlineParserEnforcesInboundLimit()
     {
         QByteArray oversized(9, 'x');
+        qsizetype  readOffset = 0;
         qsizetype  scanOffset = 0;
-        auto result = QSocMcpStdioInternal::takeLine(oversized, scanOffset, qsizetype(8), false);
+        auto       result     = QSocMcpStdioInternal::takeLine(
+            oversized, readOffset, scanOffset, qsizetype(8), false);
         QCOMPARE(result.status, QSocMcpStdioInternal::LineStatus::TooLarge);
 
         oversized.append('\n');
         scanOffset = 0;
-        result     = QSocMcpStdioInternal::takeLine(oversized, scanOffset, qsizetype(8), false);
+        result     = QSocMcpStdioInternal::takeLine(
+            oversized, readOffset, scanOffset, qsizetype(8), false);
         QCOMPARE(result.status, QSocMcpStdioInternal::LineStatus::TooLarge);
 
         QByteArray exact(8, 'x');
         exact.append('\r');
         scanOffset = 0;
-        result     = QSocMcpStdioInternal::takeLine(exact, scanOffset, qsizetype(8), false);
+        result     = QSocMcpStdioInternal::takeLine(
+            exact, readOffset, scanOffset, qsizetype(8), false);
         QCOMPARE(result.status, QSocMcpStdioInternal::LineStatus::NeedMore);
         exact.append('\n');
-        result = QSocMcpStdioInternal::takeLine(exact, scanOffset, qsizetype(8), false);
+        result = QSocMcpStdioInternal::takeLine(exact, readOffset, scanOffset, qsizetype(8), false);
         QCOMPARE(result.status, QSocMcpStdioInternal::LineStatus::Message);
         QCOMPARE(result.message, QByteArray(8, 'x'));
         QVERIFY(exact.isEmpty());
@@ -116,11 +120,46 @@ private slots:
     void newlineParserReportsUnterminatedEnd()
     {
         QByteArray buffer     = QByteArrayLiteral("{\"jsonrpc\":\"2.0\"}");
+        qsizetype  readOffset = 0;
         qsizetype  scanOffset = 0;
-        const auto result = QSocMcpStdioInternal::takeLine(buffer, scanOffset, qsizetype(64), true);
+        const auto result     = QSocMcpStdioInternal::takeLine(
+            buffer, readOffset, scanOffset, qsizetype(64), true);
         QCOMPARE(result.status, QSocMcpStdioInternal::LineStatus::Unterminated);
     }
 
+    /* A burst of lines is consumed by advancing the cursor; the buffer is
+     * compacted once, when only a partial line is left. */
+    void newlineParserDrainsBurstWithCursor()
+    {
+        QByteArray burst;
+        for (int index = 0; index < 1000; index++) {
+            burst += QByteArray::number(index) + "\r\n";
+        }
+        burst += "{\"partial";
+        qsizetype readOffset = 0;
+        qsizetype scanOffset = 0;
+        for (int index = 0; index < 1000; index++) {
+            const auto result = QSocMcpStdioInternal::takeLine(
+                burst, readOffset, scanOffset, qsizetype(64), false);
+            QCOMPARE(result.status, QSocMcpStdioInternal::LineStatus::Message);
+            QCOMPARE(result.message, QByteArray::number(index));
+        }
+        QVERIFY(readOffset > 0);
+
+        auto result = QSocMcpStdioInternal::takeLine(
+            burst, readOffset, scanOffset, qsizetype(64), false);
+        QCOMPARE(result.status, QSocMcpStdioInternal::LineStatus::NeedMore);
+        QCOMPARE(burst, QByteArray("{\"partial"));
+        QCOMPARE(readOffset, qsizetype(0));
+
+        burst += "\":1}\n";
+        result = QSocMcpStdioInternal::takeLine(
+            burst, readOffset, scanOffset, qsizetype(64), false);
+        QCOMPARE(result.status, QSocMcpStdioInternal::LineStatus::Message);
+        QCOMPARE(result.message, QByteArray("{\"partial\":1}"));
+        QVERIFY(burst.isEmpty());
+    }
+
     void newlineWireRoundTripsUtf8()
     {
         QSocMcpStdioTransport transport(peerConfig(QStringLiteral("echo")));
@@ -0,0 +1,207 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Huang Rui <vowstar@gmail.com>
+
+#include "common/qsocgeneratemanager.h"
+#include "common/qsocprojectmanager.h"
+#include "common/qsocrdlcache.h"
+#include "qsoc_test.h"
+
+#include <QTemporaryDir>
+#include <QtCore>
+#include <QtTest>
+
+namespace {
+
+struct TestApp
+{
+    static auto &instance()
+    {
+        static auto                   argc      = 1;
+        static char                   appName[] = "qsoc";
+        static std::array<char *, 1>  argv      = {{appName}};
+        static const QCoreApplication app       = QCoreApplication(argc, argv.data());
+        return app;
+    }
+};
+
+void writeFile(const QString &path, const QByteArray &content)
+{
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write(content);
+}
+
+const QByteArray kChipRdl = R"(addrmap cache_chip {
+    reg {
+        field {
+            sw = rw;
+            hw = r;
+        } enable[0:0];
+    } ctrl_reg @ 0x0000;
+};
+)";
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private:
+    QTemporaryDir sharedCacheDir;
+
+private slots:
+    void initTestCase()
+    {
+        TestApp::instance();
+        QVERIFY(sharedCacheDir.isValid());
+        /* Read by QSocRdlCache::shared() on every render */
+        qputenv("QSOC_RDL_CACHE", sharedCacheDir.path().toUtf8());
+    }
+
+    /* The key follows the content of the file and of the files it includes. */
+    void testKeyFollowsIncludedContent()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString top    = dir.filePath(QStringLiteral("top.rdl"));
+        const QString common = dir.filePath(QStringLiteral("common.rdl"));
+        writeFile(top, "`include \"common.rdl\"\naddrmap top {};\n");
+        writeFile(common, "reg common_reg { field {} f; };\n");
+
+        const QString first = QSocRdlCache::keyFor(QSocRdlCache::Kind::Rdl, top);
+        QVERIFY(!first.isEmpty());
+        QCOMPARE(QSocRdlCache::keyFor(QSocRdlCache::Kind::Rdl, top), first);
+        QVERIFY(QSocRdlCache::keyFor(QSocRdlCache::Kind::Rcsv, top) != first);
+
+        writeFile(common, "reg common_reg { field {} g; };\n");
+        const QString second = QSocRdlCache::keyFor(QSocRdlCache::Kind::Rdl, top);
+        QVERIFY(second != first);
+
+        writeFile(top, "`include \"common.rdl\"\naddrmap top2 {};\n");
+        QVERIFY(QSocRdlCache::keyFor(QSocRdlCache::Kind::Rdl, top) != second);
+
+        QVERIFY(QSocRdlCache::keyFor(QSocRdlCache::Kind::Rdl, dir.filePath("none.rdl")).isEmpty());
+    }
+
+    /* Angle includes are followed too; unresolved ones are not cacheable. */
+    void testKeyFollowsAngleIncludes()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString top    = dir.filePath(QStringLiteral("top.rdl"));
+        const QString common = dir.filePath(QStringLiteral("common.rdl"));
+        writeFile(top, "`include <common.rdl>\naddrmap top {};\n");
+        writeFile(common, "reg common_reg { field {} f; };\n");
+
+        const QString first = QSocRdlCache::keyFor(QSocRdlCache::Kind::Rdl, top);
+        QVERIFY(!first.isEmpty());
+        writeFile(common, "reg common_reg { field {} g; };\n");
+        QVERIFY(QSocRdlCache::keyFor(QSocRdlCache::Kind::Rdl, top) != first);
+
+        writeFile(top, "`include <elsewhere.rdl>\naddrmap top {};\n");
+        QVERIFY(QSocRdlCache::keyFor(QSocRdlCache::Kind::Rdl, top).isEmpty());
+    }
+
+    /* The environment is read per call, as a daemon changes it per client. */
+    void testSharedFollowsEnvironment()
+    {
+        QTemporaryDir other;
+        QVERIFY(other.isValid());
+        const auto restore = qScopeGuard(
+            [this]() { qputenv("QSOC_RDL_CACHE", sharedCacheDir.path().toUtf8()); });
+
+        qputenv("QSOC_RDL_CACHE", other.path().toUtf8());
+        QSocRdlCache *cache = QSocRdlCache::shared();
+        QVERIFY(cache != nullptr);
+        QCOMPARE(cache->directory(), other.path());
+        QCOMPARE(QSocRdlCache::shared(), cache);
+
+        qputenv("QSOC_RDL_CACHE", "0");
+        QVERIFY(QSocRdlCache::shared() == nullptr);
+    }
+
+    /* Entries round-trip through CBOR; damaged ones are misses; old ones go. */
+    void testStoreLookupAndEvict()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        QSocRdlCache cache(dir.path(), 2);
+
+        const nlohmann::json value = {{"addrmap", {{"inst_name", "chip"}}}, {"registers", {1, 2}}};
+        nlohmann::json       loaded;
+        QVERIFY(!cache.lookup(QStringLiteral("a"), loaded));
+        cache.store(QStringLiteral("a"), value);
+        QVERIFY(cache.lookup(QStringLiteral("a"), loaded));
+        QVERIFY(loaded == value);
+
+        writeFile(dir.filePath(QStringLiteral("a.cbor")), "\xbf\x61");
+        QVERIFY(!cache.lookup(QStringLiteral("a"), loaded));
+        QCOMPARE(cache.stats().hits, qint64(1));
+        QCOMPARE(cache.stats().misses, qint64(2));
+
+        cache.store(QStringLiteral("b"), value);
+        QTest::qWait(20);
+        cache.store(QStringLiteral("c"), value);
+        QTest::qWait(20);
+        cache.store(QStringLiteral("d"), value);
+        QCOMPARE(QDir(dir.path()).entryList({QStringLiteral("*.cbor")}, QDir::Files).size(), 2);
+        QVERIFY(cache.stats().evictions >= 1);
+    }
+
+    /* A hit refreshes the entry, so eviction drops the least recently used. */
+    void testLookupKeepsEntryRecent()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        QSocRdlCache cache(dir.path(), 2);
+
+        const nlohmann::json value = {{"registers", {1}}};
+        nlohmann::json       loaded;
+        cache.store(QStringLiteral("a"), value);
+        QTest::qWait(20);
+        cache.store(QStringLiteral("b"), value);
+        QTest::qWait(20);
+        QVERIFY(cache.lookup(QStringLiteral("a"), loaded));
+        QTest::qWait(20);
+        cache.store(QStringLiteral("c"), value);
+
+        QVERIFY(QFile::exists(dir.filePath(QStringLiteral("a.cbor"))));
+        QVERIFY(!QFile::exists(dir.filePath(QStringLiteral("b.cbor"))));
+        QVERIFY(QFile::exists(dir.filePath(QStringLiteral("c.cbor"))));
+    }
+
+    /* A second render of an unchanged RDL file skips elaboration. */
+    void testRenderReusesElaboration()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString rdlPath      = dir.filePath(QStringLiteral("cache_chip.rdl"));
+        const QString templatePath = dir.filePath(QStringLiteral("chip.h.j2"));
+        writeFile(rdlPath, kChipRdl);
+        writeFile(templatePath, "{{ cache_chip.addrmap.inst_name }}\n");
+
+        QSocProjectManager project;
+        project.setOutputPath(dir.path());
+        QSocGenerateManager generator(nullptr, &project);
+
+        QSocRdlCache *cache = QSocRdlCache::shared();
+        QVERIFY(cache != nullptr);
+        QCOMPARE(cache->directory(), sharedCacheDir.path());
+        const qint64 hits = cache->stats().hits;
+
+        QVERIFY(generator.renderTemplate(templatePath, {}, {}, {}, {rdlPath}, {}, "first.h"));
+        QCOMPARE(cache->stats().hits, hits);
+        QVERIFY(generator.renderTemplate(templatePath, {}, {}, {}, {rdlPath}, {}, "second.h"));
+        QCOMPARE(cache->stats().hits, hits + 1);
+
+        QFile first(dir.filePath(QStringLiteral("first.h")));
+        QFile second(dir.filePath(QStringLiteral("second.h")));
+        QVERIFY(first.open(QIODevice::ReadOnly));
+        QVERIFY(second.open(QIODevice::ReadOnly));
+        QCOMPARE(second.readAll(), first.readAll());
+    }
+};
+
+} // namespace
+
+QSOC_TEST_MAIN(Test)
+#include "test_qsocrdlcache.moc"
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Huang Rui <vowstar@gmail.com>
+
+#include "agent/remote/qsocremotelister.h"
+#include "agent/remote/qsocsshsession.h"
+#include "qsoc_test.h"
+
+#include <QtCore>
+#include <QtTest>
+
+namespace {
+
+struct TestApp
+{
+    static auto &instance()
+    {
+        static auto                   argc      = 1;
+        static char                   appName[] = "qsoc";
+        static std::array<char *, 1>  argv      = {{appName}};
+        static const QCoreApplication app       = QCoreApplication(argc, argv.data());
+        return app;
+    }
+};
+
+QByteArray record(const char *text)
+{
+    return QByteArray(text) + '\0';
+}
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase() { TestApp::instance(); }
+
+    /* Stamp, entries and type letters decode; the path keeps its tabs. */
+    void testParseEntries()
+    {
+        const QByteArray bytes = record("S1712345678.5000000000")
+                                 + record("d\t4096\t1712345600.2\trtl")
+                                 + record("f\t120\t1712345601.9\trtl/top.sv")
+                                 + record("l\t7\t1712345602.0\tlink")
+                                 + record("f\t3\t1712345603.0\todd\tname.sv");
+        const auto listing = QSocRemoteLister::parse(bytes, 10);
+        QCOMPARE(listing.stamp, QStringLiteral("1712345678.5000000000"));
+        QVERIFY(!listing.unchanged);
+        QVERIFY(!listing.truncated);
+        QCOMPARE(listing.entries.size(), 4);
+        QVERIFY(listing.entries.at(0).isDirectory);
+        QCOMPARE(listing.entries.at(1).path, QStringLiteral("rtl/top.sv"));
+        QCOMPARE(listing.entries.at(1).size, qint64(120));
+        QCOMPARE(listing.entries.at(1).mtime, qint64(1712345601));
+        QVERIFY(listing.entries.at(2).isSymlink);
+        QCOMPARE(listing.entries.at(3).path, QStringLiteral("odd\tname.sv"));
+    }
+
+    /* The host sends limit + 1 records so an overflow is detectable. */
+    void testParseMarksTruncation()
+    {
+        const QByteArray bytes = record("S1") + record("f\t1\t1\ta") + record("f\t1\t1\tb")
+                                 + record("f\t1\t1\tc");
+        const auto listing = QSocRemoteLister::parse(bytes, 2);
+        QCOMPARE(listing.entries.size(), 2);
+        QVERIFY(listing.truncated);
+    }
+
+    void testParseUnchangedMarker()
+    {
+        const auto listing = QSocRemoteLister::parse(record("S42.0") + record("U"), 10);
+        QVERIFY(listing.unchanged);
+        QCOMPARE(listing.stamp, QStringLiteral("42.0"));
+        QVERIFY(listing.entries.isEmpty());
+    }
+
+    /* Root, pattern and prune names are single-quoted for the shell. */
+    void testBuildCommandQuotes()
+    {
+        QSocRemoteLister::Query query;
+        query.root        = QStringLiteral("/work/it's");
+        query.maxDepth    = 2;
+        query.limit       = 50;
+        query.namePattern = QStringLiteral("*.sv");
+        query.pruneNames  = {QStringLiteral(".git")};
+        query.filesOnly   = true;
+        const QString command = QSocRemoteLister::buildCommand(query, QStringLiteral("9.5"));
+        const QString prune   = QStringLiteral("\\( -name '.git' \\) -prune -o ");
+        QVERIFY(command.contains(QStringLiteral("cd '/work/it'\\''s'")));
+        QVERIFY(
+            command.contains(QStringLiteral("-maxdepth 1 ") + prune + QStringLiteral("-type d")));
+        QVERIFY(command.contains(
+            QStringLiteral("-maxdepth 2 ") + prune + QStringLiteral("-type f -name '*.sv'")));
+        QVERIFY(command.contains(QStringLiteral("[ \"$s\" = '9.5' ]")));
+        QVERIFY(command.contains(QStringLiteral("head -z -n 51")));
+    }
+
+    void testListWithoutConnectedSession()
+    {
+        QSocSshSession            session;
+        QSocRemoteLister          lister(&session);
+        QSocRemoteLister::Query   query;
+        QSocRemoteLister::Listing listing;
+        QString                   err;
+        query.root = QStringLiteral("/");
+        QVERIFY(!lister.list(query, &listing, &err));
+        QVERIFY(!err.isEmpty());
+    }
+};
+
+} // namespace
+
+QSOC_TEST_MAIN(Test)
+#include "test_qsocremotelister.moc"
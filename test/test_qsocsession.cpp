@@ -7,6 +7,7 @@
 #include <nlohmann/json.hpp>
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QScopeGuard>
 #include <QStandardPaths>
 #include <QTemporaryDir>
@@ -444,6 +445,67 @@ private slots:
         QVERIFY(!session.rewriteMessages(json::array({{{"role", "user"}, {"content", "x"}}})));
     }
 
+    void testBackgroundWritesKeepOrder()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+
+        const QString id   = QSocSession::generateId();
+        const QString path = QDir(QSocSession::sessionsDir(tempDir.path())).filePath(id + ".jsonl");
+        {
+            QSocSession session(id, path);
+            session.setBackgroundWrites(true);
+            QVERIFY(session.appendMeta(QStringLiteral("created"), QStringLiteral("2026-10-01Z")));
+            for (int index = 0; index < 300; ++index) {
+                QVERIFY(session.appendMessage(
+                    {{"role", index % 2 == 0 ? "user" : "assistant"},
+                     {"content", QString::number(index).toStdString()}}));
+            }
+            QVERIFY(session.flush());
+            QCOMPARE(static_cast<int>(QSocSession::loadMessages(path).size()), 300);
+            QVERIFY(session.appendMeta(QStringLiteral("title"), QStringLiteral("queued")));
+        } /* destructor drains the queue */
+
+        const json restored = QSocSession::loadMessages(path);
+        QCOMPARE(static_cast<int>(restored.size()), 300);
+        for (int index = 0; index < 300; ++index) {
+            const std::string expected = QString::number(index).toStdString();
+            QCOMPARE(restored[index]["content"].get<std::string>(), expected);
+        }
+        QCOMPARE(QSocSession::readMeta(path, QStringLiteral("title")), QStringLiteral("queued"));
+    }
+
+    void testBackgroundRunRecordIsDurable()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+
+        const QString id   = QSocSession::generateId();
+        const QString path = QDir(QSocSession::sessionsDir(tempDir.path())).filePath(id + ".jsonl");
+        QSocSession   session(id, path);
+        session.setBackgroundWrites(true);
+        QVERIFY(session.appendMessage({{"role", "user"}, {"content", "before run"}}));
+        QVERIFY(session.appendRun(startedRun(QStringLiteral("run-a"), QStringLiteral("go"))));
+
+        /* No flush(): the run record waits for itself and all before it */
+        const auto latest = QSocSession::latestRun(path);
+        QVERIFY(latest.has_value());
+        QCOMPARE(latest->runId, QStringLiteral("run-a"));
+        QCOMPARE(static_cast<int>(QSocSession::loadMessages(path).size()), 1);
+    }
+
+    void testBackgroundWriteFailureIsReported()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+
+        QSocSession session(QStringLiteral("blocked"), tempDir.path());
+        session.setBackgroundWrites(true);
+        session.appendMessage({{"role", "user"}, {"content", "cannot write here"}});
+        QVERIFY(!session.flush());
+        QVERIFY(!session.appendMessage({{"role", "user"}, {"content", "still failing"}}));
+    }
+
     void testRecoveryClaimLifecycleAndPathIsolation()
     {
         QStandardPaths::setTestModeEnabled(true);
@@ -852,6 +914,68 @@ private slots:
         QCOMPARE(QSocSession::readInfo(path).messageCount, 3);
     }
 
+    void testDeltaSnapshotStoresOnlyNewMessages()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+
+        const QString id   = QSocSession::generateId();
+        const QString path = QDir(QSocSession::sessionsDir(tempDir.path())).filePath(id + ".jsonl");
+        QSocSession   session(id, path);
+        json          history = json::array();
+        for (int index = 0; index < 40; ++index) {
+            const json message
+                = {{"role", index % 2 == 0 ? "user" : "assistant"},
+                   {"content", std::string(512, static_cast<char>('a' + index % 26))
+                                   + std::to_string(index)}};
+            QVERIFY(session.appendMessage(message));
+            history.push_back(message);
+        }
+
+        /* Compaction: a summary replaces the first 30, the tail is kept */
+        json compacted = json::array({{{"role", "user"}, {"content", "summary"}}});
+        for (int index = 30; index < 40; ++index) {
+            compacted.push_back(history[index]);
+        }
+        const qint64 before = QFileInfo(path).size();
+        QVERIFY(session.appendSnapshot(compacted, history));
+        QVERIFY(QFileInfo(path).size() - before < 512);
+
+        QVERIFY(session.appendMessage({{"role", "user"}, {"content", "after"}}));
+        json expected = compacted;
+        expected.push_back({{"role", "user"}, {"content", "after"}});
+        QCOMPARE(QSocSession::loadMessages(path), expected);
+        QCOMPARE(QSocSession::readInfo(path).messageCount, 12);
+
+        /* A second delta resolves against the rebuilt history */
+        json trimmed = expected;
+        trimmed.erase(trimmed.begin() + 1);
+        QVERIFY(session.appendSnapshot(trimmed, expected));
+        QCOMPARE(QSocSession::loadMessages(path), trimmed);
+    }
+
+    void testDeltaSnapshotWithBadReferenceIsIgnored()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+
+        const QString id   = QSocSession::generateId();
+        const QString path = QDir(QSocSession::sessionsDir(tempDir.path())).filePath(id + ".jsonl");
+        QSocSession   session(id, path);
+        QVERIFY(session.appendMessage({{"role", "user"}, {"content", "preserved"}}));
+
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::Append));
+        const QByteArray bad = QByteArrayLiteral(
+            "{\"type\":\"snapshot\",\"count\":2,\"parts\":[[0,2]]}\n");
+        QCOMPARE(file.write(bad), qint64(bad.size()));
+        file.close();
+
+        const json restored = QSocSession::loadMessages(path);
+        QCOMPARE(restored.size(), json::size_type(1));
+        QCOMPARE(restored[0]["content"].get<std::string>(), std::string("preserved"));
+    }
+
     void testTornSnapshotKeepsEarlierMessages()
     {
         QTemporaryDir tempDir;
@@ -2,9 +2,13 @@
 // SPDX-FileCopyrightText: 2026 Huang Rui <vowstar@gmail.com>
 
 #include "agent/remote/qsocagentremote.h"
+#include "agent/remote/qsocremotelister.h"
+#include "agent/remote/qsocremotepathcontext.h"
 #include "agent/remote/qsocsftpclient.h"
+#include "agent/remote/qsocsshexec.h"
 #include "agent/remote/qsocsshhostconfig.h"
 #include "agent/remote/qsocsshsession.h"
+#include "agent/remote/qsoctoolremote.h"
 #include "qsoc_test.h"
 
 #include <QDir>
@@ -115,6 +119,10 @@ private slots:
     void cleanupTestCase();
     void releasesAuthenticationCallbackAfterConnect();
     void overwriteExistingFileRepeatedly();
+    void listerReusesListingUntilTreeChanges();
+    void remoteBashSpillsTruncatedOutputToJob();
+    void execReusesPrewarmedChannels();
+    void keepaliveTickRefillsPool();
 
 private:
     QTemporaryDir m_dir;
@@ -338,5 +346,225 @@ void Test::overwriteExistingFileRepeatedly()
     }
 }
 
+/* One exec lists the tree; a repeat with no directory change is served
+ * from the cache, and adding a file invalidates it. */
+void Test::listerReusesListingUntilTreeChanges()
+{
+    if (!m_ready) {
+        QSKIP("loopback sshd unavailable in this environment");
+    }
+
+    QSocSshHostConfig host;
+    host.hostname           = QStringLiteral("127.0.0.1");
+    host.port               = m_port;
+    host.user               = m_user;
+    host.identityFiles      = {m_keyPath};
+    host.identitiesOnly     = true;
+    host.strictHostKey      = QSocSshHostConfig::StrictHostKey::No;
+    host.userKnownHostsFile = QStringLiteral("/dev/null");
+
+    QSocSshSession session;
+    QString        connectErr;
+    if (session.connectTo(host, &connectErr) != QSocSshSession::ConnectStatus::Ok) {
+        QSKIP(qPrintable(QStringLiteral("connect failed: %1").arg(connectErr)));
+    }
+
+    const QString tree = m_workDir + QStringLiteral("/lister");
+    QVERIFY(QDir().mkpath(tree + QStringLiteral("/rtl/core")));
+    QVERIFY(QDir().mkpath(tree + QStringLiteral("/build")));
+    for (const QString &name :
+         {QStringLiteral("rtl/top.sv"),
+          QStringLiteral("rtl/core/alu.sv"),
+          QStringLiteral("build/skip.sv"),
+          QStringLiteral("README")}) {
+        QFile file(tree + QLatin1Char('/') + name);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("x\n");
+    }
+
+    QSocRemoteLister        lister(&session);
+    QSocRemoteLister::Query query;
+    query.root        = tree;
+    query.maxDepth    = 0;
+    query.namePattern = QStringLiteral("*.sv");
+    query.pruneNames  = {QStringLiteral("build")};
+    query.filesOnly   = true;
+
+    QSocRemoteLister::Listing listing;
+    QString                   err;
+    QVERIFY2(lister.list(query, &listing, &err), qPrintable(err));
+    QStringList paths;
+    for (const auto &entry : listing.entries) {
+        paths.append(entry.path);
+    }
+    paths.sort();
+    QCOMPARE(paths, QStringList({QStringLiteral("rtl/core/alu.sv"), QStringLiteral("rtl/top.sv")}));
+    QVERIFY(!listing.unchanged);
+
+    QVERIFY2(lister.list(query, &listing, &err), qPrintable(err));
+    QVERIFY(listing.unchanged);
+    QCOMPARE(listing.entries.size(), 2);
+    QCOMPARE(lister.cacheHits(), qint64(1));
+
+    /* Directory mtimes have one-second resolution on some filesystems. */
+    QTest::qWait(1100);
+    QFile added(tree + QStringLiteral("/rtl/core/fpu.sv"));
+    QVERIFY(added.open(QIODevice::WriteOnly));
+    added.close();
+    QVERIFY2(lister.list(query, &listing, &err), qPrintable(err));
+    QVERIFY(!listing.unchanged);
+    QCOMPARE(listing.entries.size(), 3);
+}
+
+/* Output past the result window is paged from a remote job directory;
+ * output that fits leaves nothing behind on the host. */
+void Test::remoteBashSpillsTruncatedOutputToJob()
+{
+    if (!m_ready) {
+        QSKIP("loopback sshd unavailable in this environment");
+    }
+
+    QSocSshHostConfig host;
+    host.hostname           = QStringLiteral("127.0.0.1");
+    host.port               = m_port;
+    host.user               = m_user;
+    host.identityFiles      = {m_keyPath};
+    host.identitiesOnly     = true;
+    host.strictHostKey      = QSocSshHostConfig::StrictHostKey::No;
+    host.userKnownHostsFile = QStringLiteral("/dev/null");
+
+    QSocSshSession session;
+    QString        connectErr;
+    if (session.connectTo(host, &connectErr) != QSocSshSession::ConnectStatus::Ok) {
+        QSKIP(qPrintable(QStringLiteral("connect failed: %1").arg(connectErr)));
+    }
+
+    const QString root = m_workDir + QStringLiteral("/spill");
+    QVERIFY(QDir().mkpath(root));
+    QSocRemotePathContext    pathCtx(root, root, {root});
+    QSocToolRemoteShellBash  bash(nullptr, &session, &pathCtx);
+    QSocToolRemoteBashManage manage(nullptr, &session, &pathCtx);
+    const QString            jobsRoot = root + QStringLiteral("/.qsoc-agent/jobs");
+
+    const QString small = bash.execute({{"command", "echo fits; exit 3"}});
+    QVERIFY2(small.contains(QStringLiteral("exit_code: 3")), qPrintable(small));
+    QVERIFY(small.contains(QStringLiteral("fits")));
+    QVERIFY(!small.contains(QStringLiteral("job_id:")));
+    QVERIFY(QDir(jobsRoot).entryList(QDir::Dirs | QDir::NoDotAndDotDot).isEmpty());
+
+    /* Each stream fits its own window even though together they exceed one */
+    const QString split = bash.execute(
+        {{"command",
+          "head -c 30000 /dev/zero | tr '\\0' a; head -c 30000 /dev/zero | tr '\\0' b >&2"}});
+    QVERIFY2(split.contains(QStringLiteral("exit_code: 0")), qPrintable(split.left(400)));
+    QVERIFY(!split.contains(QStringLiteral("job_id:")));
+    QVERIFY(!split.contains(QStringLiteral("bytes omitted")));
+    QVERIFY(QDir(jobsRoot).entryList(QDir::Dirs | QDir::NoDotAndDotDot).isEmpty());
+
+    const QString large = bash.execute(
+        {{"command", "head -c 120000 /dev/zero | tr '\\0' a; echo; echo oops >&2"}});
+    QVERIFY2(large.contains(QStringLiteral("exit_code: 0")), qPrintable(large.left(400)));
+    const qsizetype at = large.indexOf(QStringLiteral("job_id: "));
+    QVERIFY(at >= 0);
+    const QString jobId = large.mid(at + 8).section(QLatin1Char('\n'), 0, 0);
+    QVERIFY(jobId.startsWith(QStringLiteral("fg-")));
+
+    /* Both streams land in one log; their relative order is not fixed */
+    const QString page = manage.execute(
+        {{"job_id", jobId.toStdString()},
+         {"action", "output"},
+         {"offset", 0},
+         {"max_bytes", 200000}});
+    QVERIFY2(page.contains(QStringLiteral("output_bytes: 120006")), qPrintable(page.left(400)));
+    QVERIFY(page.contains(QStringLiteral("next_offset: 120006")));
+    QVERIFY(page.contains(QStringLiteral("oops\n")));
+}
+
+/* Connecting fills the warm pool; an exec consumes one pre-opened channel
+ * instead of paying for a channel-open round trip, and prewarmChannels()
+ * tops the pool back up. With the pool disabled exec opens on the spot. */
+void Test::execReusesPrewarmedChannels()
+{
+    if (!m_ready) {
+        QSKIP("loopback sshd unavailable in this environment");
+    }
+
+    QSocSshHostConfig host;
+    host.hostname           = QStringLiteral("127.0.0.1");
+    host.port               = m_port;
+    host.user               = m_user;
+    host.identityFiles      = {m_keyPath};
+    host.identitiesOnly     = true;
+    host.strictHostKey      = QSocSshHostConfig::StrictHostKey::No;
+    host.userKnownHostsFile = QStringLiteral("/dev/null");
+
+    QSocSshSession session;
+    QString        connectErr;
+    if (session.connectTo(host, &connectErr) != QSocSshSession::ConnectStatus::Ok) {
+        QSKIP(qPrintable(QStringLiteral("connect failed: %1").arg(connectErr)));
+    }
+
+    QCOMPARE(session.warmChannelCount(), 2);
+    const auto opens = [&session]() {
+        return session.latencyStats().value(QStringLiteral("channel_open")).count;
+    };
+    const qint64 prewarmOpens = opens();
+
+    QSocSshExec exec(session);
+    auto        result = exec.run(QStringLiteral("echo warm"), 15000);
+    QVERIFY2(result.exitCode == 0, qPrintable(result.errorText));
+    QCOMPARE(result.stdoutBytes, QByteArray("warm\n"));
+    QCOMPARE(session.warmChannelCount(), 1);
+    QCOMPARE(opens(), prewarmOpens);
+
+    session.prewarmChannels();
+    QCOMPARE(session.warmChannelCount(), 2);
+
+    session.setChannelPoolSize(0);
+    QCOMPARE(session.warmChannelCount(), 0);
+    result = exec.run(QStringLiteral("echo cold"), 15000);
+    QVERIFY2(result.exitCode == 0, qPrintable(result.errorText));
+    QCOMPARE(result.stdoutBytes, QByteArray("cold\n"));
+    QCOMPARE(session.warmChannelCount(), 0);
+    QCOMPARE(opens(), prewarmOpens + 2);
+}
+
+/* The maintenance tick sends a keepalive against a live server, keeps the
+ * session healthy and refills the pool drained by an exec. */
+void Test::keepaliveTickRefillsPool()
+{
+    if (!m_ready) {
+        QSKIP("loopback sshd unavailable in this environment");
+    }
+
+    QSocSshHostConfig host;
+    host.hostname           = QStringLiteral("127.0.0.1");
+    host.port               = m_port;
+    host.user               = m_user;
+    host.identityFiles      = {m_keyPath};
+    host.identitiesOnly     = true;
+    host.strictHostKey      = QSocSshHostConfig::StrictHostKey::No;
+    host.userKnownHostsFile = QStringLiteral("/dev/null");
+
+    QSocSshSession session;
+    QString        connectErr;
+    if (session.connectTo(host, &connectErr) != QSocSshSession::ConnectStatus::Ok) {
+        QSKIP(qPrintable(QStringLiteral("connect failed: %1").arg(connectErr)));
+    }
+
+    QSignalSpy lost(&session, &QSocSshSession::connectionLost);
+    session.setMaintenanceInterval(50);
+
+    QSocSshExec exec(session);
+    const auto  result = exec.run(QStringLiteral("true"), 15000);
+    QVERIFY2(result.exitCode == 0, qPrintable(result.errorText));
+    QCOMPARE(session.warmChannelCount(), 1);
+
+    QTRY_COMPARE_WITH_TIMEOUT(session.warmChannelCount(), 2, 5000);
+    QTest::qWait(300);
+    QVERIFY(session.isHealthy());
+    QCOMPARE(lost.count(), 0);
+}
+
 QSOC_TEST_MAIN(Test)
 #include "test_qsocsftp_loopback.moc"
@@ -54,6 +54,21 @@ private slots:
         QCOMPARE(result.exitCode, -1);
         QVERIFY(!result.errorText.isEmpty());
     }
+
+    /* A streaming run that never opens a channel must not call the sink. */
+    void testStreamWithoutConnectedSession()
+    {
+        QSocSshSession      session;
+        QSocSshExec         exec(session);
+        int                 chunks = 0;
+        QSocSshExec::Stream stream;
+        stream.onChunk    = [&chunks](const QByteArray &, bool) { chunks++; };
+        stream.onIdle     = [&chunks]() { chunks++; };
+        const auto result = exec.run(QStringLiteral("echo hi"), 500, &stream);
+        QCOMPARE(result.exitCode, -1);
+        QCOMPARE(chunks, 0);
+        QVERIFY(!result.errorText.isEmpty());
+    }
 };
 
 } // namespace
@@ -84,6 +84,40 @@ private slots:
     {
         QCOMPARE(QSocSshSession::waitSocket(-1, nullptr, 100), -1);
     }
+
+    /* The channel pool stays empty and takeChannel fails cleanly until the
+     * session is connected. */
+    void testChannelPoolWithoutConnection()
+    {
+        QSocSshSession session;
+        session.prewarmChannels();
+        QCOMPARE(session.warmChannelCount(), 0);
+        QString err;
+        QCOMPARE(session.takeChannel(&err), static_cast<LIBSSH2_CHANNEL *>(nullptr));
+        QVERIFY(!err.isEmpty());
+        session.setChannelPoolSize(0);
+        QCOMPARE(session.warmChannelCount(), 0);
+        QVERIFY(session.isHealthy());
+    }
+
+    /* Operation scopes accumulate count, total and max per name. */
+    void testOperationRecordsLatency()
+    {
+        QSocSshSession session;
+        {
+            const QSocSshSession::Operation operation(session, "sftp_read");
+            QTest::qWait(20);
+        }
+        {
+            const QSocSshSession::Operation operation(session, "sftp_read");
+        }
+        const auto stats = session.latencyStats();
+        QVERIFY(stats.contains(QStringLiteral("sftp_read")));
+        const auto read = stats.value(QStringLiteral("sftp_read"));
+        QCOMPARE(read.count, qint64(2));
+        QVERIFY(read.maxMs >= 15);
+        QVERIFY(read.totalMs >= read.maxMs);
+    }
 };
 
 QSOC_TEST_MAIN(Test)
@@ -90,6 +90,64 @@ private:
     int               globalAbortCount_ = 0;
 };
 
+class ThreadSafeSleepTool final : public QSocTool
+{
+public:
+    explicit ThreadSafeSleepTool(QObject *parent = nullptr)
+        : QSocTool(parent)
+    {}
+
+    QString getName() const override { return QStringLiteral("thread_safe_sleep"); }
+    QString getDescription() const override { return QStringLiteral("Sleep on the caller"); }
+    json    getParametersSchema() const override
+    {
+        return {{"type", "object"}, {"properties", json::object()}};
+    }
+    bool isThreadSafe() const override { return true; }
+
+    QString execute(const json &arguments) override
+    {
+        const QSocToolCallContext *callContext = currentCallContext();
+        const QString label = QString::fromStdString(arguments.value("label", std::string()));
+        const int     delay = arguments.value("delay", 50);
+        {
+            const QMutexLocker locker(&mutex_);
+            threads_.insert(QThread::currentThread());
+            peakRunning_ = qMax(peakRunning_, ++running_);
+        }
+
+        QElapsedTimer elapsed;
+        elapsed.start();
+        bool cancelled = false;
+        while (elapsed.elapsed() < delay && !cancelled) {
+            QThread::msleep(10);
+            cancelled = callContext != nullptr && callContext->isCancellationRequested();
+        }
+
+        const QMutexLocker locker(&mutex_);
+        --running_;
+        return (cancelled ? QStringLiteral("aborted:") : QStringLiteral("completed:")) + label;
+    }
+
+    int peakRunning() const
+    {
+        const QMutexLocker locker(&mutex_);
+        return peakRunning_;
+    }
+
+    QSet<QThread *> threads() const
+    {
+        const QMutexLocker locker(&mutex_);
+        return threads_;
+    }
+
+private:
+    mutable QMutex  mutex_;
+    QSet<QThread *> threads_;
+    int             running_     = 0;
+    int             peakRunning_ = 0;
+};
+
 class Test : public QObject
 {
     Q_OBJECT
@@ -279,6 +337,126 @@ private slots:
         QCOMPARE(tool.globalAbortCount(), 0);
     }
 
+    void testThreadedRunsUseOwnThreads()
+    {
+        QSocToolRegistry registry;
+        ScopedWaitTool   tool(&registry);
+        registry.registerTool(&tool);
+
+        QSocAgentConfig childConfig;
+        childConfig.isSubAgent = true;
+        auto *childA           = new QSocAgent(nullptr, nullptr, &registry, childConfig);
+        auto *childB           = new QSocAgent(nullptr, nullptr, &registry, childConfig);
+
+        QTemporaryDir tmp;
+        QVERIFY(tmp.isValid());
+        QSocSubAgentTaskSource src;
+        src.setTranscriptDir(tmp.path());
+        src.setThreadedRuns(true);
+        const QString idA = src.registerRun(QStringLiteral("a"), QStringLiteral("test"), childA);
+        const QString idB = src.registerRun(QStringLiteral("b"), QStringLiteral("test"), childB);
+
+        QMutex          mutex;
+        QSet<QThread *> threads;
+        QString         resultA;
+        const auto      record = [&]() {
+            const QMutexLocker locker(&mutex);
+            threads.insert(QThread::currentThread());
+        };
+        /* A parks in a tool call forwarded to this thread; B just starts */
+        src.start(idA, [&]() {
+            record();
+            const QString result = registry.executeTool(
+                QStringLiteral("scoped_wait"), json{{"label", "a"}, {"delay", 5000}}, childA);
+            const QMutexLocker locker(&mutex);
+            resultA = result;
+        });
+        src.start(idB, record);
+        QCOMPARE(src.countRunning(), 2);
+
+        /* The forwarded call spins a nested loop here, so kill from a timer */
+        bool          killed = false;
+        QElapsedTimer elapsed;
+        elapsed.start();
+        QTimer::singleShot(100, &registry, [&]() { killed = src.killTask(idA); });
+
+        const auto finalA = [&]() {
+            const QMutexLocker locker(&mutex);
+            return resultA;
+        };
+        QTRY_COMPARE_WITH_TIMEOUT(finalA(), QStringLiteral("aborted:a"), 3000);
+        QVERIFY(killed);
+        QVERIFY(elapsed.elapsed() < 3000);
+        {
+            const QMutexLocker locker(&mutex);
+            QCOMPARE(threads.size(), qsizetype(2));
+            QVERIFY(!threads.contains(QThread::currentThread()));
+            QVERIFY(threads.contains(childA->thread()));
+            QVERIFY(threads.contains(childB->thread()));
+        }
+        QCOMPARE(tool.globalAbortCount(), 0);
+    }
+
+    void testThreadedRunsShareThreadSafeTools()
+    {
+        QSocToolRegistry    registry;
+        ThreadSafeSleepTool tool(&registry);
+        registry.registerTool(&tool);
+
+        QSocAgentConfig childConfig;
+        childConfig.isSubAgent = true;
+        auto *childA           = new QSocAgent(nullptr, nullptr, &registry, childConfig);
+        auto *childB           = new QSocAgent(nullptr, nullptr, &registry, childConfig);
+
+        QTemporaryDir tmp;
+        QVERIFY(tmp.isValid());
+        QSocSubAgentTaskSource src;
+        src.setTranscriptDir(tmp.path());
+        src.setThreadedRuns(true);
+        const QString idA = src.registerRun(QStringLiteral("a"), QStringLiteral("test"), childA);
+        const QString idB = src.registerRun(QStringLiteral("b"), QStringLiteral("test"), childB);
+
+        /* Both children sit in the slow tool while this loop keeps ticking */
+        QMutex      mutex;
+        QStringList results;
+        const auto  call = [&](QSocAgent *child, const char *label, int delay) {
+            return [&, child, label, delay]() {
+                const QString result = registry.executeTool(
+                    QStringLiteral("thread_safe_sleep"),
+                    json{{"label", label}, {"delay", delay}},
+                    child);
+                const QMutexLocker locker(&mutex);
+                results.append(result);
+            };
+        };
+        int    ticks = 0;
+        QTimer ticker;
+        connect(&ticker, &QTimer::timeout, &ticker, [&ticks]() { ++ticks; });
+        ticker.start(10);
+
+        QElapsedTimer elapsed;
+        elapsed.start();
+        src.start(idA, call(childA, "a", 5000));
+        src.start(idB, call(childB, "b", 400));
+
+        const auto finished = [&](const QString &result) {
+            const QMutexLocker locker(&mutex);
+            return results.contains(result);
+        };
+        /* B returns while A is still inside the tool, then A is cancelled */
+        QTRY_VERIFY_WITH_TIMEOUT(finished(QStringLiteral("completed:b")), 3000);
+        QVERIFY(!finished(QStringLiteral("aborted:a")));
+        QCOMPARE(tool.peakRunning(), 2);
+        QVERIFY(ticks >= 10);
+        QVERIFY(src.killTask(idA));
+        QTRY_VERIFY_WITH_TIMEOUT(finished(QStringLiteral("aborted:a")), 3000);
+        QVERIFY(elapsed.elapsed() < 3000);
+
+        const QSet<QThread *> threads = tool.threads();
+        QCOMPARE(threads.size(), qsizetype(2));
+        QVERIFY(!threads.contains(QThread::currentThread()));
+    }
+
     void testQueueRequestForPropagatesHardStopRejection()
     {
         QSocSubAgentTaskSource src;
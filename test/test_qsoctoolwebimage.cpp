@@ -12,6 +12,7 @@
 #include "agent/tool/qsoctoolweb.h"
 #include "common/qllmservice.h"
 #include "common/qsocconfig.h"
+#include "common/qsocimageattach.h"
 #include "qsoc_test.h"
 
 #include <nlohmann/json.hpp>
@@ -260,6 +261,46 @@ llm:
         QVERIFY(!result.contains(QString::fromLatin1(QSocToolWebFetch::attachmentMarkerOpen())));
     }
 
+    /* Re-attaching the same bytes under the same limits reuses the
+     * cached encode; only the source label in the summary changes. */
+    void visionModelReusesCachedEncode()
+    {
+        const QByteArray yaml = R"(
+llm:
+  model: vision
+  models:
+    vision:
+      url: http://example.invalid/v1/chat/completions
+      modalities:
+        image: true
+        image_max_tokens: 10000
+        image_max_dimension: 1024
+)";
+        ScopedConfig     scope(yaml);
+
+        auto *config = new QSocConfig(this, nullptr);
+        auto *llm    = new QLLMService(this, nullptr);
+        llm->setConfig(config);
+        QSocImageAttach::clearEncodeCache();
+
+        const QByteArray png   = makePng(2048, 1024, QColor(Qt::cyan));
+        auto            *tool  = new QSocToolWebFetch(this, config, llm);
+        const QString    first = runOn(
+            tool, QStringLiteral("https://e/first.png"), QStringLiteral("image/png"), png);
+        const QString second = runOn(
+            tool, QStringLiteral("https://e/second.png"), QStringLiteral("image/png"), png);
+        delete tool;
+
+        QCOMPARE(QSocImageAttach::encodeCacheStats().misses, qint64(1));
+        QCOMPARE(QSocImageAttach::encodeCacheStats().hits, qint64(1));
+        QVERIFY(second.contains(QStringLiteral("from https://e/second.png")));
+        const QString openMarker = QString::fromLatin1(QSocToolWebFetch::attachmentMarkerOpen());
+        QVERIFY(first.contains(openMarker));
+        QCOMPARE(
+            first.mid(first.indexOf(openMarker)).replace(QStringLiteral("first"), "x"),
+            second.mid(second.indexOf(openMarker)).replace(QStringLiteral("second"), "x"));
+    }
+
     void visionModelDescriptionMentionsImages()
     {
         const QByteArray yaml = R"(
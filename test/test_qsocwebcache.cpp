@@ -0,0 +1,319 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Huang Rui <vowstar@gmail.com>
+
+#include "agent/tool/qsoctoolweb.h"
+#include "common/qsocwebcache.h"
+#include "qsoc_test.h"
+
+#include <QHostAddress>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTemporaryDir>
+#include <QtCore>
+#include <QtTest>
+
+namespace {
+
+/* Local HTTP stand-in: one canned response, 304 when If-None-Match hits */
+class HttpStandIn
+{
+public:
+    QByteArray contentType = "text/html";
+    QByteArray extraHeaders;
+    QByteArray body;
+    QByteArray etag;
+    int        requests = 0;
+    QByteArray lastRequest;
+
+    bool listen()
+    {
+        if (!server.listen(QHostAddress::LocalHost, 0)) {
+            return false;
+        }
+        QObject::connect(&server, &QTcpServer::newConnection, &server, [this]() {
+            while (QTcpSocket *socket = server.nextPendingConnection()) {
+                socket->setParent(&server);
+                QObject::connect(socket, &QTcpSocket::readyRead, socket, [this, socket]() {
+                    QByteArray request = socket->property("request").toByteArray();
+                    request += socket->readAll();
+                    socket->setProperty("request", request);
+                    if (!request.contains("\r\n\r\n") || socket->property("handled").toBool()) {
+                        return;
+                    }
+                    socket->setProperty("handled", true);
+                    respond(socket, request);
+                });
+            }
+        });
+        return true;
+    }
+
+    json args(const QString &path) const
+    {
+        const QString url
+            = QStringLiteral("http://127.0.0.1:%1%2").arg(server.serverPort()).arg(path);
+        return {{"url", url.toStdString()}};
+    }
+
+private:
+    QTcpServer server;
+
+    void respond(QTcpSocket *socket, const QByteArray &request)
+    {
+        requests++;
+        lastRequest = request;
+        const bool notModified = !etag.isEmpty()
+                                 && request.contains("If-None-Match: " + etag + "\r\n");
+        QByteArray head = notModified ? QByteArrayLiteral("HTTP/1.1 304 Not Modified\r\n")
+                                      : QByteArrayLiteral("HTTP/1.1 200 OK\r\n");
+        head += extraHeaders;
+        if (!etag.isEmpty()) {
+            head += "ETag: " + etag + "\r\n";
+        }
+        const QByteArray payload = notModified ? QByteArray() : body;
+        head += "Content-Type: " + contentType + "\r\nContent-Length: "
+                + QByteArray::number(payload.size()) + "\r\nConnection: close\r\n\r\n";
+        socket->write(head + payload);
+        socket->disconnectFromHost();
+    }
+};
+
+} // namespace
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void freshHitSkipsNetworkAndConversion();
+    void staleEntryRevalidatesWithEtag();
+    void noStoreIsNeverCached();
+    void failedFetchCountsAsMiss();
+    void varyOutsideVariantIsNotStored();
+    void leastRecentlyUsedIsEvicted();
+    void indexSurvivesReopen();
+    void freshnessFollowsHeaders();
+};
+
+void Test::freshHitSkipsNetworkAndConversion()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QSocWebCache cache(dir.path());
+    HttpStandIn  server;
+    server.extraHeaders = "Cache-Control: max-age=600\r\n";
+    server.body         = "<html><body><h1>Datasheet</h1><p>Register map</p></body></html>";
+    QVERIFY(server.listen());
+
+    QSocToolWebFetch tool(this);
+    tool.setWebCache(&cache);
+    const QString first = tool.execute(server.args(QStringLiteral("/ds.html#regs")));
+    QVERIFY2(first.contains(QStringLiteral("# Datasheet")), qPrintable(first));
+
+    const QString second = tool.execute(server.args(QStringLiteral("/ds.html")));
+    QCOMPARE(second, first);
+    QCOMPARE(server.requests, 1);
+
+    const QSocWebCache::Stats stats = cache.stats();
+    QCOMPARE(stats.hits, qint64(1));
+    QCOMPARE(stats.misses, qint64(1));
+    QCOMPARE(stats.entries, qint64(1));
+    QCOMPARE(stats.hitRate(), 0.5);
+}
+
+void Test::staleEntryRevalidatesWithEtag()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QSocWebCache cache(dir.path());
+    HttpStandIn  server;
+    server.contentType  = "text/plain";
+    server.extraHeaders = "Cache-Control: no-cache\r\n";
+    server.body         = "app note v1";
+    server.etag         = "\"v1\"";
+    QVERIFY(server.listen());
+
+    QSocToolWebFetch tool(this);
+    tool.setWebCache(&cache);
+    QCOMPARE(tool.execute(server.args(QStringLiteral("/an.txt"))), QStringLiteral("app note v1"));
+    QVERIFY(!server.lastRequest.contains("If-None-Match"));
+
+    QCOMPARE(tool.execute(server.args(QStringLiteral("/an.txt"))), QStringLiteral("app note v1"));
+    QCOMPARE(server.requests, 2);
+    QVERIFY(server.lastRequest.contains("If-None-Match: \"v1\"\r\n"));
+    QCOMPARE(cache.stats().revalidated, qint64(1));
+
+    /* A changed resource replaces the entry and its validator */
+    server.body = "app note v2";
+    server.etag = "\"v2\"";
+    QCOMPARE(tool.execute(server.args(QStringLiteral("/an.txt"))), QStringLiteral("app note v2"));
+    QCOMPARE(tool.execute(server.args(QStringLiteral("/an.txt"))), QStringLiteral("app note v2"));
+    QVERIFY(server.lastRequest.contains("If-None-Match: \"v2\"\r\n"));
+    QCOMPARE(cache.stats().revalidated, qint64(2));
+    QCOMPARE(cache.stats().entries, qint64(1));
+}
+
+void Test::noStoreIsNeverCached()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QSocWebCache cache(dir.path());
+    HttpStandIn  server;
+    server.contentType  = "text/plain";
+    server.extraHeaders = "Cache-Control: private, no-store\r\n";
+    server.body         = "volatile";
+    server.etag         = "\"x\"";
+    QVERIFY(server.listen());
+
+    QSocToolWebFetch tool(this);
+    tool.setWebCache(&cache);
+    tool.execute(server.args(QStringLiteral("/v")));
+    tool.execute(server.args(QStringLiteral("/v")));
+    QCOMPARE(server.requests, 2);
+    QVERIFY(!server.lastRequest.contains("If-None-Match"));
+    QCOMPARE(cache.stats().entries, qint64(0));
+}
+
+void Test::failedFetchCountsAsMiss()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QSocWebCache cache(dir.path());
+
+    /* Nothing listens on a port just released by a closed server */
+    QTcpServer probe;
+    QVERIFY(probe.listen(QHostAddress::LocalHost, 0));
+    const QString url = QStringLiteral("http://127.0.0.1:%1/gone").arg(probe.serverPort());
+    probe.close();
+
+    QSocToolWebFetch tool(this);
+    tool.setWebCache(&cache);
+    const QString result = tool.execute({{"url", url.toStdString()}});
+    QVERIFY2(result.startsWith(QStringLiteral("Error:")), qPrintable(result));
+    QCOMPARE(cache.stats().misses, qint64(1));
+    QCOMPARE(cache.stats().hitRate(), 0.0);
+}
+
+void Test::varyOutsideVariantIsNotStored()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QSocWebCache                 cache(dir.path());
+    const QMap<QString, QString> variant = {{QStringLiteral("user-agent"), QStringLiteral("ua")}};
+
+    const auto stored = [&](const QByteArray &vary) {
+        const QSocWebCache::RawHeaders headers = {{"Cache-Control", "max-age=600"}, {"Vary", vary}};
+        return cache.store(
+            QStringLiteral("http://host/") + QString::fromLatin1(vary),
+            variant,
+            headers,
+            "text/plain",
+            "body",
+            QStringLiteral("body"));
+    };
+
+    QVERIFY(stored("User-Agent"));
+    QVERIFY(!stored("Accept-Language"));
+    QVERIFY(!stored("user-agent, Cookie"));
+    QVERIFY(!stored("*"));
+    QCOMPARE(cache.stats().entries, qint64(1));
+}
+
+void Test::leastRecentlyUsedIsEvicted()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QSocWebCache                   cache(dir.path(), 250);
+    const QSocWebCache::RawHeaders headers = {{"Cache-Control", "max-age=600"}};
+    const QByteArray               body(100, 'x');
+
+    QVERIFY(cache.store(QStringLiteral("http://a/"), {}, headers, "text/plain", body, QString()));
+    QTest::qWait(5);
+    QVERIFY(cache.store(QStringLiteral("http://b/"), {}, headers, "text/plain", body, QString()));
+    QTest::qWait(5);
+    QVERIFY(cache.lookup(QStringLiteral("http://a/"), {}).has_value());
+    QTest::qWait(5);
+    QVERIFY(cache.store(QStringLiteral("http://c/"), {}, headers, "text/plain", body, QString()));
+
+    QVERIFY(cache.lookup(QStringLiteral("http://a/"), {}).has_value());
+    QVERIFY(!cache.lookup(QStringLiteral("http://b/"), {}).has_value());
+    QVERIFY(cache.lookup(QStringLiteral("http://c/"), {}).has_value());
+    QCOMPARE(cache.stats().evictions, qint64(1));
+    QCOMPARE(cache.stats().bytes, qint64(200));
+
+    /* Larger than the whole cap: refused outright */
+    QVERIFY(!cache.store(
+        QStringLiteral("http://d/"), {}, headers, "text/plain", QByteArray(300, 'y'), QString()));
+}
+
+void Test::indexSurvivesReopen()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QSocWebCache::RawHeaders headers = {{"ETag", "\"e\""}, {"Cache-Control", "no-cache"}};
+    {
+        QSocWebCache cache(dir.path());
+        QVERIFY(cache.store(
+            QStringLiteral("http://host/page"),
+            {{QStringLiteral("user-agent"), QStringLiteral("ua")}},
+            headers,
+            "text/html",
+            "<p>hi</p>",
+            QStringLiteral("hi")));
+    }
+
+    QSocWebCache reopened(dir.path());
+    const auto   entry = reopened.lookup(
+        QStringLiteral("http://host/page"), {{QStringLiteral("user-agent"), QStringLiteral("ua")}});
+    QVERIFY(entry.has_value());
+    QCOMPARE(entry->text, QStringLiteral("hi"));
+    QCOMPARE(entry->body, QByteArray("<p>hi</p>"));
+    QCOMPARE(entry->etag, QStringLiteral("\"e\""));
+    QVERIFY(!entry->isFresh(QDateTime::currentMSecsSinceEpoch()));
+
+    /* A different variant is a different entry */
+    QVERIFY(!reopened
+                 .lookup(
+                     QStringLiteral("http://host/page"),
+                     {{QStringLiteral("user-agent"), QStringLiteral("other")}})
+                 .has_value());
+}
+
+void Test::freshnessFollowsHeaders()
+{
+    using Headers = QSocWebCache::RawHeaders;
+    bool noCache  = false;
+    QCOMPARE(
+        QSocWebCache::freshnessLifetime(Headers{{"Cache-Control", "max-age=60"}}), qint64(60000));
+    QCOMPARE(
+        QSocWebCache::freshnessLifetime(Headers{{"cache-control", "max-age=60"}, {"Age", "15"}}),
+        qint64(45000));
+    QCOMPARE(QSocWebCache::freshnessLifetime(Headers{{"Cache-Control", "no-store"}}), qint64(-1));
+    QCOMPARE(QSocWebCache::freshnessLifetime(Headers{{"Vary", "*"}}), qint64(-1));
+    QCOMPARE(
+        QSocWebCache::freshnessLifetime(
+            Headers{{"Cache-Control", "no-cache, max-age=5"}}, &noCache),
+        qint64(5000));
+    QVERIFY(noCache);
+    QCOMPARE(
+        QSocWebCache::freshnessLifetime(
+            Headers{
+                {"Date", "Sun, 06 Nov 1994 08:49:37 GMT"},
+                {"Expires", "Sun, 06 Nov 1994 09:49:37 GMT"}}),
+        qint64(3600000));
+    QCOMPARE(
+        QSocWebCache::freshnessLifetime(
+            Headers{{"Date", "Sun, 06 Nov 1994 08:49:37 GMT"}, {"Expires", "0"}}),
+        qint64(0));
+    /* Heuristic: a tenth of the Last-Modified age */
+    QCOMPARE(
+        QSocWebCache::freshnessLifetime(
+            Headers{
+                {"Date", "Sun, 06 Nov 1994 10:00:00 GMT"},
+                {"Last-Modified", "Sun, 06 Nov 1994 00:00:00 GMT"}}),
+        qint64(3600000));
+    QCOMPARE(QSocWebCache::parseHttpDate("Thu, 01 Jan 1970 00:00:01 GMT"), qint64(1000));
+}
+
+QSOC_TEST_MAIN(Test)
+#include "test_qsocwebcache.moc"
@@ -0,0 +1,230 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Huang Rui <vowstar@gmail.com>
+
+#include "qsoc_test.h"
+#include "tui/qtuiscreen.h"
+
+#include <QRandomGenerator>
+#include <QtTest>
+
+namespace {
+
+/* Minimal VT model: CUP, EL, DECSTBM, SU/SD with auto-wrap off. SGR and
+ * OSC payloads are consumed without effect; only glyphs are tracked. */
+class Terminal
+{
+public:
+    Terminal(int width, int height)
+        : cols(width)
+        , rows(height)
+        , grid(height, QString(width, QLatin1Char(' ')))
+    {}
+
+    void feed(const QByteArray &bytes)
+    {
+        const QString text = QString::fromUtf8(bytes);
+        for (qsizetype idx = 0; idx < text.size();) {
+            const QChar chr = text.at(idx);
+            if (chr == QLatin1Char('\033') && idx + 1 < text.size()
+                && text.at(idx + 1) == QLatin1Char(']')) {
+                idx = text.indexOf(QStringLiteral("\033\\"), idx) + 2;
+                continue;
+            }
+            if (chr == QLatin1Char('\033') && idx + 1 < text.size()
+                && text.at(idx + 1) == QLatin1Char('[')) {
+                qsizetype end = idx + 2;
+                while (text.at(end).unicode() < 0x40 || text.at(end).unicode() > 0x7E) {
+                    end++;
+                }
+                csi(text.mid(idx + 2, end - idx - 2), text.at(end).toLatin1());
+                idx = end + 1;
+                continue;
+            }
+            if (col < cols) {
+                grid[row][col] = chr;
+            }
+            col = qMin(col + 1, cols - 1);
+            idx++;
+        }
+    }
+
+    QStringList lines() const { return grid; }
+
+private:
+    void csi(const QString &params, char final)
+    {
+        if (params.startsWith(QLatin1Char('?'))) {
+            return;
+        }
+        const QStringList args = params.split(QLatin1Char(';'));
+        const auto        arg  = [&](int index, int fallback) {
+            const int value = args.value(index).toInt();
+            return value > 0 ? value : fallback;
+        };
+        switch (final) {
+        case 'H':
+            row = arg(0, 1) - 1;
+            col = arg(1, 1) - 1;
+            break;
+        case 'K':
+            for (int index = col; index < cols; index++) {
+                grid[row][index] = QLatin1Char(' ');
+            }
+            break;
+        case 'r':
+            top    = params.isEmpty() ? 0 : arg(0, 1) - 1;
+            bottom = params.isEmpty() ? rows : arg(1, rows);
+            row    = 0;
+            col    = 0;
+            break;
+        case 'S':
+        case 'T':
+            for (int count = 0; count < arg(0, 1); count++) {
+                if (final == 'S') {
+                    grid.removeAt(top);
+                    grid.insert(bottom - 1, QString(cols, QLatin1Char(' ')));
+                } else {
+                    grid.removeAt(bottom - 1);
+                    grid.insert(top, QString(cols, QLatin1Char(' ')));
+                }
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    int         cols;
+    int         rows;
+    QStringList grid;
+    int         row    = 0;
+    int         col    = 0;
+    int         top    = 0;
+    int         bottom = 0;
+};
+
+QStringList screenLines(const QTuiScreen &screen)
+{
+    QStringList lines;
+    for (int row = 0; row < screen.height(); row++) {
+        QString line;
+        for (int col = 0; col < screen.width(); col++) {
+            line += screen.at(col, row).character;
+        }
+        lines.append(line);
+    }
+    return lines;
+}
+
+} // namespace
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void unchangedFrameIsEmpty();
+    void singleCellChangeRepaintsOnlyThatSpan();
+    void streamingShiftUsesScrollRegion();
+    void synchronizedOutputBracketsFrame();
+    void randomFramesMatchTerminal();
+};
+
+void Test::unchangedFrameIsEmpty()
+{
+    QTuiScreen screen(40, 5);
+    screen.putString(0, 0, QStringLiteral("hello"));
+    QVERIFY(!screen.encode().isEmpty());
+    QVERIFY(screen.encode().isEmpty());
+}
+
+void Test::singleCellChangeRepaintsOnlyThatSpan()
+{
+    QTuiScreen screen(80, 4);
+    screen.putString(0, 1, QStringLiteral("the quick brown fox jumps over the lazy dog"));
+    screen.encode();
+
+    screen.putChar(4, 1, QLatin1Char('Q'));
+    const QByteArray frame = screen.encode();
+    QCOMPARE(frame, QByteArray("\033[2;5HQ"));
+}
+
+void Test::streamingShiftUsesScrollRegion()
+{
+    QTuiScreen screen(60, 12);
+    screen.setScrollRegion(1, 9);
+    for (int row = 1; row < 9; row++) {
+        screen.putString(0, row, QStringLiteral("transcript line %1").arg(row));
+    }
+    screen.putString(0, 11, QStringLiteral("> input"));
+    screen.encode();
+
+    /* One new line arrives: the pane moves up by one row */
+    screen.clear();
+    for (int row = 1; row < 9; row++) {
+        screen.putString(0, row, QStringLiteral("transcript line %1").arg(row + 1));
+    }
+    screen.putString(0, 11, QStringLiteral("> input"));
+    const QByteArray frame = screen.encode();
+
+    QVERIFY(frame.startsWith("\033[2;9r\033[1S\033[r"));
+    QVERIFY(frame.contains("transcript line 9"));
+    QVERIFY(!frame.contains("transcript line 5"));
+    QVERIFY(frame.size() < 60);
+}
+
+void Test::synchronizedOutputBracketsFrame()
+{
+    QTuiScreen screen(20, 2);
+    screen.setSynchronizedOutput(true);
+    screen.putString(0, 0, QStringLiteral("abc"));
+    const QByteArray frame = screen.encode();
+    QVERIFY(frame.startsWith("\033[?2026h"));
+    QVERIFY(frame.endsWith("\033[?2026l"));
+    QVERIFY(screen.encode().isEmpty());
+}
+
+void Test::randomFramesMatchTerminal()
+{
+    const int         width    = 30;
+    const int         height   = 10;
+    const QTuiFgColor colors[] = {QTuiFgColor::Default, QTuiFgColor::Red, QTuiFgColor::Blue};
+    QTuiScreen        screen(width, height);
+    Terminal          terminal(width, height);
+    QRandomGenerator  random(2026);
+    QStringList       transcript;
+    screen.setScrollRegion(0, height - 2);
+
+    for (int frame = 0; frame < 200; frame++) {
+        /* Mostly append (streaming), sometimes rewrite a visible line */
+        const int action = random.bounded(4);
+        if (action < 2 || transcript.isEmpty()) {
+            QString line;
+            for (int index = random.bounded(width + 1); index > 0; index--) {
+                line += QLatin1Char('a' + random.bounded(4));
+            }
+            transcript.append(line);
+        } else if (action == 2) {
+            transcript.last().chop(qMin<qsizetype>(transcript.last().size(), random.bounded(6)));
+        } else {
+            transcript[random.bounded(transcript.size())] = QStringLiteral("edited %1").arg(frame);
+        }
+
+        screen.clear();
+        const int visible = static_cast<int>(qMin<qsizetype>(transcript.size(), height - 2));
+        for (int row = 0; row < visible; row++) {
+            const QString &line = transcript.at(transcript.size() - visible + row);
+            screen.putString(0, row, line, false, false, false, colors[line.size() % 3]);
+        }
+        screen.putString(0, height - 1, QStringLiteral("> %1").arg(frame));
+        if (frame % 50 == 49) {
+            screen.invalidate();
+        }
+
+        terminal.feed(screen.encode());
+        QCOMPARE(terminal.lines(), screenLines(screen));
+    }
+}
+
+QSOC_TEST_MAIN(Test)
+#include "test_qtuiscreen.moc"